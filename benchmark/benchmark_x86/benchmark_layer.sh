@@ -0,0 +1,102 @@
+#!/bin/bash
+
+CLEAN=""
+FILTER=""
+THREADS="1"
+KERNEL_TUNE=""
+
+if [ -z $TNN_ROOT_PATH ]
+then
+    TNN_ROOT_PATH=$(cd `dirname $0`; pwd)/../..
+fi
+
+WORK_DIR=`pwd`
+BUILD_DIR=build_layer
+OUTPUT_RESULT_FILE=benchmark_layer_result.jsonl
+LOOP_COUNT=10
+
+function usage() {
+    echo "usage: ./benchmark_layer.sh  [-c] [-f] <filter-info> [-th] <1,2,4> [-et]"
+    echo "options:"
+    echo "        -c    Clean up build folders."
+    echo "        -f    specified layer"
+    echo "        -th   comma separated thread counts, default: 1"
+    echo "        -et   enable kernel tuning"
+}
+
+function exit_with_msg() {
+    echo $1
+    exit 1
+}
+
+function clean_build() {
+    echo $1 | grep "$BUILD_DIR\b" > /dev/null
+    if [[ "$?" != "0" ]]; then
+        exit_with_msg "Warnning: $1 seems not to be a BUILD folder."
+    fi
+    rm -rf $1
+    mkdir $1
+}
+
+function build_x86_bench() {
+    if [ "-c" == "$CLEAN" ]; then
+        clean_build $BUILD_DIR
+    fi
+    mkdir -p $BUILD_DIR
+    cd $BUILD_DIR
+    cmake ${TNN_ROOT_PATH} \
+        -DCMAKE_BUILD_TYPE=Release \
+        -DTNN_CPU_ENABLE:BOOL=ON \
+        -DTNN_X86_ENABLE:BOOL=ON \
+        -DTNN_OPENMP_ENABLE:BOOL=ON \
+        -DTNN_TEST_ENABLE:BOOL=ON \
+        -DTNN_UNIT_TEST_ENABLE:BOOL=ON \
+        -DTNN_UNIT_TEST_BENCHMARK:BOOL=ON \
+        -DTNN_PROFILER_ENABLE:BOOL=ON \
+        -DTNN_BUILD_SHARED:BOOL=ON
+
+    make -j4 unit_test
+    ret=$?
+    cd $WORK_DIR
+    return $ret
+}
+
+function bench_x86() {
+    build_x86_bench
+    if [ $? != 0 ];then
+        exit_with_msg "build failed"
+    fi
+
+    rm -f $WORK_DIR/$OUTPUT_RESULT_FILE
+    LD_LIBRARY_PATH=$BUILD_DIR ./$BUILD_DIR/test/unit_test/unit_test ${KERNEL_TUNE} -ic ${LOOP_COUNT} -dt X86 \
+        --gtest_filter="*${FILTER}*" -ub -ubt ${THREADS} -ubo $WORK_DIR/$OUTPUT_RESULT_FILE
+    echo "result written to $WORK_DIR/$OUTPUT_RESULT_FILE"
+}
+
+while [ "$1" != "" ]; do
+    case $1 in
+        -c)
+            shift
+            CLEAN="-c"
+            ;;
+        -f)
+            shift
+            FILTER=$1
+            shift
+            ;;
+        -th)
+            shift
+            THREADS="$1"
+            shift
+            ;;
+        -et)
+            shift
+            KERNEL_TUNE="-et"
+            ;;
+        *)
+            usage
+            exit 1
+    esac
+done
+
+bench_x86
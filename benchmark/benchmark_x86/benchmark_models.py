@@ -0,0 +1,223 @@
+# Tencent is pleased to support the open source community by making TNN available.
+#
+# Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+#
+# Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+# in compliance with the License. You may obtain a copy of the License at
+#
+# https://opensource.org/licenses/BSD-3-Clause
+#
+# Unless required by applicable law or agreed to in writing, software distributed
+# under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+# CONDITIONS OF ANY KIND, either express or implied. See the License for the
+# specific language governing permissions and limitations under the License.
+
+import argparse
+import csv
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+
+RESULT_VERSION = 1
+
+TIME_COST_PATTERN = re.compile(r"TNN Benchmark time cost: min = *([\d.]+) *ms *\| *max = *([\d.]+) *ms *\| *"
+                               r"avg = *([\d.]+) *ms *\| *p50 = *([\d.]+) *ms *\| *p99 = *([\d.]+) *ms")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="benchmark tnn models on x86 with TNNTest")
+    parser.add_argument("--tnn_test", required=True, help="path of the TNNTest binary")
+    parser.add_argument("--model_dir", required=True, help="dir of the *.tnnproto models")
+    parser.add_argument("--models", default="", help="comma separated model file names, default all")
+    parser.add_argument("--threads", default="1", help="comma separated thread counts")
+    parser.add_argument("--batches", default="1", help="comma separated batch sizes")
+    parser.add_argument("--precisions", default="HIGH", help="comma separated precisions: HIGH, NORMAL, LOW")
+    parser.add_argument("--warm_up", type=int, default=5, help="warm up count")
+    parser.add_argument("--loop", type=int, default=20, help="timed iterations")
+    parser.add_argument("--profile", action="store_true", help="collect hot spots, TNNTest must be built with "
+                                                               "TNN_PROFILER_ENABLE")
+    parser.add_argument("--hot_spots", type=int, default=10, help="layers reported per run with --profile")
+    parser.add_argument("--output", default="benchmark_x86_result.json", help="result json path")
+    parser.add_argument("--baseline", default="", help="baseline result json to compare with")
+    parser.add_argument("--latency_threshold", type=float, default=0.05,
+                        help="relative p50 latency increase reported as regression")
+    parser.add_argument("--memory_threshold", type=float, default=0.10,
+                        help="relative peak rss increase reported as regression")
+    return parser.parse_args()
+
+
+def split_list(value, convert=str):
+    return [convert(item.strip()) for item in value.split(",") if item.strip()]
+
+
+def read_input_shapes(proto_path):
+    """input names and dims from the second line of the tnnproto"""
+    with open(proto_path) as proto_file:
+        proto_file.readline()
+        line = proto_file.readline().strip().strip('"').rstrip(",")
+    inputs = []
+    for item in line.split(":"):
+        tokens = item.split()
+        if len(tokens) < 5:
+            continue
+        inputs.append((tokens[0], [int(dim) for dim in tokens[1:5]]))
+    return inputs
+
+
+def cpu_name():
+    try:
+        with open("/proc/cpuinfo") as cpuinfo:
+            for line in cpuinfo:
+                if line.startswith("model name"):
+                    return line.split(":", 1)[1].strip()
+    except IOError:
+        pass
+    return platform.processor()
+
+
+def run_tnn_test(command):
+    """run TNNTest, returns its output, exit code and peak rss in MB"""
+    process = subprocess.Popen(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    output = process.stdout.read()
+    _, status, rusage = os.wait4(process.pid, 0)
+    process.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+    # ru_maxrss is in KB on linux
+    return output, process.returncode, rusage.ru_maxrss / 1024.0
+
+
+def read_hot_spots(csv_path, count):
+    with open(csv_path) as csv_file:
+        layers = list(csv.DictReader(csv_file))
+    total = sum(float(layer["kernel_ms"]) for layer in layers)
+    layers.sort(key=lambda layer: float(layer["kernel_ms"]), reverse=True)
+    hot_spots = []
+    for layer in layers[:count]:
+        kernel_ms = float(layer["kernel_ms"])
+        hot_spots.append({
+            "name": layer["name"],
+            "op_type": layer["op_type"],
+            "impl": layer.get("impl", ""),
+            "kernel_ms": round(kernel_ms, 4),
+            "percent": round(kernel_ms / total * 100, 2) if total > 0 else 0,
+            "gflops": round(float(layer["gflops"]), 3),
+        })
+    return hot_spots
+
+
+def benchmark_model(args, model, threads, batch, precision, work_dir):
+    proto_path = os.path.join(args.model_dir, model)
+    result = {"model": model, "threads": threads, "batch": batch, "precision": precision}
+    command = [args.tnn_test, "-dt", "X86", "-mt", "TNN", "-mp", proto_path, "-wc", str(args.warm_up),
+               "-ic", str(args.loop), "-th", str(threads), "-pr", precision]
+
+    # TNNTest takes the shape of one input
+    inputs = read_input_shapes(proto_path)
+    if len(inputs) == 1:
+        name, dims = inputs[0]
+        command += ["-is", "%s[%s]" % (name, ",".join(str(dim) for dim in [batch] + dims[1:]))]
+    elif batch != 1:
+        result["status"] = "skipped: batch only applies to models with one input"
+        return result
+
+    profile_prefix = os.path.join(work_dir, "%s_%d_%d_%s" % (model, threads, batch, precision))
+    if args.profile:
+        command += ["-pp", profile_prefix]
+
+    output, returncode, peak_rss = run_tnn_test(command)
+    match = TIME_COST_PATTERN.search(output)
+    if returncode != 0 or not match:
+        result["status"] = "failed: exit code %d" % returncode
+        sys.stderr.write(output)
+        return result
+
+    latency = [float(value) for value in match.groups()]
+    result["status"] = "ok"
+    result["latency_ms"] = dict(zip(["min", "max", "avg", "p50", "p99"], latency))
+    result["throughput"] = round(batch * 1000.0 / latency[2], 3) if latency[2] > 0 else 0
+    result["peak_rss_mb"] = round(peak_rss, 2)
+    if args.profile and os.path.exists(profile_prefix + ".csv"):
+        result["hot_spots"] = read_hot_spots(profile_prefix + ".csv", args.hot_spots)
+    return result
+
+
+def result_key(result):
+    return "%s/th%d/b%d/%s" % (result["model"], result["threads"], result["batch"], result["precision"])
+
+
+def compare_with_baseline(report, baseline, args):
+    """print the changes against the baseline, returns the count of regressions"""
+    if baseline.get("version") != report["version"]:
+        print("baseline version %s differs from %s" % (baseline.get("version"), report["version"]))
+    if baseline.get("profile") != report["profile"]:
+        print("warning: baseline and result differ in profiling, the latencies are not comparable")
+
+    baseline_results = dict((result_key(result), result) for result in baseline.get("results", []))
+    regressions = 0
+    print("%-56s %12s %12s %8s %12s %12s %8s" % ("case", "base p50", "p50", "diff", "base rss", "rss", "diff"))
+    for result in report["results"]:
+        key = result_key(result)
+        base = baseline_results.get(key)
+        if not base or base.get("status") != "ok":
+            print("%-56s new" % key)
+            continue
+        if result.get("status") != "ok":
+            print("%-56s %s" % (key, result.get("status")))
+            regressions += 1
+            continue
+        base_p50, p50 = base["latency_ms"]["p50"], result["latency_ms"]["p50"]
+        base_rss, rss = base["peak_rss_mb"], result["peak_rss_mb"]
+        p50_diff = (p50 - base_p50) / base_p50 if base_p50 > 0 else 0
+        rss_diff = (rss - base_rss) / base_rss if base_rss > 0 else 0
+        regressed = p50_diff > args.latency_threshold or rss_diff > args.memory_threshold
+        regressions += 1 if regressed else 0
+        print("%-56s %12.3f %12.3f %+7.1f%% %12.2f %12.2f %+7.1f%%%s" %
+              (key, base_p50, p50, p50_diff * 100, base_rss, rss, rss_diff * 100, "  REGRESSION" if regressed else ""))
+    return regressions
+
+
+def main():
+    args = parse_args()
+    models = split_list(args.models)
+    if not models:
+        models = sorted(name for name in os.listdir(args.model_dir) if name.endswith(".tnnproto"))
+
+    report = {
+        "version": RESULT_VERSION,
+        "device": "X86",
+        "cpu": cpu_name(),
+        "profile": args.profile,
+        "warm_up": args.warm_up,
+        "loop": args.loop,
+        "results": [],
+    }
+    work_dir = tempfile.mkdtemp(prefix="tnn_benchmark_")
+    for model in models:
+        for threads in split_list(args.threads, int):
+            for batch in split_list(args.batches, int):
+                for precision in split_list(args.precisions):
+                    result = benchmark_model(args, model, threads, batch, precision, work_dir)
+                    print("%-56s %s" % (result_key(result), result.get("latency_ms", result["status"])))
+                    report["results"].append(result)
+
+    with open(args.output, "w") as output_file:
+        json.dump(report, output_file, indent=2, sort_keys=True)
+        output_file.write("\n")
+    print("result written to %s" % args.output)
+
+    failures = sum(1 for result in report["results"] if not result["status"].startswith(("ok", "skipped")))
+    if args.baseline:
+        with open(args.baseline) as baseline_file:
+            baseline = json.load(baseline_file)
+        regressions = compare_with_baseline(report, baseline, args)
+        if regressions > 0:
+            print("%d regressions against %s" % (regressions, args.baseline))
+            return 1
+    return 1 if failures > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
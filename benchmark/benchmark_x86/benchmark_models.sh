@@ -0,0 +1,154 @@
+#!/bin/bash
+
+PROFILING="OFF"
+CLEAN=""
+BUILD_ONLY=""
+OPENMP="ON"
+THREADS="1"
+BATCHES="1"
+PRECISIONS="HIGH"
+BASELINE=""
+
+if [ -z $TNN_ROOT_PATH ]
+then
+    TNN_ROOT_PATH=$(cd `dirname $0`; pwd)/../..
+fi
+
+WORK_DIR=`pwd`
+BENCHMARK_MODEL_DIR=$TNN_ROOT_PATH/benchmark/benchmark-model
+BUILD_DIR=build
+OUTPUT_RESULT_FILE=benchmark_x86_result.json
+LOOP_COUNT=20
+WARM_UP_COUNT=5
+
+benchmark_model_list=(
+#test.tnnproto \
+)
+
+function usage() {
+    echo "usage: ./benchmark_models.sh  [-c] [-b] [-f] [-th <1,4>] [-bs <1,8>] [-pr <HIGH,LOW>] [-base <baseline.json>]"
+    echo "options:"
+    echo "        -c    Clean up build folders."
+    echo "        -b    build targets only"
+    echo "        -f    build profiling targets, adds the per layer hot spots to the result"
+    echo "        -th   comma separated thread counts, default: 1"
+    echo "        -bs   comma separated batch sizes, default: 1"
+    echo "        -pr   comma separated precisions, default: HIGH"
+    echo "        -base baseline result to compare with, exits with 1 on regressions"
+}
+
+function exit_with_msg() {
+    echo $1
+    exit 1
+}
+
+function clean_build() {
+    echo $1 | grep "$BUILD_DIR\b" > /dev/null
+    if [[ "$?" != "0" ]]; then
+        exit_with_msg "Warnning: $1 seems not to be a BUILD folder."
+    fi
+    rm -rf $1
+    mkdir $1
+}
+
+function build_x86_bench() {
+    if [ "-c" == "$CLEAN" ]; then
+        clean_build $BUILD_DIR
+    fi
+    mkdir -p $BUILD_DIR
+    cd $BUILD_DIR
+    cmake ${TNN_ROOT_PATH} \
+        -DCMAKE_BUILD_TYPE=Release \
+        -DTNN_CPU_ENABLE:BOOL=ON \
+        -DTNN_X86_ENABLE:BOOL=ON \
+        -DTNN_OPENMP_ENABLE:BOOL=$OPENMP \
+        -DTNN_PROFILER_ENABLE:BOOL=${PROFILING} \
+        -DTNN_TEST_ENABLE:BOOL=ON \
+        -DTNN_BUILD_SHARED:BOOL=ON \
+        -DTNN_BENCHMARK_MODE:BOOL=ON
+
+    make -j4 TNNTest
+    ret=$?
+    cd $WORK_DIR
+    return $ret
+}
+
+function bench_x86() {
+    build_x86_bench
+    if [ $? != 0 ];then
+        exit_with_msg "build failed"
+    fi
+
+    if [ "" != "$BUILD_ONLY" ]; then
+        echo "build done!"
+        exit 0
+    fi
+
+    if [ ${#benchmark_model_list[*]} == 0 ];then
+        benchmark_model_list=`cd ${BENCHMARK_MODEL_DIR}; ls *.tnnproto`
+    fi
+    models=`echo ${benchmark_model_list[*]} | tr ' ' ','`
+
+    profile_args=""
+    if [ "ON" == $PROFILING ]; then
+        profile_args="--profile"
+    fi
+    baseline_args=""
+    if [ "" != "$BASELINE" ]; then
+        baseline_args="--baseline $BASELINE"
+    fi
+
+    LD_LIBRARY_PATH=$BUILD_DIR python3 `dirname $0`/benchmark_models.py \
+        --tnn_test $BUILD_DIR/test/TNNTest \
+        --model_dir $BENCHMARK_MODEL_DIR \
+        --models $models \
+        --threads $THREADS \
+        --batches $BATCHES \
+        --precisions $PRECISIONS \
+        --warm_up $WARM_UP_COUNT \
+        --loop $LOOP_COUNT \
+        --output $WORK_DIR/$OUTPUT_RESULT_FILE \
+        $profile_args $baseline_args
+}
+
+while [ "$1" != "" ]; do
+    case $1 in
+        -c)
+            shift
+            CLEAN="-c"
+            ;;
+        -b)
+            shift
+            BUILD_ONLY="-b"
+            ;;
+        -f)
+            shift
+            PROFILING="ON"
+            ;;
+        -th)
+            shift
+            THREADS="$1"
+            shift
+            ;;
+        -bs)
+            shift
+            BATCHES="$1"
+            shift
+            ;;
+        -pr)
+            shift
+            PRECISIONS="$1"
+            shift
+            ;;
+        -base)
+            shift
+            BASELINE="$1"
+            shift
+            ;;
+        *)
+            usage
+            exit 1
+    esac
+done
+
+bench_x86
@@ -0,0 +1,111 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_INCLUDE_TNN_CORE_BATCH_EXECUTOR_H_
+#define TNN_INCLUDE_TNN_CORE_BATCH_EXECUTOR_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tnn/core/blob.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/mat.h"
+#include "tnn/core/status.h"
+#include "tnn/utils/blob_converter.h"
+
+#pragma warning(push)
+#pragma warning(disable : 4251)
+
+namespace TNN_NS {
+
+struct PUBLIC BatchConfig {
+    // max batch of one forward, requests are coalesced until it is reached
+    int max_batch_size = 8;
+    // max time in microseconds the oldest queued request waits for others
+    int max_delay_us = 1000;
+    // convert param of each input, inputs not in the map use the default param
+    std::map<std::string, MatConvertParam> input_params;
+};
+
+struct PUBLIC BatchResult {
+    Status status;
+    // output mats of one request, NCHW_FLOAT with the batch of the request
+    MatMap outputs;
+};
+
+// @brief BatchExecutor owns an instance and runs the requests submitted from any thread
+// on one worker thread. Queued requests are coalesced along the batch dim, the instance
+// is reshaped to the batch and the outputs are split back to the request futures.
+// The instance must be created with inputs of batch max_batch_size, reshape only shrinks it.
+// The input mats of a request must be host mats with the same batch of at most max_batch_size
+// and the non batch dims of the instance inputs, requests are only coalesced when their mat
+// types are equal.
+class PUBLIC BatchExecutor {
+public:
+    BatchExecutor(std::shared_ptr<Instance> instance, BatchConfig config);
+
+    ~BatchExecutor();
+
+    // start the worker thread, the instance is reshaped lazily to the batch of each forward.
+    Status Init();
+
+    // finish the queued requests and stop the worker thread.
+    Status DeInit();
+
+    // queue one request, the inputs are keyed by input name. Invalid requests get a
+    // ready future with the error status.
+    // the mats are read by the worker, keep them unchanged until the future is ready.
+    std::future<BatchResult> Submit(MatMap inputs);
+
+private:
+    struct Request {
+        MatMap inputs;
+        int batch = 0;
+        std::chrono::steady_clock::time_point enqueue_time;
+        std::promise<BatchResult> promise;
+    };
+
+    void WorkerLoop();
+    bool CanCoalesce(Request &first, Request &other);
+    Status ReshapeToBatch(int batch);
+    Status RunBatch(std::vector<std::shared_ptr<Request>> &requests, std::vector<MatMap> &outputs);
+
+    std::shared_ptr<Instance> instance_;
+    BatchConfig config_;
+
+    // input dims of batch 1 and the current input shapes of the instance
+    InputShapesMap sample_shapes_;
+    InputShapesMap current_shapes_;
+
+    std::deque<std::shared_ptr<Request>> queue_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread worker_;
+    bool running_ = false;
+};
+
+}  // namespace TNN_NS
+
+#pragma warning(pop)
+
+#endif  // TNN_INCLUDE_TNN_CORE_BATCH_EXECUTOR_H_
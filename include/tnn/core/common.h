@@ -68,6 +68,7 @@ typedef enum {
     PRECISION_HIGH = 1,
     // Low precision
     // ARM: run with bfp16
+    // X86: run with fp32, packed conv and fc weights are kept in fp16 or bf16
     // OPENCL: run with fp16
     // METAL: run with fp16
     PRECISION_LOW = 2
@@ -110,6 +111,8 @@ typedef enum {
 
 typedef enum {
     MODEL_TYPE_TNN      = 0x0001,
+    // tnn model whose weights are memory mapped from file instead of copied
+    MODEL_TYPE_TNN_MMAP = 0x0002,
     MODEL_TYPE_NCNN     = 0x0100,
     MODEL_TYPE_OPENVINO = 0x1000,
     MODEL_TYPE_COREML   = 0x2000,
@@ -151,12 +154,17 @@ struct PUBLIC NetworkConfig {
     // network init or reshape may cost more time to select opt kernel implement if enable tune kernel
     // cache_path can set to store tune kernel info.
     bool enable_tune_kernel = false;
+
+    // run the independent branches of the network at the same time, the cpu threads are shared by
+    // the layers running together. x86 with openmp only, other devices run the layers in order.
+    bool enable_parallel_branches = false;
 };
 
 struct PUBLIC ModelConfig {
     ModelType model_type = MODEL_TYPE_TNN;
 
     // tnn model need two params: order is proto content, model content.
+    // tnn mmap model need two params: order is proto content, model file path.
     // ncnn need two: params: order is param, weights.
     // openvino model need two params: order is xml content, model path.
     // coreml model need one param: coreml model dir.
@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "tnn/core/blob.h"
@@ -32,6 +33,7 @@ namespace TNN_NS {
 
 class AbstractNetwork;
 class AbstractModelInterpreter;
+class ProfileResult;
 
 struct LayerInfo;
 
@@ -97,6 +99,12 @@ public:
     void StartProfile();
     /**finish profile each layer and show result*/
     std::string FinishProfile(bool do_print = false);
+    /**write the last finished profile to path_prefix.trace.json (chrome trace), path_prefix.csv and
+     * path_prefix.json. peak_gflops (GFLOP/s) and peak_bandwidth (GB/s) of the device give the roofline
+     * columns, they are 0 without the peaks.*/
+    Status ExportProfile(std::string path_prefix, double peak_gflops = 0, double peak_bandwidth = 0);
+    /**result of the last FinishProfile, nullptr before*/
+    std::shared_ptr<ProfileResult> GetProfileResult();
 #endif
 
 private:
@@ -104,6 +112,8 @@ private:
     std::shared_ptr<AbstractNetwork> network_;
     NetworkConfig net_config_;
     ModelConfig model_config_;
+    // result of the last FinishProfile
+    std::shared_ptr<ProfileResult> profile_result_;
     
     AbstractNetwork *GetNetwork();
     
@@ -0,0 +1,114 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_INCLUDE_TNN_CORE_INSTANCE_POOL_H_
+#define TNN_INCLUDE_TNN_CORE_INSTANCE_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tnn/core/instance.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/mat.h"
+#include "tnn/core/status.h"
+#include "tnn/core/tnn.h"
+#include "tnn/utils/blob_converter.h"
+
+#pragma warning(push)
+#pragma warning(disable : 4251)
+
+namespace TNN_NS {
+
+struct PUBLIC InstancePoolConfig {
+    // count of the instances, the cpus are split into as many disjoint groups
+    int instance_count = 2;
+    // bind the threads of each instance to the cpus of its group, only linux and android
+    // support the cpu affinity
+#if defined(__ANDROID__) || defined(__linux__)
+    bool bind_cpu = true;
+#else
+    bool bind_cpu = false;
+#endif
+    // convert param of each input, inputs not in the map use the default param
+    std::map<std::string, MatConvertParam> input_params;
+};
+
+struct PUBLIC InstancePoolResult {
+    Status status;
+    // output mats of the request, NCHW_FLOAT owned by the result
+    MatMap outputs;
+};
+
+// @brief InstancePool runs several instances of one model side by side. The cpus are split into
+// disjoint groups of whole cores with CpuUtils::PartitionCpus, every instance runs on a worker
+// thread bound to its group with as many threads as the group has cpus, so the instances do not
+// share cores or openmp threads. Requests go to the instance with the fewest pending requests.
+class PUBLIC InstancePool {
+public:
+    explicit InstancePool(InstancePoolConfig config);
+
+    ~InstancePool();
+
+    // create the instances on their worker threads, net_config.device_type should be a cpu device.
+    Status Init(TNN &tnn, NetworkConfig &net_config, InputShapesMap inputs_shape = InputShapesMap());
+
+    // finish the queued requests and stop the worker threads.
+    Status DeInit();
+
+    // queue one request, the inputs are keyed by input name.
+    // the mats are read by the worker, keep them unchanged until the future is ready.
+    std::future<InstancePoolResult> Submit(MatMap inputs);
+
+    // cpuids the instance at index runs on
+    std::vector<int> GetCpuGroup(int index);
+
+private:
+    struct Request {
+        MatMap inputs;
+        std::promise<InstancePoolResult> promise;
+    };
+
+    struct Worker {
+        std::shared_ptr<Instance> instance;
+        std::vector<int> cpus;
+        std::deque<std::shared_ptr<Request>> queue;
+        // queued and running requests
+        int pending = 0;
+        std::condition_variable cond;
+        std::thread thread;
+    };
+
+    Status InitWorker(Worker *worker, TNN &tnn, NetworkConfig net_config, InputShapesMap inputs_shape);
+    void WorkerLoop(Worker *worker);
+    Status RunRequest(Worker *worker, Request &request, MatMap &outputs);
+
+    InstancePoolConfig config_;
+    std::vector<std::shared_ptr<Worker>> workers_;
+    // guards the queues and the pending counts of all workers
+    std::mutex mutex_;
+    bool running_ = false;
+};
+
+}  // namespace TNN_NS
+
+#pragma warning(pop)
+
+#endif  // TNN_INCLUDE_TNN_CORE_INSTANCE_POOL_H_
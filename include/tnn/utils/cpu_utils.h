@@ -39,6 +39,12 @@ public:
     // @brief set x86 cpu denormal ftz and daz, no use for other cpu.
     // @param denormal 0:turn off denormal 1:turn on denormal
     PUBLIC static void SetCpuDenormal(int denormal);
+
+    // @brief split the cpus the process may run on into disjoint groups, the hyper threads of
+    // one core stay in the same group. cores of one package are taken first.
+    // @param group_count count of the groups, at most the count of the cpus
+    // @param cpu_groups cpuids of each group
+    PUBLIC static Status PartitionCpus(int group_count, std::vector<std::vector<int>>& cpu_groups);
 };
 
 }  // namespace TNN_NS
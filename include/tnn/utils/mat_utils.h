@@ -17,6 +17,7 @@
 
 #include "tnn/core/status.h"
 #include "tnn/core/mat.h"
+#include "tnn/utils/blob_converter.h"
 
 namespace TNN_NS {
 
@@ -71,6 +72,20 @@ struct PUBLIC CopyMakeBorderParam {
     float border_val       = 0.0f;
 };
 
+struct PUBLIC PreprocessParam {
+    // region of src to resize, the whole src when width or height is 0
+    CropParam crop;
+    // interp type of resizing the crop region to the dst size minus border
+    InterpType interp_type = INTERP_TYPE_LINEAR;
+    // constant border around the resized region, e.g. letterbox padding
+    CopyMakeBorderParam border;
+    // sample dst by warp_affine instead of crop, resize and border
+    bool use_warp_affine = false;
+    WarpAffineParam warp_affine;
+    // scale, bias and reverse_channel applied at last, same as SetInputMat
+    MatConvertParam convert_param;
+};
+
 class PUBLIC MatUtils {
 public:
     //copy cpu <-> device, cpu<->cpu, device<->device, src and dst dims must be equal.
@@ -92,6 +107,11 @@ public:
 
     //src and dst device type must be same. param top, bottom, left and right must be non-negative.
     static Status CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, void* command_queue);
+
+    //src and dst device type must be same. src is N8UC3, N8UC4, NGRAY, NNV12 or NNV21, dst is NCHW_FLOAT.
+    //crop, resize or warp affine, border, yuv to bgr and convert param run in one pass without intermediate mats,
+    //dst can wrap the input blob memory of a host instance to skip SetInputMat.
+    static Status Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue);
 };
 
 }  // namespace TNN_NS
@@ -31,6 +31,10 @@ std::shared_ptr<const ImplementedPrecision> AbstractDevice::GetImplementedPrecis
     return std::make_shared<ImplementedPrecision>();
 }
 
+AbstractDevice* AbstractDevice::GetFallbackDevice() {
+    return nullptr;
+}
+
 AbstractDevice* GetDevice(DeviceType type) {
     return GetGlobalDeviceMap()[type].get();
 }
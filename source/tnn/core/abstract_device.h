@@ -79,6 +79,10 @@ public:
     // @brief get implemented precisions on the device by layer type
     virtual std::shared_ptr<const ImplementedPrecision> GetImplementedPrecision(LayerType type);
 
+    // @brief get the device running the layers not implemented on this device, it works
+    // on the blob memory of this device in place. nullptr if there is no fallback.
+    virtual AbstractDevice* GetFallbackDevice();
+
     // @brief get factory device type
     DeviceType GetDeviceType();
 
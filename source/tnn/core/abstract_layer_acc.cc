@@ -14,8 +14,14 @@
 
 #include "tnn/core/abstract_layer_acc.h"
 #include "tnn/core/profile.h"
+#include "tnn/utils/dims_vector_utils.h"
 
 #include <algorithm>
+#include <typeinfo>
+#if TNN_PROFILE && defined(__GNUC__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
 
 namespace TNN_NS {
 
@@ -62,6 +68,12 @@ void AbstractLayerAcc::UpdateProfilingData(ProfilingData *pdata, LayerParam *par
 
     pdata->flops     = GetFlops();
     pdata->bandwidth = GetBandwidth();
+    if (pdata->flops <= 0 && pdata->bandwidth <= 0) {
+        EstimateFlopsAndBandwidth(pdata, param, input_dim, output_dim);
+    }
+    pdata->impl_name  = GetImplName();
+    pdata->start_time = GetProfilingTime();
+    pdata->thread_id  = GetProfilingThreadId();
 
     // for conv/deconv
     {
@@ -95,6 +107,62 @@ void AbstractLayerAcc::UpdateProfilingData(ProfilingData *pdata, LayerParam *par
     }
 }
 
+/*
+ * rough estimate for the accs without GetFlops and GetBandwidth, fp32 tensors read and written once.
+ * flops are only counted for conv, inner product, matmul and the recurrent layers, they dominate the compute of most
+ * models.
+ */
+void AbstractLayerAcc::EstimateFlopsAndBandwidth(ProfilingData *pdata, LayerParam *param, DimsVector input_dim,
+                                                 DimsVector output_dim) {
+    if (input_dim.size() < 2 || output_dim.size() < 2) {
+        return;
+    }
+    double weight_count = 0;
+    auto conv_param     = dynamic_cast<ConvLayerParam *>(param);
+    auto fc_param       = dynamic_cast<InnerProductLayerParam *>(param);
+    auto rnn_param      = dynamic_cast<RNNLayerParam *>(param);
+    auto matmul_param   = dynamic_cast<MatMulLayerParam *>(param);
+    if (conv_param && param->type != "Deconvolution" && conv_param->group > 0 && conv_param->kernels.size() >= 2) {
+        double kernel_size = 1.0 * input_dim[1] / conv_param->group * conv_param->kernels[0] * conv_param->kernels[1];
+        weight_count       = kernel_size * output_dim[1];
+        pdata->flops       = 2.0 * DimsVectorUtils::Count(output_dim) * kernel_size / 1e6;
+    } else if (fc_param) {
+        double kernel_size = DimsVectorUtils::Count(input_dim, 1);
+        weight_count       = kernel_size * fc_param->num_output;
+        pdata->flops       = 2.0 * DimsVectorUtils::Count(output_dim) * kernel_size / 1e6;
+    } else if (matmul_param) {
+        // the first input is B [..., K, N] if A is the constant, else A [..., M, K]
+        double k = matmul_param->weight_position == 0 ? input_dim[input_dim.size() - 2] : input_dim.back();
+        if (matmul_param->weight_position != -1) {
+            weight_count = DimsVectorUtils::Count(matmul_param->weight_dims);
+        }
+        pdata->flops = 2.0 * DimsVectorUtils::Count(output_dim) * k / 1e6;
+    } else if (rnn_param && input_dim.size() >= 3) {
+        // x W^T and h R^T of every step and direction
+        double gates      = dynamic_cast<GRULayerParam *>(param) ? 3 : 4;
+        double input_size = DimsVectorUtils::Count(input_dim, 2);
+        weight_count      = output_dim[1] * gates * rnn_param->hidden_size * (input_size + rnn_param->hidden_size);
+        pdata->flops      = 2.0 * input_dim[0] * input_dim[1] * weight_count / 1e6;
+    }
+    pdata->bandwidth =
+        (1.0 * DimsVectorUtils::Count(input_dim) + DimsVectorUtils::Count(output_dim) + weight_count) * 4 / 1e6;
+}
+
+std::string AbstractLayerAcc::GetImplName() {
+    std::string name = typeid(*this).name();
+#if defined(__GNUC__)
+    int status      = 0;
+    char *demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (status == 0 && demangled) {
+        name = demangled;
+    }
+    free(demangled);
+#endif
+    // drop the namespace and the class keyword of msvc
+    auto pos = name.find_last_of(": ");
+    return pos == std::string::npos ? name : name.substr(pos + 1);
+}
+
 double AbstractLayerAcc::GetFlops() {
     return 0;
 }
@@ -107,7 +175,10 @@ double AbstractLayerAcc::GetBandwidth() {
 Status AbstractLayerAcc::ResolveBlobDataFormat(Blob *blob) {
     BlobDesc desc                        = blob->GetBlobDesc();
     std::vector<DataFormat> support_list = SupportDataFormat(desc.data_type, static_cast<int>(desc.dims.size()));
-    ASSERT(support_list.size() > 0);
+    if (support_list.empty()) {
+        LOGE("device acc supports no data format for blob %s of %d dims\n", desc.name.c_str(), (int)desc.dims.size());
+        return Status(TNNERR_DEVICE_ACC_DATA_FORMAT_NOT_SUPPORT, "device acc does not support the blob dims");
+    }
 
     /*
      * DATA_FORMAT_AUTO : first format supported by the LayerAcc
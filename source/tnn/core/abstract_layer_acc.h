@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_CORE_LAYER_ACC_H_
 #define TNN_SOURCE_TNN_CORE_LAYER_ACC_H_
 
+#include <string>
 #include <vector>
 
 #include "tnn/core/blob.h"
@@ -60,6 +61,10 @@ public:
                                      DimsVector output_dim);
     virtual double GetFlops();
     virtual double GetBandwidth();
+    void EstimateFlopsAndBandwidth(ProfilingData *pdata, LayerParam *param, DimsVector input_dim,
+                                   DimsVector output_dim);
+    // @brief class name of the acc, accs dispatching to an impl return the name of the impl
+    virtual std::string GetImplName();
 #endif
 
 private:
@@ -0,0 +1,330 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/batch_executor.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/mat_converter_utils.h"
+
+namespace TNN_NS {
+
+static bool IsHostDevice(DeviceType device_type) {
+    return device_type == DEVICE_NAIVE || device_type == DEVICE_X86 || device_type == DEVICE_ARM;
+}
+
+// bytes of one batch of the mat, 0 for the unsupported mat types
+static size_t GetMatBatchBytes(Mat *mat) {
+    const int height = mat->GetHeight();
+    const int width  = mat->GetWidth();
+    switch (mat->GetMatType()) {
+        case N8UC4:
+            return (size_t)4 * height * width;
+        case NNV21:
+        case NNV12:
+            return (size_t)height * width * 3 / 2;
+        default:
+            return (size_t)DimsVectorUtils::Count(mat->GetDims(), 1) * GetMatElementSize(mat);
+    }
+}
+
+// whether the mat holds samples of the input dims, the channel of the image mats is
+// fixed by the mat type and left to the blob converter
+static bool IsMatOfSampleDims(Mat *mat, const DimsVector &sample_dims) {
+    auto dims = mat->GetDims();
+    if (dims.size() != sample_dims.size() || dims.size() < 2) {
+        return false;
+    }
+    const bool is_image = mat->GetMatType() == N8UC3 || mat->GetMatType() == N8UC4 ||
+                          mat->GetMatType() == NGRAY || mat->GetMatType() == NNV21 ||
+                          mat->GetMatType() == NNV12;
+    const int start = is_image ? 2 : 1;
+    return std::equal(dims.begin() + start, dims.end(), sample_dims.begin() + start);
+}
+
+BatchExecutor::BatchExecutor(std::shared_ptr<Instance> instance, BatchConfig config) {
+    instance_ = instance;
+    config_   = config;
+}
+
+BatchExecutor::~BatchExecutor() {
+    DeInit();
+}
+
+Status BatchExecutor::Init() {
+    if (!instance_) {
+        LOGE("BatchExecutor got an empty instance\n");
+        return Status(TNNERR_INST_ERR, "BatchExecutor got an empty instance");
+    }
+    if (config_.max_batch_size < 1 || config_.max_delay_us < 0) {
+        LOGE("BatchExecutor got invalid config, max_batch_size: %d max_delay_us: %d\n", config_.max_batch_size,
+             config_.max_delay_us);
+        return Status(TNNERR_PARAM_ERR, "BatchExecutor got invalid config");
+    }
+
+    BlobMap input_blobs;
+    auto status = instance_->GetAllInputBlobs(input_blobs);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    sample_shapes_.clear();
+    current_shapes_.clear();
+    for (auto iter : input_blobs) {
+        auto dims = iter.second->GetBlobDesc().dims;
+        // reshape does not allocate blob memory, the instance must be inited with the max batch
+        if (dims.empty() || dims[0] < config_.max_batch_size) {
+            LOGE("BatchExecutor needs input %s inited with batch %d\n", iter.first.c_str(), config_.max_batch_size);
+            return Status(TNNERR_PARAM_ERR, "BatchExecutor needs the instance inited with max_batch_size");
+        }
+        current_shapes_[iter.first] = dims;
+        dims[0]                     = 1;
+        sample_shapes_[iter.first]  = dims;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (running_) {
+        return Status(TNNERR_INST_ERR, "BatchExecutor is already running");
+    }
+    running_ = true;
+    worker_  = std::thread(&BatchExecutor::WorkerLoop, this);
+    return TNN_OK;
+}
+
+Status BatchExecutor::DeInit() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cond_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    return TNN_OK;
+}
+
+std::future<BatchResult> BatchExecutor::Submit(MatMap inputs) {
+    auto request          = std::make_shared<Request>();
+    auto future           = request->promise.get_future();
+    request->inputs       = inputs;
+    request->enqueue_time = std::chrono::steady_clock::now();
+
+    auto reject = [&](Status status) {
+        LOGE("BatchExecutor::Submit Error: %s\n", status.description().c_str());
+        BatchResult result;
+        result.status = status;
+        request->promise.set_value(result);
+        return std::move(future);
+    };
+
+    if (inputs.size() != sample_shapes_.size()) {
+        return reject(Status(TNNERR_PARAM_ERR, "request inputs do not match the instance inputs"));
+    }
+    for (auto iter : sample_shapes_) {
+        auto mat_iter = inputs.find(iter.first);
+        if (mat_iter == inputs.end() || !mat_iter->second || !mat_iter->second->GetData()) {
+            return reject(Status(TNNERR_PARAM_ERR, "request misses the input mat " + iter.first));
+        }
+        auto mat = mat_iter->second;
+        if (!IsHostDevice(mat->GetDeviceType()) || GetMatBatchBytes(mat.get()) == 0) {
+            return reject(Status(TNNERR_PARAM_ERR, "request input mat must be a host mat of known type"));
+        }
+        if (mat->GetBatch() <= 0 || (request->batch > 0 && mat->GetBatch() != request->batch)) {
+            return reject(Status(TNNERR_PARAM_ERR, "request input mats have different batch"));
+        }
+        if (!IsMatOfSampleDims(mat.get(), iter.second)) {
+            return reject(Status(TNNERR_PARAM_ERR, "request input mat dims do not match the input " + iter.first));
+        }
+        request->batch = mat->GetBatch();
+    }
+    // the instance is inited with max_batch_size, larger requests do not fit its blob memory
+    if (request->batch > config_.max_batch_size) {
+        return reject(Status(TNNERR_PARAM_ERR, "request batch exceeds max_batch_size"));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!running_) {
+            lock.unlock();
+            return reject(Status(TNNERR_INST_ERR, "BatchExecutor is not running"));
+        }
+        queue_.push_back(request);
+    }
+    cond_.notify_one();
+    return future;
+}
+
+bool BatchExecutor::CanCoalesce(Request &first, Request &other) {
+    for (auto iter : first.inputs) {
+        auto mat       = iter.second;
+        auto other_mat = other.inputs[iter.first];
+        if (mat->GetMatType() != other_mat->GetMatType() || mat->GetDeviceType() != other_mat->GetDeviceType()) {
+            return false;
+        }
+        auto dims       = mat->GetDims();
+        auto other_dims = other_mat->GetDims();
+        if (dims.size() != other_dims.size() || !std::equal(dims.begin() + 1, dims.end(), other_dims.begin() + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BatchExecutor::WorkerLoop() {
+    while (true) {
+        std::vector<std::shared_ptr<Request>> requests;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+            // stopped and all queued requests are done
+            if (queue_.empty()) {
+                break;
+            }
+
+            // wait for more requests until the batch is full or the oldest one is due
+            auto deadline = queue_.front()->enqueue_time + std::chrono::microseconds(config_.max_delay_us);
+            auto queued_batch = [this] {
+                int batch = 0;
+                for (auto &request : queue_) {
+                    batch += request->batch;
+                }
+                return batch;
+            };
+            while (running_ && queued_batch() < config_.max_batch_size &&
+                   cond_.wait_until(lock, deadline) != std::cv_status::timeout) {
+            }
+
+            int batch = 0;
+            while (!queue_.empty()) {
+                auto request = queue_.front();
+                if (!requests.empty() && (batch + request->batch > config_.max_batch_size ||
+                                          !CanCoalesce(*requests[0], *request))) {
+                    break;
+                }
+                batch += request->batch;
+                requests.push_back(request);
+                queue_.pop_front();
+            }
+        }
+
+        std::vector<MatMap> outputs(requests.size());
+        auto status = RunBatch(requests, outputs);
+        if (status != TNN_OK) {
+            LOGE("BatchExecutor::RunBatch Error: %s\n", status.description().c_str());
+        }
+        for (size_t i = 0; i < requests.size(); i++) {
+            BatchResult result;
+            result.status = status;
+            if (status == TNN_OK) {
+                result.outputs = outputs[i];
+            }
+            requests[i]->promise.set_value(result);
+        }
+    }
+}
+
+Status BatchExecutor::ReshapeToBatch(int batch) {
+    InputShapesMap shapes = sample_shapes_;
+    for (auto &iter : shapes) {
+        iter.second[0] = batch;
+    }
+    if (shapes == current_shapes_) {
+        return TNN_OK;
+    }
+
+    auto status = instance_->Reshape(shapes);
+    if (status != TNN_OK) {
+        // the instance shapes are unknown now, reshape again next time
+        current_shapes_.clear();
+        return status;
+    }
+    current_shapes_ = shapes;
+    return TNN_OK;
+}
+
+Status BatchExecutor::RunBatch(std::vector<std::shared_ptr<Request>> &requests, std::vector<MatMap> &outputs) {
+    int batch = 0;
+    for (auto &request : requests) {
+        batch += request->batch;
+    }
+    auto status = ReshapeToBatch(batch);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    for (auto iter : sample_shapes_) {
+        const auto &name = iter.first;
+        auto first_mat   = requests[0]->inputs[name];
+
+        // a single request is fed directly, others are concatenated along the batch dim
+        std::shared_ptr<Mat> mat = first_mat;
+        if (requests.size() > 1) {
+            auto dims = first_mat->GetDims();
+            dims[0]   = batch;
+            mat       = std::make_shared<Mat>(first_mat->GetDeviceType(), first_mat->GetMatType(), dims);
+            if (!mat->GetData()) {
+                return Status(TNNERR_OUTOFMEMORY, "BatchExecutor failed to allocate the batch mat");
+            }
+            char *dst = static_cast<char *>(mat->GetData());
+            for (auto &request : requests) {
+                auto src   = request->inputs[name];
+                auto bytes = GetMatBatchBytes(src.get()) * request->batch;
+                memcpy(dst, src->GetData(), bytes);
+                dst += bytes;
+            }
+        }
+
+        auto param_iter = config_.input_params.find(name);
+        auto param      = param_iter != config_.input_params.end() ? param_iter->second : MatConvertParam();
+        status          = instance_->SetInputMat(mat, param, name);
+        RETURN_ON_NEQ(status, TNN_OK);
+    }
+
+    status = instance_->Forward();
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    BlobMap output_blobs;
+    status = instance_->GetAllOutputBlobs(output_blobs);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    const auto device_type = requests[0]->inputs.begin()->second->GetDeviceType();
+    for (auto iter : output_blobs) {
+        std::shared_ptr<Mat> mat;
+        status = instance_->GetOutputMat(mat, MatConvertParam(), iter.first, device_type, NCHW_FLOAT);
+        RETURN_ON_NEQ(status, TNN_OK);
+
+        auto dims = mat->GetDims();
+        if (dims.empty() || dims[0] != batch) {
+            LOGE("BatchExecutor output %s has batch %d, expect %d\n", iter.first.c_str(), dims.empty() ? 0 : dims[0],
+                 batch);
+            return Status(TNNERR_MODEL_ERR, "BatchExecutor needs outputs with the input batch");
+        }
+
+        const size_t sample_bytes = (size_t)DimsVectorUtils::Count(dims, 1) * sizeof(float);
+        const char *src           = static_cast<const char *>(mat->GetData());
+        for (size_t i = 0; i < requests.size(); i++) {
+            dims[0]     = requests[i]->batch;
+            auto output = std::make_shared<Mat>(device_type, NCHW_FLOAT, dims);
+            if (!output->GetData()) {
+                return Status(TNNERR_OUTOFMEMORY, "BatchExecutor failed to allocate the output mat");
+            }
+            memcpy(output->GetData(), src, sample_bytes * requests[i]->batch);
+            src += sample_bytes * requests[i]->batch;
+            outputs[i][iter.first] = output;
+        }
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
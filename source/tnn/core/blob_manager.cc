@@ -20,6 +20,7 @@
 
 #include "tnn/memory_manager/blob_memory_pool_factory.h"
 #include "tnn/memory_manager/blob_memory_size_info.h"
+#include "tnn/memory_manager/memory_lifetime_assign_strategy.h"
 #include "tnn/memory_manager/memory_mode_state_factory.h"
 #include "tnn/memory_manager/memory_seperate_assign_strategy.h"
 #include "tnn/memory_manager/memory_unify_assign_strategy.h"
@@ -76,8 +77,8 @@ Status BlobManager::Init(NetworkConfig &config, NetStructure *net_structure, Inp
         input_dims = std::max(input_dims, dims);
     }
 
-    // only supports dims >=4 .
-    if (input_dims < 4) {
+    // inputs of any rank, the accs of the layers fail Init on the ranks they do not support
+    if (input_dims < 1) {
         LOGE("invalid input shape\n");
         return Status(TNNERR_PARAM_ERR, "invalid input shape");
     }
@@ -125,6 +126,10 @@ Status BlobManager::Init(NetworkConfig &config, NetStructure *net_structure, Inp
  *  The size may be different for different devices.
  */
 Status BlobManager::AllocateBlobMemory() {
+    if (config_.share_memory_mode != SHARE_MEMORY_MODE_DEFAULT) {
+        return AllocateBlobMemoryByLifetime();
+    }
+
     const auto &input_shapes_map = net_structure_->inputs_shape_map;
 
     for (auto iter : input_shapes_map) {
@@ -132,9 +137,6 @@ Status BlobManager::AllocateBlobMemory() {
         Blob *current_blob            = blobs_[current_blob_name];
         // todo. need refactor
         BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
-        if (info.dims.size() > 1 && config_.share_memory_mode != SHARE_MEMORY_MODE_DEFAULT) {
-            return Status(TNNERR_SHARE_MEMORY_MODE_NOT_SUPPORT, "share_memory_mode option is unsupported");
-        }
         int use_count           = 1;
         BlobMemory *blob_memory = NULL;
         blob_memory             = blob_memory_pool_->BorrowBlobMemory(use_count, info, true);
@@ -144,68 +146,190 @@ Status BlobManager::AllocateBlobMemory() {
     /*
      *  We reuse blob memory of the previos layers if it is not referenced.
      *  So, a use_count is calculated here.
+     *  The layers of one step may run at the same time, so the outputs of a step
+     *  are allocated before its inputs are refunded.
      */
-    for (size_t layer_index = 0; layer_index < net_structure_->layers.size(); layer_index++) {
+    auto layer_steps = GetLayerStepsFromNetStructure(net_structure_, config_);
+    for (auto &step : layer_steps) {
+        for (auto layer_index : step) {
+            LayerInfo *layer_info = net_structure_->layers[layer_index].get();
+            // allocating blob memory for every out nodes of this layer
+            for (auto current_blob_name : layer_info->outputs) {
+                Blob *current_blob = blobs_[current_blob_name];
+                // ASSERT(current_blob->count() > 0);
+                if (DimsVectorUtils::Count(current_blob->GetBlobDesc().dims) <= 0) {
+                    LOGE("Got empty blob, name:%s\n", current_blob_name.c_str());
+                    return Status(TNNERR_LAYER_ERR, "blob dims is invaid");
+                }
+
+                if (blob_memory_mapping_.find(current_blob) == blob_memory_mapping_.end()) {
+                    // calculate the use count of this blob
+                    int use_count = GetBlobUseCount(layer_index, current_blob_name);
+
+                    BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
+                    // find an available BlobMemory
+                    BlobMemory *blob_memory = blob_memory_pool_->BorrowBlobMemory(use_count, info, false);
+                    blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
+                }
+            }
+        }
+
+        // refund the input blob memory
+        for (auto layer_index : step) {
+            LayerInfo *layer_info = net_structure_->layers[layer_index].get();
+            for (auto current_blob_name : layer_info->inputs) {
+                Blob *current_blob = blobs_[current_blob_name];
+                if (input_shapes_map.count(current_blob_name) == 0) {
+                    std::map<Blob *, BlobMemory *>::const_iterator blob_memory_iter =
+                        blob_memory_mapping_.find(current_blob);
+                    ASSERT(blob_memory_iter->second->GetUseCount() > 0);
+                    blob_memory_iter->second->DecrementUseCount();
+                    if (blob_memory_iter->second->GetUseCount() == 0) {
+                        blob_memory_pool_->RefundBlobMemory(blob_memory_iter->second);
+                    }
+                }
+            }
+        }
+    }
+
+    // The default strategy allocated the blob memory seperately.
+    MemorySeperateAssignStrategy strategy;
+    Status status = blob_memory_pool_->AssignAllBlobMemory(strategy);
+    if (status == TNN_OK) {
+        BindBlobMemory();
+    }
+    return status;
+}
+
+/*
+ *  The share memory modes put all blobs into one arena.
+ *  Every blob gets its own blob memory together with the layers it is alive in,
+ *  and MemoryLifetimeAssignStrategy plans the offsets, so that blobs never alive
+ *  at the same time share the same bytes.
+ */
+Status BlobManager::AllocateBlobMemoryByLifetime() {
+    const auto &input_shapes_map = net_structure_->inputs_shape_map;
+    const int layer_count        = static_cast<int>(net_structure_->layers.size());
+
+    // lifetimes are counted in steps, the layers of one step may run at the same time
+    auto layer_steps = GetLayerStepsFromNetStructure(net_structure_, config_);
+    const int step_count = static_cast<int>(layer_steps.size());
+    std::vector<int> step_of_layer(layer_count, 0);
+    for (int step_index = 0; step_index < step_count; step_index++) {
+        for (auto layer_index : layer_steps[step_index]) {
+            step_of_layer[layer_index] = step_index;
+        }
+    }
+
+    // the last step reading each blob, net outputs are alive until the forward ends
+    std::map<std::string, int> last_use_map;
+    for (int layer_index = 0; layer_index < layer_count; layer_index++) {
+        for (auto blob_name : net_structure_->layers[layer_index]->inputs) {
+            last_use_map[blob_name] = std::max(last_use_map[blob_name], step_of_layer[layer_index]);
+        }
+    }
+    for (auto blob_name : net_structure_->outputs) {
+        last_use_map[blob_name] = step_count;
+    }
+
+    std::vector<BlobMemoryLifetime> lifetimes;
+    auto add_blob_memory = [&](Blob *blob, const std::string &blob_name, int first_use) {
+        BlobMemorySizeInfo info = device_->Calculate(blob->GetBlobDesc());
+        if (info.dims.size() > 1) {
+            return Status(TNNERR_SHARE_MEMORY_MODE_NOT_SUPPORT, "share_memory_mode option is unsupported");
+        }
+        BlobMemory *blob_memory = blob_memory_pool_->BorrowBlobMemory(1, info, true);
+        blob_memory_mapping_.insert(std::make_pair(blob, blob_memory));
+
+        BlobMemoryLifetime lifetime;
+        lifetime.blob_memory = blob_memory;
+        lifetime.first_use   = first_use;
+        lifetime.last_use    = first_use;
+        if (last_use_map.count(blob_name) > 0) {
+            lifetime.last_use = std::max(first_use, last_use_map[blob_name]);
+        }
+        lifetimes.push_back(lifetime);
+        return Status(TNN_OK);
+    };
+
+    // the inputs are filled before the forward, so they are alive from the first layer
+    for (auto iter : input_shapes_map) {
+        RETURN_ON_NEQ(add_blob_memory(blobs_[iter.first], iter.first, 0), TNN_OK);
+    }
+
+    for (int layer_index = 0; layer_index < layer_count; layer_index++) {
         LayerInfo *layer_info = net_structure_->layers[layer_index].get();
-        // allocating blob memory for every out nodes of this layer
         for (auto current_blob_name : layer_info->outputs) {
             Blob *current_blob = blobs_[current_blob_name];
-            // ASSERT(current_blob->count() > 0);
             if (DimsVectorUtils::Count(current_blob->GetBlobDesc().dims) <= 0) {
                 LOGE("Got empty blob, name:%s\n", current_blob_name.c_str());
                 return Status(TNNERR_LAYER_ERR, "blob dims is invaid");
             }
-
             if (blob_memory_mapping_.find(current_blob) == blob_memory_mapping_.end()) {
-                // calculate the use count of this blob
-                int use_count = GetBlobUseCount(layer_index, current_blob_name);
-
-                BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
-                // find an available BlobMemory
-                BlobMemory *blob_memory = blob_memory_pool_->BorrowBlobMemory(use_count, info, false);
-                blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
+                RETURN_ON_NEQ(add_blob_memory(current_blob, current_blob_name, step_of_layer[layer_index]),
+                              TNN_OK);
             }
         }
+    }
 
-        // refund the input blob memory
-        for (auto current_blob_name : layer_info->inputs) {
-            Blob *current_blob = blobs_[current_blob_name];
-            if (input_shapes_map.count(current_blob_name) == 0) {
-                std::map<Blob *, BlobMemory *>::const_iterator blob_memory_iter =
-                    blob_memory_mapping_.find(current_blob);
-                ASSERT(blob_memory_iter->second->GetUseCount() > 0);
-                blob_memory_iter->second->DecrementUseCount();
-                if (blob_memory_iter->second->GetUseCount() == 0) {
-                    blob_memory_pool_->RefundBlobMemory(blob_memory_iter->second);
+    lifetime_strategy_ = std::make_shared<MemoryLifetimeAssignStrategy>(lifetimes);
+
+    Status status = TNN_OK;
+    if (config_.share_memory_mode == SHARE_MEMORY_MODE_SHARE_ONE_THREAD) {
+        // The share_on_thread strategy may share memory of different models-
+        // whithin the same thread.
+        int forward_memory_size   = GetAllBlobMemorySize();
+        SharedMemory share_memory = SharedMemoryManager::GetSharedMemory(forward_memory_size, init_thread_id_, device_,
+                                                                        config_.device_id, this, status);
+        RETURN_ON_NEQ(status, TNN_OK);
+        lifetime_strategy_->SetMemory(share_memory.shared_memory_data);
+        status = blob_memory_pool_->AssignAllBlobMemory(*lifetime_strategy_);
+        RETURN_ON_NEQ(status, TNN_OK);
+        BindBlobMemory();
+    }
+
+    return status;
+}
+
+/*
+ *  Reshape only changes the blob dims, the memory allocated by the init shapes
+ *  is reused as long as every blob still fits in it.
+ */
+bool BlobManager::IsBlobMemoryEnough() {
+    for (auto iter : blob_memory_mapping_) {
+        BlobMemorySizeInfo need_info = device_->Calculate(iter.first->GetBlobDesc());
+        BlobMemorySizeInfo have_info = iter.second->GetBlobMemorySizeInfo();
+        if (need_info.dims.size() != have_info.dims.size()) {
+            return false;
+        }
+        if (need_info.dims.size() == 1) {
+            if (GetBlobMemoryBytesSize(need_info) > GetBlobMemoryBytesSize(have_info)) {
+                return false;
+            }
+        } else {
+            // 2d memory must hold the blob in every dim
+            for (size_t i = 0; i < need_info.dims.size(); i++) {
+                if (need_info.dims[i] > have_info.dims[i]) {
+                    return false;
                 }
             }
         }
     }
+    return true;
+}
 
-    Status status = TNN_OK;
-
-    do {
-        if (config_.share_memory_mode == SHARE_MEMORY_MODE_DEFAULT) {
-            // The default strategy allocated the blob memory seperately.
-            MemorySeperateAssignStrategy strategy;
-            status = blob_memory_pool_->AssignAllBlobMemory(strategy);
-            BREAK_IF(status != TNN_OK);
-            BindBlobMemory();
-        } else if (config_.share_memory_mode == SHARE_MEMORY_MODE_SHARE_ONE_THREAD) {
-            // The share_on_thread strategy may share memory of different models-
-            // whithin the same thread.
-            int forward_memory_size   = blob_memory_pool_->GetAllBlobMemorySize();
-            SharedMemory share_memory = SharedMemoryManager::GetSharedMemory(forward_memory_size, init_thread_id_, device_,
-                                                                            config_.device_id, this, status);
-            BREAK_IF(status != TNN_OK);
-            MemoryUnifyAssignStrategy strategy(share_memory.shared_memory_data);
-            status = blob_memory_pool_->AssignAllBlobMemory(strategy);
-            BREAK_IF(status != TNN_OK);
-            BindBlobMemory();
-        }
-    } while (0);
+Status BlobManager::ReallocateBlobMemory() {
+    if (config_.share_memory_mode != SHARE_MEMORY_MODE_DEFAULT) {
+        LOGE("blob memory can not grow in share memory mode %d\n", config_.share_memory_mode);
+        return Status(TNNERR_SHARE_MEMORY_MODE_NOT_SUPPORT, "reshape needs more memory than the forward memory");
+    }
 
-    return status;
+    blob_memory_mapping_.clear();
+    if (blob_memory_pool_ != NULL) {
+        delete blob_memory_pool_;
+    }
+    blob_memory_pool_ = BlobMemoryPoolFactory::CreateBlobMemoryPool(device_);
+    return AllocateBlobMemory();
 }
 
 /*
@@ -248,8 +372,13 @@ Status BlobManager::DeInit() {
 }
 
 void BlobManager::OnSharedForwardMemoryChanged(void *memory) {
-    MemoryUnifyAssignStrategy strategy(memory);
-    blob_memory_pool_->AssignAllBlobMemory(strategy);
+    if (lifetime_strategy_) {
+        lifetime_strategy_->SetMemory(memory);
+        blob_memory_pool_->AssignAllBlobMemory(*lifetime_strategy_);
+    } else {
+        MemoryUnifyAssignStrategy strategy(memory);
+        blob_memory_pool_->AssignAllBlobMemory(strategy);
+    }
     BindBlobMemory();
 }
 
@@ -261,8 +390,14 @@ Status BlobManager::SetForwardMemory(void *memory) {
     if (config_.share_memory_mode != SHARE_MEMORY_MODE_SET_FROM_EXTERNAL) {
         return Status(TNNERR_NOT_SUPPORT_SET_FORWARD_MEM, "set memory from external is unsupported");
     }
-    MemoryUnifyAssignStrategy strategy(memory);
-    auto status = blob_memory_pool_->AssignAllBlobMemory(strategy);
+    Status status = TNN_OK;
+    if (lifetime_strategy_) {
+        lifetime_strategy_->SetMemory(memory);
+        status = blob_memory_pool_->AssignAllBlobMemory(*lifetime_strategy_);
+    } else {
+        MemoryUnifyAssignStrategy strategy(memory);
+        status = blob_memory_pool_->AssignAllBlobMemory(strategy);
+    }
     if (status == TNN_OK) {
         BindBlobMemory();
     }
@@ -272,12 +407,23 @@ Status BlobManager::SetForwardMemory(void *memory) {
 void BlobManager::BindBlobMemory() {
     memory_mode_state_->SetMemoryAllocatedFlag();
     // bind every blob_memory's data_ into every blob's data
+    // the cpu layer accs address blob data by base only, so the offset inside the shared memory is folded into base
+    const auto device_type = device_->GetDeviceType();
+    const bool fold_offset = device_type == DEVICE_NAIVE || device_type == DEVICE_X86 || device_type == DEVICE_ARM;
     for (auto iter : blob_memory_mapping_) {
-        iter.first->SetHandle(iter.second->GetHandle());
+        BlobHandle handle = iter.second->GetHandle();
+        if (fold_offset && handle.bytes_offset != 0) {
+            handle.base         = reinterpret_cast<char *>(handle.base) + handle.bytes_offset;
+            handle.bytes_offset = 0;
+        }
+        iter.first->SetHandle(handle);
     }
 }
 
 int BlobManager::GetAllBlobMemorySize() {
+    if (lifetime_strategy_) {
+        return lifetime_strategy_->GetPlannedMemorySize();
+    }
     return blob_memory_pool_->GetAllBlobMemorySize();
 }
 
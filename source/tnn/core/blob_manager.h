@@ -28,6 +28,7 @@
 #include "tnn/memory_manager/blob_memory.h"
 #include "tnn/memory_manager/blob_memory_pool.h"
 #include "tnn/memory_manager/memory_assign_strategy.h"
+#include "tnn/memory_manager/memory_lifetime_assign_strategy.h"
 #include "tnn/memory_manager/memory_mode_state.h"
 #include "tnn/memory_manager/shared_memory_manager.h"
 
@@ -70,6 +71,13 @@ public:
     // @brief AllocateBlobMemory
     virtual Status AllocateBlobMemory();
 
+    // @brief check whether the allocated blob memory holds every blob with its current dims
+    bool IsBlobMemoryEnough();
+
+    // @brief release the blob memory and allocate it again for the current blob dims,
+    // only the default share memory mode owns its memory and can do it
+    virtual Status ReallocateBlobMemory();
+
     // @brief OnSharedForwardMemoryChanged for share memory change observer
     virtual void OnSharedForwardMemoryChanged(void *memory);
 
@@ -82,6 +90,7 @@ public:
 protected:
     void BindBlobMemory();
     int GetBlobUseCount(int layer_index, std::string current_blob_name);
+    Status AllocateBlobMemoryByLifetime();
 
     NetworkConfig config_;
     NetStructure *net_structure_;
@@ -90,6 +99,8 @@ protected:
     BlobMap input_blobs_;
     BlobMap output_blobs_;
     std::shared_ptr<MemoryAssignStrategy> strategy_;
+    // offsets planned in one arena, used by the share memory modes
+    std::shared_ptr<MemoryLifetimeAssignStrategy> lifetime_strategy_;
     std::map<std::string, Blob *> blobs_;
     std::map<Blob *, BlobMemory *> blob_memory_mapping_;
 
@@ -46,6 +46,26 @@ Status Context::SetNumThreads(int num_threads) {
     return TNN_OK;
 }
 
+int Context::GetNumThreads() {
+    return 1;
+}
+
+static thread_local int g_branch_index       = 0;
+static thread_local int g_branch_num_threads = 0;
+
+void Context::SetBranch(int index, int num_threads) {
+    g_branch_index       = index;
+    g_branch_num_threads = num_threads;
+}
+
+int Context::GetBranchIndex() {
+    return g_branch_index;
+}
+
+int Context::GetBranchNumThreads() {
+    return g_branch_num_threads;
+}
+
 void Context::SetPrecision(Precision precision) {
     precision_ = precision;
 }
@@ -70,6 +90,14 @@ std::string Context::GetCacheFilePath() {
     return cache_file_path_;
 }
 
+void Context::SetModelMd5(std::string model_md5) {
+    model_md5_ = model_md5;
+}
+
+std::string Context::GetModelMd5() {
+    return model_md5_;
+}
+
 #if TNN_PROFILE
 void Context::StartProfile() {
     profile_layer     = true;
@@ -82,10 +110,22 @@ std::shared_ptr<ProfileResult> Context::FinishProfile() {
 }
 
 void Context::AddProfilingData(std::shared_ptr<ProfilingData> pdata) {
+    std::lock_guard<std::mutex> guard(profiling_mutex_);
     if (profile_layer && profiling_result_) {
         profiling_result_->AddProfilingData(pdata);
     }
 }
+
+void Context::AddMemoryEvent(std::string name, double bytes) {
+    std::lock_guard<std::mutex> guard(profiling_mutex_);
+    if (profile_layer && profiling_result_) {
+        MemoryEvent event;
+        event.name  = name;
+        event.bytes = bytes;
+        event.time  = GetProfilingTime();
+        profiling_result_->AddMemoryEvent(event);
+    }
+}
 #endif
 
 }  // namespace TNN_NS
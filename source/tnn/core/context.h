@@ -16,6 +16,7 @@
 #define TNN_SOURCE_TNN_CORE_CONTEXT_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -59,6 +60,19 @@ public:
     // @brief set threads run on device
     virtual Status SetNumThreads(int num_threads);
 
+    // @brief get threads run on device
+    virtual int GetNumThreads();
+
+    // @brief with parallel branches, the layers of one step run on several threads at the same time.
+    // the scheduler gives every thread a branch index and its share of the device threads.
+    static void SetBranch(int index, int num_threads);
+
+    // @brief branch index of the calling thread, layers of different branches must not share work space
+    static int GetBranchIndex();
+
+    // @brief threads of the branch run by the calling thread, 0 if it does not run a branch
+    static int GetBranchNumThreads();
+
     void SetPrecision(Precision precision);
 
     Precision GetPrecision();
@@ -71,22 +85,32 @@ public:
 
     std::string GetCacheFilePath();
 
+    // @brief md5 of the model, layer accs of the instances with the same md5 share their packed weights
+    void SetModelMd5(std::string model_md5);
+
+    std::string GetModelMd5();
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
     virtual std::shared_ptr<ProfileResult> FinishProfile();
     void AddProfilingData(std::shared_ptr<ProfilingData> pdata);
+    // @brief record an allocation of bytes while profiling, negative bytes for a release
+    void AddMemoryEvent(std::string name, double bytes);
 
     bool profile_layer = false;
 
 protected:
     std::shared_ptr<ProfileResult> profiling_result_ = nullptr;
+    // layers of parallel branches add profiling data at the same time
+    std::mutex profiling_mutex_;
 #endif
 
 protected:
     Precision precision_ = PRECISION_AUTO;
     bool enable_tune_kernel_ = true;
     std::string cache_file_path_ = "";
+    std::string model_md5_ = "";
 };
 
 }  // namespace TNN_NS
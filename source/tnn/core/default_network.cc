@@ -16,6 +16,9 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <set>
+
 #include "tnn/core/blob_int8.h"
 #include "tnn/core/profile.h"
 #include "tnn/interpreter/default_model_interpreter.h"
@@ -27,6 +30,7 @@
 #include "tnn/utils/cpu_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
 #include "tnn/utils/md5.h"
+#include "tnn/utils/omp_utils.h"
 #include "tnn/utils/string_utils_inner.h"
 
 namespace TNN_NS {
@@ -39,6 +43,9 @@ NetworkImplFactoryRegister<NetworkImplFactory<DefaultNetwork>> g_network_impl_de
 
 std::mutex DefaultNetwork::optimize_mtx_;
 
+// max count of the cached reshape plans
+static const size_t kMaxReshapePlanCount = 8;
+
 DefaultNetwork::DefaultNetwork()
     : device_(nullptr), context_(nullptr), blob_manager_(nullptr), net_structure_(nullptr) {}
 
@@ -85,7 +92,8 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     context_->SetPrecision(net_config.precision);
     context_->SetEnableTuneKernel(net_config.enable_tune_kernel);
     if(!net_config.cache_path.empty()) {
-        context_->SetCacheFilePath(GenerateCacheFileName(model_config));
+        // the cache file of the model lives in the cache directory
+        context_->SetCacheFilePath(net_config.cache_path + "/" + GenerateCacheFileName(model_config));
     }
 
     ret = context_->LoadLibrary(net_config.library_path);
@@ -105,6 +113,18 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
         if (ret != TNN_OK) {
             return ret;
         }
+
+        // the per network optimizers change a copy, the other networks of the model keep the shared structure
+        network_structure_ = std::make_shared<NetStructure>(*net_structure);
+        net_structure      = network_structure_.get();
+        ret = optimizer::NetOptimizerManager::OptimizeNetwork(net_structure, net_resource, net_config);
+        if (ret != TNN_OK) {
+            return ret;
+        }
+
+        // the instances of one model share their packed weights, see PackedWeightCache.
+        // the interpreter leaves the md5 empty for random weights (e.g. the layer tests), those are not shared.
+        context_->SetModelMd5(default_interpreter->GetModelMd5());
     }
 
     blob_manager_ = new BlobManager(device_);
@@ -119,6 +139,8 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
         return ret;
     }
 
+    InitLayerSteps(net_structure, net_config);
+
     ret = blob_manager_->AllocateBlobMemory();
     if (ret != TNN_OK) {
         return ret;
@@ -126,6 +148,7 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
 
     net_structure_ = net_structure;
 
+    // reshape to the init shapes, which become the first reshape plan
     InputShapesMap input_shape_map;
     return Reshape(input_shape_map);
 }
@@ -244,6 +267,33 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
     return ret;
 }
 
+/*
+ * The layers are ordered by steps, the layers of one step only read the outputs of
+ * the previous steps. The blob memory is planned by the same steps, so the layers of
+ * one step can run at the same time.
+ */
+void DefaultNetwork::InitLayerSteps(NetStructure *net_structure, NetworkConfig &net_config) {
+    layer_steps_.clear();
+    auto steps = GetLayerStepsFromNetStructure(net_structure, net_config);
+
+    bool has_branch = false;
+    std::vector<BaseLayer *> layers;
+    for (auto &step : steps) {
+        std::vector<BaseLayer *> step_layers;
+        for (auto layer_index : step) {
+            step_layers.push_back(layers_[layer_index]);
+            layers.push_back(layers_[layer_index]);
+        }
+        has_branch = has_branch || step_layers.size() > 1;
+        layer_steps_.push_back(step_layers);
+    }
+    layers_ = layers;
+
+    if (!has_branch) {
+        layer_steps_.clear();
+    }
+}
+
 Status DefaultNetwork::GenerateInt8Blob(const std::string &name, NetResource *net_resource, Blob **blob) {
     auto new_blob = new BlobInt8((*blob)->GetBlobDesc(), (*blob)->GetHandle());
     CHECK_PARAM_NULL(new_blob);
@@ -271,7 +321,8 @@ Status DefaultNetwork::GenerateInt8Blob(const std::string &name, NetResource *ne
 
 Status DefaultNetwork::UpdateBlobPrecision(std::shared_ptr<LayerInfo> layer_info, bool is_input, bool is_quantized_net,
                                            const std::string &name, NetResource *net_resource, Blob **blob) {
-    if (device_->GetDeviceType() != DEVICE_ARM && device_->GetDeviceType() != DEVICE_NAIVE) {
+    auto device_type = device_->GetDeviceType();
+    if (device_type != DEVICE_ARM && device_type != DEVICE_NAIVE && device_type != DEVICE_X86) {
         return TNN_OK;
     }
 
@@ -284,8 +335,9 @@ Status DefaultNetwork::UpdateBlobPrecision(std::shared_ptr<LayerInfo> layer_info
             if (layer_info->param->quantized && desc.data_type != DATA_TYPE_INT8) {
                 RETURN_ON_NEQ(GenerateInt8Blob(name, net_resource, blob), TNN_OK);
             }
-        } else {
+        } else if (device_type != DEVICE_X86) {
             // update blob of non-quantized network by config precision and enabled precision
+            // x86 runs non-quantized network in float only
             if (config_.precision == PRECISION_NORMAL || config_.precision == PRECISION_AUTO) {
                 static bool cpu_support_fp16 = CpuUtils::CpuSupportFp16();
                 bool layer_implemented_fp16  = device_->GetImplementedPrecision(layer_type)->fp16_implemented;
@@ -345,6 +397,9 @@ Status DefaultNetwork::GetAllOutputBlobs(BlobMap &blobs) {
 /*
  * Reshape function is called when the input shape changes.
  * Memory allocation may be involved in Reshape function.
+ * The blob dims and inferred layer params of recent input shapes are cached as reshape
+ * plans and the blob memory is planned to hold all of them. Switching to a known shape
+ * restores the plan instead of inferring the shapes again and never allocates.
  */
 Status DefaultNetwork::Reshape(const InputShapesMap &inputs) {
     Status ret = TNN_OK;
@@ -361,15 +416,145 @@ Status DefaultNetwork::Reshape(const InputShapesMap &inputs) {
         blob->GetBlobDesc().dims = iter.second;
     }
 
+    BlobMap input_blobs;
+    blob_manager_->GetAllInputBlobs(input_blobs);
+    InputShapesMap input_shapes;
+    for (auto iter : input_blobs) {
+        input_shapes[iter.first] = iter.second->GetBlobDesc().dims;
+    }
+
+    auto plan = std::find_if(reshape_plans_.begin(), reshape_plans_.end(),
+                             [&](const ReshapePlan &item) { return item.inputs == input_shapes; });
+    if (plan != reshape_plans_.end()) {
+        if (plan == reshape_plans_.begin() && reshape_plan_applied_) {
+            return context_->OnInstanceReshapeEnd();
+        }
+        // the accs hold the state of the previous plan if it was applied completely
+        const bool reshape_all_accs = !reshape_plan_applied_;
+        reshape_plans_.splice(reshape_plans_.begin(), reshape_plans_, plan);
+        reshape_plan_applied_ = false;
+        ret                   = ApplyReshapePlan(reshape_plans_.front(), reshape_all_accs);
+        RETURN_ON_NEQ(ret, TNN_OK);
+        reshape_plan_applied_ = true;
+        return context_->OnInstanceReshapeEnd();
+    }
+
+    reshape_plan_applied_ = false;
+    ret                   = ReshapeLayers();
+    RETURN_ON_NEQ(ret, TNN_OK);
+
+    reshape_plans_.push_front(CreateReshapePlan(input_shapes));
+    if (reshape_plans_.size() > kMaxReshapePlanCount) {
+        reshape_plans_.pop_back();
+    }
+
+    if (!blob_manager_->IsBlobMemoryEnough()) {
+        ret = ReallocateBlobMemory();
+        if (ret != TNN_OK) {
+            reshape_plans_.pop_front();
+            return ret;
+        }
+        // layer accs see the new blob memory in reshape, as they do after init
+        ret = ReshapeLayers();
+        RETURN_ON_NEQ(ret, TNN_OK);
+    }
+    reshape_plan_applied_ = true;
+
+    return context_->OnInstanceReshapeEnd();
+}
+
+Status DefaultNetwork::ReshapeLayers() {
     for (auto cur_layer : layers_) {
-        ret = cur_layer->Reshape();
+        auto ret = cur_layer->Reshape();
         if (ret != TNN_OK) {
             return ret;
         }
     }
+    return TNN_OK;
+}
+
+DefaultNetwork::ReshapePlan DefaultNetwork::CreateReshapePlan(const InputShapesMap &inputs) {
+    ReshapePlan plan;
+    plan.inputs = inputs;
+    if (net_structure_ != nullptr) {
+        for (auto name : net_structure_->blobs) {
+            Blob *blob = blob_manager_->GetBlob(name);
+            if (blob != nullptr) {
+                plan.blob_dims[blob] = blob->GetBlobDesc().dims;
+            }
+        }
+    }
+    for (auto cur_layer : layers_) {
+        for (auto blob : cur_layer->GetInputBlobs()) {
+            plan.blob_dims[blob] = blob->GetBlobDesc().dims;
+        }
+        for (auto blob : cur_layer->GetOutputBlobs()) {
+            plan.blob_dims[blob] = blob->GetBlobDesc().dims;
+        }
+        plan.layer_params[cur_layer] = cur_layer->GetInferredParams();
+    }
+    return plan;
+}
+
+Status DefaultNetwork::ApplyReshapePlan(const ReshapePlan &plan, bool reshape_all_accs) {
+    std::set<Blob *> changed_blobs;
+    for (auto iter : plan.blob_dims) {
+        auto &dims = iter.first->GetBlobDesc().dims;
+        if (dims != iter.second) {
+            dims = iter.second;
+            changed_blobs.insert(iter.first);
+        }
+    }
+
+    for (auto cur_layer : layers_) {
+        auto params = plan.layer_params.find(cur_layer);
+        if (params == plan.layer_params.end()) {
+            LOGE("DefaultNetwork reshape plan misses layer %s\n", cur_layer->GetLayerName().c_str());
+            return Status(TNNERR_NET_ERR, "DefaultNetwork reshape plan misses layer");
+        }
+        cur_layer->SetInferredParams(params->second);
 
-    ret = context_->OnInstanceReshapeEnd();
+        // the acc keeps the state of the previous plan if none of its blobs changes
+        bool changed = reshape_all_accs;
+        for (auto blob : cur_layer->GetInputBlobs()) {
+            changed |= changed_blobs.count(blob) > 0;
+        }
+        for (auto blob : cur_layer->GetOutputBlobs()) {
+            changed |= changed_blobs.count(blob) > 0;
+        }
+        if (changed) {
+            auto ret = cur_layer->ReshapeAcc();
+            RETURN_ON_NEQ(ret, TNN_OK);
+        }
+    }
+    return TNN_OK;
+}
 
+Status DefaultNetwork::ReallocateBlobMemory() {
+    // the max dims over the cached plans hold every one of them
+    const auto &current_dims = reshape_plans_.front().blob_dims;
+    for (auto iter : current_dims) {
+        auto dims = iter.second;
+        for (auto &plan : reshape_plans_) {
+            const auto &plan_dims = plan.blob_dims[iter.first];
+            if (plan_dims.size() != dims.size()) {
+                if (DimsVectorUtils::Count(plan_dims) > DimsVectorUtils::Count(dims)) {
+                    dims = plan_dims;
+                }
+                continue;
+            }
+            for (size_t i = 0; i < dims.size(); i++) {
+                dims[i] = std::max(dims[i], plan_dims[i]);
+            }
+        }
+        iter.first->GetBlobDesc().dims = dims;
+    }
+
+    auto ret = blob_manager_->ReallocateBlobMemory();
+
+    for (auto iter : current_dims) {
+        iter.first->GetBlobDesc().dims = iter.second;
+    }
     return ret;
 }
 
@@ -380,6 +565,9 @@ Status DefaultNetwork::DeInit() {
         }
     }
     layers_.clear();
+    layer_steps_.clear();
+    reshape_plans_.clear();
+    reshape_plan_applied_ = false;
 
     if (blob_manager_ != NULL) {
         delete blob_manager_;
@@ -432,6 +620,16 @@ Status DefaultNetwork::Forward() {
     }
 
     context_->OnInstanceForwardBegin();
+    if (!layer_steps_.empty() && context_->GetNumThreads() > 1) {
+        result = ForwardLayerSteps();
+        if (result != TNN_OK) {
+            return result;
+        }
+        context_->OnInstanceForwardEnd();
+        context_->Synchronize();
+        return result;
+    }
+
     int cnt = 0;
     for (auto layer : layers_) {
         std::vector<Blob *> inputs  = layer->GetInputBlobs();
@@ -491,6 +689,67 @@ Status DefaultNetwork::Forward() {
     return result;
 }
 
+/*
+ * The layers of one step run at the same time, the threads of the context are split
+ * among them by their output sizes. Every layer gets a branch index for its work space.
+ */
+Status DefaultNetwork::ForwardLayerSteps() {
+    const int num_threads = context_->GetNumThreads();
+    for (auto &step : layer_steps_) {
+        const int layer_count = static_cast<int>(step.size());
+        if (layer_count == 1) {
+            auto result = step[0]->Forward();
+            if (result != TNN_OK) {
+                LOGE("Forward error %s, exit\n", result.description().c_str());
+                return result;
+            }
+            continue;
+        }
+
+        std::vector<int> layer_threads(layer_count, 1);
+        std::vector<double> layer_sizes(layer_count, 0);
+        double step_size = 0;
+        for (int i = 0; i < layer_count; i++) {
+            for (auto blob : step[i]->GetOutputBlobs()) {
+                layer_sizes[i] += DimsVectorUtils::Count(blob->GetBlobDesc().dims);
+            }
+            step_size += layer_sizes[i];
+        }
+        for (int i = 0; i < layer_count; i++) {
+            if (step_size > 0) {
+                layer_threads[i] = std::max(1, static_cast<int>(num_threads * layer_sizes[i] / step_size));
+            }
+        }
+
+        std::vector<Status> results(layer_count);
+#ifdef _OPENMP
+        const int max_active_levels = omp_get_max_active_levels();
+        omp_set_max_active_levels(2);
+#pragma omp parallel for num_threads(std::min(layer_count, num_threads)) schedule(dynamic, 1)
+        for (int i = 0; i < layer_count; i++) {
+            Context::SetBranch(OMP_TID_ + 1, layer_threads[i]);
+            OMP_SET_THREADS_(layer_threads[i]);
+            results[i] = step[i]->Forward();
+            Context::SetBranch(0, 0);
+        }
+        omp_set_max_active_levels(max_active_levels);
+        OMP_SET_THREADS_(num_threads);
+#else
+        for (int i = 0; i < layer_count; i++) {
+            results[i] = step[i]->Forward();
+        }
+#endif
+
+        for (int i = 0; i < layer_count; i++) {
+            if (results[i] != TNN_OK) {
+                LOGE("Forward error %s, exit\n", results[i].description().c_str());
+                return results[i];
+            }
+        }
+    }
+    return TNN_OK;
+}
+
 #ifdef FORWARD_CALLBACK_ENABLE
 Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after) {
     Status result = TNN_OK;
@@ -15,6 +15,9 @@
 #ifndef TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 #define TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 
+#include <list>
+#include <map>
+#include <memory>
 #include <vector>
 
 #include "tnn/core/abstract_device.h"
@@ -106,15 +109,45 @@ protected:
 
     std::string GenerateCacheFileName(ModelConfig &model_config);
 
+    // @brief order the layers by steps, keep the steps if the layers of one step can run together
+    void InitLayerSteps(NetStructure *net_structure, NetworkConfig &net_config);
+    // @brief forward the layers of every step at the same time
+    Status ForwardLayerSteps();
+
+    // @brief reshape every layer with the current input blob dims
+    Status ReshapeLayers();
+    // @brief allocate the blob memory for the max dims of the cached reshape plans
+    Status ReallocateBlobMemory();
+
+    // @brief dims of every blob and the params of every layer inferred for one set of input shapes
+    struct ReshapePlan {
+        InputShapesMap inputs;
+        std::map<Blob *, DimsVector> blob_dims;
+        std::map<BaseLayer *, std::vector<int>> layer_params;
+    };
+    // @brief record the current blob dims and layer params as a plan
+    ReshapePlan CreateReshapePlan(const InputShapesMap &inputs);
+    // @brief restore the blob dims and layer params of a cached plan without inferring them,
+    // only the accs of the layers whose blob dims change are reshaped
+    Status ApplyReshapePlan(const ReshapePlan &plan, bool reshape_all_accs);
+    // LRU of the reshape plans, the front one is the latest, the blob memory holds all of them
+    std::list<ReshapePlan> reshape_plans_;
+    // the front plan is the current state of the layers
+    bool reshape_plan_applied_ = false;
+
     AbstractDevice *device_ = nullptr;
     Context *context_       = nullptr;
     Context *GetContext();
 
     std::vector<BaseLayer *> layers_;
+    // layers of every step, empty if every step has one layer
+    std::vector<std::vector<BaseLayer *>> layer_steps_;
 
     BlobManager *blob_manager_ = nullptr;
 
     NetStructure *net_structure_ = nullptr;
+    // copy of the structure of the model changed by the per network optimizers
+    std::shared_ptr<NetStructure> network_structure_;
 
     NetworkConfig config_;
 
@@ -14,6 +14,7 @@
 
 #include "tnn/core/instance.h"
 
+#include <fstream>
 #include <memory>
 
 #include "tnn/core/abstract_network.h"
@@ -251,10 +252,40 @@ std::string Instance::FinishProfile(bool do_print) {
             printf("%s", result_str.c_str());
         }
     }
+    profile_result_ = profile_result;
 
     return result_str;
 }
 
+static Status WriteProfileFile(const std::string &path, const std::string &content) {
+    std::ofstream write_stream(path);
+    if (!write_stream) {
+        LOGE("open profile file %s failed\n", path.c_str());
+        return Status(TNNERR_COMMON_ERROR, "open profile file failed");
+    }
+    write_stream << content;
+    write_stream.close();
+    return TNN_OK;
+}
+
+std::shared_ptr<ProfileResult> Instance::GetProfileResult() {
+    return profile_result_;
+}
+
+Status Instance::ExportProfile(std::string path_prefix, double peak_gflops, double peak_bandwidth) {
+    if (!profile_result_) {
+        return Status(TNNERR_INST_ERR, "no profile result, call StartProfile and FinishProfile first");
+    }
+    RETURN_ON_NEQ(WriteProfileFile(path_prefix + ".trace.json", profile_result_->GetChromeTrace()), TNN_OK);
+    RETURN_ON_NEQ(WriteProfileFile(path_prefix + ".csv",
+                                   profile_result_->GetProfilingDataCsv(peak_gflops, peak_bandwidth)),
+                  TNN_OK);
+    RETURN_ON_NEQ(WriteProfileFile(path_prefix + ".json",
+                                   profile_result_->GetProfilingDataJson(peak_gflops, peak_bandwidth)),
+                  TNN_OK);
+    return TNN_OK;
+}
+
 #endif
 
 }  // namespace TNN_NS
@@ -0,0 +1,260 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/instance_pool.h"
+
+#include <cstring>
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+static bool IsHostDevice(DeviceType device_type) {
+    return device_type == DEVICE_NAIVE || device_type == DEVICE_X86 || device_type == DEVICE_ARM;
+}
+
+InstancePool::InstancePool(InstancePoolConfig config) {
+    config_ = config;
+}
+
+InstancePool::~InstancePool() {
+    DeInit();
+}
+
+Status InstancePool::Init(TNN &tnn, NetworkConfig &net_config, InputShapesMap inputs_shape) {
+    if (!IsHostDevice(net_config.device_type)) {
+        LOGE("InstancePool got device type %d, only the cpu devices are supported\n", net_config.device_type);
+        return Status(TNNERR_PARAM_ERR, "InstancePool only supports the cpu devices");
+    }
+
+    std::vector<std::vector<int>> cpu_groups;
+    auto status = CpuUtils::PartitionCpus(config_.instance_count, cpu_groups);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (running_ || !workers_.empty()) {
+            return Status(TNNERR_INST_ERR, "InstancePool is already running");
+        }
+        running_ = true;
+    }
+
+    // the instances are created one by one on the bound worker threads, the memory of an
+    // instance is first touched by the cpus that run it
+    for (auto &cpus : cpu_groups) {
+        auto worker  = std::make_shared<Worker>();
+        worker->cpus = cpus;
+
+        auto init_promise = std::make_shared<std::promise<Status>>();
+        auto init_future  = init_promise->get_future();
+        auto worker_ptr   = worker.get();
+        worker->thread    = std::thread([this, worker_ptr, init_promise, &tnn, net_config, inputs_shape]() {
+            auto init_status = InitWorker(worker_ptr, tnn, net_config, inputs_shape);
+            init_promise->set_value(init_status);
+            if (init_status == TNN_OK) {
+                WorkerLoop(worker_ptr);
+            }
+        });
+
+        status = init_future.get();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            workers_.push_back(worker);
+        }
+        if (status != TNN_OK) {
+            LOGE("InstancePool::Init Error: %s\n", status.description().c_str());
+            DeInit();
+            return status;
+        }
+    }
+    return TNN_OK;
+}
+
+Status InstancePool::InitWorker(Worker *worker, TNN &tnn, NetworkConfig net_config, InputShapesMap inputs_shape) {
+    // the binding only keeps the instances apart, an instance that can not be bound still runs
+    bool bound = false;
+    if (config_.bind_cpu) {
+        bound = CpuUtils::SetCpuAffinity(worker->cpus) == TNN_OK;
+        if (!bound) {
+            LOGE("InstancePool failed to bind the worker thread, the instance runs unbound\n");
+        }
+    }
+
+    Status status;
+    worker->instance = tnn.CreateInst(net_config, status, inputs_shape);
+    RETURN_ON_NEQ(status, TNN_OK);
+    if (!worker->instance) {
+        return Status(TNNERR_INST_ERR, "InstancePool failed to create the instance");
+    }
+
+    const int num_threads = worker->cpus.size();
+    status                = worker->instance->SetCpuNumThreads(num_threads);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+#ifdef _OPENMP
+    // the openmp threads forking from this thread are bound to the group as well
+    if (bound) {
+        std::vector<Status> results(num_threads, TNN_OK);
+#pragma omp parallel for num_threads(num_threads)
+        for (int i = 0; i < num_threads; i++) {
+            results[i] = CpuUtils::SetCpuAffinity(worker->cpus);
+        }
+        for (auto &result : results) {
+            if (result != TNN_OK) {
+                LOGE("InstancePool failed to bind an openmp thread, it runs unbound\n");
+                break;
+            }
+        }
+    }
+#endif
+    return TNN_OK;
+}
+
+Status InstancePool::DeInit() {
+    std::vector<std::shared_ptr<Worker>> workers;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        running_ = false;
+        workers  = workers_;
+    }
+    for (auto &worker : workers) {
+        worker->cond.notify_all();
+    }
+    for (auto &worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    workers_.clear();
+    return TNN_OK;
+}
+
+std::future<InstancePoolResult> InstancePool::Submit(MatMap inputs) {
+    auto request    = std::make_shared<Request>();
+    auto future     = request->promise.get_future();
+    request->inputs = inputs;
+
+    auto reject = [&](Status status) {
+        LOGE("InstancePool::Submit Error: %s\n", status.description().c_str());
+        InstancePoolResult result;
+        result.status = status;
+        request->promise.set_value(result);
+        return std::move(future);
+    };
+
+    if (inputs.empty()) {
+        return reject(Status(TNNERR_PARAM_ERR, "request has no input mat"));
+    }
+    for (auto iter : inputs) {
+        auto mat = iter.second;
+        if (!mat || !mat->GetData() || !IsHostDevice(mat->GetDeviceType())) {
+            return reject(Status(TNNERR_PARAM_ERR, "request input mat " + iter.first + " must be a host mat"));
+        }
+    }
+
+    Worker *target = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!running_ || workers_.empty()) {
+            lock.unlock();
+            return reject(Status(TNNERR_INST_ERR, "InstancePool is not running"));
+        }
+        // the least loaded instance, ties go to the first one
+        for (auto &worker : workers_) {
+            if (!target || worker->pending < target->pending) {
+                target = worker.get();
+            }
+        }
+        target->queue.push_back(request);
+        target->pending++;
+    }
+    target->cond.notify_one();
+    return future;
+}
+
+std::vector<int> InstancePool::GetCpuGroup(int index) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (index < 0 || index >= (int)workers_.size()) {
+        return std::vector<int>();
+    }
+    return workers_[index]->cpus;
+}
+
+void InstancePool::WorkerLoop(Worker *worker) {
+    while (true) {
+        std::shared_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            worker->cond.wait(lock, [this, worker] { return !running_ || !worker->queue.empty(); });
+            // stopped and all queued requests are done
+            if (worker->queue.empty()) {
+                break;
+            }
+            request = worker->queue.front();
+            worker->queue.pop_front();
+        }
+
+        InstancePoolResult result;
+        result.status = RunRequest(worker, *request, result.outputs);
+        if (result.status != TNN_OK) {
+            LOGE("InstancePool::RunRequest Error: %s\n", result.status.description().c_str());
+            result.outputs.clear();
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            worker->pending--;
+        }
+        request->promise.set_value(result);
+    }
+}
+
+Status InstancePool::RunRequest(Worker *worker, Request &request, MatMap &outputs) {
+    auto instance = worker->instance;
+    for (auto iter : request.inputs) {
+        auto param_iter = config_.input_params.find(iter.first);
+        auto param      = param_iter != config_.input_params.end() ? param_iter->second : MatConvertParam();
+        auto status     = instance->SetInputMat(iter.second, param, iter.first);
+        RETURN_ON_NEQ(status, TNN_OK);
+    }
+
+    auto status = instance->Forward();
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    BlobMap output_blobs;
+    status = instance->GetAllOutputBlobs(output_blobs);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    const auto device_type = request.inputs.begin()->second->GetDeviceType();
+    for (auto iter : output_blobs) {
+        std::shared_ptr<Mat> mat;
+        status = instance->GetOutputMat(mat, MatConvertParam(), iter.first, device_type, NCHW_FLOAT);
+        RETURN_ON_NEQ(status, TNN_OK);
+
+        // the mat of the instance is overwritten by its next forward
+        auto output = std::make_shared<Mat>(device_type, NCHW_FLOAT, mat->GetDims());
+        if (!output->GetData()) {
+            return Status(TNNERR_OUTOFMEMORY, "InstancePool failed to allocate the output mat");
+        }
+        memcpy(output->GetData(), mat->GetData(), DimsVectorUtils::Count(mat->GetDims()) * sizeof(float));
+        outputs[iter.first] = output;
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
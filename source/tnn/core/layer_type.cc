@@ -213,9 +213,13 @@ static std::map<std::string, LayerType> global_layer_type_map = {
     {"SquaredDifference", LAYER_SQUARED_DIFFERENCE},
     {"ArgMaxOrMin", LAYER_ARG_MAX_OR_MIN},
     {"PixelShuffle", LAYER_PIXEL_SHUFFLE},
+    {"LayerNorm", LAYER_LAYER_NORM},
+    {"GELU", LAYER_GELU},
+    {"Gelu", LAYER_GELU},
 
     {"CbamFusedReduce", LAYER_CBAM_FUSED_REDUCE},
-    {"CbamFusedPooling", LAYER_CBAM_FUSED_POOLING}
+    {"CbamFusedPooling", LAYER_CBAM_FUSED_POOLING},
+    {"FusedAttention", LAYER_FUSED_ATTENTION}
 };
 
 LayerType GlobalConvertLayerType(std::string layer_type_str) {
@@ -190,6 +190,8 @@ enum LayerType {
 
     LAYER_HDRGUIDE                                          = 302,
     LAYER_PIXEL_SHUFFLE                                     = 303,
+    LAYER_LAYER_NORM                                        = 304,
+    LAYER_GELU                                              = 305,
 
     LAYER_BLOB_SCALE                                        = 600,
 
@@ -197,7 +199,8 @@ enum LayerType {
     LAYER_TRT_ENGINE                                        = 701,
 
     LAYER_CBAM_FUSED_REDUCE                                 = 800,
-    LAYER_CBAM_FUSED_POOLING                                = 801
+    LAYER_CBAM_FUSED_POOLING                                = 801,
+    LAYER_FUSED_ATTENTION                                   = 802
 };
 
 LayerType GlobalConvertLayerType(std::string layer_type_str);
@@ -14,6 +14,9 @@
 
 #include "tnn/core/profile.h"
 #include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iomanip>
 #include <sstream>
 
@@ -24,6 +27,17 @@ namespace TNN_NS {
 
 ProfilingData::~ProfilingData() {}
 
+double GetProfilingTime() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count() / 1000.0;
+}
+
+int GetProfilingThreadId() {
+    static std::atomic<int> thread_count(0);
+    static thread_local int thread_id = thread_count++;
+    return thread_id;
+}
+
 bool ProfilingData::IsSameID(ProfilingData* data) {
     return data && op_name == data->op_name && layer_name == data->layer_name;
 }
@@ -63,6 +77,10 @@ void ProfilingData::Add(ProfilingData* data) {
     if (group <= 0) {
         group = data->group;
     }
+
+    if (impl_name.empty()) {
+        impl_name = data->impl_name;
+    }
 }
 
 #if TNN_PROFILE
@@ -70,12 +88,17 @@ ProfileResult::~ProfileResult() {}
 
 void ProfileResult::Reset() {
     profiling_data_.clear();
+    trace_data_.clear();
+    memory_events_.clear();
 }
 
 /*
 call this function in each layer
 */
 void ProfileResult::AddProfilingData(std::shared_ptr<ProfilingData> pdata) {
+    // the first data of a layer accumulates the later runs, the trace keeps a copy
+    trace_data_.push_back(std::make_shared<ProfilingData>(*pdata));
+
     std::shared_ptr<ProfilingData> internal = nullptr;
     for (auto& item : profiling_data_) {
         if (item->IsSameID(pdata.get())) {
@@ -95,10 +118,19 @@ void ProfileResult::AddProfilingData(std::shared_ptr<ProfilingData> pdata) {
 call this function in network
 */
 void ProfileResult::AddProfileResult(std::shared_ptr<ProfileResult> result) {
+    // the data of result are merged already, keep its own trace of the runs
+    const auto trace_size      = trace_data_.size();
     auto result_profiling_data = result->GetData();
     for (auto pf_data : result_profiling_data) {
         AddProfilingData(pf_data);
     }
+    trace_data_.resize(trace_size);
+    trace_data_.insert(trace_data_.end(), result->trace_data_.begin(), result->trace_data_.end());
+    memory_events_.insert(memory_events_.end(), result->memory_events_.begin(), result->memory_events_.end());
+}
+
+void ProfileResult::AddMemoryEvent(MemoryEvent event) {
+    memory_events_.push_back(event);
 }
 
 /*
@@ -191,6 +223,141 @@ std::string ProfileResult::GetProfilingDataSummary(bool do_average) {
     std::string show_string_summary = StringFormatter::Table(title_summary, header_summary, data_summary);
     return show_string_summary;
 }
+
+// a quoted csv field, quotes inside are doubled so that commas and quotes in names keep the columns
+static std::string CsvString(const std::string& str) {
+    std::string escaped = "\"";
+    for (auto c : str) {
+        if (c == '"') {
+            escaped += '"';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+static std::string DimsToString(const std::vector<int>& dims, const std::string& separator) {
+    std::ostringstream ostr;
+    for (size_t i = 0; i < dims.size(); i++) {
+        ostr << (i > 0 ? separator : "") << dims[i];
+    }
+    return ostr.str();
+}
+
+/*
+chrome trace event format: complete events of the layer runs, counter events of the allocated memory
+*/
+std::string ProfileResult::GetChromeTrace() {
+    double time_base = -1;
+    for (auto p : trace_data_) {
+        if (time_base < 0 || p->start_time < time_base) {
+            time_base = p->start_time;
+        }
+    }
+    for (auto& event : memory_events_) {
+        if (time_base < 0 || event.time < time_base) {
+            time_base = event.time;
+        }
+    }
+
+    std::ostringstream ostr;
+    ostr << std::fixed << std::setprecision(3);
+    ostr << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (auto p : trace_data_) {
+        ostr << (first ? "\n" : ",\n");
+        first = false;
+        ostr << "{\"name\": " << JsonString(p->layer_name) << ", \"cat\": " << JsonString(p->op_name)
+             << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << p->thread_id
+             << ", \"ts\": " << (p->start_time - time_base) * 1000 << ", \"dur\": " << p->kernel_time * 1000
+             << ", \"args\": {\"impl\": " << JsonString(p->impl_name)
+             << ", \"input_dims\": " << JsonString(VectorToString(p->input_dims))
+             << ", \"output_dims\": " << JsonString(VectorToString(p->output_dims)) << ", \"mflops\": " << p->flops
+             << ", \"mbytes\": " << p->bandwidth << "}}";
+    }
+
+    double allocated = 0;
+    for (auto& event : memory_events_) {
+        allocated += event.bytes;
+        ostr << (first ? "\n" : ",\n");
+        first = false;
+        ostr << "{\"name\": \"memory\", \"ph\": \"C\", \"pid\": 0, \"ts\": " << (event.time - time_base) * 1000
+             << ", \"args\": {\"allocated_bytes\": " << allocated << "}},\n";
+        ostr << "{\"name\": " << JsonString(event.name) << ", \"ph\": \"i\", \"s\": \"p\", \"pid\": 0, \"ts\": "
+             << (event.time - time_base) * 1000 << ", \"args\": {\"bytes\": " << event.bytes << "}}";
+    }
+    ostr << "\n]}\n";
+    return ostr.str();
+}
+
+// statistics of one layer, averaged over its runs
+struct LayerProfilingStat {
+    double kernel_time = 0;
+    double gflops      = 0;
+    double gbps        = 0;
+    // flop per byte
+    double intensity = 0;
+    // attainable GFLOP/s by the roofline, 0 if unknown
+    double roofline   = 0;
+    double efficiency = 0;
+    std::string bound = "";
+};
+
+static LayerProfilingStat GetLayerProfilingStat(ProfilingData* p, double peak_gflops, double peak_bandwidth) {
+    LayerProfilingStat stat;
+    stat.kernel_time = p->kernel_time / std::max(p->count, 1);
+    if (stat.kernel_time > 0) {
+        // MFLOP per ms is GFLOP per s
+        stat.gflops = p->flops / stat.kernel_time;
+        stat.gbps   = p->bandwidth / stat.kernel_time;
+    }
+    if (p->bandwidth > 0) {
+        stat.intensity = p->flops / p->bandwidth;
+    }
+    if (peak_gflops > 0 && peak_bandwidth > 0 && p->flops > 0 && p->bandwidth > 0) {
+        stat.roofline   = std::min(peak_gflops, stat.intensity * peak_bandwidth);
+        stat.efficiency = stat.gflops / stat.roofline * 100;
+        stat.bound      = stat.intensity * peak_bandwidth < peak_gflops ? "memory" : "compute";
+    }
+    return stat;
+}
+
+std::string ProfileResult::GetProfilingDataCsv(double peak_gflops, double peak_bandwidth) {
+    std::ostringstream ostr;
+    ostr << "name,op_type,impl,count,kernel_ms,input_dims,output_dims,mflops,mbytes,gflops,gbps,intensity,"
+            "roofline_gflops,efficiency_percent,bound\n";
+    for (auto p : profiling_data_) {
+        auto stat = GetLayerProfilingStat(p.get(), peak_gflops, peak_bandwidth);
+        ostr << CsvString(p->layer_name) << "," << CsvString(p->op_name) << "," << CsvString(p->impl_name) << ","
+             << p->count << "," << stat.kernel_time << "," << CsvString(DimsToString(p->input_dims, "x")) << ","
+             << CsvString(DimsToString(p->output_dims, "x")) << "," << p->flops << "," << p->bandwidth << ","
+             << stat.gflops << "," << stat.gbps << "," << stat.intensity << "," << stat.roofline << ","
+             << stat.efficiency << "," << CsvString(stat.bound) << "\n";
+    }
+    return ostr.str();
+}
+
+std::string ProfileResult::GetProfilingDataJson(double peak_gflops, double peak_bandwidth) {
+    double kernel_time_sum = 0;
+    std::ostringstream ostr;
+    ostr << "{\"peak_gflops\": " << peak_gflops << ", \"peak_bandwidth\": " << peak_bandwidth << ", \"layers\": [";
+    for (size_t i = 0; i < profiling_data_.size(); i++) {
+        auto p    = profiling_data_[i];
+        auto stat = GetLayerProfilingStat(p.get(), peak_gflops, peak_bandwidth);
+        kernel_time_sum += stat.kernel_time;
+        ostr << (i > 0 ? ",\n" : "\n");
+        ostr << "{\"name\": " << JsonString(p->layer_name) << ", \"op_type\": " << JsonString(p->op_name)
+             << ", \"impl\": " << JsonString(p->impl_name) << ", \"count\": " << p->count
+             << ", \"kernel_ms\": " << stat.kernel_time
+             << ", \"input_dims\": [" << DimsToString(p->input_dims, ", ") << "], \"output_dims\": ["
+             << DimsToString(p->output_dims, ", ") << "], \"mflops\": " << p->flops << ", \"mbytes\": " << p->bandwidth
+             << ", \"gflops\": " << stat.gflops << ", \"gbps\": " << stat.gbps << ", \"intensity\": " << stat.intensity
+             << ", \"roofline_gflops\": " << stat.roofline << ", \"efficiency_percent\": " << stat.efficiency
+             << ", \"bound\": " << JsonString(stat.bound) << "}";
+    }
+    ostr << "\n], \"kernel_ms_total\": " << kernel_time_sum << "}\n";
+    return ostr.str();
+}
 #endif
 
 }  // namespace TNN_NS
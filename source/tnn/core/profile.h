@@ -39,9 +39,18 @@ struct ProfilingData {
     /**kernel time*/
     double kernel_time = 0;
 
+    /**MFLOP of one run*/
     double flops     = 0;
+    /**MB read and written by one run*/
     double bandwidth = 0;
 
+    /**start time of the run in ms, system clock*/
+    double start_time = 0;
+    /**id of the thread running the layer*/
+    int thread_id = 0;
+    /**class of the acc or of the impl it picked*/
+    std::string impl_name = "";
+
     std::vector<int> input_dims     = {};
     std::vector<int> output_dims    = {};
     std::vector<int> kernel_shape   = {};
@@ -56,6 +65,21 @@ struct ProfilingData {
     bool IsSameID(ProfilingData *data);
 };
 
+struct MemoryEvent {
+    /**name of the allocation*/
+    std::string name = "";
+    /**allocated bytes, negative if released*/
+    double bytes = 0;
+    /**time in ms, system clock*/
+    double time = 0;
+};
+
+// @brief time in ms of the system clock, the base of the profiling timestamps
+double GetProfilingTime();
+
+// @brief small id of the calling thread for the profiling data
+int GetProfilingThreadId();
+
 #if TNN_PROFILE
 class ProfileResult {
 public:
@@ -73,9 +97,24 @@ public:
     // @brief get profiling data
     virtual std::vector<std::shared_ptr<ProfilingData>> GetData();
 
+    // @brief add an allocation done while profiling
+    void AddMemoryEvent(MemoryEvent event);
+
     // @brief This function shows the detailed timing for each layer in the model.
     virtual std::string GetProfilingDataInfo();
 
+    // @brief every run of each layer and the memory allocations as chrome trace event json,
+    // it opens in chrome://tracing or perfetto.
+    virtual std::string GetChromeTrace();
+
+    // @brief per layer statistics as csv, with the achieved GFLOP/s and GB/s.
+    // @param peak_gflops peak compute of the device in GFLOP/s, the roofline columns are 0 without the peaks.
+    // @param peak_bandwidth peak memory bandwidth of the device in GB/s.
+    virtual std::string GetProfilingDataCsv(double peak_gflops = 0, double peak_bandwidth = 0);
+
+    // @brief per layer statistics as json, same fields as the csv.
+    virtual std::string GetProfilingDataJson(double peak_gflops = 0, double peak_bandwidth = 0);
+
 protected:
     /*
      * This function shows an overview of the timings in the model.
@@ -84,6 +123,9 @@ protected:
     virtual std::string GetProfilingDataSummary(bool do_average);
 
     std::vector<std::shared_ptr<ProfilingData>> profiling_data_ = {};
+    // every added profiling data, profiling_data_ merges the runs of a layer
+    std::vector<std::shared_ptr<ProfilingData>> trace_data_ = {};
+    std::vector<MemoryEvent> memory_events_                 = {};
 };
 #endif
 
@@ -20,6 +20,8 @@ namespace TNN_NS {
 
 TNNImplFactoryRegister<TNNImplFactory<TNNImplDefault>> g_tnn_impl_default_factory_register(MODEL_TYPE_TNN);
 
+TNNImplFactoryRegister<TNNImplFactory<TNNImplDefault>> g_tnn_impl_mmap_factory_register(MODEL_TYPE_TNN_MMAP);
+
 TNNImplFactoryRegister<TNNImplFactory<TNNImplDefault>> g_tnn_impl_ncnn_factory_register(MODEL_TYPE_NCNN);
 
 TNNImplDefault::TNNImplDefault() {}
@@ -20,6 +20,7 @@
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_utils_inner.h"
 
 namespace TNN_NS {
 
@@ -88,48 +89,54 @@ Status ArmInnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
         DimsVector dims_input  = inputs[0]->GetBlobDesc().dims;
         DimsVector dims_output = outputs[0]->GetBlobDesc().dims;
 
-        RawBuffer w_handle = fc_res->weight_handle;
-        CHECK_PARAM_NULL(w_handle.force_to<void *>());
-
-        if (w_handle.GetDataType() == DATA_TYPE_HALF)
-            w_handle = ConvertHalfHandle(w_handle);
-
-        auto weight_data_type = w_handle.GetDataType();
-        int ic                = dims_input[1] * dims_input[2] * dims_input[3];
-        const int oc          = fc_param->num_output;
-        auto data_byte_size   = DataTypeUtils::GetBytesSize(weight_data_type);
-        if (weight_data_type == DATA_TYPE_FLOAT) {
-            // transform weight dims from 4 to 2
-            if (dims_input[2] != 1 || dims_input[3] != 1) {
-                RawBuffer reorder_buffer =
-                    RawBuffer(dims_input[3] * dims_input[2] * ROUND_UP(dims_input[1], 4) * oc * data_byte_size);
-                for (int i = 0; i < oc; i++) {
-                    auto dst_ptr = reorder_buffer.force_to<float *>() +
-                                   i * dims_input[3] * dims_input[2] * ROUND_UP(dims_input[1], 4);
-                    auto src_ptr = w_handle.force_to<float *>() + i * ic;
-                    PackC4(dst_ptr, src_ptr, dims_input[2] * dims_input[3], dims_input[1]);
+        auto input_data_type = inputs[0]->GetBlobDesc().data_type;
+        auto pack = [&](RawBuffer &packed) -> Status {
+            RawBuffer w_handle = fc_res->weight_handle;
+            CHECK_PARAM_NULL(w_handle.force_to<void *>());
+
+            if (w_handle.GetDataType() == DATA_TYPE_HALF)
+                w_handle = ConvertHalfHandle(w_handle);
+
+            auto weight_data_type = w_handle.GetDataType();
+            int ic                = dims_input[1] * dims_input[2] * dims_input[3];
+            const int oc          = fc_param->num_output;
+            auto data_byte_size   = DataTypeUtils::GetBytesSize(weight_data_type);
+            if (weight_data_type == DATA_TYPE_FLOAT) {
+                // transform weight dims from 4 to 2
+                if (dims_input[2] != 1 || dims_input[3] != 1) {
+                    RawBuffer reorder_buffer =
+                        RawBuffer(dims_input[3] * dims_input[2] * ROUND_UP(dims_input[1], 4) * oc * data_byte_size);
+                    for (int i = 0; i < oc; i++) {
+                        auto dst_ptr = reorder_buffer.force_to<float *>() +
+                                       i * dims_input[3] * dims_input[2] * ROUND_UP(dims_input[1], 4);
+                        auto src_ptr = w_handle.force_to<float *>() + i * ic;
+                        PackC4(dst_ptr, src_ptr, dims_input[2] * dims_input[3], dims_input[1]);
+                    }
+
+                    ic       = dims_input[3] * dims_input[2] * ROUND_UP(dims_input[1], 4);
+                    w_handle = reorder_buffer;
                 }
 
-                ic       = dims_input[3] * dims_input[2] * ROUND_UP(dims_input[1], 4);
-                w_handle = reorder_buffer;
-            }
-
-            auto weight_count = ROUND_UP(oc, 4) * ROUND_UP(ic, 4);
-            buffer_weight_    = RawBuffer(weight_count * data_byte_size);
-            PackWeightO4(w_handle.force_to<float *>(), buffer_weight_.force_to<float *>(), oc, ic);
+                auto weight_count = ROUND_UP(oc, 4) * ROUND_UP(ic, 4);
+                packed            = RawBuffer(weight_count * data_byte_size);
+                PackWeightO4(w_handle.force_to<float *>(), packed.force_to<float *>(), oc, ic);
 
-            // both data and weight will use type bfp16
-            if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
-                RawBuffer bfp16_buffer(weight_count * sizeof(bfp16_t));
-                ConvertFromFloatToBFP16(buffer_weight_.force_to<float *>(), bfp16_buffer.force_to<void *>(),
-                                        weight_count);
-                buffer_weight_ = bfp16_buffer;
+                // both data and weight will use type bfp16
+                if (input_data_type == DATA_TYPE_BFP16) {
+                    RawBuffer bfp16_buffer(weight_count * sizeof(bfp16_t));
+                    ConvertFromFloatToBFP16(packed.force_to<float *>(), bfp16_buffer.force_to<void *>(),
+                                            weight_count);
+                    packed = bfp16_buffer;
+                }
+            } else {
+                auto weight_count = ROUND_UP(oc, 4) * ROUND_UP(ic, 8);
+                packed            = RawBuffer(weight_count * data_byte_size + NEON_KERNEL_EXTRA_LOAD);
+                packweight_i8(w_handle.force_to<int8_t *>(), packed.force_to<int8_t *>(), oc, ic);
             }
-        } else {
-            auto weight_count = ROUND_UP(oc, 4) * ROUND_UP(ic, 8);
-            buffer_weight_    = RawBuffer(weight_count * data_byte_size + NEON_KERNEL_EXTRA_LOAD);
-            packweight_i8(w_handle.force_to<int8_t *>(), buffer_weight_.force_to<int8_t *>(), oc, ic);
-        }
+            return TNN_OK;
+        };
+        std::string variant = "fc_" + ToString(fc_res->weight_handle.GetDataType()) + "_" + ToString(input_data_type);
+        RETURN_ON_NEQ(GetSharedPackedWeight(buffer_weight_, variant, pack), TNN_OK);
     }
 
     return TNN_OK;
@@ -21,6 +21,8 @@
 #include "tnn/device/arm/acc/arm_layer_acc.h"
 #include "tnn/core/profile.h"
 #include "tnn/device/arm/arm_context.h"
+#include "tnn/utils/packed_weight_cache.h"
+#include "tnn/utils/string_utils_inner.h"
 
 namespace TNN_NS {
 
@@ -67,6 +69,13 @@ Status ArmLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector
     return TNN_OK;
 }
 
+Status ArmLayerAcc::GetSharedPackedWeight(RawBuffer &buffer, const std::string &variant,
+                                          const std::function<Status(RawBuffer &)> &pack) {
+    auto key = PackedWeightCache::GetKey(context_->GetModelMd5(), param_->name, DEVICE_ARM,
+                                         variant + "_" + ToString(context_->GetPrecision()));
+    return PackedWeightCache::Get(key, buffer, pack);
+}
+
 bool ArmLayerAcc::DataTypeSupported(DataType data_type) {
     if (data_type == DATA_TYPE_FLOAT || data_type == DATA_TYPE_BFP16 || data_type == DATA_TYPE_INT8 ||
         data_type == DATA_TYPE_HALF) {
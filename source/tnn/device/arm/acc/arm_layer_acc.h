@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_ARM_ARM_LAYER_ACC_H_
 #define TNN_SOURCE_TNN_DEVICE_ARM_ARM_LAYER_ACC_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -71,6 +72,11 @@ protected:
 
     virtual bool DataTypeSupported(DataType data_type);
 
+    // @brief packed weight shared by the instances of the model, pack is only called if no instance holds it.
+    // variant names the packing layout, the precision is added here.
+    Status GetSharedPackedWeight(RawBuffer &buffer, const std::string &variant,
+                                 const std::function<Status(RawBuffer &)> &pack);
+
 private:
     // @brief return device layer acc support data format
     virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
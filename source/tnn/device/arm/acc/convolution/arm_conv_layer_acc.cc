@@ -84,6 +84,12 @@ Status ArmConvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     }
 }
 
+#if TNN_PROFILE
+std::string ArmConvLayerAcc::GetImplName() {
+    return conv_acc_impl_ ? conv_acc_impl_->GetImplName() : ArmLayerAcc::GetImplName();
+}
+#endif
+
 REGISTER_ARM_ACC(Conv, LAYER_CONVOLUTION)
 REGISTER_ARM_PRECISION_FP16(LAYER_CONVOLUTION)
 
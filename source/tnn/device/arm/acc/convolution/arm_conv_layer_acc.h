@@ -32,6 +32,10 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+#if TNN_PROFILE
+    virtual std::string GetImplName();
+#endif
+
 protected:
     std::shared_ptr<ArmLayerAcc> conv_acc_impl_           = nullptr;
     std::shared_ptr<LayerResource> conv_acc_f32_resource_ = nullptr;
@@ -64,17 +64,21 @@ Status ArmConvLayerCommon::allocateBufferWeight(const std::vector<Blob *> &input
         int weight_count   = group * goc_4 * gic_4 * kh * kw * 16;
         int data_byte_size = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
-        /*
-        [ATTENTION]
-        alloc more NEON_KERNEL_EXTRA_LOAD bytes for assemble kernel prefetch
-        */
-        RawBuffer temp_buffer(weight_count * data_byte_size + NEON_KERNEL_EXTRA_LOAD);
-        float *dst = temp_buffer.force_to<float *>();
-
-        ConvertWeightsFromGOIHWToGOIHW16((float *)src, (float *)dst, group, input_channel, output_channel,
-                                         conv_param->kernels[1], conv_param->kernels[0]);
-
-        buffer_weight_ = temp_buffer;
+        auto pack = [&](RawBuffer &packed) -> Status {
+            /*
+            [ATTENTION]
+            alloc more NEON_KERNEL_EXTRA_LOAD bytes for assemble kernel prefetch
+            */
+            RawBuffer temp_buffer(weight_count * data_byte_size + NEON_KERNEL_EXTRA_LOAD);
+            float *dst = temp_buffer.force_to<float *>();
+
+            ConvertWeightsFromGOIHWToGOIHW16((float *)src, (float *)dst, group, input_channel, output_channel,
+                                             conv_param->kernels[1], conv_param->kernels[0]);
+
+            packed = temp_buffer;
+            return TNN_OK;
+        };
+        RETURN_ON_NEQ(GetSharedPackedWeight(buffer_weight_, "common_goihw16", pack), TNN_OK);
     }
     return TNN_OK;
 }
@@ -61,8 +61,14 @@ void* ArmContext::GetSharedWorkSpace(size_t size) {
 void* ArmContext::GetSharedWorkSpace(size_t size, int index) {
     while(work_space_.size() < index + 1) {
         work_space_.push_back(RawBuffer(ROUND_UP(size, 64)));
+#if TNN_PROFILE
+        AddMemoryEvent("work_space", ROUND_UP(size, 64));
+#endif
     }
     if (work_space_[index].GetBytesSize() < size) {
+#if TNN_PROFILE
+        AddMemoryEvent("work_space", (double)ROUND_UP(size, 64) - work_space_[index].GetBytesSize());
+#endif
         work_space_[index] = RawBuffer(ROUND_UP(size, 64));
     }
     return work_space_[index].force_to<void*>();
@@ -44,7 +44,7 @@ public:
     virtual Status SetNumThreads(int num_threads) override;
 
     // @brief get threads run on device
-    virtual int GetNumThreads();
+    virtual int GetNumThreads() override;
 
     void* GetSharedWorkSpace(size_t size);
     void* GetSharedWorkSpace(size_t size, int index);
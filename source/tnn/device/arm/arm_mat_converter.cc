@@ -284,6 +284,16 @@ Status ArmMatConverterAcc::CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderPara
     return ret;
 }
 
+Status ArmMatConverterAcc::Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue) {
+    Status ret = TNN_OK;
+
+    ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    return FusedPreprocess(src, dst, param);
+}
+
 DECLARE_MAT_CONVERTER_CREATER(Arm);
 REGISTER_MAT_CONVERTER(Arm, DEVICE_ARM);
 
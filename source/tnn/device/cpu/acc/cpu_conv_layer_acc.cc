@@ -113,20 +113,22 @@ Status CpuConvLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::ve
     }
     DimsVector output_dims = output_blob->GetBlobDesc().dims;
     DimsVector input_dims  = input_blob->GetBlobDesc().dims;
+    void *add_input        = (param->fusion_type == FusionType_None) ? nullptr : inputs[1]->GetHandle().base;
 
     if (data_type == DATA_TYPE_FLOAT) {
         NaiveConv<float, float, float, float>(input_ptr, output_ptr, weight_ptr, bias_ptr, input_dims, output_dims,
                                               param->strides[1], param->strides[0], param->kernels[1],
                                               param->kernels[0], param->pads[2], param->pads[0], param->group,
-                                              param->dialations[1], param->activation_type, NULL, 0);
+                                              param->dialations[1], param->activation_type, NULL, 0,
+                                              param->fusion_type, add_input);
     } else if (data_type == DATA_TYPE_BFP16) {
         NaiveConv<bfp16_t, float, float, bfp16_t>(input_ptr, output_ptr, weight_ptr, bias_ptr, input_dims, output_dims,
                                                   param->strides[1], param->strides[0], param->kernels[1],
                                                   param->kernels[0], param->pads[2], param->pads[0], param->group,
-                                                  param->dialations[1], param->activation_type, NULL, 0);
+                                                  param->dialations[1], param->activation_type, NULL, 0,
+                                                  param->fusion_type, add_input);
     } else if (data_type == DATA_TYPE_INT8) {
         float *scale_ptr = buffer_scale_.force_to<float *>();
-        void *add_input  = (param->fusion_type == FusionType_None) ? nullptr : inputs[1]->GetHandle().base;
         NaiveConv<int8_t, int8_t, int32_t, int8_t>(
             input_ptr, output_ptr, weight_ptr, bias_ptr, input_dims, output_dims, param->strides[1], param->strides[0],
             param->kernels[1], param->kernels[0], param->pads[2], param->pads[0], param->group, param->dialations[1],
@@ -71,6 +71,8 @@ void CpuDeconvLayerAcc::ActiveOutput(ConvLayerParam *param, float &sum) {
 
     } else if (param->activation_type == ActivationType_SIGMOID_MUL) {
         sum = 1.0f / (1.0f + exp(-sum)) * sum;
+    } else if (param->activation_type == ActivationType_HARDSWISH) {
+        sum = sum * std::min(std::max(sum / 6.0f + 0.5f, 0.0f), 1.0f);
     }
 }
 
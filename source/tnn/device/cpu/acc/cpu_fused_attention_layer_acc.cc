@@ -0,0 +1,101 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/attention_utils.h"
+
+namespace TNN_NS {
+
+class CpuFusedAttentionLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuFusedAttentionLayerAcc(){};
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+private:
+    // q, k and v are batched matmul operands of any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) {
+        return SupportAnyRankDataFormat(data_type, dims_size);
+    }
+};
+
+Status CpuFusedAttentionLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuFusedAttentionLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<FusedAttentionLayerParam *>(param_);
+    if (!param) {
+        return Status(TNNERR_MODEL_ERR, "Error: FusedAttentionLayerParam is nil");
+    }
+
+    const bool has_mask  = inputs.size() > 3;
+    DimsVector mask_dims = has_mask ? inputs[3]->GetBlobDesc().dims : DimsVector();
+    AttentionShape shape;
+    RETURN_ON_NEQ(GetAttentionShape(inputs[0]->GetBlobDesc().dims, inputs[1]->GetBlobDesc().dims,
+                                    inputs[2]->GetBlobDesc().dims, mask_dims, shape),
+                  TNN_OK);
+    const int Sq = shape.query_len, Sk = shape.key_len, D = shape.head_size, Dv = shape.value_size;
+
+    const float *q    = static_cast<float *>(inputs[0]->GetHandle().base);
+    const float *k    = static_cast<float *>(inputs[1]->GetHandle().base);
+    const float *v    = static_cast<float *>(inputs[2]->GetHandle().base);
+    const float *mask = has_mask ? static_cast<float *>(inputs[3]->GetHandle().base) : nullptr;
+    float *output     = static_cast<float *>(outputs[0]->GetHandle().base);
+
+    // one row of scores at a time
+    std::vector<float> scores(Sk);
+    for (int n = 0; n < shape.q_index.size(); n++) {
+        const float *q_n = q + shape.q_index[n] * Sq * D;
+        const float *k_n = k + shape.k_index[n] * D * Sk;
+        const float *v_n = v + shape.v_index[n] * Sk * Dv;
+        float *output_n  = output + n * Sq * Dv;
+        for (int i = 0; i < Sq; i++) {
+            float max_score = -FLT_MAX;
+            for (int j = 0; j < Sk; j++) {
+                float sum = 0.f;
+                for (int d = 0; d < D; d++) {
+                    sum += q_n[i * D + d] * k_n[d * Sk + j];
+                }
+                scores[j] = sum * param->scale;
+                if (mask) {
+                    scores[j] += mask[shape.mask_offset[n] + i * shape.mask_row_stride + j * shape.mask_col_stride];
+                }
+                max_score = std::max(max_score, scores[j]);
+            }
+            float exp_sum = 0.f;
+            for (int j = 0; j < Sk; j++) {
+                scores[j] = std::exp(scores[j] - max_score);
+                exp_sum += scores[j];
+            }
+            for (int d = 0; d < Dv; d++) {
+                float sum = 0.f;
+                for (int j = 0; j < Sk; j++) {
+                    sum += scores[j] * v_n[j * Dv + d];
+                }
+                output_n[i * Dv + d] = sum / exp_sum;
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(FusedAttention, LAYER_FUSED_ATTENTION);
+
+}  // namespace TNN_NS
@@ -0,0 +1,85 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cstring>
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/gather_utils.h"
+
+namespace TNN_NS {
+
+class CpuGatherLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuGatherLayerAcc(){};
+    virtual Status Init(Context *context, LayerParam *param, LayerResource *resource,
+                        const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+        // data and indices are inputs, there is no constant to convert
+        if (!resource) {
+            return CpuLayerAcc::Init(context, param, resource, inputs, outputs);
+        }
+        CPU_CONVERT_HALF_RESOURCE(LAYER_GATHER);
+        return TNN_OK;
+    }
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    std::shared_ptr<LayerResource> fp32_resource_ = nullptr;
+
+private:
+    // the data and the indices are of any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) {
+        return SupportAnyRankDataFormat(data_type, dims_size);
+    }
+};
+
+Status CpuGatherLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuGatherLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<GatherLayerParam *>(param_);
+    auto resource = dynamic_cast<GatherLayerResource *>(resource_);
+    if (!param) {
+        return Status(TNNERR_MODEL_ERR, "Error: GatherLayerParam is nil");
+    }
+
+    DimsVector data_dims, indices_dims;
+    int axis = 0;
+    RETURN_ON_NEQ(GetGatherShape(param, inputs, data_dims, indices_dims, axis), TNN_OK);
+    std::vector<int> indices;
+    RETURN_ON_NEQ(GetGatherIndices(param, resource, inputs, data_dims[axis], indices), TNN_OK);
+
+    const float *data = GetGatherData(param, resource, inputs);
+    float *output     = static_cast<float *>(outputs[0]->GetHandle().base);
+    if (!data) {
+        return Status(TNNERR_MODEL_ERR, "Error: Gather data is nil");
+    }
+
+    const int outer    = DimsVectorUtils::Count(data_dims, 0, axis);
+    const int inner    = DimsVectorUtils::Count(data_dims, axis + 1);
+    const int axis_dim = data_dims[axis];
+    for (int i = 0; i < outer; i++) {
+        for (int j = 0; j < indices.size(); j++) {
+            memcpy(output + (i * indices.size() + j) * inner, data + (i * axis_dim + indices[j]) * inner,
+                   inner * sizeof(float));
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(Gather, LAYER_GATHER);
+
+}  // namespace TNN_NS
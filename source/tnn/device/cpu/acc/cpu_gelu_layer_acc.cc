@@ -0,0 +1,32 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/cpu/acc/cpu_unary_layer_acc.h"
+
+#include <math.h>
+
+namespace TNN_NS {
+
+// gelu of the erf form, 0.5 * x * (1 + erf(x / sqrt(2)))
+typedef struct gelu_operator : unary_operator {
+    virtual float operator()(float in) {
+        return 0.5f * in * (1.0f + erff(in * 0.70710678f));
+    }
+} GELU_OP;
+
+DECLARE_UNARY_ACC(Gelu, LAYER_GELU, GELU_OP);
+
+REGISTER_CPU_ACC(Gelu, LAYER_GELU);
+
+}  // namespace TNN_NS
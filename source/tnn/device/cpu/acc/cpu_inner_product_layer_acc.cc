@@ -12,11 +12,15 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include <algorithm>
+#include <cfloat>
+
 #include "tnn/core/blob_int8.h"
 #include "tnn/device/cpu/acc/cpu_layer_acc.h"
 #include "tnn/interpreter/layer_resource_generator.h"
 #include "tnn/utils/bfp16.h"
 #include "tnn/utils/bfp16_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
 #include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
@@ -107,6 +111,14 @@ Status CpuInnerProductLayerAcc::Forward(const std::vector<Blob *> &inputs, const
     if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         NaiveFC((float *)input_data, (float *)output_data, (float *)weight_data, (float *)bias_data, dims_input,
                 dims_output);
+        if (param->activation_type == ActivationType_ReLU || param->activation_type == ActivationType_ReLU6) {
+            float *output_ptr = (float *)output_data;
+            int count         = DimsVectorUtils::Count(dims_output);
+            float max_value   = param->activation_type == ActivationType_ReLU6 ? 6.0f : FLT_MAX;
+            for (int i = 0; i < count; i++) {
+                output_ptr[i] = std::min(std::max(output_ptr[i], 0.0f), max_value);
+            }
+        }
     } else if (output_blob->GetBlobDesc().data_type == DATA_TYPE_INT8) {
         NaiveFC(input_data, output_data, weight_data, buffer_scale_.force_to<float *>(), dims_output[1], bias_data,
                 dims_input, dims_output);
@@ -20,7 +20,7 @@ CpuLayerAcc::~CpuLayerAcc() {}
 
 Status CpuLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                          const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    AbstractLayerAcc::Init(context, param, resource, inputs, outputs);
+    RETURN_ON_NEQ(AbstractLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
 
     param_    = param;
     resource_ = resource;
@@ -35,4 +35,12 @@ std::vector<DataFormat> CpuLayerAcc::SupportDataFormat(DataType data_type, int d
     return support_list;
 }
 
+std::vector<DataFormat> CpuLayerAcc::SupportAnyRankDataFormat(DataType data_type, int dims_size) {
+    std::vector<DataFormat> support_list;
+    if (dims_size > 0) {
+        support_list.push_back(DATA_FORMAT_NCHW);
+    }
+    return support_list;
+}
+
 }  // namespace TNN_NS
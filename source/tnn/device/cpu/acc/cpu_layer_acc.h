@@ -45,6 +45,9 @@ protected:
     LayerParam *param_       = nullptr;
     LayerResource *resource_ = nullptr;
 
+    // @brief data formats of the accs indexing the dims by the rank, NCHW holds blobs of any rank
+    std::vector<DataFormat> SupportAnyRankDataFormat(DataType data_type, int dims_size);
+
 private:
     // @brief return device layer acc support data format
     virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
@@ -0,0 +1,108 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cmath>
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class CpuLayerNormLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuLayerNormLayerAcc(){};
+    virtual Status Init(Context *context, LayerParam *param, LayerResource *resource,
+                        const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+        CPU_CONVERT_HALF_RESOURCE(LAYER_LAYER_NORM);
+        return TNN_OK;
+    }
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    std::shared_ptr<LayerResource> fp32_resource_ = nullptr;
+
+private:
+    // rows of the dims from the normalized axis on, any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) {
+        return SupportAnyRankDataFormat(data_type, dims_size);
+    }
+};
+
+Status CpuLayerNormLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<LayerNormLayerParam *>(param_);
+    auto resource = dynamic_cast<LayerNormLayerResource *>(resource_);
+    if (!param) {
+        return Status(TNNERR_MODEL_ERR, "Error: LayerNormLayerParam is nil");
+    }
+    if (!resource) {
+        return Status(TNNERR_MODEL_ERR, "Error: LayerNormLayerResource is nil");
+    }
+
+    auto dims             = inputs[0]->GetBlobDesc().dims;
+    const int reduce_axis = static_cast<int>(dims.size()) - param->reduce_dims_size;
+    if (reduce_axis < 0 || param->reduce_dims_size < 1) {
+        return Status(TNNERR_PARAM_ERR, "Error: LayerNorm reduce_dims_size is out of the input rank");
+    }
+    const int cols = DimsVectorUtils::Count(dims, reduce_axis);
+    if (resource->scale_handle.GetDataCount() != cols || resource->bias_handle.GetDataCount() != cols) {
+        return Status(TNNERR_PARAM_ERR, "Error: LayerNorm scale and bias do not match the normalized dims");
+    }
+    return TNN_OK;
+}
+
+Status CpuLayerNormLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<LayerNormLayerParam *>(param_);
+    auto resource = dynamic_cast<LayerNormLayerResource *>(resource_);
+    if (!param) {
+        return Status(TNNERR_MODEL_ERR, "Error: LayerNormLayerParam is nil");
+    }
+    if (!resource) {
+        return Status(TNNERR_MODEL_ERR, "Error: LayerNormLayerResource is nil");
+    }
+
+    // the axis and the sizes of scale and bias are checked by Reshape
+    auto dims             = inputs[0]->GetBlobDesc().dims;
+    const int reduce_axis = static_cast<int>(dims.size()) - param->reduce_dims_size;
+    const int rows        = DimsVectorUtils::Count(dims, 0, reduce_axis);
+    const int cols        = DimsVectorUtils::Count(dims, reduce_axis);
+
+    const float *scale = resource->scale_handle.force_to<float *>();
+    const float *bias  = resource->bias_handle.force_to<float *>();
+    const float *input = static_cast<float *>(inputs[0]->GetHandle().base);
+    float *output      = static_cast<float *>(outputs[0]->GetHandle().base);
+
+    for (int r = 0; r < rows; r++) {
+        const float *x = input + r * cols;
+        float *y       = output + r * cols;
+        double mean = 0, variance = 0;
+        for (int i = 0; i < cols; i++) {
+            mean += x[i];
+        }
+        mean /= cols;
+        for (int i = 0; i < cols; i++) {
+            variance += (x[i] - mean) * (x[i] - mean);
+        }
+        variance /= cols;
+        const double rstd = 1.0 / std::sqrt(variance + param->eps);
+        for (int i = 0; i < cols; i++) {
+            y[i] = static_cast<float>((x[i] - mean) * rstd * scale[i] + bias[i]);
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(LayerNorm, LAYER_LAYER_NORM);
+
+}  // namespace TNN_NS
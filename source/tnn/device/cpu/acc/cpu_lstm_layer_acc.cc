@@ -0,0 +1,139 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cmath>
+#include <cstring>
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/rnn_utils.h"
+
+namespace TNN_NS {
+
+class CpuLstmLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuLstmLayerAcc(){};
+    virtual Status Init(Context *context, LayerParam *param, LayerResource *resource,
+                        const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+        CPU_CONVERT_HALF_RESOURCE(LAYER_LSTM);
+        return TNN_OK;
+    }
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    std::shared_ptr<LayerResource> fp32_resource_ = nullptr;
+
+private:
+    // the input is [sequence, batch, input...], the states and sequence_lens have 1 to 3 dims
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) {
+        return SupportAnyRankDataFormat(data_type, dims_size);
+    }
+};
+
+static float Sigmoid(float x) {
+    return 1.0f / (1.0f + std::exp(-x));
+}
+
+static float Dot(const float *a, const float *b, int count) {
+    float sum = 0.f;
+    for (int i = 0; i < count; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+Status CpuLstmLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuLstmLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<LSTMLayerParam *>(param_);
+    auto resource = dynamic_cast<RNNLayerResource *>(resource_);
+    if (!param) {
+        return Status(TNNERR_MODEL_ERR, "Error: LSTMLayerParam is nil");
+    }
+    if (!resource) {
+        return Status(TNNERR_MODEL_ERR, "Error: RNNLayerResource is nil");
+    }
+
+    auto dims_input          = inputs[0]->GetBlobDesc().dims;
+    const int batch          = dims_input[1];
+    const int input_size     = DimsVectorUtils::Count(dims_input, 2);
+    const int hidden_size    = param->hidden_size;
+    const int num_directions = param->direction == 2 ? 2 : 1;
+    const int gate_size      = 4 * hidden_size;
+
+    const float *x          = static_cast<float *>(inputs[0]->GetHandle().base);
+    const float *weight     = resource->weight_handle.force_to<float *>();
+    const float *recurrence = resource->recurrence_handle.force_to<float *>();
+    const float *bias       = resource->bias_handle.GetDataCount() > 0 ? resource->bias_handle.force_to<float *>()
+                                                                       : nullptr;
+    const float *initial_h  = GetRNNInitialState(param, inputs, 0);
+    const float *initial_c  = GetRNNInitialState(param, inputs, 1);
+    auto sequence_lens      = GetRNNSequenceLens(param, inputs);
+
+    float *y = static_cast<float *>(outputs[0]->GetHandle().base);
+    // steps past the sequence length of a batch are 0
+    memset(y, 0, DimsVectorUtils::Count(outputs[0]->GetBlobDesc().dims) * sizeof(float));
+
+    std::vector<float> h(hidden_size), c(hidden_size), gates(gate_size);
+    for (int d = 0; d < num_directions; d++) {
+        const bool reverse = param->direction == 1 || d == 1;
+        const float *w     = weight + d * gate_size * input_size;
+        const float *r     = recurrence + d * gate_size * hidden_size;
+        const float *wb    = bias ? bias + d * 2 * gate_size : nullptr;
+        for (int n = 0; n < batch; n++) {
+            const int state_offset = (d * batch + n) * hidden_size;
+            for (int j = 0; j < hidden_size; j++) {
+                h[j] = initial_h ? initial_h[state_offset + j] : 0.f;
+                c[j] = initial_c ? initial_c[state_offset + j] : 0.f;
+            }
+
+            const int len = sequence_lens[n];
+            for (int s = 0; s < len; s++) {
+                const int t     = reverse ? len - 1 - s : s;
+                const float *xt = x + (t * batch + n) * input_size;
+                for (int g = 0; g < gate_size; g++) {
+                    gates[g] = (wb ? wb[g] + wb[gate_size + g] : 0.f) + Dot(w + g * input_size, xt, input_size) +
+                               Dot(r + g * hidden_size, h.data(), hidden_size);
+                }
+                // iofc
+                for (int j = 0; j < hidden_size; j++) {
+                    float i_gate = Sigmoid(gates[j]);
+                    float o_gate = Sigmoid(gates[hidden_size + j]);
+                    float f_gate = Sigmoid(gates[2 * hidden_size + j]);
+                    float c_gate = std::tanh(gates[3 * hidden_size + j]);
+                    c[j]         = f_gate * c[j] + i_gate * c_gate;
+                    h[j]         = o_gate * std::tanh(c[j]);
+                }
+                memcpy(y + ((t * num_directions + d) * batch + n) * hidden_size, h.data(), hidden_size * sizeof(float));
+            }
+
+            if (outputs.size() > 1) {
+                memcpy(static_cast<float *>(outputs[1]->GetHandle().base) + state_offset, h.data(),
+                       hidden_size * sizeof(float));
+            }
+            if (outputs.size() > 2) {
+                memcpy(static_cast<float *>(outputs[2]->GetHandle().base) + state_offset, c.data(),
+                       hidden_size * sizeof(float));
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(Lstm, LAYER_LSTM);
+
+}  // namespace TNN_NS
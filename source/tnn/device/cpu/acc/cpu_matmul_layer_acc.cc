@@ -0,0 +1,98 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/matmul_utils.h"
+
+namespace TNN_NS {
+
+class CpuMatMulLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuMatMulLayerAcc(){};
+    virtual Status Init(Context *context, LayerParam *param, LayerResource *resource,
+                        const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+        // both matrices are inputs, there is no constant to convert
+        if (!resource) {
+            return CpuLayerAcc::Init(context, param, resource, inputs, outputs);
+        }
+        CPU_CONVERT_HALF_RESOURCE(LAYER_MATMUL);
+        return TNN_OK;
+    }
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    std::shared_ptr<LayerResource> fp32_resource_ = nullptr;
+
+private:
+    // [..., M, K] x [..., K, N] of any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) {
+        return SupportAnyRankDataFormat(data_type, dims_size);
+    }
+};
+
+Status CpuMatMulLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuMatMulLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<MatMulLayerParam *>(param_);
+    auto resource = dynamic_cast<MatMulLayerResource *>(resource_);
+    if (!param) {
+        return Status(TNNERR_MODEL_ERR, "Error: MatMulLayerParam is nil");
+    }
+    if (param->weight_position != -1 && !resource) {
+        return Status(TNNERR_MODEL_ERR, "Error: MatMulLayerResource is nil");
+    }
+
+    DimsVector a_dims, b_dims;
+    MatMulShape shape;
+    RETURN_ON_NEQ(GetMatMulInputDims(param, inputs, a_dims, b_dims), TNN_OK);
+    RETURN_ON_NEQ(GetMatMulShape(a_dims, b_dims, shape), TNN_OK);
+
+    const float *a = nullptr, *b = nullptr;
+    if (param->weight_position == 0) {
+        a = resource->weight_handle.force_to<float *>();
+        b = static_cast<float *>(inputs[0]->GetHandle().base);
+    } else if (param->weight_position == 1) {
+        a = static_cast<float *>(inputs[0]->GetHandle().base);
+        b = resource->weight_handle.force_to<float *>();
+    } else {
+        a = static_cast<float *>(inputs[0]->GetHandle().base);
+        b = static_cast<float *>(inputs[1]->GetHandle().base);
+    }
+    float *c = static_cast<float *>(outputs[0]->GetHandle().base);
+
+    const int M = shape.M, N = shape.N, K = shape.K;
+    for (int n = 0; n < shape.a_index.size(); n++) {
+        const float *a_n = a + shape.a_index[n] * M * K;
+        const float *b_n = b + shape.b_index[n] * K * N;
+        float *c_n       = c + n * M * N;
+        for (int m = 0; m < M; m++) {
+            for (int j = 0; j < N; j++) {
+                float sum = 0.f;
+                for (int k = 0; k < K; k++) {
+                    sum += a_n[m * K + k] * b_n[k * N + j];
+                }
+                c_n[m * N + j] = sum;
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(MatMul, LAYER_MATMUL);
+
+}  // namespace TNN_NS
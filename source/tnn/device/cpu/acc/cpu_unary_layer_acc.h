@@ -63,6 +63,12 @@ public:
 
 protected:
     std::shared_ptr<UNARY_OP> op_;
+
+private:
+    // elementwise on blobs of any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) {
+        return SupportAnyRankDataFormat(data_type, dims_size);
+    }
 };
 
 #define DECLARE_UNARY_ACC(type_string, layer_type, OP_TYPE)                                                            \
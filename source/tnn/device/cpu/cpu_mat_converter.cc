@@ -271,6 +271,16 @@ void CpuMatConverterAcc::MatMemcpy2D(void* src, void* dst, int width, int height
 
 }
 
+Status CpuMatConverterAcc::Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue) {
+    Status ret = TNN_OK;
+
+    ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    return FusedPreprocess(src, dst, param);
+}
+
 DECLARE_MAT_CONVERTER_CREATER(Cpu);
 REGISTER_MAT_CONVERTER(Cpu, DEVICE_NAIVE);
 
@@ -153,6 +153,15 @@ struct Float4 {
         dst.value = _mm_div_ps(one, _mm_add_ps(one, exp_ps(_mm_sub_ps(_mm_setzero_ps(), v.value))));
         return dst;
     }
+    // tanh(x) = 2 / (1 + exp(-2x)) - 1
+    static Float4 tanh(const Float4 &v) {
+        Float4 dst;
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        __m128 exp_v     = exp_ps(_mm_mul_ps(_mm_set1_ps(-2.0f), v.value));
+        dst.value        = _mm_sub_ps(_mm_div_ps(two, _mm_add_ps(one, exp_v)), one);
+        return dst;
+    }
     static Float4 exp(const Float4 &v) {
         Float4 dst;
         dst.value = exp_ps(v.value);
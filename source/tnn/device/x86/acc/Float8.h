@@ -149,6 +149,15 @@ struct Float8 {
         dst.value = _mm256_div_ps(one, _mm256_add_ps(one, exp256_ps(_mm256_sub_ps(_mm256_setzero_ps(), v.value))));
         return dst;
     }
+    // tanh(x) = 2 / (1 + exp(-2x)) - 1
+    static Float8 tanh(const Float8 &v) {
+        Float8 dst;
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 two = _mm256_set1_ps(2.0f);
+        __m256 exp_v     = exp256_ps(_mm256_mul_ps(_mm256_set1_ps(-2.0f), v.value));
+        dst.value        = _mm256_sub_ps(_mm256_div_ps(two, _mm256_add_ps(one, exp_v)), one);
+        return dst;
+    }
     static Float8 exp(const Float8 &v) {
         Float8 dst;
         dst.value = exp256_ps(v.value);
@@ -29,6 +29,16 @@ namespace TNN_NS {
 
 typedef ptrdiff_t dim_t;
 
+// post ops of the conv sgemm kernels, applied in registers to the last K block before storing.
+// relu and relu6 keep the values of ActivationType, the residual add is done before the
+// activation unless CONV_SGEMM_POST_ADD_LAST is set.
+enum conv_sgemm_post_t : dim_t {
+    CONV_SGEMM_POST_NONE     = 0x00,
+    CONV_SGEMM_POST_RELU     = 0x01,
+    CONV_SGEMM_POST_RELU6    = 0x02,
+    CONV_SGEMM_POST_ADD_LAST = 0x10,
+};
+
 } // namespace tnn
 
 #endif // TNN_DEVICE_X86_ACC_COMPUTE_JIT_TYPE_DEF_H_
\ No newline at end of file
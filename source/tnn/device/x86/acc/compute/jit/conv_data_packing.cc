@@ -19,6 +19,7 @@
 #include <xmmintrin.h>
 
 #include <stdio.h>
+#include <string.h>
 
 #include "tnn/device/x86/acc/compute/jit/conv_gemm_config.h"
 
@@ -70,6 +71,15 @@ void pack_t(const T * a, dim_t lda, T * b, dim_t ldb, dim_t m, dim_t n, conv_gem
         }
     } else if (block_size == 8) {
         
+    } else if (block_size == 64) {
+        // a full 64 panel is contiguous in both a and b, copy row by row
+        for(;i + 64 <=n;i+=64) {
+            const T * cur_a = a + i;
+            T * cur_b = b + i * ldb;
+            for(dim_t j=0;j<m;j++) {
+                memcpy(cur_b + j * block_size, cur_a + j * lda, block_size * sizeof(T));
+            }
+        }
     }
 
     for(;i<n;) {
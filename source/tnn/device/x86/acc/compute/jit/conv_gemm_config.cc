@@ -43,7 +43,15 @@ conv_gemm_config<a_t, b_t, c_t>::conv_gemm_config(
     M_c_ = 64;
     K_c_ = 256;
 
-    if (cpu_with_isa(avx2)) {
+    if (cpu_with_isa(avx512)) {
+#ifdef XBYAK64
+        m_block_ = 64;
+        kernel_m_r_ = 64;
+#else
+        m_block_ = 8;
+        kernel_m_r_ = 8;
+#endif
+    } else if (cpu_with_isa(avx2)) {
 #ifdef XBYAK64
         m_block_ = 16;
         kernel_m_r_ = 16; 
@@ -70,6 +78,7 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
     static std::shared_ptr<jit::base_jit_kernel> g_kernel_4 [nb_kernels_m + 1][nb_kernels_n + 1];
     static std::shared_ptr<jit::base_jit_kernel> g_kernel_8 [nb_kernels_m + 1][nb_kernels_n + 1];
     static std::shared_ptr<jit::base_jit_kernel> g_kernel_16[nb_kernels_m + 1][nb_kernels_n + 1];
+    static std::shared_ptr<jit::base_jit_kernel> g_kernel_64[nb_kernels_m + 1][nb_kernels_n + 1];
 
     static std::once_flag initialized;
     std::call_once(initialized, [] {
@@ -135,6 +144,8 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
 
         g_pack_t_4x16_ker = std::make_shared<jit::sgemm_fetch_t_4x16_ker_t>();
 
+        const bool with_avx512 = cpu_with_isa(avx512);
+
 #define REGISTER_KERNEL(M, N)                                                                   \
             if (M <= 4)  g_kernel_4[M][N] =                                                     \
             std::make_shared<jit::conv_sgemm_avx_kernel<M, N, 4, 6>>();                         \
@@ -142,6 +153,8 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
             std::make_shared<jit::conv_sgemm_avx_kernel<M, N, 8, 6>>();                         \
             if (M <= 16) g_kernel_16[M][N] =                                                    \
             std::make_shared<jit::conv_sgemm_avx_kernel<M, N, 16, 6>>();                        \
+            if (with_avx512) g_kernel_64[M][N] =                                                \
+            std::make_shared<jit::conv_sgemm_avx_kernel<M, N, 64, 6>>();                        \
 
 #define REGISTER_KERNEL_M(M)                                                                    \
             REGISTER_KERNEL(M, 1);                                                              \
@@ -156,6 +169,11 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
         REGISTER_KERNEL_M(4);
         REGISTER_KERNEL_M(8);
         REGISTER_KERNEL_M(16);
+#ifdef XBYAK64
+        // zmm kernels for m = 32, 64, only generated on avx512 machines
+        REGISTER_KERNEL_M(32);
+        REGISTER_KERNEL_M(64);
+#endif
 
 #ifdef TNN_JIT_DUMP_KERNEL
         for(int i=1;i<=nb_kernels_m;i++) {
@@ -182,6 +200,9 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
                 if (g_kernel_16[m][n]) {
                     g_kernel_16[m][n]->dump_to_file();
                 }
+                if (g_kernel_64[m][n]) {
+                    g_kernel_64[m][n]->dump_to_file();
+                }
             }
         }
 #endif
@@ -216,6 +237,8 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
         kernel_array = &g_kernel_8;
     } else if (m_block_ == 16) {
         kernel_array = &g_kernel_16;
+    } else if (m_block_ == 64) {
+        kernel_array = &g_kernel_64;
     } else {
         throw std::runtime_error("unsupported m_block value."); 
     }
@@ -28,7 +28,8 @@ typedef void (*conv_sgemm_ker_func_t)(const dim_t K,
                                  const a_t * src_a, dim_t lda,
                                  const b_t * src_b, dim_t ldb,
                                  c_t * dst, dim_t ldc,
-                                 const b_t * bias, dim_t first, dim_t act_type);
+                                 const b_t * bias, dim_t first, dim_t act_type,
+                                 const c_t * residual);
 
     conv_gemm_config(const dim_t m_block = 16, const dim_t n_block = 6);
 
@@ -44,7 +45,7 @@ typedef void (*conv_sgemm_ker_func_t)(const dim_t K,
     dim_t M_c_;
     dim_t K_c_;
 
-    constexpr static int nb_kernels_m = 16;
+    constexpr static int nb_kernels_m = 64;
     constexpr static int nb_kernels_n = 6;
 
     fetch_t_func_t pack_t_ker_[nb_kernels_m + 1];
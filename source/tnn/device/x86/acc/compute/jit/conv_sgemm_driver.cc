@@ -22,15 +22,22 @@
 #include "tnn/device/x86/acc/compute/jit/conv_gemm_config.h"
 #include "tnn/device/x86/acc/compute/jit/utils/timer.hpp"
 #include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/x86_util.h"
 
 namespace TNN_NS {
 
+typedef void (*conv_sgemm_tile_post_t)(float *dst, long ld, long m, long n, const float *add);
+
 void conv_sgemm_block_n(
         dim_t M, dim_t N, dim_t K,
         const float * src_a, dim_t lda,
         const float * src_b, dim_t ldb,
         float * dst, dim_t ldc,
         const float * bias, dim_t first, dim_t act_type,
+        const float * residual,
+        conv_sgemm_tile_post_t tile_post, const float * tile_residual,
         conv_gemm_config<float, float, float> &conv_gemm_conf) 
 {
 
@@ -43,62 +50,65 @@ void conv_sgemm_block_n(
         const float * cur_a = src_a + divDown(i, m_block) * K_c + i % m_block;
         const float * cur_b = src_b;
         float * cur_c = dst + i;
+        const float * cur_residual = residual ? residual + i : nullptr;
+
+        // kernels are generated for power of 2 sizes, zmm kernels for 32 and 64 only on avx512 machines
+        dim_t ker_m = 64;
+        while (ker_m > cur_m) {
+            ker_m >>= 1;
+        }
+        conv_gemm_conf.kernels_[ker_m][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type, cur_residual);
 
-        switch(cur_m) {
-            case 1:
-                conv_gemm_conf.kernels_[1][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=1;
-                break;
-            case 2:
-            case 3:
-                conv_gemm_conf.kernels_[2][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=2;
-                break;
-            case 4:
-            case 5:
-            case 6:
-            case 7:
-                conv_gemm_conf.kernels_[4][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=4;
-                break;
-            case 8:
-            case 9:
-            case 10:
-            case 11:
-            case 12:
-            case 13:
-            case 14:
-            case 15:
-                conv_gemm_conf.kernels_[8][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=8;
-                break;
-            default:
-                conv_gemm_conf.kernels_[16][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
-                i+=16;
-                break;
+        // the tile is still in L1, finish the activations the kernels can not hold in registers
+        if (tile_post) {
+            tile_post(cur_c, ldc, ker_m, N, tile_residual ? tile_residual + i : nullptr);
         }
+        i += ker_m;
     }
 }
 
-void conv_sgemm_nn_col_major(
+// get_b(k) returns the packed src_b of the K block starting at k
+template <typename GetPackB>
+static void conv_sgemm_nn_col_major_impl(
         dim_t M, dim_t N, dim_t K,
         const float * src_a, dim_t lda,
-        const float * src_b, dim_t ldb,
+        const GetPackB &get_b, dim_t ldb,
         float * dst, dim_t ldc,
         const float * bias, dim_t act_type,
         float *src_trans_buf,
-        conv_gemm_config<float, float, float> &conv_gemm_conf)
+        conv_gemm_config<float, float, float> &conv_gemm_conf,
+        const float * residual, dim_t fusion_type)
 {
     dim_t M_c = conv_gemm_conf.M_c_;
     dim_t K_c = conv_gemm_conf.K_c_;
     dim_t m_block = conv_gemm_conf.m_block_;
     dim_t n_block = conv_gemm_conf.n_block_;
 
+    // relu, relu6 and the residual add are fused into the store of the jit kernels,
+    // sigmoid mul and hardswish are applied on each tile right after it is stored.
+    dim_t kernel_post = CONV_SGEMM_POST_NONE;
+    const float * kernel_residual = residual;
+    const float * tile_residual = nullptr;
+    conv_sgemm_tile_post_t tile_post = nullptr;
+    bool add_last = (fusion_type == FusionType_Conv_Activation_Add);
+    if (act_type == ActivationType_ReLU || act_type == ActivationType_ReLU6) {
+        kernel_post = act_type | (add_last ? CONV_SGEMM_POST_ADD_LAST : 0);
+    } else if (act_type == ActivationType_SIGMOID_MUL) {
+        tile_post = cpu_with_isa(avx2) ? X86_Post_Tile<ActivationType_SIGMOID_MUL, Float8, 8>
+                                       : X86_Post_Tile<ActivationType_SIGMOID_MUL, Float4, 4>;
+    } else if (act_type == ActivationType_HARDSWISH) {
+        tile_post = cpu_with_isa(avx2) ? X86_Post_Tile<ActivationType_HARDSWISH, Float8, 8>
+                                       : X86_Post_Tile<ActivationType_HARDSWISH, Float4, 4>;
+    }
+    if (tile_post && add_last) {
+        tile_residual = residual;
+        kernel_residual = nullptr;
+    }
+
     dim_t i, j, k;
     i = j = k = 0;
 
     dim_t first;
-    dim_t post_type;
 
     for (k = 0; k < K; k += K_c)  {
         if (k == 0) {
@@ -107,16 +117,13 @@ void conv_sgemm_nn_col_major(
             first = 1;
         }
 
-        if (k + K_c >= K) {
-            post_type = act_type;
-        } else {
-            post_type = 0;
-        }
+        // post ops go with the last K block only
+        bool last_k = (k + K_c >= K);
 
         dim_t cur_k = MIN(K - k, K_c);
 
         // pack b -> K_c * N;
-        const float *pack_b_k = src_b + k * divUp(N, n_block);
+        const float *pack_b_k = get_b(k);
 
         for (i = 0; i < M; i += M_c)  {
             dim_t cur_m = MIN(M - i, M_c);
@@ -129,13 +136,61 @@ void conv_sgemm_nn_col_major(
 
                 const float * packed_cur_b = pack_b_k + divDown(j, n_block) * K_c + j % n_block;
                 const float * cur_bias = bias + j;
-                conv_sgemm_block_n(cur_m, cur_n, cur_k, src_trans_buf, lda, packed_cur_b, ldb, cur_c, ldc, cur_bias, first, post_type, conv_gemm_conf);
+                if (last_k) {
+                    conv_sgemm_block_n(cur_m, cur_n, cur_k, src_trans_buf, lda, packed_cur_b, ldb, cur_c, ldc,
+                                       cur_bias, first, kernel_post,
+                                       kernel_residual ? kernel_residual + i + j * ldc : nullptr,
+                                       tile_post, tile_residual ? tile_residual + i + j * ldc : nullptr,
+                                       conv_gemm_conf);
+                } else {
+                    conv_sgemm_block_n(cur_m, cur_n, cur_k, src_trans_buf, lda, packed_cur_b, ldb, cur_c, ldc,
+                                       cur_bias, first, CONV_SGEMM_POST_NONE, nullptr, nullptr, nullptr,
+                                       conv_gemm_conf);
+                }
                 j += cur_n;
             }
         }
     }
 }
 
+void conv_sgemm_nn_col_major(
+        dim_t M, dim_t N, dim_t K,
+        const float * src_a, dim_t lda,
+        const float * src_b, dim_t ldb,
+        float * dst, dim_t ldc,
+        const float * bias, dim_t act_type,
+        float *src_trans_buf,
+        conv_gemm_config<float, float, float> &conv_gemm_conf,
+        const float * residual, dim_t fusion_type)
+{
+    dim_t N_round_up = divUp(N, conv_gemm_conf.n_block_);
+    auto get_b = [&](dim_t k) {
+        return src_b + k * N_round_up;
+    };
+    conv_sgemm_nn_col_major_impl(M, N, K, src_a, lda, get_b, ldb, dst, ldc, bias, act_type, src_trans_buf,
+                                 conv_gemm_conf, residual, fusion_type);
+}
+
+void conv_sgemm_nn_col_major(
+        dim_t M, dim_t N, dim_t K,
+        const float * src_a, dim_t lda,
+        const uint16_t * src_b, DataType b_type, dim_t ldb,
+        float * dst, dim_t ldc,
+        const float * bias, dim_t act_type,
+        float *src_trans_buf, float *b_buf,
+        conv_gemm_config<float, float, float> &conv_gemm_conf,
+        const float * residual, dim_t fusion_type)
+{
+    dim_t N_round_up = divUp(N, conv_gemm_conf.n_block_);
+    dim_t block_size = conv_gemm_conf.K_c_ * N_round_up;
+    auto get_b = [&](dim_t k) {
+        WidenToFloat(b_buf, src_b + k * N_round_up, block_size, b_type);
+        return (const float *)b_buf;
+    };
+    conv_sgemm_nn_col_major_impl(M, N, K, src_a, lda, get_b, ldb, dst, ldc, bias, act_type, src_trans_buf,
+                                 conv_gemm_conf, residual, fusion_type);
+}
+
 void conv_pack_weights(
         dim_t N, dim_t K,
         const float * src, dim_t ld_src,
@@ -17,10 +17,12 @@
 
 #include "tnn/core/common.h"
 #include "tnn/core/macro.h"
+#include "tnn/interpreter/layer_param.h"
 #include "tnn/device/x86/acc/compute/jit/conv_gemm_config.h"
 
 namespace TNN_NS {
 
+// residual has the layout of dst and is added before or after the activation as fusion_type tells
 void conv_sgemm_nn_col_major(
         dim_t M, dim_t N, dim_t K,
         const float * src_a, dim_t lda,
@@ -28,7 +30,20 @@ void conv_sgemm_nn_col_major(
         float * dst, dim_t ldc,
         const float * bias, dim_t act_type,
         float * src_buf,
-        conv_gemm_config<float, float, float> &conv_gemm_conf);
+        conv_gemm_config<float, float, float> &conv_gemm_conf,
+        const float * residual = nullptr, dim_t fusion_type = FusionType_None);
+
+// src_b holds the weights of conv_pack_weights in fp16 or bf16 as b_type tells, each K block is widened
+// into b_buf of K_c * n_block aligned N floats before the kernels read it
+void conv_sgemm_nn_col_major(
+        dim_t M, dim_t N, dim_t K,
+        const float * src_a, dim_t lda,
+        const uint16_t * src_b, DataType b_type, dim_t ldb,
+        float * dst, dim_t ldc,
+        const float * bias, dim_t act_type,
+        float * src_buf, float * b_buf,
+        conv_gemm_config<float, float, float> &conv_gemm_conf,
+        const float * residual = nullptr, dim_t fusion_type = FusionType_None);
 
 void conv_pack_weights(
         dim_t N, dim_t K,
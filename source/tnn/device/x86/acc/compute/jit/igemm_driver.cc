@@ -0,0 +1,75 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/jit/igemm_driver.h"
+
+#include <mutex>
+#include <memory>
+
+#include "tnn/device/x86/acc/compute/jit/kernels/jit_kernels.h"
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
+
+namespace TNN_NS {
+
+typedef jit::igemm_avx512_vnni_mx6<1>::func_ptr_t igemm_vnni_func_t;
+
+template <int M_r>
+static igemm_vnni_func_t get_igemm_avx512_vnni_ker() {
+    static std::shared_ptr<jit::igemm_avx512_vnni_mx6<M_r>> g_kernel;
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+        g_kernel = std::make_shared<jit::igemm_avx512_vnni_mx6<M_r>>();
+#ifdef TNN_JIT_DUMP_KERNEL
+        g_kernel->dump_to_file();
+#endif
+    });
+    return jit::get_func_ptr<jit::igemm_avx512_vnni_mx6<M_r>>(g_kernel.get());
+}
+
+bool igemm_avx512_vnni_available() {
+#ifdef XBYAK64
+    return cpu_with_isa(avx512_vnni);
+#else
+    return false;
+#endif
+}
+
+void igemm_avx512_vnni(
+        dim_t M, dim_t N, dim_t K4,
+        const uint8_t * a,
+        const int8_t * b,
+        int32_t * c, dim_t ldc)
+{
+    igemm_vnni_func_t kernels[5] = {
+        nullptr,
+        get_igemm_avx512_vnni_ker<1>(),
+        get_igemm_avx512_vnni_ker<2>(),
+        get_igemm_avx512_vnni_ker<3>(),
+        get_igemm_avx512_vnni_ker<4>(),
+    };
+
+    const dim_t a_stride = K4 * 16 * 4;
+    const dim_t b_stride = K4 * 6 * 4;
+
+    // a block of 64 rows stays in L1 while b is streamed
+    for (dim_t m = 0; m < M; m += 64) {
+        dim_t m_r = MIN(M - m, 64) / 16;
+        const uint8_t * a_m = a + (m / 16) * a_stride;
+        for (dim_t n = 0; n < N; n += 6) {
+            kernels[m_r](K4, a_m, a_stride, b + (n / 6) * b_stride, c + n * ldc + m, ldc);
+        }
+    }
+}
+
+} // namespace tnn
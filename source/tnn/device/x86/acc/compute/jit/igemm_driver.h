@@ -0,0 +1,40 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_JIT_IGEMM_DRIVER_H_
+#define SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_JIT_IGEMM_DRIVER_H_
+
+#include <stdint.h>
+
+#include "tnn/core/common.h"
+#include "tnn/core/macro.h"
+#include "tnn/device/x86/acc/compute/jit/common/type_def.h"
+
+namespace TNN_NS {
+
+// @brief whether igemm_avx512_vnni can run on this cpu and build
+bool igemm_avx512_vnni_available();
+
+// @brief c(N, M) = b(N, K) * a(K, M) with int32 results, M must be a multiple of 16, N a multiple of 6.
+// a is u8 packed as [M / 16][K4][16][4], b is s8 packed as [N / 6][K4][6][4].
+// Runs vpdpbusd on zmm registers, the caller must check igemm_avx512_vnni_available() first.
+void igemm_avx512_vnni(
+        dim_t M, dim_t N, dim_t K4,
+        const uint8_t * a,
+        const int8_t * b,
+        int32_t * c, dim_t ldc);
+
+}   // namespace TNN_NS
+
+#endif
@@ -408,6 +408,22 @@ public:
         }
     }
 
+    // broadcast a float immediate to all lanes of v, tmp is a scratch gpr
+    inline void broadcast_float(Xbyak::Xmm v, float value, rf_t tmp) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        mov(tmp.cvt32(), bits);
+        if (v.isZMM()) {
+            vpbroadcastd(v, tmp.cvt32());
+        } else if (v.isYMM()) {
+            vmovd(Xbyak::Xmm(v.getIdx()), tmp.cvt32());
+            vbroadcastss(v, Xbyak::Xmm(v.getIdx()));
+        } else {
+            movd(v, tmp.cvt32());
+            shufps(v, v, 0);
+        }
+    }
+
 protected:
     size_t abi_nb_argment = 0;
     size_t abi_bp_offset_ = 0;
@@ -0,0 +1,243 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_CONV_SGEMM_AVX512_MxI_H_
+#define TNN_CONV_SGEMM_AVX512_MxI_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <fstream>
+#include <immintrin.h>
+#include <xmmintrin.h>
+#include <exception>
+#include <utility>
+
+#include <xbyak/xbyak.h>
+
+#include "tnn/device/x86/acc/compute/jit/common/type_def.h"
+#include "tnn/device/x86/acc/compute/jit/common/abi_info.h"
+#include "tnn/device/x86/acc/compute/jit/common/asm_common.h"
+#include "tnn/device/x86/acc/compute/jit/utils/macro.h"
+#include "tnn/device/x86/acc/compute/jit/kernels/base_jit_kernel.h"
+
+namespace TNN_NS {
+namespace jit {
+
+// M x I register blocking with zmm registers, M must be 32 or 64.
+// zmm0  - zmm23 : accumulators, (M / 16) x 6
+// zmm24 - zmm27 : a panel
+// zmm28 - zmm29 : broadcasted b
+// zmm30         : zero for relu
+// zmm31         : six for relu6
+template<int M, int I, int M_BLOCK_SIZE, int N_BLOCK_SIZE>
+class conv_sgemm_avx512_mxi: public base_jit_kernel {
+
+public:
+    static void naive_impl(const dim_t K,
+                           const float * src_a, const dim_t lda,
+                           const float * src_b, dim_t ldb,
+                           float * dst, dim_t ldc,
+                           const float * bias, dim_t first, dim_t act_type,
+                           const float * residual) {}
+
+    using func_ptr_t = decltype(&conv_sgemm_avx512_mxi::naive_impl);
+
+    virtual std::string get_kernel_name() {
+        std::stringstream buf;
+        buf << JIT_KERNEL_NAME(conv_sgemm_avx512) << "_" << M << "_" << I << "_" << M_BLOCK_SIZE << "_" << N_BLOCK_SIZE;
+        return buf.str();
+    }
+
+public:
+    conv_sgemm_avx512_mxi() {
+
+#ifdef XBYAK64
+        constexpr int N_r = MIN_(6, I);
+        constexpr int M_r = M / 16;
+
+        declare_param<const dim_t>();       // 0. K
+        declare_param<const float *>();     // 1. src_a
+        declare_param<const dim_t>();       // 2. lda
+        declare_param<const float *>();     // 3. src_b
+        declare_param<const dim_t>();       // 4. ldb
+        declare_param<float *>();           // 5. dst
+        declare_param<const dim_t>();       // 6. ldc
+        declare_param<const float *>();     // 7. bias
+        declare_param<dim_t>();             // 8. first
+        declare_param<dim_t>();             // 9. act_type
+        declare_param<const float *>();     // 10. residual
+
+        abi_prolog();
+
+        stack_var K         = get_arguement_to_stack(0);
+        reg_var src_a       = get_arguement(1);
+        reg_var lda         = get_arguement(2);
+        reg_var src_b       = get_arguement(3);
+        reg_var ldb         = get_arguement(4);
+        reg_var dst         = get_arguement(5);
+        reg_var ldc         = get_arguement(6);
+        reg_var bias        = get_arguement(7);
+        reg_var first       = get_arguement(8);
+        reg_var act_type    = get_arguement(9);
+        reg_var residual    = get_arguement(10);
+
+        reg_var c[3] = {REG_VAR_ARRAY_3};
+        reg_var tmp(this);
+
+        auto c_data = [](int m, int n) { return Xbyak::Zmm(m * 6 + n); };
+        Xbyak::Zmm a_data[4] = {Xbyak::Zmm(24), Xbyak::Zmm(25), Xbyak::Zmm(26), Xbyak::Zmm(27)};
+        Xbyak::Zmm b_data[2] = {Xbyak::Zmm(28), Xbyak::Zmm(29)};
+        Xbyak::Zmm v_zero(30);
+        Xbyak::Zmm v_six(31);
+
+        ldc.restore();
+        mov(c[0].aquire(), dst.restore());
+        lea(c[1].aquire(), byte[dst + (ldc * 8)]);
+        lea(c[2].aquire(), byte[c[1]+ (ldc * 8)]);
+        dst.release();
+
+        Xbyak::RegExp c_addr[6] = {
+            Xbyak::RegExp(c[0]),
+            Xbyak::RegExp(c[0] + (ldc * 4)),
+            Xbyak::RegExp(c[1]),
+            Xbyak::RegExp(c[1] + (ldc * 4)),
+            Xbyak::RegExp(c[2]),
+            Xbyak::RegExp(c[2] + (ldc * 4)),
+        };
+
+        first.restore();
+        cmp(first, 0);
+        jne("L_init", T_NEAR);
+        bias.restore();
+        for(int i=0;i<N_r;i++) {
+            for(int m=0;m<M_r;m++) {
+                vbroadcastss(c_data(m, i), dword[bias + i * 4]);
+            }
+        }
+        bias.release();
+        jmp("L_init_end", T_NEAR);
+        L("L_init");
+        for(int i=0;i<N_r;i++) {
+            for(int m=0;m<M_r;m++) {
+                vmovups(c_data(m, i), zword[c_addr[i] + m * 16 * 4]);
+            }
+        }
+        L("L_init_end");
+        first.release();
+
+        src_a.restore();
+        src_b.restore();
+
+        LOOP_STACK_VAR(K, CONV_SGEMM_AVX512_K)
+        {
+            for(int m=0;m<M_r;m++) {
+                vmovups(a_data[m], zword[src_a + m * 16 * 4]);
+            }
+
+            for(int i=0;i<N_r;i++) {
+                vbroadcastss(b_data[i % 2], dword[src_b + i * 4]);
+                for(int m=0;m<M_r;m++) {
+                    vfmadd231ps(c_data(m, i), a_data[m], b_data[i % 2]);
+                }
+            }
+
+            lea(src_a, byte[src_a + M_BLOCK_SIZE * 4]);
+            lea(src_b, byte[src_b + N_BLOCK_SIZE * 4]);
+        }
+
+        src_a.release();
+        src_b.release();
+
+        // residual has the layout of dst, shift the c pointers onto it to share c_addr
+        auto residual_add = [&]() {
+            sub(residual, c[0]);
+            for(int k=0;k<3;k++) {
+                add(c[k], residual);
+            }
+            for(int i=0;i<N_r;i++) {
+                for(int m=0;m<M_r;m++) {
+                    vaddps(c_data(m, i), c_data(m, i), zword[c_addr[i] + m * 16 * 4]);
+                }
+            }
+            for(int k=0;k<3;k++) {
+                sub(c[k], residual);
+            }
+            add(residual, c[0]);
+        };
+
+        // fuse residual add, relu and relu6, same as the avx kernels
+        act_type.restore();
+        residual.restore();
+        test(residual, residual);
+        je("L_add_first_end", T_NEAR);
+        test(act_type, CONV_SGEMM_POST_ADD_LAST);
+        jne("L_add_first_end", T_NEAR);
+            residual_add();
+        L("L_add_first_end");
+
+        test(act_type, CONV_SGEMM_POST_RELU | CONV_SGEMM_POST_RELU6);
+        je("L_act_end", T_NEAR);
+            vxorps(v_zero, v_zero, v_zero);
+            for(int i=0;i<N_r;i++) {
+                for(int m=0;m<M_r;m++) {
+                    vmaxps(c_data(m, i), c_data(m, i), v_zero);
+                }
+            }
+        test(act_type, CONV_SGEMM_POST_RELU6);
+        je("L_act_end", T_NEAR);
+            broadcast_float(v_six, 6.f, tmp.aquire());
+            tmp.release();
+            for(int i=0;i<N_r;i++) {
+                for(int m=0;m<M_r;m++) {
+                    vminps(c_data(m, i), c_data(m, i), v_six);
+                }
+            }
+        L("L_act_end");
+
+        test(residual, residual);
+        je("L_add_last_end", T_NEAR);
+        test(act_type, CONV_SGEMM_POST_ADD_LAST);
+        je("L_add_last_end", T_NEAR);
+            residual_add();
+        L("L_add_last_end");
+        act_type.release();
+        residual.release();
+
+        for(int i=0;i<N_r;i++) {
+            for(int m=0;m<M_r;m++) {
+                vmovups(zword[c_addr[i] + m * 16 * 4], c_data(m, i));
+            }
+        }
+
+        // avoid the avx-sse transition penalty in the caller
+        vzeroupper();
+
+        abi_epilog();
+#endif // XBYAK64
+        ret();
+    }
+
+    virtual ~conv_sgemm_avx512_mxi() {
+
+    }
+
+private:
+
+};
+
+} // namespace jit
+} // namespace tnn
+
+#endif // TNN_CONV_SGEMM_AVX512_MxI_H_
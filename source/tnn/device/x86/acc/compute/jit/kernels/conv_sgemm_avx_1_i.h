@@ -43,7 +43,8 @@ public:
                            const float * src_a, const dim_t lda,
                            const float * src_b, dim_t ldb,
                            float * dst, dim_t ldc,
-                           const float * bias, dim_t first, dim_t act_type) {}
+                           const float * bias, dim_t first, dim_t act_type,
+                           const float * residual) {}
 
     using func_ptr_t = decltype(&conv_sgemm_avx_1xi::naive_impl);
 
@@ -67,6 +68,7 @@ public:
         declare_param<const float *>();     // 7. bias
         declare_param<dim_t>();             // 8. first
         declare_param<dim_t>();             // 9. act_type
+        declare_param<const float *>();     // 10. residual
 
         abi_prolog();
 
@@ -80,11 +82,13 @@ public:
         reg_var bias        = get_arguement(7);
         reg_var first       = get_arguement(8);
         reg_var act_type    = get_arguement(9);
+        reg_var residual    = get_arguement(10);
 
         reg_var c[3] = {REG_VAR_ARRAY_3};
-        // reg_var op_6f(this);
+        reg_var tmp(this);
         vreg_var v_zero(this);
-        // vreg_var v_6f(this);
+        vreg_var v_six(this);
+        vreg_var v_res(this);
         vreg_var c_data[6] = {VREG_VAR_ARRAY_6};
         vreg_var a_data(this), b_data(this);
         
@@ -141,18 +145,61 @@ public:
         src_a.release();
         src_b.release();
 
-        // fuse relu
+        // residual has the layout of dst, shift the c pointers onto it to share c_addr
+        auto residual_add = [&]() {
+            sub(residual, c[0]);
+            for(int k=0;k<3;k++) {
+                add(c[k], residual);
+            }
+            v_res.aquire();
+            for(int i=0;i<N_r;i++) {
+                movss(v_res.xmm(), dword[c_addr[i]]);
+                addps(c_data[i].xmm(), v_res.xmm());
+            }
+            v_res.release();
+            for(int k=0;k<3;k++) {
+                sub(c[k], residual);
+            }
+            add(residual, c[0]);
+        };
+
+        // fuse residual add, relu and relu6
         act_type.restore();
-        cmp(act_type, 0);
-        je("L_post_end");
+        residual.restore();
+        test(residual, residual);
+        je("L_add_first_end", T_NEAR);
+        test(act_type, CONV_SGEMM_POST_ADD_LAST);
+        jne("L_add_first_end", T_NEAR);
+            residual_add();
+        L("L_add_first_end");
+
+        test(act_type, CONV_SGEMM_POST_RELU | CONV_SGEMM_POST_RELU6);
+        je("L_act_end", T_NEAR);
             v_zero.aquire();
             xorps(v_zero.xmm(), v_zero.xmm());
             for(int i=0;i<N_r;i++) {
                 maxps(c_data[i].xmm(), v_zero.xmm());
             }
             v_zero.release();
-        L("L_post_end");
+        test(act_type, CONV_SGEMM_POST_RELU6);
+        je("L_act_end", T_NEAR);
+            v_six.aquire();
+            broadcast_float(v_six.xmm(), 6.f, tmp.aquire());
+            tmp.release();
+            for(int i=0;i<N_r;i++) {
+                minps(c_data[i].xmm(), v_six.xmm());
+            }
+            v_six.release();
+        L("L_act_end");
+
+        test(residual, residual);
+        je("L_add_last_end", T_NEAR);
+        test(act_type, CONV_SGEMM_POST_ADD_LAST);
+        je("L_add_last_end", T_NEAR);
+            residual_add();
+        L("L_add_last_end");
         act_type.release();
+        residual.release();
 
         for(int i=0;i<N_r;i++) {
             movss(dword[c_addr[i]], c_data[i].xmm());
@@ -38,6 +38,7 @@
 #include "tnn/device/x86/acc/compute/jit/kernels/conv_sgemm_avx_4_i.h"
 #include "tnn/device/x86/acc/compute/jit/kernels/conv_sgemm_avx_2_i.h"
 #include "tnn/device/x86/acc/compute/jit/kernels/conv_sgemm_avx_1_i.h"
+#include "tnn/device/x86/acc/compute/jit/kernels/conv_sgemm_avx512_m_i.h"
 
 namespace TNN_NS {
 namespace jit {
@@ -50,7 +51,8 @@ public:
                            const float * src_a, const dim_t lda,
                            const float * src_b, dim_t ldb,
                            float * dst, dim_t ldc,
-                           const float * bias, dim_t first, dim_t act_type) {}
+                           const float * bias, dim_t first, dim_t act_type,
+                           const float * residual) {}
 
     using func_ptr_t = decltype(&conv_sgemm_avx_kernel::naive_impl);
 
@@ -72,6 +74,12 @@ public:
             case 16:
                 actual = new conv_sgemm_avx_16xi<N, M_BLOCK_SIZE, N_BLOCK_SIZE>();
                 break;
+            case 32:
+                actual = new conv_sgemm_avx512_mxi<32, N, M_BLOCK_SIZE, N_BLOCK_SIZE>();
+                break;
+            case 64:
+                actual = new conv_sgemm_avx512_mxi<64, N, M_BLOCK_SIZE, N_BLOCK_SIZE>();
+                break;
             default:
                 throw std::runtime_error("kernel not found for specified param."); 
                 break;
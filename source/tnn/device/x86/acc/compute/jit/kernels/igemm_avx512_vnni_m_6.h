@@ -0,0 +1,153 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_IGEMM_AVX512_VNNI_Mx6_H_
+#define TNN_IGEMM_AVX512_VNNI_Mx6_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <fstream>
+#include <immintrin.h>
+#include <xmmintrin.h>
+#include <exception>
+#include <utility>
+
+#include <xbyak/xbyak.h>
+
+#include "tnn/device/x86/acc/compute/jit/common/type_def.h"
+#include "tnn/device/x86/acc/compute/jit/common/abi_info.h"
+#include "tnn/device/x86/acc/compute/jit/common/asm_common.h"
+#include "tnn/device/x86/acc/compute/jit/utils/macro.h"
+#include "tnn/device/x86/acc/compute/jit/kernels/base_jit_kernel.h"
+
+namespace TNN_NS {
+namespace jit {
+
+// c(6, M_r * 16) = b(6, K) * a(K, M_r * 16), int32 results, u8 a and s8 b.
+// a is packed as [M / 16][K / 4][16][4], a_stride is the bytes between two 16 panels.
+// b is packed as [K / 4][6][4], every 4 bytes of b are broadcasted to vpdpbusd.
+// zmm0  - zmm23 : accumulators, M_r x 6
+// zmm24 - zmm27 : a panel
+template<int M_r>
+class igemm_avx512_vnni_mx6: public base_jit_kernel {
+
+public:
+    static void naive_impl(const dim_t K4,
+                           const uint8_t * a, const dim_t a_stride,
+                           const int8_t * b,
+                           int32_t * c, const dim_t ldc) {}
+
+    using func_ptr_t = decltype(&igemm_avx512_vnni_mx6::naive_impl);
+
+    virtual std::string get_kernel_name() {
+        std::stringstream buf;
+        buf << JIT_KERNEL_NAME(igemm_avx512_vnni) << "_" << M_r * 16 << "_6";
+        return buf.str();
+    }
+
+public:
+    igemm_avx512_vnni_mx6() {
+
+#ifdef XBYAK64
+        declare_param<const dim_t>();       // 0. K4
+        declare_param<const uint8_t *>();   // 1. a
+        declare_param<const dim_t>();       // 2. a_stride
+        declare_param<const int8_t *>();    // 3. b
+        declare_param<int32_t *>();         // 4. c
+        declare_param<const dim_t>();       // 5. ldc
+
+        abi_prolog();
+
+        stack_var K4        = get_arguement_to_stack(0);
+        reg_var a           = get_arguement(1);
+        reg_var a_stride    = get_arguement(2);
+        reg_var b           = get_arguement(3);
+        reg_var c           = get_arguement(4);
+        reg_var ldc         = get_arguement(5);
+
+        reg_var a_ptr(this);
+
+        auto c_data = [](int m, int n) { return Xbyak::Zmm(m * 6 + n); };
+        Xbyak::Zmm a_data[4] = {Xbyak::Zmm(24), Xbyak::Zmm(25), Xbyak::Zmm(26), Xbyak::Zmm(27)};
+
+        for(int n=0;n<6;n++) {
+            for(int m=0;m<M_r;m++) {
+                vpxord(c_data(m, n), c_data(m, n), c_data(m, n));
+            }
+        }
+
+        a.restore();
+        a_stride.restore();
+        b.restore();
+        a_ptr.aquire();
+
+        LOOP_STACK_VAR(K4, IGEMM_AVX512_VNNI_K4)
+        {
+            mov(a_ptr, a);
+            for(int m=0;m<M_r;m++) {
+                vmovdqu32(a_data[m], zword[a_ptr]);
+                if (m + 1 < M_r) {
+                    add(a_ptr, a_stride);
+                }
+            }
+
+            for(int n=0;n<6;n++) {
+                for(int m=0;m<M_r;m++) {
+                    vpdpbusd(c_data(m, n), a_data[m], zword_b[b + n * 4]);
+                }
+            }
+
+            lea(a, byte[a + 16 * 4]);
+            lea(b, byte[b + 6 * 4]);
+        }
+
+        a_ptr.release();
+        a.release();
+        a_stride.release();
+        b.release();
+
+        c.restore();
+        ldc.restore();
+        for(int n=0;n<6;n++) {
+            for(int m=0;m<M_r;m++) {
+                vmovdqu32(zword[c + m * 16 * 4], c_data(m, n));
+            }
+            if (n + 1 < 6) {
+                lea(c, byte[c + ldc * 4]);
+            }
+        }
+        c.release();
+        ldc.release();
+
+        // avoid the avx-sse transition penalty in the caller
+        vzeroupper();
+
+        abi_epilog();
+#endif // XBYAK64
+        ret();
+    }
+
+    virtual ~igemm_avx512_vnni_mx6() {
+
+    }
+
+private:
+
+};
+
+} // namespace jit
+} // namespace tnn
+
+#endif // TNN_IGEMM_AVX512_VNNI_Mx6_H_
@@ -24,5 +24,8 @@
 #include "tnn/device/x86/acc/compute/jit/kernels/sgemm_fetch_t_4x16.h"
 #include "tnn/device/x86/acc/compute/jit/kernels/sgemm_avx_kernels.h"
 #include "tnn/device/x86/acc/compute/jit/kernels/conv_sgemm_avx_kernels.h"
+#include "tnn/device/x86/acc/compute/jit/kernels/sgemv_avx512_16.h"
+#include "tnn/device/x86/acc/compute/jit/kernels/igemm_avx512_vnni_m_6.h"
+#include "tnn/device/x86/acc/compute/jit/kernels/winograd_gemm_avx512_m_n.h"
 
 #endif // TNN_JIT_JIT_KERNELS_H_
\ No newline at end of file
@@ -0,0 +1,155 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SGEMV_AVX512_16_H_
+#define TNN_SGEMV_AVX512_16_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <fstream>
+#include <immintrin.h>
+#include <xmmintrin.h>
+#include <exception>
+#include <utility>
+
+#include <xbyak/xbyak.h>
+
+#include "tnn/device/x86/acc/compute/jit/common/type_def.h"
+#include "tnn/device/x86/acc/compute/jit/common/abi_info.h"
+#include "tnn/device/x86/acc/compute/jit/common/asm_common.h"
+#include "tnn/device/x86/acc/compute/jit/utils/macro.h"
+#include "tnn/device/x86/acc/compute/jit/kernels/base_jit_kernel.h"
+
+namespace TNN_NS {
+namespace jit {
+
+// dst[0:n] = bias[0:n] + sum_k(src[k] * weight[k * 16 + 0:n]), n <= 16
+// weight is one 16-channel panel packed by PackC16, padding lanes are zero.
+class sgemv_avx512_16_ker_t: public base_jit_kernel {
+
+public:
+    static void naive_impl(const dim_t K, const float * src, const float * weight,
+                           const float * bias, float * dst, const dim_t n) {}
+
+    using func_ptr_t = decltype(&sgemv_avx512_16_ker_t::naive_impl);
+
+    virtual std::string get_kernel_name() {
+        return JIT_KERNEL_NAME(sgemv_avx512_16);
+    }
+
+public:
+    sgemv_avx512_16_ker_t() {
+
+#ifdef XBYAK64
+        declare_param<const dim_t>();       // 0. K
+        declare_param<const float *>();     // 1. src
+        declare_param<const float *>();     // 2. weight
+        declare_param<const float *>();     // 3. bias
+        declare_param<float *>();           // 4. dst
+        declare_param<const dim_t>();       // 5. n
+
+        abi_prolog();
+
+        stack_var K         = get_arguement_to_stack(0);
+        reg_var src         = get_arguement(1);
+        reg_var weight      = get_arguement(2);
+        reg_var bias        = get_arguement(3);
+        reg_var dst         = get_arguement(4);
+        reg_var n           = get_arguement(5);
+
+        stack_var k4 = get_stack_var();
+        stack_var k1 = get_stack_var();
+
+        reg_var tmp(this);
+
+        // 4 independent accumulators to hide the fma latency
+        Xbyak::Zmm acc[4]   = {Xbyak::Zmm(0), Xbyak::Zmm(1), Xbyak::Zmm(2), Xbyak::Zmm(3)};
+        Xbyak::Zmm src_v[4] = {Xbyak::Zmm(4), Xbyak::Zmm(5), Xbyak::Zmm(6), Xbyak::Zmm(7)};
+        Xbyak::Opmask mask(1);
+
+        // init k4 = K / 4, k1 = K % 4
+        mov(tmp.aquire(), K);
+        sar(tmp, 0x2);
+        mov(k4, tmp);
+        mov(tmp, K);
+        and_(tmp, 0x3);
+        mov(k1, tmp);
+
+        // mask of the valid output lanes
+        mov(tmp, 0xFFFF);
+        bzhi(tmp, tmp, n.restore());
+        kmovw(mask, tmp.cvt32());
+        n.release();
+        tmp.release();
+
+        bias.restore();
+        vmovups(acc[0] | mask | T_z, zword[bias]);
+        bias.release();
+        for(int i=1;i<4;i++) {
+            vxorps(acc[i], acc[i], acc[i]);
+        }
+
+        src.restore();
+        weight.restore();
+
+        LOOP_STACK_VAR(k4, SGEMV_AVX512_16_K4)
+        {
+            for(int i=0;i<4;i++) {
+                vbroadcastss(src_v[i], dword[src + i * 4]);
+                vfmadd231ps(acc[i], src_v[i], zword[weight + i * 16 * 4]);
+            }
+            lea(src, byte[src + 4 * 4]);
+            lea(weight, byte[weight + 4 * 16 * 4]);
+        }
+
+        LOOP_STACK_VAR(k1, SGEMV_AVX512_16_K1)
+        {
+            vbroadcastss(src_v[0], dword[src]);
+            vfmadd231ps(acc[0], src_v[0], zword[weight]);
+            lea(src, byte[src + 4]);
+            lea(weight, byte[weight + 16 * 4]);
+        }
+
+        src.release();
+        weight.release();
+
+        vaddps(acc[0], acc[0], acc[1]);
+        vaddps(acc[2], acc[2], acc[3]);
+        vaddps(acc[0], acc[0], acc[2]);
+
+        dst.restore();
+        vmovups(zword[dst] | mask, acc[0]);
+        dst.release();
+
+        // avoid the avx-sse transition penalty in the caller
+        vzeroupper();
+
+        abi_epilog();
+#endif // XBYAK64
+        ret();
+    }
+
+    virtual ~sgemv_avx512_16_ker_t() {
+
+    }
+
+private:
+
+};
+
+} // namespace jit
+} // namespace tnn
+
+#endif // TNN_SGEMV_AVX512_16_H_
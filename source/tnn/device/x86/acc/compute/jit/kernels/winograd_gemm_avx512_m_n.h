@@ -0,0 +1,178 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_WINOGRAD_GEMM_AVX512_MxN_H_
+#define TNN_WINOGRAD_GEMM_AVX512_MxN_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <fstream>
+#include <immintrin.h>
+#include <xmmintrin.h>
+#include <exception>
+#include <utility>
+
+#include <xbyak/xbyak.h>
+
+#include "tnn/device/x86/acc/compute/jit/common/type_def.h"
+#include "tnn/device/x86/acc/compute/jit/common/abi_info.h"
+#include "tnn/device/x86/acc/compute/jit/common/asm_common.h"
+#include "tnn/device/x86/acc/compute/jit/utils/macro.h"
+#include "tnn/device/x86/acc/compute/jit/kernels/base_jit_kernel.h"
+
+namespace TNN_NS {
+namespace jit {
+
+// winograd tile gemm on c16 data, dst(M_r * 16, N_r) = weight(M_r * 16, K) * src(K, N_r)
+// src is packed as [K / 16][tiles][16], src_stride is the bytes between two 16 channel blocks.
+// weight is packed as [oc / 16][K / 16][16 ic][16 oc], weight_stride is the bytes between two oc blocks.
+// dst is packed as [oc / 16][tiles][16], dst_stride is the bytes between two oc blocks.
+// zmm0  - zmm23 : accumulators, M_r x N_r
+// zmm24 - zmm25 : weight
+// zmm26 - zmm27 : broadcasted src
+template<int M_r, int N_r>
+class winograd_gemm_avx512_mxn: public base_jit_kernel {
+
+public:
+    static void naive_impl(const dim_t K16,
+                           const float * src, const dim_t src_stride,
+                           const float * weight, const dim_t weight_stride,
+                           float * dst, const dim_t dst_stride) {}
+
+    using func_ptr_t = decltype(&winograd_gemm_avx512_mxn::naive_impl);
+
+    virtual std::string get_kernel_name() {
+        std::stringstream buf;
+        buf << JIT_KERNEL_NAME(winograd_gemm_avx512) << "_" << M_r * 16 << "_" << N_r;
+        return buf.str();
+    }
+
+public:
+    winograd_gemm_avx512_mxn() {
+
+#ifdef XBYAK64
+        declare_param<const dim_t>();       // 0. K16
+        declare_param<const float *>();     // 1. src
+        declare_param<const dim_t>();       // 2. src_stride
+        declare_param<const float *>();     // 3. weight
+        declare_param<const dim_t>();       // 4. weight_stride
+        declare_param<float *>();           // 5. dst
+        declare_param<const dim_t>();       // 6. dst_stride
+
+        abi_prolog();
+
+        stack_var K16           = get_arguement_to_stack(0);
+        reg_var src             = get_arguement(1);
+        reg_var src_stride      = get_arguement(2);
+        reg_var weight          = get_arguement(3);
+        reg_var weight_stride   = get_arguement(4);
+        reg_var dst             = get_arguement(5);
+        reg_var dst_stride      = get_arguement(6);
+
+        reg_var weight_1(this);
+        stack_var k4 = get_stack_var();
+
+        auto c_data = [](int m, int n) { return Xbyak::Zmm(m * 12 + n); };
+        Xbyak::Zmm w_data[2] = {Xbyak::Zmm(24), Xbyak::Zmm(25)};
+        Xbyak::Zmm b_data[2] = {Xbyak::Zmm(26), Xbyak::Zmm(27)};
+
+        for(int m=0;m<M_r;m++) {
+            for(int n=0;n<N_r;n++) {
+                vxorps(c_data(m, n), c_data(m, n), c_data(m, n));
+            }
+        }
+
+        src.restore();
+        src_stride.restore();
+        weight.restore();
+        if (M_r > 1) {
+            weight_stride.restore();
+            lea(weight_1.aquire(), byte[weight + weight_stride]);
+            weight_stride.release();
+        }
+
+        // 16 input channels of a block are walked 4 at a time to bound the code size
+        LOOP_STACK_VAR(K16, WINOGRAD_GEMM_AVX512_K16)
+        {
+            mov(k4, 4);
+            LOOP_STACK_VAR(k4, WINOGRAD_GEMM_AVX512_K4)
+            {
+                for(int k=0;k<4;k++) {
+                    vmovups(w_data[0], zword[weight + k * 16 * 4]);
+                    if (M_r > 1) {
+                        vmovups(w_data[1], zword[weight_1 + k * 16 * 4]);
+                    }
+                    for(int n=0;n<N_r;n++) {
+                        if (M_r > 1) {
+                            // one broadcast feeds both oc blocks
+                            vbroadcastss(b_data[n % 2], dword[src + (n * 16 + k) * 4]);
+                            vfmadd231ps(c_data(0, n), w_data[0], b_data[n % 2]);
+                            vfmadd231ps(c_data(1, n), w_data[1], b_data[n % 2]);
+                        } else {
+                            vfmadd231ps(c_data(0, n), w_data[0], zword_b[src + (n * 16 + k) * 4]);
+                        }
+                    }
+                }
+
+                lea(src, byte[src + 4 * 4]);
+                lea(weight, byte[weight + 4 * 16 * 4]);
+                if (M_r > 1) {
+                    lea(weight_1, byte[weight_1 + 4 * 16 * 4]);
+                }
+            }
+
+            lea(src, byte[src + src_stride - 16 * 4]);
+        }
+
+        if (M_r > 1) {
+            weight_1.release();
+        }
+        src.release();
+        src_stride.release();
+        weight.release();
+
+        dst.restore();
+        dst_stride.restore();
+        for(int m=0;m<M_r;m++) {
+            for(int n=0;n<N_r;n++) {
+                vmovups(zword[dst + n * 16 * 4], c_data(m, n));
+            }
+            if (m + 1 < M_r) {
+                add(dst, dst_stride);
+            }
+        }
+        dst.release();
+        dst_stride.release();
+
+        // avoid the avx-sse transition penalty in the caller
+        vzeroupper();
+
+        abi_epilog();
+#endif // XBYAK64
+        ret();
+    }
+
+    virtual ~winograd_gemm_avx512_mxn() {
+
+    }
+
+private:
+
+};
+
+} // namespace jit
+} // namespace tnn
+
+#endif // TNN_WINOGRAD_GEMM_AVX512_MxN_H_
@@ -0,0 +1,67 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/jit/sgemv_driver.h"
+
+#include <mutex>
+#include <memory>
+
+#include "tnn/device/x86/acc/compute/jit/kernels/jit_kernels.h"
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
+#include "tnn/device/x86/x86_util.h"
+
+namespace TNN_NS {
+
+static jit::sgemv_avx512_16_ker_t::func_ptr_t get_sgemv_avx512_16_ker() {
+    static std::shared_ptr<jit::sgemv_avx512_16_ker_t> g_kernel;
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+        g_kernel = std::make_shared<jit::sgemv_avx512_16_ker_t>();
+#ifdef TNN_JIT_DUMP_KERNEL
+        g_kernel->dump_to_file();
+#endif
+    });
+    return jit::get_func_ptr<jit::sgemv_avx512_16_ker_t>(g_kernel.get());
+}
+
+bool sgemv_avx512_c16_available() {
+#ifdef XBYAK64
+    return cpu_with_isa(avx512);
+#else
+    return false;
+#endif
+}
+
+void sgemv_avx512_c16(
+        dim_t batch, dim_t N, dim_t K,
+        const float * src,
+        const float * weight,
+        const float * bias,
+        float * dst,
+        int num_threads)
+{
+    auto kernel = get_sgemv_avx512_16_ker();
+
+    // blocks of 16 outputs of every batch are split among threads
+    const dim_t n_blocks = UP_DIV(N, 16);
+    X86ParallelFor(num_threads, batch * n_blocks, UP_DIV(4096, MAX(K, 1)), [&](long begin, long end) {
+        for (long i = begin; i < end; i++) {
+            dim_t b = i / n_blocks;
+            dim_t n = (i % n_blocks) * 16;
+            kernel(K, src + b * K, weight + n * K, bias + n, dst + b * N + n, MIN(N - n, 16));
+        }
+    });
+}
+
+} // namespace tnn
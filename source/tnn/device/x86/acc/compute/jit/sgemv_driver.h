@@ -0,0 +1,40 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_JIT_SGEMV_DRIVER_H_
+#define SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_JIT_SGEMV_DRIVER_H_
+
+#include "tnn/core/common.h"
+#include "tnn/core/macro.h"
+#include "tnn/device/x86/acc/compute/jit/common/type_def.h"
+
+namespace TNN_NS {
+
+// @brief whether sgemv_avx512_c16 can run on this cpu and build
+bool sgemv_avx512_c16_available();
+
+// @brief dst(batch, N) = src(batch, K) * weight^T + bias, weight is packed by PackC16.
+// Runs on zmm registers, the caller must check sgemv_avx512_c16_available() first.
+// Output blocks of 16 are split among num_threads threads.
+void sgemv_avx512_c16(
+        dim_t batch, dim_t N, dim_t K,
+        const float * src,
+        const float * weight,
+        const float * bias,
+        float * dst,
+        int num_threads = 1);
+
+}   // namespace TNN_NS
+
+#endif
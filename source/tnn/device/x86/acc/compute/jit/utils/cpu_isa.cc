@@ -46,4 +46,10 @@ bool cpu_with_isa(x86_isa_t arch) {
     return false;
 }
 
+std::string cpu_model_name() {
+    char name[64];
+    snprintf(name, sizeof(name), "x86_%d_%X_%d", cpu.displayFamily, cpu.displayModel, cpu.stepping);
+    return name;
+}
+
 }
@@ -24,6 +24,7 @@
 #include <random>
 #include <fstream>
 #include <exception>
+#include <string>
 
 #include <immintrin.h>
 #include <xmmintrin.h>
@@ -42,6 +43,9 @@ typedef enum {
 
 bool cpu_with_isa(x86_isa_t arch);
 
+// family, model and stepping of the cpu, e.g. x86_6_55_7
+std::string cpu_model_name();
+
 } // namespace tnn
 
 #endif // TNN_DEVICE_X86_ACC_COMPUTE_JIT_UTILS_CPU_ISA_HPP_
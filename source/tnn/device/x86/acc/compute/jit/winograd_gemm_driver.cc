@@ -0,0 +1,86 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/jit/winograd_gemm_driver.h"
+
+#include <mutex>
+#include <memory>
+
+#include "tnn/device/x86/acc/compute/jit/kernels/jit_kernels.h"
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
+
+namespace TNN_NS {
+
+typedef jit::winograd_gemm_avx512_mxn<1, 1>::func_ptr_t winograd_gemm_func_t;
+
+template <int M_r, int N_r>
+static winograd_gemm_func_t get_winograd_gemm_avx512_ker() {
+    static std::shared_ptr<jit::winograd_gemm_avx512_mxn<M_r, N_r>> g_kernel;
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+        g_kernel = std::make_shared<jit::winograd_gemm_avx512_mxn<M_r, N_r>>();
+#ifdef TNN_JIT_DUMP_KERNEL
+        g_kernel->dump_to_file();
+#endif
+    });
+    return jit::get_func_ptr<jit::winograd_gemm_avx512_mxn<M_r, N_r>>(g_kernel.get());
+}
+
+#define WINOGRAD_GEMM_KERNELS(M_r)                                                                                   \
+    {                                                                                                                \
+        nullptr, get_winograd_gemm_avx512_ker<M_r, 1>(), get_winograd_gemm_avx512_ker<M_r, 2>(),                     \
+            get_winograd_gemm_avx512_ker<M_r, 3>(), get_winograd_gemm_avx512_ker<M_r, 4>(),                          \
+            get_winograd_gemm_avx512_ker<M_r, 5>(), get_winograd_gemm_avx512_ker<M_r, 6>(),                          \
+            get_winograd_gemm_avx512_ker<M_r, 7>(), get_winograd_gemm_avx512_ker<M_r, 8>(),                          \
+            get_winograd_gemm_avx512_ker<M_r, 9>(), get_winograd_gemm_avx512_ker<M_r, 10>(),                         \
+            get_winograd_gemm_avx512_ker<M_r, 11>(), get_winograd_gemm_avx512_ker<M_r, 12>(),                        \
+    }
+
+bool winograd_gemm_avx512_available() {
+#ifdef XBYAK64
+    return cpu_with_isa(avx512);
+#else
+    return false;
+#endif
+}
+
+void winograd_gemm_avx512(
+        dim_t oc16, dim_t tiles, dim_t ic16,
+        const float * src,
+        const float * weight,
+        float * dst)
+{
+    static winograd_gemm_func_t kernels[3][13] = {
+        {nullptr},
+        WINOGRAD_GEMM_KERNELS(1),
+        WINOGRAD_GEMM_KERNELS(2),
+    };
+
+    const dim_t src_stride    = tiles * 16 * 4;
+    const dim_t weight_stride = ic16 * 16 * 16 * 4;
+    const dim_t dst_stride    = tiles * 16 * 4;
+
+    // weights of two oc blocks stay in L1 while the tiles are streamed
+    for (dim_t m = 0; m < oc16; m += 2) {
+        dim_t m_r = MIN(oc16 - m, 2);
+        const float * weight_m = weight + m * ic16 * 16 * 16;
+        float * dst_m = dst + m * tiles * 16;
+        for (dim_t n = 0; n < tiles; n += 12) {
+            dim_t n_r = MIN(tiles - n, 12);
+            kernels[m_r][n_r](ic16, src + n * 16, src_stride, weight_m, weight_stride, dst_m + n * 16, dst_stride);
+        }
+    }
+}
+
+} // namespace tnn
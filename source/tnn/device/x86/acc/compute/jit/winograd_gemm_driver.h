@@ -0,0 +1,37 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_JIT_WINOGRAD_GEMM_DRIVER_H_
+#define SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_JIT_WINOGRAD_GEMM_DRIVER_H_
+
+#include "tnn/core/common.h"
+#include "tnn/core/macro.h"
+#include "tnn/device/x86/acc/compute/jit/common/type_def.h"
+
+namespace TNN_NS {
+
+// @brief whether winograd_gemm_avx512 can run on this cpu and build
+bool winograd_gemm_avx512_available();
+
+// @brief one winograd tile gemm on c16 data, the caller must check winograd_gemm_avx512_available() first.
+// src is [ic16][tiles][16], weight is [oc16][ic16][16 ic][16 oc], dst is [oc16][tiles][16].
+void winograd_gemm_avx512(
+        dim_t oc16, dim_t tiles, dim_t ic16,
+        const float * src,
+        const float * weight,
+        float * dst);
+
+}   // namespace TNN_NS
+
+#endif
@@ -17,6 +17,7 @@
 #include "tnn/device/x86/acc/Float4.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <functional>
 #include <type_traits>
@@ -225,11 +226,11 @@ void X86MaxPoolingCorner(const float* src, long iw, long ih, float* dst, long ow
             for (long ky = kys; ky < kye; ++ky) {
                 const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
                 for (long kx = kxs; kx < kxe; kx++) {
-                    vmax = T::max(vmax, T::load(src_ptr_h + kx * pack_c));
+                    vmax = T::max(vmax, T::loadu(src_ptr_h + kx * pack_c));
                 }
             }
 
-            T::save(dst_ptr, vmax);
+            T::saveu(dst_ptr, vmax);
         }
     }
 }
@@ -251,11 +252,11 @@ void X86MaxPoolingCenter3x3s2(const float* src, long iw, long ih, float* dst, lo
 
             for (long ky = 0; ky < 3; ++ky) {
                 const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
-                vmax                 = T::max(vmax, T::load(src_ptr_h + 0 * pack_c));
-                vmax                 = T::max(vmax, T::load(src_ptr_h + 1 * pack_c));
-                vmax                 = T::max(vmax, T::load(src_ptr_h + 2 * pack_c));
+                vmax                 = T::max(vmax, T::loadu(src_ptr_h + 0 * pack_c));
+                vmax                 = T::max(vmax, T::loadu(src_ptr_h + 1 * pack_c));
+                vmax                 = T::max(vmax, T::loadu(src_ptr_h + 2 * pack_c));
             }
-            T::save(dst_ptr, vmax);
+            T::saveu(dst_ptr, vmax);
         }
     }
 }
@@ -278,11 +279,11 @@ void X86MaxPoolingCenter(const float* src, long iw, long ih, float* dst, long ow
             for (long ky = 0; ky < kh; ++ky) {
                 const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
                 for (long kx = 0; kx < kw; kx++) {
-                    vmax = T::max(vmax, T::load(src_ptr_h + kx * pack_c));
+                    vmax = T::max(vmax, T::loadu(src_ptr_h + kx * pack_c));
                 }
             }
 
-            T::save(dst_ptr, vmax);
+            T::saveu(dst_ptr, vmax);
         }
     }
 }
@@ -337,12 +338,12 @@ void X86AvgPooling(const float* src, long iw, long ih, float* dst, long ow, long
             for (long ky = kys; ky < kye; ++ky) {
                 const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
                 for (long kx = kxs; kx < kxe; kx++) {
-                    vavg = vavg + T::load(src_ptr_h + kx * pack_c);
+                    vavg = vavg + T::loadu(src_ptr_h + kx * pack_c);
                 }
             }
 
             vavg = vavg * T(kernel_count);
-            T::save(dst_ptr, vavg);
+            T::saveu(dst_ptr, vavg);
         }
     }
 }
@@ -352,108 +353,56 @@ template void X86AvgPooling<Float8, 8>(const float* src, long iw, long ih, float
 template void X86AvgPooling<Float4, 4>(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
                 long stride_h, long pad_w, long pad_h);
 
+// output = input * scale + bias on count floats
+static void fma_kernel(const float *input, float *output, const float scale, const float bias, bool has_bias,
+                       long count) {
+    long index = 0;
+#ifdef __AVX2__
+    __m256 v_scale = _mm256_set1_ps(scale);
+    __m256 v_bias  = _mm256_set1_ps(bias);
+    for (; index + 7 < count; index += 8) {
+        __m256 src = _mm256_loadu_ps(input + index);
+        if (has_bias)
+            src = _mm256_fmadd_ps(src, v_scale, v_bias);
+        else
+            src = _mm256_mul_ps(src, v_scale);
+        _mm256_storeu_ps(output + index, src);
+    }
+#endif
+    for (; index < count; index++) {
+        if (has_bias)
+            output[index] = input[index] * scale + bias;
+        else
+            output[index] = input[index] * scale;
+    }
+}
+
 Status X86_FMA(float *input_data, float *output_data, float *scale_data, float *bias_data,
-               bool shared_channel, bool has_bias, DimsVector output_dim) {
+               bool shared_channel, bool has_bias, DimsVector output_dim, int num_threads) {
     
     int channel = output_dim[1];
-    int cal_count;
+    long cal_count;
     if (shared_channel)
         cal_count = DimsVectorUtils::Count(output_dim);
     else
         cal_count = DimsVectorUtils::Count(output_dim, 2);
     
     if (shared_channel) {
-#ifdef __AVX2__
-        int tail = cal_count - cal_count % 8;
-        if (has_bias) {     // has bias
-            // register __m256 src, scale, bias;
-            __m256 src, scale, bias;
-            scale = _mm256_broadcast_ss(&scale_data[0]);
-            bias  = _mm256_broadcast_ss(&bias_data[0]);
-            for (size_t i = 0; i < tail; i += 8) {
-                src = _mm256_loadu_ps(input_data + i);
-                src = _mm256_fmadd_ps(src, scale, bias);
-                _mm256_storeu_ps(output_data + i, src);
-            }
-            for (size_t i = tail; i < cal_count; i++) {
-                output_data[i] = input_data[i] * scale_data[0] + bias_data[0];
-            }
-        } else {        // no bias
-            // register __m256 src, scale;
-            __m256 src, scale;
-            scale = _mm256_broadcast_ss(&scale_data[0]);
-            for (size_t i = 0; i < tail; i += 8) {
-                src = _mm256_loadu_ps(input_data + i);
-                src = _mm256_mul_ps(src, scale);
-                _mm256_storeu_ps(output_data + i, src);
-            }
-            for (size_t i = tail; i < cal_count; i++) {
-                output_data[i] = input_data[i] * scale_data[0];
-            }
-        }  
-#else
         const float scale = scale_data[0];
-        float bias = 0.f;
-        if (has_bias) bias = bias_data[0];
-        for (int index = 0; index < cal_count; index++) {
-            if (has_bias)
-                output_data[index] = input_data[index] * scale + bias;
-            else 
-                output_data[index] = input_data[index] * scale;
-        }
-#endif
+        const float bias  = has_bias ? bias_data[0] : 0.f;
+        X86ParallelFor(num_threads, cal_count, 4096, [&](long begin, long end) {
+            fma_kernel(input_data + begin, output_data + begin, scale, bias, has_bias, end - begin);
+        });
     } else {
-#ifdef __AVX2__
-        int tail = cal_count - cal_count % 8;
-        for (int b = 0; b < output_dim[0]; b++) {
-            for (int c = 0; c < channel; c++) {
-                if (has_bias) {
-                    // register __m256 src, scale, bias;
-                    __m256 src, scale, bias;
-                    scale = _mm256_broadcast_ss(&scale_data[c]);
-                    bias  = _mm256_broadcast_ss(&bias_data[c]);
-                    float *input  = input_data + (b * channel + c) * cal_count;
-                    float *output = output_data + (b * channel + c) * cal_count;
-                    for (size_t index = 0; index < tail; index += 8) {
-                        src = _mm256_loadu_ps(input + index);
-                        src = _mm256_fmadd_ps(src, scale, bias);
-                        _mm256_storeu_ps(output + index, src);
-                    }
-                    for (size_t index = tail; index < cal_count; index++)
-                        output[index] = input[index] * scale_data[c] + bias_data[c];
-                } else {
-                    // register __m256 src, scale;
-                    __m256 src, scale;
-                    scale = _mm256_broadcast_ss(&scale_data[c]);
-                    float *input  = input_data + (b * channel + c) * cal_count;
-                    float *output = output_data + (b * channel + c) * cal_count;
-                    for (size_t index = 0; index < tail; index += 8) {
-                        src = _mm256_loadu_ps(input + index);
-                        src = _mm256_mul_ps(src, scale);
-                        _mm256_storeu_ps(output + index, src);
-                    }
-                    for (size_t index = tail; index < cal_count; index++)
-                        output[index] = input[index] * scale_data[c];
-                }
-            }
-        }
-#else
-        for (int b = 0; b < output_dim[0]; b++) {
-            for (int c = 0; c < channel; c++) {
-                float *input  = input_data + (b * channel + c) * cal_count;
-                float *output = output_data + (b * channel + c) * cal_count;
-                const float scale = scale_data[c];
-                float bias = 0.f;
-                if (has_bias) bias = bias_data[c];
-                for (int index = 0; index < cal_count; index++) {
-                    if (has_bias)
-                        output[index] = input[index] * scale + bias;
-                    else
-                        output[index] = input[index] * scale;
-                }
+        // split by planes of batch * channel
+        X86ParallelFor(num_threads, output_dim[0] * channel, UP_DIV(4096, cal_count), [&](long begin, long end) {
+            for (long bc = begin; bc < end; bc++) {
+                int c             = bc % channel;
+                const float bias  = has_bias ? bias_data[c] : 0.f;
+                fma_kernel(input_data + bc * cal_count, output_data + bc * cal_count, scale_data[c], bias, has_bias,
+                           cal_count);
             }
-        }
-#endif
+        });
     }
     return TNN_OK;
 }
@@ -526,10 +475,15 @@ template<> void reduce_postprocess<X86ReduceOpType::kLOGSUM>(float* input, float
 }
 
 template<X86ReduceOpType type>
-void reduce_kernel(float * input, float * output, size_t outer_size, size_t inner_size, size_t reduce_size) 
+void reduce_kernel(float * input, float * output, size_t outer_size, size_t inner_size, size_t reduce_size,
+                   int num_threads)
 {
-    for(size_t outer_idx=0;outer_idx<outer_size;outer_idx++) {
-        for(size_t inner_idx=0;inner_idx<inner_size;inner_idx++) {
+    // every output position is reduced independently, positions are split among threads
+    X86ParallelFor(num_threads, outer_size * inner_size, UP_DIV(4096, reduce_size), [&](long begin, long end) {
+        for (long idx = begin; idx < end; idx++) {
+            size_t outer_idx = idx / inner_size;
+            size_t inner_idx = idx % inner_size;
+            const float *src = input + outer_idx * reduce_size * inner_size + inner_idx;
             float acc = 0;
             if (type == X86ReduceOpType::kMIN) {
                 acc = FLT_MAX;
@@ -537,13 +491,11 @@ void reduce_kernel(float * input, float * output, size_t outer_size, size_t inne
                 acc = -FLT_MAX;
             }
             for(int i=0;i<reduce_size;i++) {
-                acc = reduce_iter_op<type>(acc, input[i * inner_size + inner_idx]);
+                acc = reduce_iter_op<type>(acc, src[i * inner_size]);
             }
-            output[inner_idx] = reduce_final_op<type>(acc, float(reduce_size));
+            output[idx] = reduce_final_op<type>(acc, float(reduce_size));
         }
-        input += reduce_size * inner_size;
-        output += inner_size;
-    }
+    });
 }
 
 using reduce_kernel_ptr_t = decltype(&reduce_kernel<X86ReduceOpType::kMEAN>);
@@ -552,7 +504,8 @@ using reduce_postprocess_ptr_t = decltype(&reduce_postprocess<X86ReduceOpType::k
 
 Status X86_REDUCE_CALCULATE(float *input, float *output, float *workspace,
                             std::vector<std::tuple<int, int, int>> &reduce_dims,
-                            DimsVector input_dim, DimsVector output_dim, X86ReduceOpType op_type)
+                            DimsVector input_dim, DimsVector output_dim, X86ReduceOpType op_type,
+                            int num_threads)
 {
     reduce_kernel_ptr_t reduce_kernel_ptr = nullptr;
     reduce_preprocess_ptr_t reduce_preprocess_ptr = nullptr;
@@ -626,7 +579,7 @@ Status X86_REDUCE_CALCULATE(float *input, float *output, float *workspace,
         auto reduce_count = std::get<1>(reduce_dim);
         auto inner_count  = std::get<2>(reduce_dim);
 
-        reduce_kernel_ptr(ping_buf, pong_buf, outer_count, inner_count, reduce_count);
+        reduce_kernel_ptr(ping_buf, pong_buf, outer_count, inner_count, reduce_count, num_threads);
         if (first) {
             first = 0;
             ping_buf = workspace + input_count;
@@ -649,13 +602,13 @@ Status X86_NORMALIZE_CALCULATE(float *input, float *output, int axis,
 
     float* tmp = (float*)malloc(outer_size * inner_size * sizeof(float));
     if (mode == 2) { // L2
-        reduce_kernel<X86ReduceOpType::kL2>(input, tmp, outer_size, inner_size, reduce_size);
+        reduce_kernel<X86ReduceOpType::kL2>(input, tmp, outer_size, inner_size, reduce_size, 1);
     } else if (mode == 1) { // L1
-        reduce_kernel<X86ReduceOpType::kL1>(input, tmp, outer_size, inner_size, reduce_size);
+        reduce_kernel<X86ReduceOpType::kL1>(input, tmp, outer_size, inner_size, reduce_size, 1);
     } else if (mode == INT_MAX) { // MAX
-        reduce_kernel<X86ReduceOpType::kMAX>(input, tmp, outer_size, inner_size, reduce_size);
+        reduce_kernel<X86ReduceOpType::kMAX>(input, tmp, outer_size, inner_size, reduce_size, 1);
     } else if (mode == INT_MIN) { // MIN
-        reduce_kernel<X86ReduceOpType::kMIN>(input, tmp, outer_size, inner_size, reduce_size);
+        reduce_kernel<X86ReduceOpType::kMIN>(input, tmp, outer_size, inner_size, reduce_size, 1);
     }
 
     for (int o = 0; o < outer_size; o++) {
@@ -672,6 +625,36 @@ Status X86_NORMALIZE_CALCULATE(float *input, float *output, int axis,
     return TNN_OK;
 }
 
+// @brief conv activations, relu and relu6 are clamps, the others need the full value
+template <int activation_type, typename VEC>
+static inline VEC X86ActivateVec(const VEC &v) {
+    if (activation_type == ActivationType_ReLU) {
+        return VEC::max(v, VEC(0.f));
+    } else if (activation_type == ActivationType_ReLU6) {
+        return VEC::min(VEC::max(v, VEC(0.f)), VEC(6.f));
+    } else if (activation_type == ActivationType_SIGMOID_MUL) {
+        return VEC::mul(v, VEC::sigmoid(v));
+    } else if (activation_type == ActivationType_HARDSWISH) {
+        VEC gate = VEC::add(VEC::mul(v, VEC(1.f / 6.f)), VEC(0.5f));
+        return VEC::mul(v, VEC::min(VEC::max(gate, VEC(0.f)), VEC(1.f)));
+    }
+    return v;
+}
+
+template <int activation_type>
+static inline float X86ActivateScalar(float v) {
+    if (activation_type == ActivationType_ReLU) {
+        return std::max(v, 0.f);
+    } else if (activation_type == ActivationType_ReLU6) {
+        return std::min(std::max(v, 0.f), 6.f);
+    } else if (activation_type == ActivationType_SIGMOID_MUL) {
+        return v / (1.f + std::exp(-v));
+    } else if (activation_type == ActivationType_HARDSWISH) {
+        return v * std::min(std::max(v / 6.f + 0.5f, 0.f), 1.f);
+    }
+    return v;
+}
+
 template <int activation_type, typename VEC, int pack>
 void DepthwiseConv(float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
                    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep) {
@@ -717,10 +700,17 @@ void DepthwiseConv(float* dst, const float* src, const float* weight, const floa
                 dst_v[2] = VEC::min(dst_v[2], v_6);
                 dst_v[3] = VEC::min(dst_v[3], v_6);
             }
-            VEC::save(dstY + (dx + 0) * pack, dst_v[0]);
-            VEC::save(dstY + (dx + 1) * pack, dst_v[1]);
-            VEC::save(dstY + (dx + 2) * pack, dst_v[2]);
-            VEC::save(dstY + (dx + 3) * pack, dst_v[3]);
+            if (activation_type == ActivationType_SIGMOID_MUL ||
+                activation_type == ActivationType_HARDSWISH) {
+                dst_v[0] = X86ActivateVec<activation_type>(dst_v[0]);
+                dst_v[1] = X86ActivateVec<activation_type>(dst_v[1]);
+                dst_v[2] = X86ActivateVec<activation_type>(dst_v[2]);
+                dst_v[3] = X86ActivateVec<activation_type>(dst_v[3]);
+            }
+            VEC::saveu(dstY + (dx + 0) * pack, dst_v[0]);
+            VEC::saveu(dstY + (dx + 1) * pack, dst_v[1]);
+            VEC::saveu(dstY + (dx + 2) * pack, dst_v[2]);
+            VEC::saveu(dstY + (dx + 3) * pack, dst_v[3]);
         }
         for (; dx < width; ++dx) {
             VEC dst_v = bias_v;
@@ -742,7 +732,11 @@ void DepthwiseConv(float* dst, const float* src, const float* weight, const floa
             if (activation_type == ActivationType_ReLU6) {
                 dst_v = VEC::min(dst_v, v_6);
             }
-            VEC::save(dstY + dx * pack, dst_v);
+            if (activation_type == ActivationType_SIGMOID_MUL ||
+                activation_type == ActivationType_HARDSWISH) {
+                dst_v = X86ActivateVec<activation_type>(dst_v);
+            }
+            VEC::saveu(dstY + dx * pack, dst_v);
         }
     }
 }
@@ -771,6 +765,22 @@ template void DepthwiseConv<ActivationType_ReLU6, Float8, 8>(
     float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
     long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
 
+template void DepthwiseConv<ActivationType_SIGMOID_MUL, Float4, 4>(
+    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
+    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
+
+template void DepthwiseConv<ActivationType_SIGMOID_MUL, Float8, 8>(
+    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
+    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
+
+template void DepthwiseConv<ActivationType_HARDSWISH, Float4, 4>(
+    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
+    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
+
+template void DepthwiseConv<ActivationType_HARDSWISH, Float8, 8>(
+    float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
+    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
+
 template <int left, int oc_>
 void X86SgemvLeft(float* dst, const float* src, const float* weight, float *bias, size_t batch_stride) {
     float acc[8];
@@ -789,62 +799,131 @@ void X86SgemvLeft(float* dst, const float* src, const float* weight, float *bias
 }
 
 template <typename VEC, int pack>
-void X86Sgemv(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output) {
+void X86Sgemv(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output,
+              int num_threads) {
     size_t batch_stride = dims_input[3] * dims_input[2] * dims_input[1];
-    for (int b = 0; b < dims_output[0]; ++b) {
-        const float *src_batch = src + b * batch_stride;
-        float *dst_batch = dst + b * dims_output[1];
+    const long oc_blocks = UP_DIV(dims_output[1], pack);
+    // blocks of pack outputs of every batch are split among threads
+    X86ParallelFor(num_threads, dims_output[0] * oc_blocks, UP_DIV(4096, MAX(batch_stride, 1)), [&](long begin, long end) {
+        for (long i = begin; i < end; i++) {
+            const int b = i / oc_blocks;
+            const int oc = (i % oc_blocks) * pack;
+            const float *src_batch = src + b * batch_stride;
+            float *dst_batch = dst + b * dims_output[1];
+
+            if (oc + pack - 1 < dims_output[1]) {
+                auto weight_oc = weight + oc * batch_stride;
+                VEC acc = VEC::loadu(bias + oc);
+                size_t ic = 0;
+                for (; ic + 3 < batch_stride; ic += 4) {
+                    auto weight_ic   = weight_oc + ic * pack;
+                    VEC src_v0    = VEC(src_batch[ic]);
+                    VEC src_v1    = VEC(src_batch[ic + 1]);
+                    VEC src_v2    = VEC(src_batch[ic + 2]);
+                    VEC src_v3    = VEC(src_batch[ic + 3]);
+                    VEC weight_v0 = VEC::load(weight_ic);
+                    VEC weight_v1 = VEC::load(weight_ic + pack * 1);
+                    VEC weight_v2 = VEC::load(weight_ic + pack * 2);
+                    VEC weight_v3 = VEC::load(weight_ic + pack * 3);
+                    VEC::mla(acc, weight_v0, src_v0);
+                    VEC::mla(acc, weight_v1, src_v1);
+                    VEC::mla(acc, weight_v2, src_v2);
+                    VEC::mla(acc, weight_v3, src_v3);
+                }
+                for (; ic < batch_stride; ic++) {
+                    VEC src_v    = VEC(src_batch[ic]);
+                    VEC weight_v = VEC::load(weight_oc + ic * pack);
+                    VEC::mla(acc, weight_v, src_v);
+                }
+                VEC::saveu(dst_batch + oc, acc);
+                continue;
+            }
 
-        int oc = 0;
-        for (; oc + pack - 1 < dims_output[1]; oc += pack) {
+            int left = dims_output[1] - oc;
+            if (pack == 8) {
+                if (left == 7) {
+                    X86SgemvLeft<7, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+                } else if (left == 6) {
+                    X86SgemvLeft<6, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+                } else if (left == 5) {
+                    X86SgemvLeft<5, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+                } else if (left == 4) {
+                    X86SgemvLeft<4, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+                }
+            }
+            if (left == 3) {
+                X86SgemvLeft<3, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+            } else if (left == 2) {
+                X86SgemvLeft<2, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+            } else if (left == 1) {
+                X86SgemvLeft<1, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+            }
+        }
+    });
+}
+template void X86Sgemv<Float4, 4>(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output,
+                                  int num_threads);
+template void X86Sgemv<Float8, 8>(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output,
+                                  int num_threads);
+
+#ifdef __AVX2__
+template <DataType weight_type>
+static inline __m256 X86LoadLowp8(const uint16_t* ptr) {
+    __m128i v = _mm_loadu_si128((const __m128i*)ptr);
+    if (weight_type == DATA_TYPE_HALF) {
+        return _mm256_cvtph_ps(v);
+    }
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(v), 16));
+}
+
+template <DataType weight_type>
+static void X86SgemvLowpImpl(float* dst, const float* src, const uint16_t* weight, float *bias, DimsVector dims_input,
+                             DimsVector dims_output, int num_threads) {
+    size_t batch_stride = dims_input[3] * dims_input[2] * dims_input[1];
+    const long oc_blocks = UP_DIV(dims_output[1], 8);
+    X86ParallelFor(num_threads, dims_output[0] * oc_blocks, UP_DIV(4096, MAX(batch_stride, 1)), [&](long begin, long end) {
+        for (long i = begin; i < end; i++) {
+            const int b = i / oc_blocks;
+            const int oc = (i % oc_blocks) * 8;
+            const float *src_batch = src + b * batch_stride;
+            float *dst_batch = dst + b * dims_output[1];
             auto weight_oc = weight + oc * batch_stride;
-            VEC acc = VEC::loadu(bias + oc);
+            const int left = MIN(dims_output[1] - oc, 8);
+
+            // the packed weights of the last block are padded to 8 channels
+            __m256 acc0 = _mm256_setzero_ps();
+            __m256 acc1 = _mm256_setzero_ps();
             size_t ic = 0;
             for (; ic + 3 < batch_stride; ic += 4) {
-                auto weight_ic   = weight_oc + ic * pack;
-                VEC src_v0    = VEC(src_batch[ic]);
-                VEC src_v1    = VEC(src_batch[ic + 1]);
-                VEC src_v2    = VEC(src_batch[ic + 2]);
-                VEC src_v3    = VEC(src_batch[ic + 3]);
-                VEC weight_v0 = VEC::load(weight_ic);
-                VEC weight_v1 = VEC::load(weight_ic + pack * 1);
-                VEC weight_v2 = VEC::load(weight_ic + pack * 2);
-                VEC weight_v3 = VEC::load(weight_ic + pack * 3);
-                VEC::mla(acc, weight_v0, src_v0);
-                VEC::mla(acc, weight_v1, src_v1);
-                VEC::mla(acc, weight_v2, src_v2);
-                VEC::mla(acc, weight_v3, src_v3);
+                auto weight_ic = weight_oc + ic * 8;
+                acc0 = _mm256_fmadd_ps(X86LoadLowp8<weight_type>(weight_ic), _mm256_set1_ps(src_batch[ic]), acc0);
+                acc1 = _mm256_fmadd_ps(X86LoadLowp8<weight_type>(weight_ic + 8), _mm256_set1_ps(src_batch[ic + 1]), acc1);
+                acc0 = _mm256_fmadd_ps(X86LoadLowp8<weight_type>(weight_ic + 16), _mm256_set1_ps(src_batch[ic + 2]), acc0);
+                acc1 = _mm256_fmadd_ps(X86LoadLowp8<weight_type>(weight_ic + 24), _mm256_set1_ps(src_batch[ic + 3]), acc1);
             }
             for (; ic < batch_stride; ic++) {
-                VEC src_v    = VEC(src_batch[ic]);
-                VEC weight_v = VEC::load(weight_oc + ic * pack);
-                VEC::mla(acc, weight_v, src_v);
+                acc0 = _mm256_fmadd_ps(X86LoadLowp8<weight_type>(weight_oc + ic * 8), _mm256_set1_ps(src_batch[ic]), acc0);
             }
-            VEC::saveu(dst_batch + oc, acc);
-        }
-        int left = dims_output[1] - oc;
-        if (pack == 8) {
-            if (left == 7) {
-                X86SgemvLeft<7, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-            } else if (left == 6) {
-                X86SgemvLeft<6, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-            } else if (left == 5) {
-                X86SgemvLeft<5, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-            } else if (left == 4) {
-                X86SgemvLeft<4, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
+            float acc[8];
+            _mm256_storeu_ps(acc, _mm256_add_ps(acc0, acc1));
+            for (int c = 0; c < left; c++) {
+                dst_batch[oc + c] = acc[c] + bias[oc + c];
             }
         }
-        if (left == 3) {
-            X86SgemvLeft<3, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-        } else if (left == 2) {
-            X86SgemvLeft<2, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-        } else if (left == 1) {
-            X86SgemvLeft<1, pack>(dst_batch + oc, src_batch, weight + oc * batch_stride, bias + oc, batch_stride);
-        }
+    });
+}
+#endif
+
+void X86SgemvLowp(float* dst, const float* src, const uint16_t* weight, DataType weight_type, float *bias,
+                  DimsVector dims_input, DimsVector dims_output, int num_threads) {
+#ifdef __AVX2__
+    if (weight_type == DATA_TYPE_HALF) {
+        X86SgemvLowpImpl<DATA_TYPE_HALF>(dst, src, weight, bias, dims_input, dims_output, num_threads);
+    } else {
+        X86SgemvLowpImpl<DATA_TYPE_BFP16>(dst, src, weight, bias, dims_input, dims_output, num_threads);
     }
+#endif
 }
-template void X86Sgemv<Float4, 4>(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output);
-template void X86Sgemv<Float8, 8>(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output);
 
 template <int activation_type, typename VEC, int pack>
 void X86_Post_Exec(float *dst, const float *bias, long channel, long area) {
@@ -865,6 +944,10 @@ void X86_Post_Exec(float *dst, const float *bias, long channel, long area) {
             if (activation_type == ActivationType_ReLU6) {
                 dst_v = VEC::min(dst_v, six_v);
             }
+            if (activation_type == ActivationType_SIGMOID_MUL ||
+                activation_type == ActivationType_HARDSWISH) {
+                dst_v = X86ActivateVec<activation_type>(dst_v);
+            }
             VEC::saveu(dst_c + i, dst_v);
         }
 
@@ -877,6 +960,10 @@ void X86_Post_Exec(float *dst, const float *bias, long channel, long area) {
             if (activation_type == ActivationType_ReLU6) {
                 dst_value = std::min(dst_value, 6.f);
             }
+            if (activation_type == ActivationType_SIGMOID_MUL ||
+                activation_type == ActivationType_HARDSWISH) {
+                dst_value = X86ActivateScalar<activation_type>(dst_value);
+            }
             dst_c[i] = dst_value;
         }
     }
@@ -887,7 +974,156 @@ template void X86_Post_Exec<ActivationType_ReLU6, Float4, 4>(float *dst, const f
 template void X86_Post_Exec<ActivationType_None, Float8, 8>(float *dst, const float *bias, long channel, long area);
 template void X86_Post_Exec<ActivationType_ReLU, Float8, 8>(float *dst, const float *bias, long channel, long area);
 template void X86_Post_Exec<ActivationType_ReLU6, Float8, 8>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_SIGMOID_MUL, Float4, 4>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_HARDSWISH, Float4, 4>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_SIGMOID_MUL, Float8, 8>(float *dst, const float *bias, long channel, long area);
+template void X86_Post_Exec<ActivationType_HARDSWISH, Float8, 8>(float *dst, const float *bias, long channel, long area);
+
+template <int activation_type, typename VEC, int pack>
+void X86_Post_Tile(float *dst, long ld, long m, long n, const float *add) {
+    for (long j = 0; j < n; j++) {
+        auto dst_j = dst + j * ld;
+        auto add_j = add ? add + j * ld : nullptr;
+        long i = 0;
+        for (; i + pack - 1 < m; i += pack) {
+            VEC dst_v = X86ActivateVec<activation_type>(VEC::loadu(dst_j + i));
+            if (add_j) {
+                dst_v = VEC::add(dst_v, VEC::loadu(add_j + i));
+            }
+            VEC::saveu(dst_j + i, dst_v);
+        }
 
-//ActivationType_SIGMOID_MUL TBD
+        for (; i < m; i++) {
+            float dst_value = X86ActivateScalar<activation_type>(dst_j[i]);
+            if (add_j) {
+                dst_value += add_j[i];
+            }
+            dst_j[i] = dst_value;
+        }
+    }
+}
+template void X86_Post_Tile<ActivationType_ReLU, Float4, 4>(float *dst, long ld, long m, long n, const float *add);
+template void X86_Post_Tile<ActivationType_ReLU6, Float4, 4>(float *dst, long ld, long m, long n, const float *add);
+template void X86_Post_Tile<ActivationType_ReLU, Float8, 8>(float *dst, long ld, long m, long n, const float *add);
+template void X86_Post_Tile<ActivationType_ReLU6, Float8, 8>(float *dst, long ld, long m, long n, const float *add);
+template void X86_Post_Tile<ActivationType_SIGMOID_MUL, Float4, 4>(float *dst, long ld, long m, long n, const float *add);
+template void X86_Post_Tile<ActivationType_HARDSWISH, Float4, 4>(float *dst, long ld, long m, long n, const float *add);
+template void X86_Post_Tile<ActivationType_SIGMOID_MUL, Float8, 8>(float *dst, long ld, long m, long n, const float *add);
+template void X86_Post_Tile<ActivationType_HARDSWISH, Float8, 8>(float *dst, long ld, long m, long n, const float *add);
+
+#define COMPUTE_UNIT(c)                                                                                                \
+    wgt  = VEC::loadu(weight_z + c * N);                                                                               \
+    data = VEC(src_z + K * 0 + c);                                                                                     \
+    VEC::mla(acc0, data, wgt);                                                                                         \
+    data = VEC(src_z + K * 1 + c);                                                                                     \
+    VEC::mla(acc1, data, wgt);                                                                                         \
+    data = VEC(src_z + K * 2 + c);                                                                                     \
+    VEC::mla(acc2, data, wgt);                                                                                         \
+    data = VEC(src_z + K * 3 + c);                                                                                     \
+    VEC::mla(acc3, data, wgt);                                                                                         \
+    data = VEC(src_z + K * 4 + c);                                                                                     \
+    VEC::mla(acc4, data, wgt);                                                                                         \
+    data = VEC(src_z + K * 5 + c);                                                                                     \
+    VEC::mla(acc5, data, wgt);
+
+#define COMPUTE_VEC(c)                                                                                                 \
+    data = VEC(src_z + c);                                                                                             \
+    wgt  = VEC::loadu(weight_z + c * N);                                                                               \
+    VEC::mla(acc, data, wgt);
+
+// A=6x8, B=8x8, C=6x8
+template <typename VEC, int M, int K, int N>
+void X86WinogradGemm(float *dst, const float *src, const float *weight, const float *bias, int ic_8, int oc_8,
+                     int width) {
+    auto w_unit         = width / M;
+    auto w_unit_end     = M * w_unit;
+    auto src_depth_step = width * K;
+
+    const int weight_unit_step = K * N;
+
+    for (int co = 0; co < oc_8; co++) {
+        auto dst_z     = dst + co * N * width;
+        auto weight_dz = weight + co * ic_8 * weight_unit_step;
+
+        for (int dx = 0; dx < w_unit; dx++) {
+            auto dst_x = dst_z + dx * N * M;
+            auto src_x = src + dx * K * M;
+
+            VEC acc0 = (bias) ? VEC::loadu(bias) : VEC(0.0f);
+            VEC acc1 = acc0;
+            VEC acc2 = acc0;
+            VEC acc3 = acc0;
+            VEC acc4 = acc0;
+            VEC acc5 = acc0;
+            VEC data;
+            VEC wgt;
+
+            for (int ci = 0; ci < ic_8; ci++) {
+                auto src_z    = src_x + ci * src_depth_step;
+                auto weight_z = weight_dz + ci * weight_unit_step;
+                if (K == 8) {
+                    COMPUTE_UNIT(0);
+                    COMPUTE_UNIT(1);
+                    COMPUTE_UNIT(2);
+                    COMPUTE_UNIT(3);
+                    COMPUTE_UNIT(4);
+                    COMPUTE_UNIT(5);
+                    COMPUTE_UNIT(6);
+                    COMPUTE_UNIT(7);
+                } else if (K == 4) {
+                    COMPUTE_UNIT(0);
+                    COMPUTE_UNIT(1);
+                    COMPUTE_UNIT(2);
+                    COMPUTE_UNIT(3);
+                }
+            }
+
+            VEC::saveu(dst_x + N * 0, acc0);
+            VEC::saveu(dst_x + N * 1, acc1);
+            VEC::saveu(dst_x + N * 2, acc2);
+            VEC::saveu(dst_x + N * 3, acc3);
+            VEC::saveu(dst_x + N * 4, acc4);
+            VEC::saveu(dst_x + N * 5, acc5);
+        }
+
+        for (int dx = w_unit_end; dx < width; dx++) {
+            auto dst_x = dst_z + dx * N;
+            auto src_x = src + dx * K;
+
+            VEC acc = (bias) ? VEC::loadu(bias) : VEC(0.0f);
+            VEC data;
+            VEC wgt;
+
+            for (int ci = 0; ci < ic_8; ci++) {
+                auto src_z    = src_x + ci * src_depth_step;
+                auto weight_z = weight_dz + ci * weight_unit_step;
+
+                if (K == 8) {
+                    COMPUTE_VEC(0);
+                    COMPUTE_VEC(1);
+                    COMPUTE_VEC(2);
+                    COMPUTE_VEC(3);
+                    COMPUTE_VEC(4);
+                    COMPUTE_VEC(5);
+                    COMPUTE_VEC(6);
+                    COMPUTE_VEC(7);
+                } else if (K == 4) {
+                    COMPUTE_VEC(0);
+                    COMPUTE_VEC(1);
+                    COMPUTE_VEC(2);
+                    COMPUTE_VEC(3);
+                }
+            }
+
+            VEC::saveu(dst_x, acc);
+        }
+    }
+}
+template void X86WinogradGemm<Float4, 6, 4, 4>(float *dst, const float *src, const float *weight, const float *bias,
+                                               int ic_8, int oc_8, int width);
+template void X86WinogradGemm<Float8, 6, 8, 8>(float *dst, const float *src, const float *weight, const float *bias,
+                                               int ic_8, int oc_8, int width);
+#undef COMPUTE_UNIT
+#undef COMPUTE_VEC
 
 }
\ No newline at end of file
@@ -44,11 +44,12 @@ Status X86_AVERAGE_POOLING(float *input, float *output, DimsVector input_dim, Di
                            int stride_h, int stride_w, int kernel_h, int kernel_w, int pad_h, int pad_w);
 
 Status X86_FMA(float *input, float *output, float *scale, float *bias,
-               bool shared_channel, bool has_bias, DimsVector output_dim);
+               bool shared_channel, bool has_bias, DimsVector output_dim, int num_threads = 1);
 
 Status X86_REDUCE_CALCULATE(float *input, float *output, float *workspace,
                             std::vector<std::tuple<int, int, int>> &reduce_dims,
-                            DimsVector input_dim, DimsVector output_dim, X86ReduceOpType op_type);
+                            DimsVector input_dim, DimsVector output_dim, X86ReduceOpType op_type,
+                            int num_threads = 1);
 
 template <class T, int pack_c>
 void X86MaxPooling(const float* src, long iw, long ih, float* dst, long ow, long oh, long kw, long kh, long stride_w,
@@ -63,10 +64,26 @@ void DepthwiseConv(float* dst, const float* src, const float* weight, const floa
                    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
 
 template <typename VEC, int pack>
-void X86Sgemv(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output);
+void X86Sgemv(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output,
+              int num_threads = 1);
+
+// @brief X86Sgemv<Float8, 8> on fp16 or bf16 weights packed by PackC8, the weights are widened in the kernel. avx2 only
+void X86SgemvLowp(float* dst, const float* src, const uint16_t* weight, DataType weight_type, float *bias,
+                  DimsVector dims_input, DimsVector dims_output, int num_threads);
 
 template <int activation_type, typename VEC, int pack>
 void X86_Post_Exec(float *dst, const float *bias, long channel, long area);
+
+// @brief activation on a column major m x n tile with leading dimension ld, add shares the layout of dst
+// and is accumulated after the activation when not null. used by the conv sgemm epilogue for the
+// activations which do not fit in the registers of the jit kernels, and after the inner product sgemv
+template <int activation_type, typename VEC, int pack>
+void X86_Post_Tile(float *dst, long ld, long m, long n, const float *add);
+
+// @brief winograd tile gemm, dst[oc_pack][width][N] = src[ic_pack][width][K] * weight[oc_pack][ic_pack][K][N]
+template <typename VEC, int M, int K, int N>
+void X86WinogradGemm(float *dst, const float *src, const float *weight, const float *bias, int ic_8, int oc_8,
+                     int width);
 }   // namespace TNN_NS
 
 #endif
@@ -0,0 +1,408 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+
+#include <immintrin.h>
+#include <string.h>
+#include <algorithm>
+
+#include "tnn/device/x86/acc/compute/jit/igemm_driver.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/naive_compute.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// same as float2int8, round half away from zero then saturate
+static inline void Float2Int8x8(int8_t *dst, __m256 v) {
+    const __m256 v_half = _mm256_set1_ps(0.5f);
+    const __m256 v_sign = _mm256_set1_ps(-0.0f);
+    v           = _mm256_add_ps(v, _mm256_or_ps(_mm256_and_ps(v, v_sign), v_half));
+    v           = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-128.0f)), _mm256_set1_ps(127.0f));
+    __m256i vi  = _mm256_cvttps_epi32(v);
+    __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(vi), _mm256_extracti128_si256(vi, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packs_epi16(v16, v16));
+}
+
+static inline __m256 Int8x8ToFloat(const int8_t *src) {
+    __m128i v8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src));
+    return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(v8));
+}
+
+void X86Int8Quant(int8_t *dst, const float *src, const float *scale, int scale_len, DimsVector dims) {
+    int batch   = dims[0];
+    int channel = dims[1];
+    long count  = DimsVectorUtils::Count(dims, 2);
+    for (int n = 0; n < batch; n++) {
+        OMP_PARALLEL_FOR_
+        for (int c = 0; c < channel; c++) {
+            long offset    = (n * channel + c) * count;
+            float scale_c  = scale[scale_len == 1 ? 0 : c];
+            auto src_c     = src + offset;
+            auto dst_c     = dst + offset;
+            if (scale_c == 0) {
+                memset(dst_c, 0, count);
+                continue;
+            }
+            float inv_scale   = 1.0f / scale_c;
+            __m256 v_inv      = _mm256_set1_ps(inv_scale);
+            long i = 0;
+            for (; i + 7 < count; i += 8) {
+                Float2Int8x8(dst_c + i, _mm256_mul_ps(_mm256_loadu_ps(src_c + i), v_inv));
+            }
+            for (; i < count; i++) {
+                dst_c[i] = float2int8(src_c[i] * inv_scale);
+            }
+        }
+    }
+}
+
+void X86Int8Dequant(float *dst, const int8_t *src, const float *scale, int scale_len, DimsVector dims) {
+    int batch   = dims[0];
+    int channel = dims[1];
+    long count  = DimsVectorUtils::Count(dims, 2);
+    for (int n = 0; n < batch; n++) {
+        OMP_PARALLEL_FOR_
+        for (int c = 0; c < channel; c++) {
+            long offset   = (n * channel + c) * count;
+            float scale_c = scale[scale_len == 1 ? 0 : c];
+            auto src_c    = src + offset;
+            auto dst_c    = dst + offset;
+            __m256 v_scale = _mm256_set1_ps(scale_c);
+            long i = 0;
+            for (; i + 7 < count; i += 8) {
+                _mm256_storeu_ps(dst_c + i, _mm256_mul_ps(Int8x8ToFloat(src_c + i), v_scale));
+            }
+            for (; i < count; i++) {
+                dst_c[i] = scale_c * static_cast<float>(src_c[i]);
+            }
+        }
+    }
+}
+
+void X86Int8Add(int8_t *dst, const std::vector<int8_t *> &srcs, const std::vector<float *> &scales, int scale_len,
+                const float *dst_scale, DimsVector dims) {
+    int batch   = dims[0];
+    int channel = dims[1];
+    long count  = DimsVectorUtils::Count(dims, 2);
+    int inputs  = static_cast<int>(srcs.size());
+    for (int n = 0; n < batch; n++) {
+        OMP_PARALLEL_FOR_
+        for (int c = 0; c < channel; c++) {
+            long offset   = (n * channel + c) * count;
+            int scale_idx = scale_len == 1 ? 0 : c;
+            float out_inv = dst_scale[scale_idx] != 0 ? 1.0f / dst_scale[scale_idx] : 0.f;
+            long i = 0;
+            for (; i + 7 < count; i += 8) {
+                __m256 acc = _mm256_setzero_ps();
+                for (int inid = 0; inid < inputs; inid++) {
+                    acc = _mm256_fmadd_ps(Int8x8ToFloat(srcs[inid] + offset + i),
+                                          _mm256_set1_ps(scales[inid][scale_idx]), acc);
+                }
+                Float2Int8x8(dst + offset + i, _mm256_mul_ps(acc, _mm256_set1_ps(out_inv)));
+            }
+            for (; i < count; i++) {
+                float acc = 0;
+                for (int inid = 0; inid < inputs; inid++) {
+                    acc += scales[inid][scale_idx] * static_cast<float>(srcs[inid][offset + i]);
+                }
+                dst[offset + i] = float2int8(acc * out_inv);
+            }
+        }
+    }
+}
+
+void X86Int8Requant(int8_t *dst, const int8_t *src, float src_scale, float dst_scale, size_t count) {
+    float scale    = dst_scale != 0 ? src_scale / dst_scale : 0.f;
+    __m256 v_scale = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 7 < count; i += 8) {
+        Float2Int8x8(dst + i, _mm256_mul_ps(Int8x8ToFloat(src + i), v_scale));
+    }
+    for (; i < count; i++) {
+        dst[i] = float2int8(src[i] * scale);
+    }
+}
+
+void X86Int8PackC16(int8_t *dst, const int8_t *src, size_t hw, size_t src_hw_stride, size_t channel) {
+    for (size_t cur_hw = 0; cur_hw < hw; cur_hw++) {
+        auto dst_hw = dst + cur_hw * 16;
+        size_t ci = 0;
+        for (; ci < channel; ci++) {
+            dst_hw[ci] = src[ci * src_hw_stride + cur_hw];
+        }
+        for (; ci < 16; ci++) {
+            dst_hw[ci] = 0;
+        }
+    }
+}
+
+void X86Int8UnpackC16(int8_t *dst, const int8_t *src, size_t hw, size_t dst_hw_stride, size_t channel) {
+    for (size_t ci = 0; ci < channel; ci++) {
+        auto dst_c = dst + ci * dst_hw_stride;
+        for (size_t cur_hw = 0; cur_hw < hw; cur_hw++) {
+            dst_c[cur_hw] = src[cur_hw * 16 + ci];
+        }
+    }
+}
+
+void X86Int8MaxPoolingC16(const int8_t *src, long iw, long ih, int8_t *dst, long ow, long oh, long kw, long kh,
+                          long stride_w, long stride_h, long pad_w, long pad_h) {
+    OMP_PARALLEL_FOR_
+    for (long oy = 0; oy < oh; oy++) {
+        long hstart = std::max(oy * stride_h - pad_h, 0L);
+        long hend   = std::min(oy * stride_h - pad_h + kh, ih);
+        for (long ox = 0; ox < ow; ox++) {
+            long wstart = std::max(ox * stride_w - pad_w, 0L);
+            long wend   = std::min(ox * stride_w - pad_w + kw, iw);
+            // -INT8_MAX as the naive int8 pooling, an empty window gives zero
+            __m128i v_max = _mm_set1_epi8(-INT8_MAX);
+            if (hend <= hstart || wend <= wstart) {
+                v_max = _mm_setzero_si128();
+            }
+            for (long iy = hstart; iy < hend; iy++) {
+                auto src_y = src + (iy * iw) * 16;
+                for (long ix = wstart; ix < wend; ix++) {
+                    v_max = _mm_max_epi8(v_max, _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_y + ix * 16)));
+                }
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + (oy * ow + ox) * 16), v_max);
+        }
+    }
+}
+
+void X86Int8AvgPoolingC16(const int8_t *src, long iw, long ih, int8_t *dst, long ow, long oh, long kw, long kh,
+                          long stride_w, long stride_h, long pad_w, long pad_h) {
+    OMP_PARALLEL_FOR_
+    for (long oy = 0; oy < oh; oy++) {
+        long hstart = std::max(oy * stride_h - pad_h, 0L);
+        long hend   = std::min(oy * stride_h - pad_h + kh, ih);
+        for (long ox = 0; ox < ow; ox++) {
+            long wstart = std::max(ox * stride_w - pad_w, 0L);
+            long wend   = std::min(ox * stride_w - pad_w + kw, iw);
+            long kernel_count = (hend - hstart) * (wend - wstart);
+            auto dst_ptr      = dst + (oy * ow + ox) * 16;
+            if (kernel_count <= 0) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_ptr), _mm_setzero_si128());
+                continue;
+            }
+            __m256i v_sum0 = _mm256_setzero_si256();
+            __m256i v_sum1 = _mm256_setzero_si256();
+            for (long iy = hstart; iy < hend; iy++) {
+                auto src_y = src + (iy * iw) * 16;
+                for (long ix = wstart; ix < wend; ix++) {
+                    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_y + ix * 16));
+                    v_sum0    = _mm256_add_epi32(v_sum0, _mm256_cvtepi8_epi32(v));
+                    v_sum1    = _mm256_add_epi32(v_sum1, _mm256_cvtepi8_epi32(_mm_srli_si128(v, 8)));
+                }
+            }
+            // the int32 sums are exact in float, truncate as the integer division of the naive pooling
+            __m256 v_count = _mm256_set1_ps(static_cast<float>(kernel_count));
+            __m256i v_avg0 = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(v_sum0), v_count));
+            __m256i v_avg1 = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(v_sum1), v_count));
+            __m128i v16_0  = _mm_packs_epi32(_mm256_castsi256_si128(v_avg0), _mm256_extracti128_si256(v_avg0, 1));
+            __m128i v16_1  = _mm_packs_epi32(_mm256_castsi256_si128(v_avg1), _mm256_extracti128_si256(v_avg1, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_ptr), _mm_packs_epi16(v16_0, v16_1));
+        }
+    }
+}
+
+size_t X86Int8PackASize(int M, int K) {
+    return ROUND_UP(M, 16) * ROUND_UP(K, 4) * sizeof(uint8_t);
+}
+
+size_t X86Int8PackBSize(int N, int K) {
+    return ROUND_UP(N, 6) * ROUND_UP(K, 4) * sizeof(int8_t);
+}
+
+static inline uint8_t *PackAPosition(uint8_t *dst, int K4, int m, int k) {
+    return dst + ((m >> 4) * K4 << 6) + ((k >> 2) << 6) + ((m & 15) << 2) + (k & 3);
+}
+
+void X86Int8PackA(uint8_t *dst, const int8_t *src, int M, int K, int lda) {
+    int K4 = UP_DIV(K, 4);
+    if (M % 16 || K % 4) {
+        memset(dst, 0x80, X86Int8PackASize(M, K));
+    }
+    for (int m = 0; m < M; m++) {
+        auto src_m = src + m * lda;
+        for (int k = 0; k < K; k++) {
+            *PackAPosition(dst, K4, m, k) = static_cast<uint8_t>(src_m[k]) ^ 0x80;
+        }
+    }
+}
+
+void X86Int8Im2ColPackA(uint8_t *dst, const int8_t *src, int channel, int height, int width, int kernel_h,
+                        int kernel_w, int pad_t, int pad_l, int stride_h, int stride_w, int dilation_h,
+                        int dilation_w, int out_height, int out_width) {
+    int M  = out_height * out_width;
+    int K  = channel * kernel_h * kernel_w;
+    int K4 = UP_DIV(K, 4);
+    if (M % 16 || K % 4) {
+        memset(dst, 0x80, X86Int8PackASize(M, K));
+    }
+
+    OMP_PARALLEL_FOR_
+    for (int k = 0; k < K; k++) {
+        int kx    = k % kernel_w;
+        int ky    = (k / kernel_w) % kernel_h;
+        int c     = k / (kernel_w * kernel_h);
+        auto src_c = src + c * height * width;
+        for (int oy = 0; oy < out_height; oy++) {
+            int iy = oy * stride_h - pad_t + ky * dilation_h;
+            int m  = oy * out_width;
+            if (iy < 0 || iy >= height) {
+                // zero point of the offset data
+                for (int ox = 0; ox < out_width; ox++, m++) {
+                    *PackAPosition(dst, K4, m, k) = 0x80;
+                }
+                continue;
+            }
+            auto src_y = src_c + iy * width;
+            for (int ox = 0; ox < out_width; ox++, m++) {
+                int ix = ox * stride_w - pad_l + kx * dilation_w;
+                uint8_t val = (ix < 0 || ix >= width) ? 0x80 : (static_cast<uint8_t>(src_y[ix]) ^ 0x80);
+                *PackAPosition(dst, K4, m, k) = val;
+            }
+        }
+    }
+}
+
+void X86Int8PackB(int8_t *dst, const int8_t *src, int N, int K, int ldb, int32_t *sum) {
+    int K4 = UP_DIV(K, 4);
+    memset(dst, 0, X86Int8PackBSize(N, K));
+    for (int n = 0; n < N; n++) {
+        auto src_n  = src + n * ldb;
+        auto dst_n  = dst + (n / 6) * K4 * 24 + (n % 6) * 4;
+        int32_t acc = 0;
+        for (int k = 0; k < K; k++) {
+            dst_n[(k >> 2) * 24 + (k & 3)] = src_n[k];
+            acc += src_n[k];
+        }
+        if (sum) {
+            sum[n] = acc;
+        }
+    }
+}
+
+/*
+ * vpmaddubsw saturates the pair sums of u8 * s8 to int16, so the bytes are widened
+ * to int16 first and multiplied with vpmaddwd, the results are exact as vpdpbusd.
+ */
+static void X86Int8GemmAvx2(int M, int N, int K4, const uint8_t *a, const int8_t *b, int32_t *c, int ldc) {
+    const __m256i v_mask = _mm256_set1_epi16(0x00ff);
+    int M8 = UP_DIV(M, 8);
+    OMP_PARALLEL_FOR_
+    for (int mi = 0; mi < M8; mi++) {
+        int m      = mi * 8;
+        auto a_m   = a + (m >> 4) * K4 * 64 + (m & 15) * 4;
+        for (int n = 0; n < N; n += 6) {
+            auto b_n = b + (n / 6) * K4 * 24;
+            __m256i v_acc[6];
+            for (int i = 0; i < 6; i++) {
+                v_acc[i] = _mm256_setzero_si256();
+            }
+            for (int k4 = 0; k4 < K4; k4++) {
+                __m256i v_a    = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a_m + k4 * 64));
+                __m256i v_a_lo = _mm256_and_si256(v_a, v_mask);
+                __m256i v_a_hi = _mm256_srli_epi16(v_a, 8);
+                auto b_k       = reinterpret_cast<const int32_t *>(b_n + k4 * 24);
+                for (int i = 0; i < 6; i++) {
+                    __m256i v_b    = _mm256_set1_epi32(b_k[i]);
+                    __m256i v_b_lo = _mm256_srai_epi16(_mm256_slli_epi16(v_b, 8), 8);
+                    __m256i v_b_hi = _mm256_srai_epi16(v_b, 8);
+                    v_acc[i]       = _mm256_add_epi32(v_acc[i], _mm256_madd_epi16(v_a_lo, v_b_lo));
+                    v_acc[i]       = _mm256_add_epi32(v_acc[i], _mm256_madd_epi16(v_a_hi, v_b_hi));
+                }
+            }
+            for (int i = 0; i < 6; i++) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(c + (n + i) * ldc + m), v_acc[i]);
+            }
+        }
+    }
+}
+
+void X86Int8Gemm(int M, int N, int K, const uint8_t *a, const int8_t *b, int32_t *c, int ldc) {
+    static bool use_vnni = igemm_avx512_vnni_available();
+    int M16 = ROUND_UP(M, 16);
+    int N6  = ROUND_UP(N, 6);
+    int K4  = UP_DIV(K, 4);
+    if (use_vnni) {
+        igemm_avx512_vnni(M16, N6, K4, a, b, c, ldc);
+    } else {
+        X86Int8GemmAvx2(M16, N6, K4, a, b, c, ldc);
+    }
+}
+
+void X86Int8ConvRequant(int8_t *dst, const int32_t *src, long len, int32_t bias, float scale, int activation_type,
+                        int fusion_type, const int8_t *add_input, float add_scale) {
+    bool relu      = activation_type == ActivationType_ReLU;
+    bool add_first = fusion_type == FusionType_Conv_Add_Activation;
+    bool add_last  = fusion_type == FusionType_Conv_Activation_Add;
+
+    __m256i v_bias      = _mm256_set1_epi32(bias);
+    __m256 v_scale      = _mm256_set1_ps(scale);
+    __m256 v_add_scale  = _mm256_set1_ps(add_scale);
+    __m256 v_zero       = _mm256_setzero_ps();
+    long i = 0;
+    for (; i + 7 < len; i += 8) {
+        __m256i v_acc = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)), v_bias);
+        __m256 v_val  = _mm256_mul_ps(_mm256_cvtepi32_ps(v_acc), v_scale);
+        if (add_first) {
+            v_val = _mm256_add_ps(v_val, _mm256_mul_ps(Int8x8ToFloat(add_input + i), v_add_scale));
+        }
+        if (relu) {
+            v_val = _mm256_max_ps(v_val, v_zero);
+        }
+        if (add_last) {
+            v_val = _mm256_add_ps(v_val, _mm256_mul_ps(Int8x8ToFloat(add_input + i), v_add_scale));
+        }
+        Float2Int8x8(dst + i, v_val);
+    }
+    for (; i < len; i++) {
+        float val = (src[i] + bias) * scale;
+        if (add_first) {
+            val += add_input[i] * add_scale;
+        }
+        if (relu) {
+            val = std::max(0.0f, val);
+        }
+        if (add_last) {
+            val += add_input[i] * add_scale;
+        }
+        dst[i] = float2int8(val);
+    }
+}
+
+void X86Int8RequantPerChannel(int8_t *dst, const int32_t *src, long len, const int32_t *bias, int32_t offset,
+                              const float *scale, int scale_len) {
+    __m256i v_offset = _mm256_set1_epi32(offset);
+    long i = 0;
+    for (; i + 7 < len; i += 8) {
+        __m256i v_acc = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)), v_offset);
+        if (bias) {
+            v_acc = _mm256_add_epi32(v_acc, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bias + i)));
+        }
+        __m256 v_scale = scale_len == 1 ? _mm256_set1_ps(scale[0]) : _mm256_loadu_ps(scale + i);
+        Float2Int8x8(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v_acc), v_scale));
+    }
+    for (; i < len; i++) {
+        int32_t acc = src[i] + offset + (bias ? bias[i] : 0);
+        dst[i]      = float2int8(acc * scale[scale_len == 1 ? 0 : i]);
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,83 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_INT8_H_
+#define SOURCE_TNN_DEVICE_X86_ACC_COMPUTE_INT8_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "tnn/core/common.h"
+#include "tnn/core/macro.h"
+
+namespace TNN_NS {
+
+// @brief dst = float2int8(src / scale), blob data format is NCHW
+void X86Int8Quant(int8_t *dst, const float *src, const float *scale, int scale_len, DimsVector dims);
+
+// @brief dst = src * scale, blob data format is NCHW
+void X86Int8Dequant(float *dst, const int8_t *src, const float *scale, int scale_len, DimsVector dims);
+
+// @brief dst = float2int8(sum(src_i * scale_i) / dst_scale), all inputs have the same dims
+void X86Int8Add(int8_t *dst, const std::vector<int8_t *> &srcs, const std::vector<float *> &scales, int scale_len,
+                const float *dst_scale, DimsVector dims);
+
+// @brief dst = float2int8(src * src_scale / dst_scale)
+void X86Int8Requant(int8_t *dst, const int8_t *src, float src_scale, float dst_scale, size_t count);
+
+// @brief pack int8 nchw data to c16 with zero padding, and back
+void X86Int8PackC16(int8_t *dst, const int8_t *src, size_t hw, size_t src_hw_stride, size_t channel);
+void X86Int8UnpackC16(int8_t *dst, const int8_t *src, size_t hw, size_t dst_hw_stride, size_t channel);
+
+// @brief pooling on c16 packed int8 data, same rounding as the naive int8 pooling
+void X86Int8MaxPoolingC16(const int8_t *src, long iw, long ih, int8_t *dst, long ow, long oh, long kw, long kh,
+                          long stride_w, long stride_h, long pad_w, long pad_h);
+void X86Int8AvgPoolingC16(const int8_t *src, long iw, long ih, int8_t *dst, long ow, long oh, long kw, long kh,
+                          long stride_w, long stride_h, long pad_w, long pad_h);
+
+/*
+ * int8 gemm, c(N, M) = b(N, K) * a(K, M), with int32 results.
+ * a is u8 (s8 + 128) packed as [M / 16][K4][16][4], b is s8 packed as [N / 6][K4][6][4],
+ * the 128 offset of a is compensated by the caller with -128 * sum_k(b(n, k)).
+ */
+// @brief bytes of the packed a and b
+size_t X86Int8PackASize(int M, int K);
+size_t X86Int8PackBSize(int N, int K);
+
+// @brief pack a(M, K) row major, rows of a are s8 and get the 128 offset
+void X86Int8PackA(uint8_t *dst, const int8_t *src, int M, int K, int lda);
+
+// @brief im2col of one group straight into the packed a, rows of a are output pixels
+void X86Int8Im2ColPackA(uint8_t *dst, const int8_t *src, int channel, int height, int width, int kernel_h,
+                        int kernel_w, int pad_t, int pad_l, int stride_h, int stride_w, int dilation_h,
+                        int dilation_w, int out_height, int out_width);
+
+// @brief pack b(N, K) row major, sum[n] = sum_k(b(n, k)) if sum is not null
+void X86Int8PackB(int8_t *dst, const int8_t *src, int N, int K, int ldb, int32_t *sum);
+
+// @brief c has ROUND_UP(N, 6) rows of ldc int32, ldc >= ROUND_UP(M, 16).
+// vpdpbusd is used with avx512 vnni, otherwise avx2 vpmaddwd on exactly widened bytes.
+void X86Int8Gemm(int M, int N, int K, const uint8_t *a, const int8_t *b, int32_t *c, int ldc);
+
+// @brief dst = float2int8((src + bias) * scale), fused with the add input and relu of the int8 conv
+void X86Int8ConvRequant(int8_t *dst, const int32_t *src, long len, int32_t bias, float scale, int activation_type,
+                        int fusion_type, const int8_t *add_input, float add_scale);
+
+// @brief dst[i] = float2int8((src[i] + bias[i] + offset) * scale[i]), scale is shared if scale_len is 1
+void X86Int8RequantPerChannel(int8_t *dst, const int32_t *src, long len, const int32_t *bias, int32_t offset,
+                              const float *scale, int scale_len);
+
+}   // namespace TNN_NS
+
+#endif
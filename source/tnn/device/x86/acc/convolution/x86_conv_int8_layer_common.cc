@@ -0,0 +1,209 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_common.h"
+
+#include <cfloat>
+
+#include "tnn/core/blob_int8.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+#include "tnn/device/x86/x86_context.h"
+
+namespace TNN_NS {
+/*
+X86ConvInt8LayerCommon as the last solution of int8, always return true
+handle the case group != 1, dilate != 1, any pads and strides
+*/
+bool X86ConvInt8LayerCommon::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                        const std::vector<Blob *> &outputs) {
+    return true;
+}
+
+X86ConvInt8LayerCommon::~X86ConvInt8LayerCommon() {}
+
+Status X86ConvInt8LayerCommon::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status X86ConvInt8LayerCommon::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                    const std::vector<Blob *> &outputs) {
+    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_weight_.GetBytesSize()) {
+        auto dims_input  = inputs[0]->GetBlobDesc().dims;
+        auto dims_output = outputs[0]->GetBlobDesc().dims;
+        if (conv_res->filter_handle.GetDataType() != DATA_TYPE_INT8) {
+            LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
+            return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
+        }
+
+        int group = param->group;
+        int K     = dims_input[1] * param->kernels[0] * param->kernels[1] / group;
+        int N     = dims_output[1] / group;
+        size_t weight_pack_per_group = X86Int8PackBSize(N, K);
+
+        RawBuffer temp_buffer(weight_pack_per_group * group);
+        RawBuffer bias_buffer(dims_output[1] * sizeof(int32_t));
+        auto src      = conv_res->filter_handle.force_to<int8_t *>();
+        auto dst      = temp_buffer.force_to<int8_t *>();
+        auto bias_dst = bias_buffer.force_to<int32_t *>();
+        for (int g = 0; g < group; g++) {
+            X86Int8PackB(dst + weight_pack_per_group * g, src + N * K * g, N, K, K, bias_dst + N * g);
+        }
+
+        // the input is fed to the gemm as u8 (x + 128), bias -= 128 * sum(w)
+        auto bias_src = conv_res->bias_handle.force_to<int32_t *>();
+        for (int oc = 0; oc < dims_output[1]; oc++) {
+            bias_dst[oc] = (bias_src ? bias_src[oc] : 0) - 128 * bias_dst[oc];
+        }
+
+        temp_buffer.SetDataType(DATA_TYPE_INT8);
+        bias_buffer.SetDataType(DATA_TYPE_INT32);
+        buffer_weight_ = temp_buffer;
+        buffer_bias_   = bias_buffer;
+    }
+    return TNN_OK;
+}
+
+Status X86ConvInt8LayerCommon::allocateBufferScale(const std::vector<Blob *> &inputs,
+                                                   const std::vector<Blob *> &outputs) {
+    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    int output_channel = outputs[0]->GetBlobDesc().dims[1];
+    auto o_resource    = reinterpret_cast<BlobInt8 *>(outputs[0])->GetIntResource();
+    const float *o_scale = o_resource->scale_handle.force_to<float *>();
+    int scale_len_o      = o_resource->scale_handle.GetDataCount();
+
+    // scale of the requant, w_scale / o_scale
+    if (!buffer_scale_.GetBytesSize()) {
+        const float *w_scale = conv_res->scale_handle.force_to<float *>();
+        CHECK_PARAM_NULL(w_scale);
+        int scale_len_w = conv_res->scale_handle.GetDataCount();
+
+        RawBuffer temp_buffer(output_channel * sizeof(float));
+        float *temp_ptr = temp_buffer.force_to<float *>();
+        for (int i = 0; i < output_channel; i++) {
+            int w_scale_idx = scale_len_w == 1 ? 0 : i;
+            int o_scale_idx = scale_len_o == 1 ? 0 : i;
+            if (o_scale[o_scale_idx] >= FLT_MIN)
+                temp_ptr[i] = w_scale[w_scale_idx] / o_scale[o_scale_idx];
+            else
+                temp_ptr[i] = 0.0;
+        }
+        buffer_scale_ = temp_buffer;
+    }
+
+    // scale of the fused add input, i_scale / o_scale
+    if (param->fusion_type != FusionType_None && !buffer_add_scale_.GetBytesSize()) {
+        auto add_resource    = reinterpret_cast<BlobInt8 *>(inputs[1])->GetIntResource();
+        const float *i_scale = add_resource->scale_handle.force_to<float *>();
+        int scale_len_i      = add_resource->scale_handle.GetDataCount();
+
+        RawBuffer temp_buffer(output_channel * sizeof(float));
+        float *temp_ptr = temp_buffer.force_to<float *>();
+        for (int i = 0; i < output_channel; i++) {
+            int scale_idx_i = scale_len_i == 1 ? 0 : i;
+            int scale_idx_o = scale_len_o == 1 ? 0 : i;
+            if (o_scale[scale_idx_o] >= FLT_MIN)
+                temp_ptr[i] = i_scale[scale_idx_i] / o_scale[scale_idx_o];
+            else
+                temp_ptr[i] = 0.0;
+        }
+        buffer_add_scale_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status X86ConvInt8LayerCommon::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                    const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto status = X86LayerAcc::Init(context, param, resource, inputs, outputs);
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferScale(inputs, outputs), TNN_OK);
+
+    return TNN_OK;
+}
+
+Status X86ConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<ConvLayerParam *>(param_);
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_INT8) {
+        return Status(TNNERR_DEVICE_ACC_DATA_FORMAT_NOT_SUPPORT, "Error: x86 device not support this data type");
+    }
+
+    int group       = param->group;
+    int in_channel  = input_dims[1] / group;
+    int in_hw       = input_dims[2] * input_dims[3];
+    int out_channel = output_dims[1] / group;
+    int out_hw      = output_dims[2] * output_dims[3];
+
+    int K   = in_channel * param->kernels[0] * param->kernels[1];
+    int M   = out_hw;
+    int N   = out_channel;
+    int ldc = ROUND_UP(M, 16);
+    size_t weight_pack_per_group = X86Int8PackBSize(N, K);
+
+    size_t pack_a_size    = ROUND_UP(X86Int8PackASize(M, K), 32);
+    size_t dst_size       = ROUND_UP(N, 6) * ldc * sizeof(int32_t);
+    size_t workspace_size = pack_a_size + dst_size;
+    int8_t *workspace     = reinterpret_cast<int8_t *>(context_->GetSharedWorkSpace(workspace_size));
+    uint8_t *pack_a       = reinterpret_cast<uint8_t *>(workspace);
+    int32_t *dst_int32    = reinterpret_cast<int32_t *>(workspace + pack_a_size);
+
+    auto input_data  = static_cast<int8_t *>(inputs[0]->GetHandle().base);
+    auto output_data = static_cast<int8_t *>(outputs[0]->GetHandle().base);
+    int8_t *add_data = nullptr;
+    if (param->fusion_type != FusionType_None) {
+        add_data = static_cast<int8_t *>(inputs[1]->GetHandle().base);
+    }
+    auto weight_data    = buffer_weight_.force_to<int8_t *>();
+    auto bias_data      = buffer_bias_.force_to<int32_t *>();
+    auto scale_data     = buffer_scale_.force_to<float *>();
+    auto add_scale_data = buffer_add_scale_.force_to<float *>();
+
+    for (int b = 0; b < output_dims[0]; b++) {
+        for (int g = 0; g < group; g++) {
+            X86Int8Im2ColPackA(pack_a, input_data + (b * group + g) * in_channel * in_hw, in_channel,
+                               input_dims[2], input_dims[3], param->kernels[1], param->kernels[0], param->pads[2],
+                               param->pads[0], param->strides[1], param->strides[0], param->dialations[1],
+                               param->dialations[0], output_dims[2], output_dims[3]);
+
+            X86Int8Gemm(M, N, K, pack_a, weight_data + weight_pack_per_group * g, dst_int32, ldc);
+
+            OMP_PARALLEL_FOR_
+            for (int n = 0; n < N; n++) {
+                int oc          = g * N + n;
+                long out_offset = (long)(b * output_dims[1] + oc) * out_hw;
+                X86Int8ConvRequant(output_data + out_offset, dst_int32 + n * ldc, out_hw, bias_data[oc],
+                                   scale_data[oc], param->activation_type, param->fusion_type,
+                                   add_data ? add_data + out_offset : nullptr,
+                                   add_scale_data ? add_scale_data[oc] : 0.f);
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+}  // namespace TNN_NS
@@ -0,0 +1,53 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_INT8_LAYER_COMMON_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_INT8_LAYER_COMMON_H_
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// @brief int8 conv in NCHW, im2col of u8 + int8 gemm (vpdpbusd with avx512 vnni) + requant
+class X86ConvInt8LayerCommon : public X86LayerAcc {
+public:
+    virtual ~X86ConvInt8LayerCommon();
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs);
+
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // always true as last solution
+    static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                           const std::vector<Blob *> &outputs);
+
+    // pack weights and fold the u8 offset of the input into the bias
+    virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual Status allocateBufferScale(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    RawBuffer buffer_weight_;
+    RawBuffer buffer_bias_;
+    RawBuffer buffer_scale_;
+    RawBuffer buffer_add_scale_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_INT8_LAYER_COMMON_H_
@@ -77,17 +77,34 @@ Status X86ConvLayer1x1::DoForward(const std::vector<Blob *> &inputs, const std::
 
     int m_c = conv_gemm_conf_.M_c_;
     int k_c = conv_gemm_conf_.K_c_;
+    int n_block = conv_gemm_conf_.n_block_;
+
+    // fp16 or bf16 weights are widened by K block into b_buf
+    auto weight_type = buffer_weight_.GetDataType();
+    bool lowp_weight = weight_type == DATA_TYPE_HALF || weight_type == DATA_TYPE_BFP16;
+    size_t src_buf_size = ROUND_UP(m_c * k_c, 8);
+    size_t b_buf_size = lowp_weight ? k_c * ROUND_UP(m, n_block) : 0;
 
     float *src_buf = reinterpret_cast<float *>(
-        context_->GetSharedWorkSpace(m_c * k_c * sizeof(float)));
+        context_->GetSharedWorkSpace((src_buf_size + b_buf_size) * sizeof(float)));
+    float *b_buf = src_buf + src_buf_size;
+
+    const float *residual = nullptr;
+    RETURN_ON_NEQ(GetResidual(inputs, outputs, residual), TNN_OK);
 
     for (int batch_idx = 0; batch_idx < batch; batch_idx++) {
         const float * B = src_origin + batch_idx * k * n;
         const float * A = weights_data;
         float * C = dst_origin + batch_idx * m * n;
+        const float * R = residual ? residual + batch_idx * m * n : nullptr;
 
+        if (lowp_weight) {
+            conv_sgemm_nn_col_major(n, m, k, B, n, buffer_weight_.force_to<uint16_t *>(), weight_type, k, C, n,
+                bias_data, param->activation_type, src_buf, b_buf, conv_gemm_conf_, R, param->fusion_type);
+            continue;
+        }
         conv_sgemm_nn_col_major(n, m, k, B, n, A, k, C, n,
-            bias_data, param->activation_type, src_buf, conv_gemm_conf_);
+            bias_data, param->activation_type, src_buf, conv_gemm_conf_, R, param->fusion_type);
     }
 
     return TNN_OK;
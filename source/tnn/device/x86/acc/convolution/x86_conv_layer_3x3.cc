@@ -24,6 +24,7 @@
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_utils_inner.h"
 
 namespace TNN_NS {
 
@@ -292,115 +293,6 @@ static void unpack_output_c4(const float *din, float *dout, int cs, int ce, int
     }
 }
 
-#define COMPUTE_UNIT(c)                                                                                                \
-    wgt  = VEC::loadu(weight_z + c * N);                                                                               \
-    data = VEC(src_z + K * 0 + c);                                                                                     \
-    VEC::mla(acc0, data, wgt);                                                                                         \
-    data = VEC(src_z + K * 1 + c);                                                                                     \
-    VEC::mla(acc1, data, wgt);                                                                                         \
-    data = VEC(src_z + K * 2 + c);                                                                                     \
-    VEC::mla(acc2, data, wgt);                                                                                         \
-    data = VEC(src_z + K * 3 + c);                                                                                     \
-    VEC::mla(acc3, data, wgt);                                                                                         \
-    data = VEC(src_z + K * 4 + c);                                                                                     \
-    VEC::mla(acc4, data, wgt);                                                                                         \
-    data = VEC(src_z + K * 5 + c);                                                                                     \
-    VEC::mla(acc5, data, wgt);
-
-#define COMPUTE_VEC(c)                                                                                                 \
-    data = VEC(src_z + c);                                                                                             \
-    wgt  = VEC::loadu(weight_z + c * N);                                                                               \
-    VEC::mla(acc, data, wgt);
-
-// A=6x8, B=8x8, C=6x8
-template <typename VEC, int M, int K, int N>
-static void gemm_kernel_avx(float *dst, float *src, const float *weight, const float *bias, int ic_8, int oc_8,
-                            int width) {
-    auto w_unit         = width / M;
-    auto w_unit_end     = M * w_unit;
-    auto src_depth_step = width * K;
-
-    const int weight_unit_step = K * N;
-
-    for (int co = 0; co < oc_8; co++) {
-        auto dst_z     = dst + co * N * width;
-        auto weight_dz = weight + co * ic_8 * weight_unit_step;
-
-        for (int dx = 0; dx < w_unit; dx++) {
-            auto dst_x = dst_z + dx * N * M;
-            auto src_x = src + dx * K * M;
-
-            VEC acc0 = (bias) ? VEC::loadu(bias) : VEC(0.0f);
-            VEC acc1 = acc0;
-            VEC acc2 = acc0;
-            VEC acc3 = acc0;
-            VEC acc4 = acc0;
-            VEC acc5 = acc0;
-            VEC data;
-            VEC wgt;
-
-            for (int ci = 0; ci < ic_8; ci++) {
-                auto src_z    = src_x + ci * src_depth_step;
-                auto weight_z = weight_dz + ci * weight_unit_step;
-                if (K == 8) {
-                    COMPUTE_UNIT(0);
-                    COMPUTE_UNIT(1);
-                    COMPUTE_UNIT(2);
-                    COMPUTE_UNIT(3);
-                    COMPUTE_UNIT(4);
-                    COMPUTE_UNIT(5);
-                    COMPUTE_UNIT(6);
-                    COMPUTE_UNIT(7);
-                } else if (K == 4) {
-                    COMPUTE_UNIT(0);
-                    COMPUTE_UNIT(1);
-                    COMPUTE_UNIT(2);
-                    COMPUTE_UNIT(3);
-                }
-            }
-
-            VEC::saveu(dst_x + N * 0, acc0);
-            VEC::saveu(dst_x + N * 1, acc1);
-            VEC::saveu(dst_x + N * 2, acc2);
-            VEC::saveu(dst_x + N * 3, acc3);
-            VEC::saveu(dst_x + N * 4, acc4);
-            VEC::saveu(dst_x + N * 5, acc5);
-        }
-
-        for (int dx = w_unit_end; dx < width; dx++) {
-            auto dst_x = dst_z + dx * N;
-            auto src_x = src + dx * K;
-
-            VEC acc = (bias) ? VEC::loadu(bias) : VEC(0.0f);
-            VEC data;
-            VEC wgt;
-
-            for (int ci = 0; ci < ic_8; ci++) {
-                auto src_z    = src_x + ci * src_depth_step;
-                auto weight_z = weight_dz + ci * weight_unit_step;
-
-                if (K == 8) {
-                    COMPUTE_VEC(0);
-                    COMPUTE_VEC(1);
-                    COMPUTE_VEC(2);
-                    COMPUTE_VEC(3);
-                    COMPUTE_VEC(4);
-                    COMPUTE_VEC(5);
-                    COMPUTE_VEC(6);
-                    COMPUTE_VEC(7);
-                } else if (K == 4) {
-                    COMPUTE_VEC(0);
-                    COMPUTE_VEC(1);
-                    COMPUTE_VEC(2);
-                    COMPUTE_VEC(3);
-                }
-            }
-
-            VEC::saveu(dst_x, acc);
-        }
-    }
-}
-
 // BT=[1, 0, -1, 0,
 //    0, 1,  1, 0,
 //    0, -1, 1, 0,
@@ -603,14 +495,18 @@ Status X86ConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs,
         const int data_byte_size = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer pack_buffer(weight_count * data_byte_size);
-            float *dst = pack_buffer.force_to<float *>();
-
-            const float G[4][3] = {{1.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}};
-            weight_transform(src, dst, 3, 4, input_channel, output_channel, CH_PACK, G);
-
-            pack_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = pack_buffer;
+            auto pack = [&](RawBuffer &packed) -> Status {
+                RawBuffer pack_buffer(weight_count * data_byte_size);
+                float *dst = pack_buffer.force_to<float *>();
+
+                const float G[4][3] = {{1.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}};
+                weight_transform(src, dst, 3, 4, input_channel, output_channel, CH_PACK, G);
+
+                pack_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = pack_buffer;
+                return TNN_OK;
+            };
+            RETURN_ON_NEQ(GetSharedPackedWeight(buffer_weight_, "3x3_" + ToString(CH_PACK), pack), TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -665,14 +561,14 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
     auto output_trans_func = output_trans_post_2x4<Float4>;
     auto pack_func         = pack_input_c4;
     auto unpack_func       = unpack_output_c4;
-    auto gemm_func         = gemm_kernel_avx<Float4, 6, 4, 4>;
+    auto gemm_func         = X86WinogradGemm<Float4, 6, 4, 4>;
     auto CH_PACK           = 4;
     if (arch_ == avx2) {
         input_trans_func  = input_trans_4x4<Float8>;
         output_trans_func = output_trans_post_2x4<Float8>;
         pack_func         = pack_input_c8;
         unpack_func       = unpack_output_c8;
-        gemm_func         = gemm_kernel_avx<Float8, 6, 8, 8>;
+        gemm_func         = X86WinogradGemm<Float8, 6, 8, 8>;
         CH_PACK           = 8;
     }
 
@@ -17,6 +17,7 @@
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_depthwise.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_1x1.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_3x3.h"
+#include "tnn/device/x86/acc/convolution/x86_conv_layer_winograd.h"
 
 namespace TNN_NS {
 
@@ -24,10 +25,16 @@ namespace TNN_NS {
 get different impl based on conv params
 ArmConvLayerCommon always as the last solution
 bfp16 impl included in fp impl
+fused add is only done by the sgemm epilogue of X86ConvLayer1x1 and X86ConvLayerCommon,
+X86ConvLayer3x3 fuses relu only
 */
 void X86ConvLayerAccFactory::CreateImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
                                          LayerParam *param, std::shared_ptr<X86LayerAcc> &conv_acc_impl) {
-    if (X86ConvLayerDepthwise::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
+    auto conv_param   = dynamic_cast<ConvLayerParam *>(param);
+    bool fused_add    = conv_param && conv_param->fusion_type != FusionType_None;
+    bool relu_or_none = conv_param && (conv_param->activation_type == ActivationType_None ||
+                                       conv_param->activation_type == ActivationType_ReLU);
+    if (!fused_add && X86ConvLayerDepthwise::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
         if (!dynamic_cast<X86ConvLayerDepthwise *>(conv_acc_impl.get())) {
             conv_acc_impl = std::make_shared<X86ConvLayerDepthwise>();
         }
@@ -35,7 +42,16 @@ void X86ConvLayerAccFactory::CreateImpFP(const std::vector<Blob *> &inputs, cons
         if (!dynamic_cast<X86ConvLayer1x1*>(conv_acc_impl.get())) {
             conv_acc_impl = std::make_shared<X86ConvLayer1x1>();
         }
-    } else if (X86ConvLayer3x3::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
+    } else if (!fused_add &&
+               X86ConvLayerWinograd::SelectDstUnit(dynamic_cast<ConvLayerParam *>(param), inputs, outputs) > 2) {
+        // larger output tiles save more multiplies, see SelectDstUnit for the cost model and accuracy guard
+        int dst_unit = X86ConvLayerWinograd::SelectDstUnit(dynamic_cast<ConvLayerParam *>(param), inputs, outputs);
+        auto winograd_impl = dynamic_cast<X86ConvLayerWinograd *>(conv_acc_impl.get());
+        if (!winograd_impl || winograd_impl->GetDstUnit() != dst_unit) {
+            conv_acc_impl = std::make_shared<X86ConvLayerWinograd>(dst_unit);
+        }
+    } else if (!fused_add && relu_or_none &&
+               X86ConvLayer3x3::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
         if (!dynamic_cast<X86ConvLayer3x3*>(conv_acc_impl.get())) {
             conv_acc_impl = std::make_shared<X86ConvLayer3x3>();
         }
@@ -44,4 +60,100 @@ void X86ConvLayerAccFactory::CreateImpFP(const std::vector<Blob *> &inputs, cons
     }
 }
 
+X86ConvImplConfig::X86ConvImplConfig(X86ConvImplType type, int dst_unit, int m_c, int k_c)
+    : type(type), dst_unit(dst_unit), m_c(m_c), k_c(k_c) {}
+
+X86ConvImplConfig::X86ConvImplConfig(const std::vector<int> &values) : X86ConvImplConfig() {
+    if (values.size() == 4) {
+        type     = static_cast<X86ConvImplType>(values[0]);
+        dst_unit = values[1];
+        m_c      = values[2];
+        k_c      = values[3];
+    }
+}
+
+std::vector<int> X86ConvImplConfig::ToVector() const {
+    return {static_cast<int>(type), dst_unit, m_c, k_c};
+}
+
+bool X86ConvImplConfig::operator==(const X86ConvImplConfig &other) const {
+    return ToVector() == other.ToVector();
+}
+
+/*
+the same impls as CreateImpFP, all of them that apply to the conv param.
+X86ConvLayer1x1 and X86ConvLayerCommon run on conv_sgemm, they are tried with a grid
+of the spatial and the reduce blocking around the default 64 x 256
+*/
+std::vector<X86ConvImplConfig> X86ConvLayerAccFactory::GetCandidatesFP(const std::vector<Blob *> &inputs,
+                                                                       const std::vector<Blob *> &outputs,
+                                                                       LayerParam *param) {
+    std::vector<X86ConvImplConfig> candidates;
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param);
+    if (!conv_param) {
+        return candidates;
+    }
+
+    bool fused_add    = conv_param->fusion_type != FusionType_None;
+    bool relu_or_none = conv_param->activation_type == ActivationType_None ||
+                        conv_param->activation_type == ActivationType_ReLU;
+    if (!fused_add && X86ConvLayerDepthwise::isPrefered(conv_param, inputs, outputs)) {
+        candidates.push_back(X86ConvImplConfig(X86_CONV_IMPL_DEPTHWISE));
+        return candidates;
+    }
+
+    if (!fused_add) {
+        for (auto dst_unit : X86ConvLayerWinograd::SupportedDstUnits(conv_param, inputs, outputs)) {
+            candidates.push_back(X86ConvImplConfig(X86_CONV_IMPL_WINOGRAD, dst_unit));
+        }
+        if (relu_or_none && X86ConvLayer3x3::isPrefered(conv_param, inputs, outputs)) {
+            candidates.push_back(X86ConvImplConfig(X86_CONV_IMPL_3X3));
+        }
+    }
+
+    auto gemm_type = X86ConvLayer1x1::isPrefered(conv_param, inputs, outputs) ? X86_CONV_IMPL_1X1
+                                                                              : X86_CONV_IMPL_COMMON;
+    for (int m_c : {64, 128, 256}) {
+        for (int k_c : {128, 256, 512}) {
+            candidates.push_back(X86ConvImplConfig(gemm_type, 0, m_c, k_c));
+        }
+    }
+    return candidates;
+}
+
+void X86ConvLayerAccFactory::CreateImpFP(const X86ConvImplConfig &config,
+                                         std::shared_ptr<X86LayerAcc> &conv_acc_impl) {
+    std::shared_ptr<X86ConvLayerCommon> impl;
+    switch (config.type) {
+        case X86_CONV_IMPL_DEPTHWISE:
+            impl = std::make_shared<X86ConvLayerDepthwise>();
+            break;
+        case X86_CONV_IMPL_WINOGRAD:
+            impl = std::make_shared<X86ConvLayerWinograd>(config.dst_unit);
+            break;
+        case X86_CONV_IMPL_3X3:
+            impl = std::make_shared<X86ConvLayer3x3>();
+            break;
+        case X86_CONV_IMPL_1X1:
+            impl = std::make_shared<X86ConvLayer1x1>();
+            break;
+        default:
+            impl = std::make_shared<X86ConvLayerCommon>();
+            break;
+    }
+    impl->SetGemmBlocking(config.m_c, config.k_c);
+    conv_acc_impl = impl;
+}
+
+/*
+int8 conv is computed in NCHW as the naive device
+X86ConvInt8LayerCommon handles all conv params
+*/
+void X86ConvLayerAccFactory::CreateImpInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                                           LayerParam *param, std::shared_ptr<X86LayerAcc> &conv_acc_impl) {
+    if (!conv_acc_impl) {
+        conv_acc_impl = std::make_shared<X86ConvInt8LayerCommon>();
+    }
+}
+
 }  // namespace TNN_NS
@@ -18,15 +18,50 @@
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_common.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_depthwise.h"
+#include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_common.h"
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace TNN_NS {
 
+enum X86ConvImplType {
+    X86_CONV_IMPL_COMMON    = 0,
+    X86_CONV_IMPL_1X1       = 1,
+    X86_CONV_IMPL_3X3       = 2,
+    X86_CONV_IMPL_WINOGRAD  = 3,
+    X86_CONV_IMPL_DEPTHWISE = 4,
+};
+
+// @brief one candidate of the conv tuner, stored in the tune cache as a vector of ints
+struct X86ConvImplConfig {
+    X86ConvImplConfig(X86ConvImplType type = X86_CONV_IMPL_COMMON, int dst_unit = 0, int m_c = 0, int k_c = 0);
+    explicit X86ConvImplConfig(const std::vector<int> &values);
+
+    std::vector<int> ToVector() const;
+    bool operator==(const X86ConvImplConfig &other) const;
+
+    X86ConvImplType type;
+    // output tile size of winograd
+    int dst_unit;
+    // sgemm blocking of the impls running on conv_sgemm, 0 keeps the default
+    int m_c;
+    int k_c;
+};
+
 class X86ConvLayerAccFactory {
 public:
     static void CreateImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs, LayerParam *param,
                             std::shared_ptr<X86LayerAcc> &conv_acc_impl);
+
+    // @brief impls CreateImpFP may choose from and the sgemm blocking grid, timed by the tuner
+    static std::vector<X86ConvImplConfig> GetCandidatesFP(const std::vector<Blob *> &inputs,
+                                                          const std::vector<Blob *> &outputs, LayerParam *param);
+
+    static void CreateImpFP(const X86ConvImplConfig &config, std::shared_ptr<X86LayerAcc> &conv_acc_impl);
+
+    static void CreateImpInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                              LayerParam *param, std::shared_ptr<X86LayerAcc> &conv_acc_impl);
 };
 
 }  // namespace TNN_NS
@@ -13,9 +13,13 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_common.h"
+
+#include <algorithm>
+
 #include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/string_utils_inner.h"
 
 namespace TNN_NS {
 /*
@@ -30,7 +34,7 @@ bool X86ConvLayerCommon::isPrefered(ConvLayerParam *param, const std::vector<Blo
 X86ConvLayerCommon::~X86ConvLayerCommon() {}
 
 Status X86ConvLayerCommon::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    return TNN_OK;
+    return PlanResidual(inputs, outputs);
 }
 
 Status X86ConvLayerCommon::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
@@ -55,17 +59,32 @@ Status X86ConvLayerCommon::allocateBufferWeight(const std::vector<Blob *> &input
         const float *src = conv_res->filter_handle.force_to<float *>();
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer temp_buffer(weight_pack_per_group * param->group * sizeof(float));
-            float *dst = temp_buffer.force_to<float *>();
+            auto pack = [&](RawBuffer &packed) -> Status {
+                RawBuffer temp_buffer(weight_pack_per_group * param->group * sizeof(float));
+                float *dst = temp_buffer.force_to<float *>();
 
-            for (int g = 0; g < param->group; g++) {
-                auto src_g = src + K * M * g;
-                auto dst_g = dst + weight_pack_per_group * g;
-                conv_pack_weights(M, K, src_g, K, dst_g, conv_gemm_conf_);
-            }
+                for (int g = 0; g < param->group; g++) {
+                    auto src_g = src + K * M * g;
+                    auto dst_g = dst + weight_pack_per_group * g;
+                    conv_pack_weights(M, K, src_g, K, dst_g, conv_gemm_conf_);
+                }
+
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
 
-            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = temp_buffer;
+                // kept in 16 bits and widened by K block in conv_sgemm_nn_col_major
+                auto lowp_type = GetLowPrecisionWeightType(src, K * M * param->group);
+                if (lowp_type != DATA_TYPE_FLOAT) {
+                    size_t count = weight_pack_per_group * param->group;
+                    RawBuffer lowp_buffer(count * sizeof(uint16_t));
+                    NarrowFromFloat(lowp_buffer.force_to<uint16_t *>(), dst, count, lowp_type);
+                    lowp_buffer.SetDataType(lowp_type);
+                    packed = lowp_buffer;
+                }
+                return TNN_OK;
+            };
+            std::string variant = "gemm_" + ToString(k_c) + "_" + ToString(n_block);
+            RETURN_ON_NEQ(GetSharedPackedWeight(buffer_weight_, variant, pack), TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -94,6 +113,98 @@ Status X86ConvLayerCommon::allocateBufferBias(const std::vector<Blob *> &inputs,
     return TNN_OK;
 }
 
+Status X86ConvLayerCommon::PlanResidual(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    residual_outer_dims_.clear();
+    residual_outer_strides_.clear();
+    residual_run_ = 0;
+    auto param    = dynamic_cast<ConvLayerParam *>(param_);
+    if (!param || param->fusion_type == FusionType_None || inputs.size() < 2) {
+        return TNN_OK;
+    }
+
+    auto output_dims   = outputs[0]->GetBlobDesc().dims;
+    auto residual_dims = inputs[1]->GetBlobDesc().dims;
+    if (DimsVectorUtils::Equal(output_dims, residual_dims)) {
+        return TNN_OK;
+    }
+
+    // broadcast from the trailing dims, the strides of broadcasted dims are 0
+    const int rank = output_dims.size();
+    if (residual_dims.size() > rank) {
+        return Status(TNNERR_LAYER_ERR, "Error: fused add input has more dims than conv output");
+    }
+    std::vector<int> strides(rank, 0);
+    int stride = 1;
+    for (int d = rank - 1, r = (int)residual_dims.size() - 1; r >= 0; d--, r--) {
+        if (residual_dims[r] != 1 && residual_dims[r] != output_dims[d]) {
+            return Status(TNNERR_LAYER_ERR, "Error: fused add input can not be broadcasted to conv output");
+        }
+        strides[d] = residual_dims[r] == 1 ? 0 : stride;
+        stride *= residual_dims[r];
+    }
+
+    // merge the trailing dims into one run, either copied from the residual or filled with one value
+    int inner = rank - 1;
+    residual_fill_ = strides[inner] == 0;
+    residual_run_  = output_dims[inner];
+    while (inner > 0) {
+        bool fill = strides[inner - 1] == 0;
+        bool copy = strides[inner - 1] == residual_run_;
+        if (residual_fill_ ? !fill : !copy) {
+            break;
+        }
+        residual_run_ *= output_dims[--inner];
+    }
+    residual_outer_dims_.assign(output_dims.begin(), output_dims.begin() + inner);
+    residual_outer_strides_.assign(strides.begin(), strides.begin() + inner);
+
+    const int count = DimsVectorUtils::Count(output_dims);
+    if (buffer_residual_.GetBytesSize() < count * sizeof(float)) {
+        buffer_residual_ = RawBuffer(count * sizeof(float));
+    }
+    return TNN_OK;
+}
+
+Status X86ConvLayerCommon::GetResidual(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                                       const float *&residual) {
+    residual   = nullptr;
+    auto param = dynamic_cast<ConvLayerParam *>(param_);
+    if (!param || param->fusion_type == FusionType_None || inputs.size() < 2) {
+        return TNN_OK;
+    }
+
+    auto residual_data = static_cast<const float *>(inputs[1]->GetHandle().base);
+    if (residual_run_ == 0) {
+        residual = residual_data;
+        return TNN_OK;
+    }
+
+    // walk the outer dims with an odometer, each step writes one run of the expanded residual
+    const int outer_rank = residual_outer_dims_.size();
+    const int outer      = DimsVectorUtils::Count(residual_outer_dims_);
+    std::vector<int> index(outer_rank, 0);
+    float *expanded = buffer_residual_.force_to<float *>();
+    int offset      = 0;
+    for (int o = 0; o < outer; o++) {
+        float *dst = expanded + (size_t)o * residual_run_;
+        if (residual_fill_) {
+            std::fill(dst, dst + residual_run_, residual_data[offset]);
+        } else {
+            memcpy(dst, residual_data + offset, residual_run_ * sizeof(float));
+        }
+        for (int d = outer_rank - 1; d >= 0; d--) {
+            offset += residual_outer_strides_[d];
+            if (++index[d] < residual_outer_dims_[d]) {
+                break;
+            }
+            offset -= index[d] * residual_outer_strides_[d];
+            index[d] = 0;
+        }
+    }
+    residual = expanded;
+    return TNN_OK;
+}
+
 Status X86ConvLayerCommon::Init(Context *context, LayerParam *param, LayerResource *resource,
                                 const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto status = X86LayerAcc::Init(context, param, resource, inputs, outputs);
@@ -101,6 +212,10 @@ Status X86ConvLayerCommon::Init(Context *context, LayerParam *param, LayerResour
         return status;
     }
     conv_gemm_conf_ = conv_gemm_config<float, float, float>();
+    if (gemm_m_c_ > 0 && gemm_k_c_ > 0) {
+        conv_gemm_conf_.M_c_ = gemm_m_c_;
+        conv_gemm_conf_.K_c_ = gemm_k_c_;
+    }
 
     RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
@@ -108,6 +223,11 @@ Status X86ConvLayerCommon::Init(Context *context, LayerParam *param, LayerResour
     return TNN_OK;
 }
 
+void X86ConvLayerCommon::SetGemmBlocking(int m_c, int k_c) {
+    gemm_m_c_ = m_c;
+    gemm_k_c_ = k_c;
+}
+
 Status X86ConvLayerCommon::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     Blob *input_blob    = inputs[0];
     Blob *output_blob   = outputs[0];
@@ -128,23 +248,31 @@ Status X86ConvLayerCommon::DoForward(const std::vector<Blob *> &inputs, const st
     int n_block = conv_gemm_conf_.n_block_;
     size_t src_trans_size = m_c * k_c;
 
+    int K = input_dims[1] * param->kernels[0] * param->kernels[1] / param->group;
+    int M = output_dims[1] / param->group;
+    int N = conv_out_spatial_dim_;
+    size_t weight_offset_per_group = ROUND_UP(K, k_c) * ROUND_UP(M, n_block);
+
+    auto weight_type = buffer_weight_.GetDataType();
+    bool lowp_weight = weight_type == DATA_TYPE_HALF || weight_type == DATA_TYPE_BFP16;
+    size_t b_buf_size = lowp_weight ? k_c * ROUND_UP(M, n_block) : 0;
+
     size_t im2col_size = ROUND_UP(col_offset_ * param->group * sizeof(float), 32);
-    size_t workspace_size = (im2col_size + ROUND_UP(src_trans_size * sizeof(float), 32));
+    size_t src_trans_bytes = ROUND_UP(src_trans_size * sizeof(float), 32);
+    size_t workspace_size = (im2col_size + src_trans_bytes + b_buf_size * sizeof(float));
     float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
 
     float *im2col_workspace = workspace;
     float *src_trans_workspace = workspace + im2col_size / sizeof(float);
-
-    int K = input_dims[1] * param->kernels[0] * param->kernels[1] / param->group;
-    int M = output_dims[1] / param->group;
-    int N = conv_out_spatial_dim_;
-    size_t weight_offset_per_group = ROUND_UP(K, k_c) * ROUND_UP(M, n_block);
+    float *b_workspace = src_trans_workspace + src_trans_bytes / sizeof(float);
 
     if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         auto input_data = static_cast<float*>(input_ptr);
         auto output_data = static_cast<float*>(output_ptr);
         auto weights_data = buffer_weight_.force_to<float*>();
         float *bias_data  = buffer_bias_.force_to<float*>();
+        const float *residual_data = nullptr;
+        RETURN_ON_NEQ(GetResidual(inputs, outputs, residual_data), TNN_OK);
         for (size_t b = 0; b < outputs[0]->GetBlobDesc().dims[0]; b++) {
             X86_IM2COL(input_data + b * conv_in_offset_, input_dims[1],
                         input_dims[2], input_dims[3],
@@ -156,12 +284,25 @@ Status X86ConvLayerCommon::DoForward(const std::vector<Blob *> &inputs, const st
                         im2col_workspace);
 
             for (int g = 0; g < param->group; g++) {
+                const float *residual_g = residual_data ? residual_data + (b * param->group + g) * output_offset_
+                                                        : nullptr;
+                if (lowp_weight) {
+                    conv_sgemm_nn_col_major(N, M, K,
+                        im2col_workspace + col_offset_ * g, N,
+                        buffer_weight_.force_to<uint16_t *>() + weight_offset_per_group * g, weight_type, K,
+                        output_data + (b * param->group + g) * output_offset_, N,
+                        bias_data + g * param->output_channel / param->group,
+                        param->activation_type, src_trans_workspace, b_workspace, conv_gemm_conf_,
+                        residual_g, param->fusion_type);
+                    continue;
+                }
                 conv_sgemm_nn_col_major(N, M, K,
                     im2col_workspace + col_offset_ * g, N,
                     weights_data + weight_offset_per_group * g, K,
                     output_data + (b * param->group + g) * output_offset_, N,
                     bias_data + g * param->output_channel / param->group,
-                    param->activation_type, src_trans_workspace, conv_gemm_conf_);
+                    param->activation_type, src_trans_workspace, conv_gemm_conf_,
+                    residual_g, param->fusion_type);
             }
         }
     } else {
@@ -44,11 +44,31 @@ public:
 
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    // @brief sgemm blocking of the spatial and the reduce dims set by the tuner before Init,
+    // 0 keeps the default of conv_gemm_config
+    void SetGemmBlocking(int m_c, int k_c);
+
 protected:
+    // @brief plan the expansion of a broadcasted residual for the current shapes, called by Reshape
+    Status PlanResidual(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // @brief residual of the conv add fusion in the output layout, nullptr without fused add.
+    // a broadcasted residual is expanded into buffer_residual_ first, one run at a time.
+    Status GetResidual(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                       const float *&residual);
+
     bool do_im2col_ = true;
     RawBuffer buffer_weight_;
     RawBuffer buffer_bias_;
+    RawBuffer buffer_residual_;
+    // expansion plan of a broadcasted residual, residual_run_ is 0 when no expansion is needed
+    DimsVector residual_outer_dims_;
+    std::vector<int> residual_outer_strides_;
+    int residual_run_   = 0;
+    bool residual_fill_ = false;
     conv_gemm_config<float, float, float> conv_gemm_conf_;
+    int gemm_m_c_ = 0;
+    int gemm_k_c_ = 0;
 };
 
 }  // namespace TNN_NS
@@ -60,16 +60,20 @@ Status X86ConvLayerDepthwise::allocateBufferWeight(const std::vector<Blob *> &in
         int data_byte_size = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer temp_buffer(weight_count * data_byte_size);
-            float *dst = temp_buffer.force_to<float *>();
-
-            if (arch_ == avx2) {
-                PackC8(dst, src, kh * kw, kh * kw, kh * kw, group);
-            } else if (arch_ == sse42) {
-                PackC4(dst, src, kh * kw, kh * kw, kh * kw, group);
-            }
-            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = temp_buffer;
+            auto pack = [&](RawBuffer &packed) -> Status {
+                RawBuffer temp_buffer(weight_count * data_byte_size);
+                float *dst = temp_buffer.force_to<float *>();
+
+                if (arch_ == avx2) {
+                    PackC8(dst, src, kh * kw, kh * kw, kh * kw, group);
+                } else if (arch_ == sse42) {
+                    PackC4(dst, src, kh * kw, kh * kw, kh * kw, group);
+                }
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
+                return TNN_OK;
+            };
+            RETURN_ON_NEQ(GetSharedPackedWeight(buffer_weight_, "depthwise", pack), TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -139,6 +143,10 @@ Status X86ConvLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const
         dw_full  = DepthwiseConv<ActivationType_ReLU, Float8, 8>;
     } else if (param->activation_type == ActivationType_ReLU6) {
         dw_full  = DepthwiseConv<ActivationType_ReLU6, Float8, 8>;
+    } else if (param->activation_type == ActivationType_SIGMOID_MUL) {
+        dw_full  = DepthwiseConv<ActivationType_SIGMOID_MUL, Float8, 8>;
+    } else if (param->activation_type == ActivationType_HARDSWISH) {
+        dw_full  = DepthwiseConv<ActivationType_HARDSWISH, Float8, 8>;
     }
     if (arch_ == sse42) {
         dw_full = DepthwiseConv<ActivationType_None, Float4, 4>;
@@ -146,6 +154,10 @@ Status X86ConvLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const
             dw_full  = DepthwiseConv<ActivationType_ReLU, Float4, 4>;
         } else if (param->activation_type == ActivationType_ReLU6) {
             dw_full  = DepthwiseConv<ActivationType_ReLU6, Float4, 4>;
+        } else if (param->activation_type == ActivationType_SIGMOID_MUL) {
+            dw_full  = DepthwiseConv<ActivationType_SIGMOID_MUL, Float4, 4>;
+        } else if (param->activation_type == ActivationType_HARDSWISH) {
+            dw_full  = DepthwiseConv<ActivationType_HARDSWISH, Float4, 4>;
         }
     }
 
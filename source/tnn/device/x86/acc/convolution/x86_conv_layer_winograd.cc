@@ -0,0 +1,471 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/convolution/x86_conv_layer_winograd.h"
+#include "tnn/device/x86/acc/convolution/x86_conv_layer_3x3.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/acc/compute/jit/winograd_gemm_driver.h"
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/x86_common.h"
+#include "tnn/device/x86/x86_context.h"
+#include "tnn/device/x86/x86_util.h"
+
+#include "tnn/interpreter/raw_buffer.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/string_utils_inner.h"
+#include "tnn/utils/winograd_generator.h"
+
+namespace TNN_NS {
+
+// F(6x6, 3x3) accumulates a larger rounding error in the transformed domain,
+// deeper inputs fall back to F(4x4, 3x3)
+#define WINOGRAD_F6_MAX_IC 512
+// transformed input and output of one tile block should stay in L2
+#define WINOGRAD_TILE_BLOCK_BYTES (256 * 1024)
+#define WINOGRAD_TILE_BLOCK_MIN 12
+#define WINOGRAD_TILE_BLOCK_MAX 120
+
+template <int CH>
+static void pack_input_cx(const float *din, float *dout, int cs, int hs, int he, int ws, int we, int channel,
+                          int width, int height) {
+    int size_w  = we - ws;
+    int size_c  = width * height;
+    int c_cnt   = MIN(channel - cs, CH);
+    int w_start = MAX(ws, 0);
+    int w_end   = MIN(we, width);
+
+    for (int h = hs; h < he; h++) {
+        float *dst = dout + (h - hs) * CH * size_w;
+        if (h < 0 || h >= height || w_start >= w_end) {
+            memset(dst, 0, sizeof(float) * CH * size_w);
+            continue;
+        }
+
+        if (c_cnt < CH) {
+            memset(dst, 0, sizeof(float) * CH * size_w);
+        } else {
+            memset(dst, 0, sizeof(float) * CH * (w_start - ws));
+            memset(dst + (w_end - ws) * CH, 0, sizeof(float) * CH * (we - w_end));
+        }
+
+        for (int c = 0; c < c_cnt; c++) {
+            const float *src_c = din + (cs + c) * size_c + h * width;
+            float *dst_c       = dst + c;
+            for (int w = w_start; w < w_end; w++) {
+                dst_c[(w - ws) * CH] = src_c[w];
+            }
+        }
+    }
+}
+
+template <int CH>
+static void unpack_output_cx(const float *din, float *dout, int cs, int channel, int height, int width,
+                             int din_width) {
+    int c_cnt = MIN(channel - cs, CH);
+    for (int c = 0; c < c_cnt; c++) {
+        float *dst_c = dout + (cs + c) * height * width;
+        for (int h = 0; h < height; h++) {
+            const float *src_h = din + h * din_width * CH + c;
+            float *dst_h       = dst_c + h * width;
+            for (int w = 0; w < width; w++) {
+                dst_h[w] = src_h[w * CH];
+            }
+        }
+    }
+}
+
+// dest = BT * src * B on an alpha x alpha tile, zero coefficients are skipped
+template <typename VEC, int ALPHA>
+static void input_trans(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+                        int dest_h_stride, const float *bt) {
+    VEC d[ALPHA][ALPHA];
+    VEC t[ALPHA][ALPHA];
+
+    for (int y = 0; y < ALPHA; y++) {
+        for (int x = 0; x < ALPHA; x++) {
+            d[y][x] = VEC::loadu(src + y * src_h_stride + x * src_stride);
+        }
+    }
+
+    for (int i = 0; i < ALPHA; i++) {
+        for (int x = 0; x < ALPHA; x++) {
+            VEC acc(0.f);
+            for (int k = 0; k < ALPHA; k++) {
+                if (bt[i * ALPHA + k] != 0.f) {
+                    VEC::mla(acc, d[k][x], VEC(bt[i * ALPHA + k]));
+                }
+            }
+            t[i][x] = acc;
+        }
+    }
+
+    for (int i = 0; i < ALPHA; i++) {
+        for (int j = 0; j < ALPHA; j++) {
+            VEC acc(0.f);
+            for (int k = 0; k < ALPHA; k++) {
+                if (bt[j * ALPHA + k] != 0.f) {
+                    VEC::mla(acc, t[i][k], VEC(bt[j * ALPHA + k]));
+                }
+            }
+            VEC::saveu(dest + i * dest_h_stride + j * dest_stride, acc);
+        }
+    }
+}
+
+// dest = act(AT * src * A + bias), dest is a (alpha - 2) x (alpha - 2) tile
+template <typename VEC, int ALPHA>
+static void output_trans_post(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+                              int dest_h_stride, const float *at, const float *bias_value, int activation_type) {
+    constexpr int UNIT = ALPHA - 2;
+    VEC m[ALPHA][ALPHA];
+    VEC t[UNIT][ALPHA];
+
+    for (int y = 0; y < ALPHA; y++) {
+        for (int x = 0; x < ALPHA; x++) {
+            m[y][x] = VEC::loadu(src + y * src_h_stride + x * src_stride);
+        }
+    }
+
+    for (int i = 0; i < UNIT; i++) {
+        for (int x = 0; x < ALPHA; x++) {
+            VEC acc(0.f);
+            for (int k = 0; k < ALPHA; k++) {
+                if (at[i * ALPHA + k] != 0.f) {
+                    VEC::mla(acc, m[k][x], VEC(at[i * ALPHA + k]));
+                }
+            }
+            t[i][x] = acc;
+        }
+    }
+
+    VEC bias  = VEC::loadu(bias_value);
+    VEC zeros = VEC(0.f);
+    VEC sixes = VEC(6.f);
+    for (int i = 0; i < UNIT; i++) {
+        for (int j = 0; j < UNIT; j++) {
+            VEC acc = bias;
+            for (int k = 0; k < ALPHA; k++) {
+                if (at[j * ALPHA + k] != 0.f) {
+                    VEC::mla(acc, t[i][k], VEC(at[j * ALPHA + k]));
+                }
+            }
+            if (activation_type == ActivationType_ReLU || activation_type == ActivationType_ReLU6) {
+                acc = VEC::max(acc, zeros);
+            }
+            if (activation_type == ActivationType_ReLU6) {
+                acc = VEC::min(acc, sixes);
+            }
+            VEC::saveu(dest + i * dest_h_stride + j * dest_stride, acc);
+        }
+    }
+}
+
+X86ConvLayerWinograd::X86ConvLayerWinograd(int dst_unit) : dst_unit_(dst_unit) {
+    const int alpha = dst_unit_ + 2;
+    WinogradGenerator generator(dst_unit_, 3);
+    // B is alpha x alpha and A is alpha x dst_unit, both stored by row
+    const float *b_data = std::get<0>(generator.B()).get();
+    const float *a_data = std::get<0>(generator.A()).get();
+
+    bt_.resize(alpha * alpha);
+    at_.resize(dst_unit_ * alpha);
+    for (int i = 0; i < alpha; i++) {
+        for (int k = 0; k < alpha; k++) {
+            bt_[i * alpha + k] = b_data[k * alpha + i];
+        }
+    }
+    for (int i = 0; i < dst_unit_; i++) {
+        for (int k = 0; k < alpha; k++) {
+            at_[i * alpha + k] = a_data[k * dst_unit_ + i];
+        }
+    }
+}
+
+X86ConvLayerWinograd::~X86ConvLayerWinograd() {}
+
+int X86ConvLayerWinograd::GetDstUnit() const {
+    return dst_unit_;
+}
+
+int X86ConvLayerWinograd::SelectDstUnit(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                        const std::vector<Blob *> &outputs) {
+    if (!X86ConvLayer3x3::isPrefered(param, inputs, outputs)) {
+        return 0;
+    }
+
+    if (param->activation_type != ActivationType_None && param->activation_type != ActivationType_ReLU &&
+        param->activation_type != ActivationType_ReLU6) {
+        return 2;
+    }
+
+    const int ic = inputs[0]->GetBlobDesc().dims[1];
+    const int oc = outputs[0]->GetBlobDesc().dims[1];
+    const int oh = outputs[0]->GetBlobDesc().dims[2];
+    const int ow = outputs[0]->GetBlobDesc().dims[3];
+
+    // multiplies of the tile gemm and the transforms, padded tiles on the border count as whole tiles
+    int best_unit    = 0;
+    double best_cost = 0;
+    for (int unit = 2; unit <= 6; unit += 2) {
+        if (unit == 6 && ic > WINOGRAD_F6_MAX_IC) {
+            continue;
+        }
+        const double alpha = unit + 2;
+        const double tiles = UP_DIV(oh, unit) * UP_DIV(ow, unit);
+        const double cost  = tiles * alpha * alpha * ((double)ic * oc + 2 * alpha * (ic + oc));
+        if (best_unit == 0 || cost < best_cost) {
+            best_unit = unit;
+            best_cost = cost;
+        }
+    }
+    return best_unit;
+}
+
+std::vector<int> X86ConvLayerWinograd::SupportedDstUnits(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                                         const std::vector<Blob *> &outputs) {
+    std::vector<int> dst_units;
+    if (SelectDstUnit(param, inputs, outputs) == 0 ||
+        (param->activation_type != ActivationType_None && param->activation_type != ActivationType_ReLU &&
+         param->activation_type != ActivationType_ReLU6)) {
+        return dst_units;
+    }
+
+    dst_units.push_back(4);
+    if (inputs[0]->GetBlobDesc().dims[1] <= WINOGRAD_F6_MAX_IC) {
+        dst_units.push_back(6);
+    }
+    return dst_units;
+}
+
+Status X86ConvLayerWinograd::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                  const std::vector<Blob *> &outputs) {
+    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+
+    // c16 with the avx512 tile gemm, otherwise the same packing as X86ConvLayer3x3
+    ch_pack_ = 4;
+    if (winograd_gemm_avx512_available()) {
+        ch_pack_ = 16;
+    } else if (arch_ == avx2) {
+        ch_pack_ = 8;
+    }
+
+    if (!buffer_weight_.GetBytesSize()) {
+        const int input_channel  = dims_input[1];
+        const int output_channel = dims_output[1];
+
+        if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
+            auto pack = [&](RawBuffer &packed) -> Status {
+                // [alpha * alpha][oc / ch_pack][ic / ch_pack][ch_pack ic][ch_pack oc]
+                WinogradGenerator generator(dst_unit_, 3);
+                auto transform_weight =
+                    generator.allocTransformWeight(output_channel, input_channel, 3, 3, ch_pack_, ch_pack_);
+                generator.transformWeight(transform_weight, conv_res->filter_handle.force_to<float *>(),
+                                          output_channel, input_channel, 3, 3);
+
+                const int weight_count = DimsVectorUtils::Count(std::get<1>(transform_weight));
+                RawBuffer pack_buffer(weight_count * sizeof(float));
+                memcpy(pack_buffer.force_to<float *>(), std::get<0>(transform_weight).get(),
+                       weight_count * sizeof(float));
+
+                pack_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = pack_buffer;
+                return TNN_OK;
+            };
+            std::string variant = "winograd_" + ToString(dst_unit_) + "_" + ToString(ch_pack_);
+            RETURN_ON_NEQ(GetSharedPackedWeight(buffer_weight_, variant, pack), TNN_OK);
+        } else {
+            LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
+            return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
+        }
+    }
+    return TNN_OK;
+}
+
+// pack input to c4/c8/c16, padded up to whole tiles
+// for every tile block: input trans, one gemm per alpha * alpha position, output trans
+// write c4/c8/c16 to nchw
+Status X86ConvLayerWinograd::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
+
+    auto input       = inputs[0];
+    auto output      = outputs[0];
+    auto dims_input  = input->GetBlobDesc().dims;
+    auto dims_output = output->GetBlobDesc().dims;
+
+    auto src_origin = reinterpret_cast<float *>(input->GetHandle().base);
+    auto dst_origin = reinterpret_cast<float *>(output->GetHandle().base);
+
+    const int batch       = dims_output[0];
+    const int channel_in  = dims_input[1];
+    const int height_in   = dims_input[2];
+    const int width_in    = dims_input[3];
+    const int channel_out = dims_output[1];
+    const int height_out  = dims_output[2];
+    const int width_out   = dims_output[3];
+
+    const int pad_left = param->pads[0];
+    const int pad_top  = param->pads[2];
+
+    const int CH_PACK  = ch_pack_;
+    const int dst_unit = dst_unit_;
+    const int src_unit = dst_unit + 2;
+    const int gi_count = src_unit * src_unit;
+
+    int ic_pack = UP_DIV(channel_in, CH_PACK);
+    int oc_pack = UP_DIV(channel_out, CH_PACK);
+
+    int w_unit     = UP_DIV(width_out, dst_unit);
+    int h_unit     = UP_DIV(height_out, dst_unit);
+    int tile_total = w_unit * h_unit;
+
+    // the packed input covers whole tiles, so that no tile needs a bound check
+    int w_up   = w_unit * dst_unit;
+    int h_up   = h_unit * dst_unit;
+    int w_pack = w_up + 2;
+    int h_pack = h_up + 2;
+
+    int tile_block = WINOGRAD_TILE_BLOCK_BYTES / (gi_count * (ic_pack + oc_pack) * CH_PACK * sizeof(float));
+    tile_block     = MIN(MAX(tile_block / 12 * 12, WINOGRAD_TILE_BLOCK_MIN), WINOGRAD_TILE_BLOCK_MAX);
+    tile_block     = MIN(tile_block, tile_total);
+
+    int in_n_stride      = channel_in * width_in * height_in;
+    int out_n_stride     = channel_out * width_out * height_out;
+    int ic_pack_stride   = w_pack * h_pack * CH_PACK;
+    int oc_pack_stride   = w_up * h_up * CH_PACK;
+    int w_gi_stride      = ic_pack * oc_pack * CH_PACK * CH_PACK;
+
+    size_t bias_size        = ROUND_UP(oc_pack * CH_PACK * sizeof(float), 32);
+    size_t pack_input_size  = ROUND_UP(ic_pack * ic_pack_stride * sizeof(float), 32);
+    size_t src_trans_size   = ROUND_UP(gi_count * ic_pack * CH_PACK * tile_block * sizeof(float), 32);
+    size_t dst_trans_size   = ROUND_UP(gi_count * oc_pack * CH_PACK * tile_block * sizeof(float), 32);
+    size_t pack_output_size = ROUND_UP(oc_pack * oc_pack_stride * sizeof(float), 32);
+    float *workspace        = reinterpret_cast<float *>(context_->GetSharedWorkSpace(
+        bias_size + pack_input_size + src_trans_size + dst_trans_size + pack_output_size));
+
+    float *bias_data      = workspace;
+    float *pack_input     = bias_data + bias_size / sizeof(float);
+    float *src_trans_data = pack_input + pack_input_size / sizeof(float);
+    float *dst_trans_data = src_trans_data + src_trans_size / sizeof(float);
+    float *pack_output    = dst_trans_data + dst_trans_size / sizeof(float);
+
+    // bias buffer is only padded to 8
+    memset(bias_data, 0, oc_pack * CH_PACK * sizeof(float));
+    memcpy(bias_data, buffer_bias_.force_to<float *>(), channel_out * sizeof(float));
+    const float *weight_ptr = buffer_weight_.force_to<float *>();
+
+    auto pack_func         = pack_input_cx<4>;
+    auto unpack_func       = unpack_output_cx<4>;
+    auto input_trans_func  = input_trans<Float4, 6>;
+    auto output_trans_func = output_trans_post<Float4, 6>;
+    auto gemm_func         = X86WinogradGemm<Float4, 6, 4, 4>;
+    int vec_size           = 4;
+    if (CH_PACK >= 8) {
+        input_trans_func  = dst_unit == 6 ? input_trans<Float8, 8> : input_trans<Float8, 6>;
+        output_trans_func = dst_unit == 6 ? output_trans_post<Float8, 8> : output_trans_post<Float8, 6>;
+        vec_size          = 8;
+    } else if (dst_unit == 6) {
+        input_trans_func  = input_trans<Float4, 8>;
+        output_trans_func = output_trans_post<Float4, 8>;
+    }
+    if (CH_PACK == 16) {
+        pack_func   = pack_input_cx<16>;
+        unpack_func = unpack_output_cx<16>;
+    } else if (CH_PACK == 8) {
+        pack_func   = pack_input_cx<8>;
+        unpack_func = unpack_output_cx<8>;
+        gemm_func   = X86WinogradGemm<Float8, 6, 8, 8>;
+    }
+
+    for (int ni = 0; ni < batch; ni++) {
+        auto input_ptr  = src_origin + ni * in_n_stride;
+        auto output_ptr = dst_origin + ni * out_n_stride;
+
+        for (int i = 0; i < ic_pack; ++i) {
+            pack_func(input_ptr, pack_input + i * ic_pack_stride, i * CH_PACK, -pad_top, h_pack - pad_top, -pad_left,
+                      w_pack - pad_left, channel_in, width_in, height_in);
+        }
+
+        for (int tile_index = 0; tile_index < tile_total; tile_index += tile_block) {
+            int tile_count  = MIN(tile_total - tile_index, tile_block);
+            int b_gi_stride = tile_count * ic_pack * CH_PACK;
+            int c_gi_stride = tile_count * oc_pack * CH_PACK;
+
+            // ----------------------------------------- input trans -------------------------------------
+            for (int ti = 0; ti < tile_count; ti++) {
+                int index = tile_index + ti;
+                int src_x = (index % w_unit) * dst_unit;
+                int src_y = (index / w_unit) * dst_unit;
+
+                const float *src_ptr = pack_input + (src_y * w_pack + src_x) * CH_PACK;
+                float *dst_ptr       = src_trans_data + ti * CH_PACK;
+                for (int ci = 0; ci < ic_pack; ci++) {
+                    const float *src_ci = src_ptr + ci * ic_pack_stride;
+                    float *dst_ci       = dst_ptr + ci * tile_count * CH_PACK;
+                    for (int c = 0; c < CH_PACK; c += vec_size) {
+                        input_trans_func(src_ci + c, CH_PACK, w_pack * CH_PACK, dst_ci + c, b_gi_stride,
+                                         b_gi_stride * src_unit, bt_.data());
+                    }
+                }
+            }
+
+            // ---------------------------------------- gemm func ----------------------------------------
+            for (int gi = 0; gi < gi_count; gi++) {
+                float *trans_src          = src_trans_data + gi * b_gi_stride;
+                float *trans_dst          = dst_trans_data + gi * c_gi_stride;
+                const float *trans_weight = weight_ptr + gi * w_gi_stride;
+                if (CH_PACK == 16) {
+                    winograd_gemm_avx512(oc_pack, tile_count, ic_pack, trans_src, trans_weight, trans_dst);
+                } else {
+                    gemm_func(trans_dst, trans_src, trans_weight, nullptr, ic_pack, oc_pack, tile_count);
+                }
+            }
+
+            // ---------------------------------------- output trans --------------------------------------
+            for (int ti = 0; ti < tile_count; ti++) {
+                int index = tile_index + ti;
+                int dst_x = (index % w_unit) * dst_unit;
+                int dst_y = (index / w_unit) * dst_unit;
+
+                const float *src_ptr = dst_trans_data + ti * CH_PACK;
+                float *dst_ptr       = pack_output + (dst_y * w_up + dst_x) * CH_PACK;
+                for (int co = 0; co < oc_pack; co++) {
+                    const float *src_co = src_ptr + co * tile_count * CH_PACK;
+                    float *dst_co       = dst_ptr + co * oc_pack_stride;
+                    for (int c = 0; c < CH_PACK; c += vec_size) {
+                        output_trans_func(src_co + c, c_gi_stride, c_gi_stride * src_unit, dst_co + c, CH_PACK,
+                                          w_up * CH_PACK, at_.data(), bias_data + co * CH_PACK + c,
+                                          param->activation_type);
+                    }
+                }
+            }
+        }
+
+        for (int co = 0; co < oc_pack; co++) {
+            unpack_func(pack_output + co * oc_pack_stride, output_ptr, co * CH_PACK, channel_out, height_out,
+                        width_out, w_up);
+        }
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
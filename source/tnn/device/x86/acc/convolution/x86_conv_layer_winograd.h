@@ -0,0 +1,57 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_LAYER_ACC_WINOGRAD_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_LAYER_ACC_WINOGRAD_H_
+
+#include <vector>
+
+#include "tnn/device/x86/acc/convolution/x86_conv_layer_common.h"
+
+namespace TNN_NS {
+
+// @brief winograd F(4x4, 3x3) and F(6x6, 3x3), transform matrices come from WinogradGenerator.
+// F(2x2, 3x3) stays in X86ConvLayer3x3.
+class X86ConvLayerWinograd : public X86ConvLayerCommon {
+public:
+    explicit X86ConvLayerWinograd(int dst_unit);
+
+    virtual ~X86ConvLayerWinograd();
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // @brief output tile size with the least estimated cost, 2 means F(2x2, 3x3) is the best choice
+    // and 0 means winograd does not apply
+    static int SelectDstUnit(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                             const std::vector<Blob *> &outputs);
+
+    // @brief output tile sizes larger than 2 winograd runs with, tried by the tuner
+    static std::vector<int> SupportedDstUnits(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                              const std::vector<Blob *> &outputs);
+
+    int GetDstUnit() const;
+
+    virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+private:
+    int dst_unit_ = 4;
+    int ch_pack_  = 8;
+    // BT and AT stored by row, alpha x alpha and dst_unit x alpha
+    std::vector<float> bt_;
+    std::vector<float> at_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_X86_CONV_LAYER_ACC_WINOGRAD_H_
@@ -12,12 +12,51 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include "tnn/core/blob_int8.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
 #include "tnn/device/x86/acc/x86_binary_op_layer_acc.h"
+#include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
-DECLARE_X86_BINARY_OP_ACC(Add, X86BinaryOpType::kADD);
+class X86AddLayerAcc : public X86BinaryOpLayerAcc {
+public:
+    X86AddLayerAcc() {
+        X86BinaryOpLayerAcc::op_type_ = X86BinaryOpType::kADD;
+    }
+    virtual ~X86AddLayerAcc(){};
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+};
+
+Status X86AddLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto output = outputs[0];
+    if (output->GetBlobDesc().data_type != DATA_TYPE_INT8) {
+        return X86BinaryOpLayerAcc::DoForward(inputs, outputs);
+    }
+
+    // int8 add requires inputs with the same dims as the cpu device
+    if (inputs.size() < 2) {
+        LOGE("Error: int8 add needs at least two inputs\n");
+        return Status(TNNERR_LAYER_ERR, "Error: int8 add needs at least two inputs");
+    }
+    std::vector<int8_t *> input_ptrs;
+    std::vector<float *> scale_ptrs;
+    for (auto input : inputs) {
+        if (!DimsVectorUtils::Equal(input->GetBlobDesc().dims, output->GetBlobDesc().dims)) {
+            LOGE("Error: int8 add does not support broadcast\n");
+            return Status(TNNERR_LAYER_ERR, "Error: int8 add does not support broadcast");
+        }
+        input_ptrs.push_back(static_cast<int8_t *>(input->GetHandle().base));
+        scale_ptrs.push_back(reinterpret_cast<BlobInt8 *>(input)->GetIntResource()->scale_handle.force_to<float *>());
+    }
+    X86Int8Add(static_cast<int8_t *>(output->GetHandle().base), input_ptrs, scale_ptrs,
+               reinterpret_cast<BlobInt8 *>(inputs[0])->GetIntResource()->scale_handle.GetDataCount(),
+               reinterpret_cast<BlobInt8 *>(output)->GetIntResource()->scale_handle.force_to<float *>(),
+               output->GetBlobDesc().dims);
+    return TNN_OK;
+}
 
 REGISTER_X86_ACC(Add, LAYER_ADD);
 
-}   // namespace TNN_NS
\ No newline at end of file
+}   // namespace TNN_NS
@@ -40,7 +40,7 @@ Status X86BatchNormLayerAcc::DoForward(const std::vector<Blob *> &inputs, const
     X86_FMA(static_cast<float *>(input_blob->GetHandle().base),
             static_cast<float *>(output_blob->GetHandle().base),
             scale_handle.force_to<float *>(), bias_handle.force_to<float *>(),
-            shared_channel, has_bias, output_blob->GetBlobDesc().dims);
+            shared_channel, has_bias, output_blob->GetBlobDesc().dims, context_->GetNumThreads());
 
     return TNN_OK;
 }
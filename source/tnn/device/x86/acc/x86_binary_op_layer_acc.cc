@@ -115,12 +115,112 @@ static void BroadCastInit(const DimsVector &dims, const DimsVector &dims0, const
     }
 }
 
+// dst[i] = op(src0[i], src1[i]), operands are swapped if swap is true
+template <X86BinaryOpType op_type, typename VEC, int pack, bool swap>
+static void BinaryRange(float *dst, const float *src0, const float *src1, long count) {
+    long n = 0;
+    for (; n + pack - 1 < count; n += pack) {
+        VEC v0 = VEC::loadu(src0 + n);
+        VEC v1 = VEC::loadu(src1 + n);
+        VEC::saveu(dst + n, swap ? binary_op<op_type, VEC>(v1, v0) : binary_op<op_type, VEC>(v0, v1));
+    }
+    for (; n < count; n++) {
+        dst[n] = swap ? binary_op<op_type>(src1[n], src0[n]) : binary_op<op_type>(src0[n], src1[n]);
+    }
+}
+
+// dst[i] = op(src0[i], scalar), operands are swapped if swap is true
+template <X86BinaryOpType op_type, typename VEC, int pack, bool swap>
+static void BinaryScalarRange(float *dst, const float *src0, const float scalar, long count) {
+    VEC v1 = VEC(scalar);
+    long n = 0;
+    for (; n + pack - 1 < count; n += pack) {
+        VEC v0 = VEC::loadu(src0 + n);
+        VEC::saveu(dst + n, swap ? binary_op<op_type, VEC>(v1, v0) : binary_op<op_type, VEC>(v0, v1));
+    }
+    for (; n < count; n++) {
+        dst[n] = swap ? binary_op<op_type>(scalar, src0[n]) : binary_op<op_type>(src0[n], scalar);
+    }
+}
+
+// stride of each output dim in an operand aligned to the trailing dims, 0 for the broadcasted dims
+static DimsVector BroadcastStrides(const DimsVector &dims, const DimsVector &dims_in) {
+    DimsVector strides(dims.size(), 0);
+    int stride = 1;
+    for (int d = (int)dims.size() - 1, r = (int)dims_in.size() - 1; d >= 0 && r >= 0; d--, r--) {
+        strides[d] = dims_in[r] == 1 ? 0 : stride;
+        stride *= dims_in[r];
+    }
+    return strides;
+}
+
+// whether the broadcast types of BroadCastInit hold: the full operand has the output dims and
+// the other one is 1 in the dims the type repeats it over
+static bool IsBroadcastTypeOf(BroadcastType type, const DimsVector &dims, const DimsVector &dims_full,
+                              const DimsVector &dims_broadcast) {
+    if (type == BroadcastTypeNormal) {
+        return true;
+    }
+    if (!DimsVectorUtils::Equal(dims_full, dims)) {
+        return false;
+    }
+    switch (type) {
+        case BroadcastTypeSingle:
+            return DimsVectorUtils::Count(dims_broadcast) == 1;
+        case BroadcastTypeChannel:
+            return DimsVectorUtils::Count(dims_broadcast, 0, 1) == 1 && DimsVectorUtils::Count(dims_broadcast, 2) == 1;
+        case BroadcastTypeElement:
+            return DimsVectorUtils::Count(dims_broadcast, 0, 1) == 1;
+        case BroadcastTypeHeightWidth:
+            return DimsVectorUtils::Count(dims_broadcast, 0, 2) == 1;
+        case BroadcastTypeWidth:
+            return DimsVectorUtils::Count(dims_broadcast, 0, 3) == 1;
+        default:
+            return false;
+    }
+}
+
+/*
+any other broadcast, e.g. a [2, 1, 1, w] mask of [2, c, h, w] scores, row by row with the strides of each operand
+*/
+template <X86BinaryOpType op_type, typename VEC, int pack>
+static Status BinaryGeneralFunc(float *output_ptr, const float *input0_ptr, const float *input1_ptr,
+                                const DimsVector &dims, const DimsVector &dims0, const DimsVector &dims1,
+                                int num_threads) {
+    auto strides0    = BroadcastStrides(dims, dims0);
+    auto strides1    = BroadcastStrides(dims, dims1);
+    const long width = dims[3];
+    const long rows  = DimsVectorUtils::Count(dims) / width;
+
+    X86ParallelFor(num_threads, rows, UP_DIV(4096, width), [&](long begin, long end) {
+        for (long r = begin; r < end; r++) {
+            const long h = r % dims[2];
+            const long c = r / dims[2] % dims[1];
+            const long n = r / dims[2] / dims[1];
+            auto src0    = input0_ptr + n * strides0[0] + c * strides0[1] + h * strides0[2];
+            auto src1    = input1_ptr + n * strides1[0] + c * strides1[1] + h * strides1[2];
+            auto dst     = output_ptr + r * width;
+            if (strides0[3] && strides1[3]) {
+                BinaryRange<op_type, VEC, pack, false>(dst, src0, src1, width);
+            } else if (strides0[3]) {
+                BinaryScalarRange<op_type, VEC, pack, false>(dst, src0, src1[0], width);
+            } else if (strides1[3]) {
+                BinaryScalarRange<op_type, VEC, pack, true>(dst, src1, src0[0], width);
+            } else {
+                dst[0] = binary_op<op_type>(src0[0], src1[0]);
+            }
+        }
+    });
+    return TNN_OK;
+}
+
 /*
 Binary func with different opreator,
 set dims0 full shape, dims1 broadcast shape, so we need to swap input ptrs
 */
 template <X86BinaryOpType op_type, typename VEC, int pack>
-Status BinaryFunc(float *output_ptr, const float *input0_ptr, const float *input1_ptr, DimsVector &dims0, DimsVector &dims1) {
+Status BinaryFunc(float *output_ptr, const float *input0_ptr, const float *input1_ptr, DimsVector &dims0, DimsVector &dims1,
+                  int num_threads) {
     DimsVector dims = DimsVectorUtils::Max(dims0, dims1);
     DimsVector dims_broadcast;
     BroadcastType type = BroadcastTypeUnknown;
@@ -137,196 +237,65 @@ Status BinaryFunc(float *output_ptr, const float *input0_ptr, const float *input
     if (dims_broadcast.size()) {
         type = (dims_broadcast[1] == 1) ? BroadcastTypeSingle : BroadcastTypeChannel;
     }
+    if (!IsBroadcastTypeOf(type, dims, swap_flag ? dims1 : dims0, swap_flag ? dims0 : dims1)) {
+        return BinaryGeneralFunc<op_type, VEC, pack>(output_ptr, input0_ptr, input1_ptr, dims, dims0, dims1,
+                                                     num_threads);
+    }
 
-    size_t count = dims[0] * dims[1] * dims[2] * dims[3];
-    size_t batch_stride = dims[1] * dims[2] * dims[3];
-    size_t channel_stride = dims[2] * dims[3];
+    long count          = dims[0] * dims[1] * dims[2] * dims[3];
+    long batch_stride   = dims[1] * dims[2] * dims[3];
+    long channel_stride = dims[2] * dims[3];
 
-    if (type == BroadcastTypeNormal) {
-        size_t n = 0;
-        for (; n + pack - 1 < count; n += pack) {
-            VEC v1 = VEC::loadu(_input0 + n);
-            VEC v2 = VEC::loadu(_input1 + n);
-            VEC::saveu(output_ptr + n, binary_op<op_type, VEC>(v1, v2));
-        }
-        for (; n < count; n++) {
-            output_ptr[n] = binary_op<op_type>(_input0[n], _input1[n]);
-        }
-        return TNN_OK;
-    }
+    // minimum number of floats processed by one thread
+    const long grain = 4096;
+    auto range_func  = swap_flag ? BinaryRange<op_type, VEC, pack, true> : BinaryRange<op_type, VEC, pack, false>;
+    auto scalar_func =
+        swap_flag ? BinaryScalarRange<op_type, VEC, pack, true> : BinaryScalarRange<op_type, VEC, pack, false>;
 
-    if (swap_flag) {
-        if (type == BroadcastTypeSingle) {
-            // broadcast single
-            VEC v2 = VEC(_input1[0]);
-            size_t n = 0;
-            for (; n + pack - 1 < count; n += pack) {
-                VEC v1 = VEC::loadu(_input0 + n);
-                VEC::saveu(output_ptr + n, binary_op<op_type, VEC>(v2, v1));
-            }
-            for (; n < count; n++) {
-                output_ptr[n] = binary_op<op_type>(_input1[0], _input0[n]);
-            }
-        } else if (type == BroadcastTypeChannel) {
-            // broadcast channel
-            for (int b = 0; b < dims[0]; b++) {
-                for (int c = 0; c < dims[1]; c++) {
-                    VEC v2 = VEC(_input1[c]);
-                    auto _input0_c = _input0 + b * batch_stride + c * channel_stride;
-                    auto _output_c = output_ptr + b * batch_stride + c * channel_stride;
-                    int hw = 0;
-                    for (; hw + pack - 1 < channel_stride; hw += pack) {
-                        VEC v1 = VEC::loadu(_input0_c + hw);
-                        VEC::saveu(_output_c + hw, binary_op<op_type, VEC>(v2, v1));
-                    }
-                    for (; hw < channel_stride; hw++) {
-                        _output_c[hw] = binary_op<op_type>(_input1[c], _input0_c[hw]);
-                    }
-                }
+    if (type == BroadcastTypeNormal) {
+        X86ParallelFor(num_threads, count, grain, [&](long begin, long end) {
+            range_func(output_ptr + begin, _input0 + begin, _input1 + begin, end - begin);
+        });
+    } else if (type == BroadcastTypeSingle) {
+        // broadcast single
+        X86ParallelFor(num_threads, count, grain, [&](long begin, long end) {
+            scalar_func(output_ptr + begin, _input0 + begin, _input1[0], end - begin);
+        });
+    } else if (type == BroadcastTypeChannel) {
+        // broadcast channel
+        X86ParallelFor(num_threads, dims[0] * dims[1], UP_DIV(grain, channel_stride), [&](long begin, long end) {
+            for (long bc = begin; bc < end; bc++) {
+                long offset = bc * channel_stride;
+                scalar_func(output_ptr + offset, _input0 + offset, _input1[bc % dims[1]], channel_stride);
             }
-        } else if (type == BroadcastTypeElement) {
-            // broadcast chw
+        });
+    } else if (type == BroadcastTypeElement) {
+        // broadcast chw
+        X86ParallelFor(num_threads, batch_stride, UP_DIV(grain, dims[0]), [&](long begin, long end) {
             for (int b = 0; b < dims[0]; b++) {
-                auto _input0_b = _input0 + b * batch_stride;
-                auto _output_b = output_ptr + b * batch_stride;
-                int chw = 0;
-                for (; chw + pack - 1 < batch_stride; chw += pack) {
-                    VEC v2 = VEC::loadu(_input1 + chw);
-                    VEC v1 = VEC::loadu(_input0_b + chw);
-                    VEC::saveu(_output_b + chw, binary_op<op_type, VEC>(v2, v1));
-                }
-                for (; chw < batch_stride; chw++) {
-                    _output_b[chw] = binary_op<op_type>(_input1[chw], _input0_b[chw]);
-                }
+                long offset = b * batch_stride + begin;
+                range_func(output_ptr + offset, _input0 + offset, _input1 + begin, end - begin);
             }
-        } else if (type == BroadcastTypeHeightWidth) {
-            // broadcast hw
-            for (int b = 0; b < dims[0]; b++) {
-                for (int c = 0; c < dims[1]; c++) {
-                    auto _input0_c = _input0 + b * batch_stride + c * channel_stride;
-                    auto _output_c = output_ptr + b * batch_stride + c * channel_stride;
-                    int hw = 0;
-                    for (; hw + pack - 1 < channel_stride; hw += pack) {
-                        VEC v2 = VEC::loadu(_input1 + hw);
-                        VEC v1 = VEC::loadu(_input0_c + hw);
-                        VEC::saveu(_output_c + hw, binary_op<op_type, VEC>(v2, v1));
-                    }
-                    for (; hw < channel_stride; hw++) {
-                        _output_c[hw] = binary_op<op_type>(_input1[hw], _input0_c[hw]);
-                    }
-                }
+        });
+    } else if (type == BroadcastTypeHeightWidth) {
+        // broadcast hw
+        X86ParallelFor(num_threads, dims[0] * dims[1], UP_DIV(grain, channel_stride), [&](long begin, long end) {
+            for (long bc = begin; bc < end; bc++) {
+                long offset = bc * channel_stride;
+                range_func(output_ptr + offset, _input0 + offset, _input1, channel_stride);
             }
-        } else if (type == BroadcastTypeWidth) {
-            // broadcast w
-            for (int b = 0; b < dims[0]; b++) {
-                for (int c = 0; c < dims[1]; c++) {
-                    auto _input0_c = _input0 + b * batch_stride + c * channel_stride;
-                    auto _output_c = output_ptr + b * batch_stride + c * channel_stride;
-                    for (int h = 0; h < dims[2]; h++) {
-                        auto _input0_h = _input0_c + h * dims[3];
-                        auto _output_h = _output_c + h * dims[3];
-                        int w = 0;
-                        for (; w + pack - 1 < dims[3]; w += pack) {
-                            VEC v2 = VEC::loadu(_input1 + w);
-                            VEC v1 = VEC::loadu(_input0_h + w);
-                            VEC::saveu(_output_h + h, binary_op<op_type, VEC>(v2, v1));
-                        }
-                        for (; w < dims[3]; w++) {
-                            _output_h[w] = binary_op<op_type>(_input1[w], _input0_h[w]);
-                        }
-                    }
-                }
+        });
+    } else if (type == BroadcastTypeWidth) {
+        // broadcast w
+        X86ParallelFor(num_threads, count / dims[3], UP_DIV(grain, dims[3]), [&](long begin, long end) {
+            for (long h = begin; h < end; h++) {
+                long offset = h * dims[3];
+                range_func(output_ptr + offset, _input0 + offset, _input1, dims[3]);
             }
-        } else {
-            LOGE("Error: invalid add type\n");
-            return Status(TNNERR_LAYER_ERR, "Error: Binary layer's unsupported broadcast type");
-        }
+        });
     } else {
-        if (type == BroadcastTypeSingle) {
-            // broadcast single
-            VEC v2 = VEC(_input1[0]);
-            size_t n = 0;
-            for (; n + pack - 1 < count; n += pack) {
-                VEC v1 = VEC::loadu(_input0 + n);
-                VEC::saveu(output_ptr + n, binary_op<op_type, VEC>(v1, v2));
-            }
-            for (; n < count; n++) {
-                output_ptr[n] = binary_op<op_type>(_input0[n], _input1[0]);
-            }
-        } else if (type == BroadcastTypeChannel) {
-            // broadcast channel
-            for (int b = 0; b < dims[0]; b++) {
-                for (int c = 0; c < dims[1]; c++) {
-                    VEC v2 = VEC(_input1[c]);
-                    auto _input0_c = _input0 + b * batch_stride + c * channel_stride;
-                    auto _output_c = output_ptr + b * batch_stride + c * channel_stride;
-                    int hw = 0;
-                    for (; hw + pack - 1 < channel_stride; hw += pack) {
-                        VEC v1 = VEC::loadu(_input0_c + hw);
-                        VEC::saveu(_output_c + hw, binary_op<op_type, VEC>(v1, v2));
-                    }
-                    for (; hw < channel_stride; hw++) {
-                        _output_c[hw] = binary_op<op_type>(_input0_c[hw], _input1[c]);
-                    }
-                }
-            }
-        } else if (type == BroadcastTypeElement) {
-            // broadcast chw
-            for (int b = 0; b < dims[0]; b++) {
-                auto _input0_b = _input0 + b * batch_stride;
-                auto _output_b = output_ptr + b * batch_stride;
-                int chw = 0;
-                for (; chw + pack - 1 < batch_stride; chw += pack) {
-                    VEC v2 = VEC::loadu(_input1 + chw);
-                    VEC v1 = VEC::loadu(_input0_b + chw);
-                    VEC::saveu(_output_b + chw, binary_op<op_type, VEC>(v1, v2));
-                }
-                for (; chw < batch_stride; chw++) {
-                    _output_b[chw] = binary_op<op_type>(_input0_b[chw], _input1[chw]);
-                }
-            }
-        } else if (type == BroadcastTypeHeightWidth) {
-            // broadcast hw
-            for (int b = 0; b < dims[0]; b++) {
-                for (int c = 0; c < dims[1]; c++) {
-                    auto _input0_c = _input0 + b * batch_stride + c * channel_stride;
-                    auto _output_c = output_ptr + b * batch_stride + c * channel_stride;
-                    int hw = 0;
-                    for (; hw + pack - 1 < channel_stride; hw += pack) {
-                        VEC v2 = VEC::loadu(_input1 + hw);
-                        VEC v1 = VEC::loadu(_input0_c + hw);
-                        VEC::saveu(_output_c + hw, binary_op<op_type, VEC>(v1, v2));
-                    }
-                    for (; hw < channel_stride; hw++) {
-                        _output_c[hw] = binary_op<op_type>(_input0_c[hw], _input1[hw]);
-                    }
-                }
-            }
-        } else if (type == BroadcastTypeWidth) {
-            // broadcast w
-            for (int b = 0; b < dims[0]; b++) {
-                for (int c = 0; c < dims[1]; c++) {
-                    auto _input0_c = _input0 + b * batch_stride + c * channel_stride;
-                    auto _output_c = output_ptr + b * batch_stride + c * channel_stride;
-                    for (int h = 0; h < dims[2]; h++) {
-                        auto _input0_h = _input0_c + h * dims[3];
-                        auto _output_h = _output_c + h * dims[3];
-                        int w = 0;
-                        for (; w + pack - 1 < dims[3]; w += pack) {
-                            VEC v2 = VEC::loadu(_input1 + w);
-                            VEC v1 = VEC::loadu(_input0_h + w);
-                            VEC::saveu(_output_h + h, binary_op<op_type, VEC>(v1, v2));
-                        }
-                        for (; w < dims[3]; w++) {
-                            _output_h[w] = binary_op<op_type>(_input0_h[w], _input1[w]);
-                        }
-                    }
-                }
-            }
-        } else {
-            LOGE("Error: invalid add type\n");
-            return Status(TNNERR_LAYER_ERR, "Error: Binary layer's unsupported broadcast type");
-        }
+        LOGE("Error: invalid add type\n");
+        return Status(TNNERR_LAYER_ERR, "Error: Binary layer's unsupported broadcast type");
     }
 
     return TNN_OK;
@@ -438,11 +407,13 @@ Status X86BinaryOpLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
         }
     }
 
-    binary_func(output_ptr, input0_ptr, input1_ptr, input_shapes[0], input_shapes[1]);
+    const int num_threads = context_->GetNumThreads();
+    RETURN_ON_NEQ(binary_func(output_ptr, input0_ptr, input1_ptr, input_shapes[0], input_shapes[1], num_threads),
+                  TNN_OK);
 
     for (int i = 2; i < input_ptrs.size(); i++) {
         auto input_ptr = reinterpret_cast<float *>(input_ptrs[i]);
-        binary_func(output_ptr, output_ptr, input_ptr, dims, input_shapes[i]);
+        RETURN_ON_NEQ(binary_func(output_ptr, output_ptr, input_ptr, dims, input_shapes[i], num_threads), TNN_OK);
     }
 
     return TNN_OK;
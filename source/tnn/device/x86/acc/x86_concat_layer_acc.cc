@@ -12,6 +12,8 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include "tnn/core/blob_int8.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/device/x86/x86_device.h"
 #include "tnn/utils/dims_vector_utils.h"
@@ -51,19 +53,53 @@ Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
         concate_size *= dims[i];
     }
 
+    // int8 inputs with per tensor scales are requantized to the output scale, same as the cpu device
+    bool int8_per_tensor_flag = false;
+    if (output->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        int8_per_tensor_flag = true;
+        for (auto &blob : inputs) {
+            if (reinterpret_cast<BlobInt8 *>(blob)->GetIntResource()->scale_handle.GetDataCount() > 1) {
+                int8_per_tensor_flag = false;
+                break;
+            }
+        }
+    }
+
     auto datasize                 = DataTypeUtils::GetBytesSize(input->GetBlobDesc().data_type);
     int8_t *output_data           = static_cast<int8_t *>(output->GetHandle().base);
     int output_concat_axis        = output->GetBlobDesc().dims[axis];
     int output_concat_axis_offset = 0;
+    const int num_threads         = context_->GetNumThreads();
     for (size_t i = 0; i < inputs.size(); ++i) {
         // use int8_t for all types
         int8_t *input_data          = static_cast<int8_t *>(inputs[i]->GetHandle().base);
         const int input_concat_axis = inputs[i]->GetBlobDesc().dims[axis];
-        for (int n = 0; n < num_concats; ++n) {
-            memcpy(output_data + (n * output_concat_axis + output_concat_axis_offset) * concate_size * datasize,
-                   input_data + n * input_concat_axis * concate_size * datasize,
-                   input_concat_axis * concate_size * datasize);
+        // bytes of one slice copied from this input, the slices are split into byte ranges among threads
+        const long slice_size = static_cast<long>(input_concat_axis) * concate_size * datasize;
+        float input_scale     = 1.f;
+        float output_scale    = 1.f;
+        if (int8_per_tensor_flag) {
+            auto input_resource  = reinterpret_cast<BlobInt8 *>(inputs[i])->GetIntResource();
+            auto output_resource = reinterpret_cast<BlobInt8 *>(output)->GetIntResource();
+            input_scale          = input_resource->scale_handle.force_to<float *>()[0];
+            output_scale         = output_resource->scale_handle.force_to<float *>()[0];
         }
+        X86ParallelFor(num_threads, num_concats * slice_size, 64 * 1024, [&](long begin, long end) {
+            for (long pos = begin; pos < end;) {
+                const long n     = pos / slice_size;
+                const long start = pos % slice_size;
+                const long len   = MIN(end - pos, slice_size - start);
+                pos += len;
+
+                auto dst = output_data + (n * output_concat_axis + output_concat_axis_offset) * concate_size * datasize;
+                auto src = input_data + n * slice_size;
+                if (int8_per_tensor_flag) {
+                    X86Int8Requant(dst + start, src + start, input_scale, output_scale, len);
+                } else {
+                    memcpy(dst + start, src + start, len);
+                }
+            }
+        });
         output_concat_axis_offset += input_concat_axis;
     }
     return TNN_OK;
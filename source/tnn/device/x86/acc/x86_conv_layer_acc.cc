@@ -13,11 +13,25 @@
 // specific language governing permissions and limitations under the License.
 
 #include "x86_conv_layer_acc.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
 #include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_acc_factory.h"
+#include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/utils/blob_memory_size_utils.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
+// timed runs of each candidate, the fastest one counts
+static const int kTuneRuns = 3;
+
 Status X86ConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                              const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto conv_param    = dynamic_cast<ConvLayerParam *>(param);
@@ -25,12 +39,23 @@ Status X86ConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
     auto conv_resource = dynamic_cast<ConvLayerResource *>(resource);
     CHECK_PARAM_NULL(conv_resource);
 
+    if (conv_resource->filter_handle.GetDataType() == DATA_TYPE_HALF) {
+        LayerResource *fp32_res = nullptr;
+        RETURN_ON_NEQ(ConvertHalfResource(LAYER_CONVOLUTION, conv_resource, &fp32_res), TNN_OK);
+        conv_acc_f32_resource_ = std::shared_ptr<LayerResource>(fp32_res);
+        resource               = conv_acc_f32_resource_.get();
+    }
+
     Status ret = X86LayerAcc::Init(context, param, resource, inputs, outputs);
     if (ret != TNN_OK) {
         return ret;
     }
 
-    X86ConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
+    if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        X86ConvLayerAccFactory::CreateImpInt8(inputs, outputs, param_, conv_acc_impl_);
+    } else {
+        X86ConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
+    }
 
     if (!conv_acc_impl_) {
         return Status(TNNERR_NET_ERR, "Could not create conv impl_");
@@ -40,6 +65,119 @@ Status X86ConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
     return TNN_OK;
 }
 
+Status X86ConvLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (!conv_acc_impl_) {
+        return TNN_OK;
+    }
+    if (context_->GetEnableTuneKernel() && outputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+        RETURN_ON_NEQ(TuneImpl(inputs, outputs), TNN_OK);
+    }
+    return conv_acc_impl_->Reshape(inputs, outputs);
+}
+
+// the cache file is keyed by the model, the entries by the cpu, the threads and the conv shape
+std::string X86ConvLayerAcc::GetTuneKey(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ConvLayerParam *>(param_);
+    std::stringstream key;
+    key << "conv_" << cpu_model_name() << "_t" << context_->GetNumThreads() << "_i";
+    for (auto dim : inputs[0]->GetBlobDesc().dims) {
+        key << "_" << dim;
+    }
+    key << "_o";
+    for (auto dim : outputs[0]->GetBlobDesc().dims) {
+        key << "_" << dim;
+    }
+    key << "_k" << param->kernels[0] << "x" << param->kernels[1] << "_s" << param->strides[0] << "x"
+        << param->strides[1] << "_d" << param->dialations[0] << "x" << param->dialations[1] << "_p"
+        << param->pads[0] << "x" << param->pads[1] << "x" << param->pads[2] << "x" << param->pads[3] << "_g"
+        << param->group << "_a" << param->activation_type << "_f" << param->fusion_type;
+    return key.str();
+}
+
+/*
+The candidates are timed on blobs of their own, the blobs of the network may be shared
+with other instances or not allocated yet. The winner is created again on the real blobs.
+*/
+Status X86ConvLayerAcc::TuneImpl(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto key = GetTuneKey(inputs, outputs);
+    if (key == tuned_key_) {
+        return TNN_OK;
+    }
+
+    auto candidates = X86ConvLayerAccFactory::GetCandidatesFP(inputs, outputs, param_);
+    if (candidates.size() <= 1) {
+        tuned_key_ = key;
+        return TNN_OK;
+    }
+
+    auto &tune_map = context_->GetKernelTuneMap();
+    X86ConvImplConfig best_config;
+    bool cached = false;
+    if (tune_map.count(key) > 0) {
+        best_config = X86ConvImplConfig(tune_map[key]);
+        cached      = std::find(candidates.begin(), candidates.end(), best_config) != candidates.end();
+    }
+
+    if (!cached) {
+        std::vector<std::shared_ptr<Blob>> tune_blobs;
+        auto create_tune_blobs = [&](const std::vector<Blob *> &blobs, std::vector<Blob *> &tune_list) {
+            for (auto blob : blobs) {
+                auto desc      = blob->GetBlobDesc();
+                auto tune_blob = std::make_shared<Blob>(desc, true);
+                if (!tune_blob->GetHandle().base) {
+                    return Status(TNNERR_OUTOFMEMORY, "x86 conv tuner failed to allocate blobs");
+                }
+                auto size_info = GetDevice(DEVICE_X86)->Calculate(desc);
+                memset(tune_blob->GetHandle().base, 0, GetBlobMemoryBytesSize(size_info));
+                tune_blobs.push_back(tune_blob);
+                tune_list.push_back(tune_blob.get());
+            }
+            return Status(TNN_OK);
+        };
+        std::vector<Blob *> tune_inputs, tune_outputs;
+        RETURN_ON_NEQ(create_tune_blobs(inputs, tune_inputs), TNN_OK);
+        RETURN_ON_NEQ(create_tune_blobs(outputs, tune_outputs), TNN_OK);
+
+        OMP_SET_THREADS_(context_->GetNumThreads());
+        double best_time = -1;
+        for (const auto &config : candidates) {
+            std::shared_ptr<X86LayerAcc> impl;
+            X86ConvLayerAccFactory::CreateImpFP(config, impl);
+            // the first run warms up the weights and the work space
+            if (impl->Init(context_, param_, resource_, tune_inputs, tune_outputs) != TNN_OK ||
+                impl->DoForward(tune_inputs, tune_outputs) != TNN_OK) {
+                continue;
+            }
+
+            double time = DBL_MAX;
+            for (int i = 0; i < kTuneRuns; i++) {
+                auto start = std::chrono::steady_clock::now();
+                impl->DoForward(tune_inputs, tune_outputs);
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                time = std::min(time, elapsed.count());
+            }
+            if (best_time < 0 || time < best_time) {
+                best_time   = time;
+                best_config = config;
+            }
+        }
+        if (best_time < 0) {
+            LOGE("x86 conv tuner got no runnable impl for %s\n", key.c_str());
+            return Status(TNNERR_LAYER_ERR, "x86 conv tuner got no runnable impl");
+        }
+        tune_map[key] = best_config.ToVector();
+        LOGD("x86 conv tuner picked impl %d unit %d blocking %d x %d for %s\n", best_config.type,
+             best_config.dst_unit, best_config.m_c, best_config.k_c, key.c_str());
+    }
+
+    std::shared_ptr<X86LayerAcc> impl;
+    X86ConvLayerAccFactory::CreateImpFP(best_config, impl);
+    RETURN_ON_NEQ(impl->Init(context_, param_, resource_, inputs, outputs), TNN_OK);
+    conv_acc_impl_ = impl;
+    tuned_key_     = key;
+    return TNN_OK;
+}
+
 Status X86ConvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     if (conv_acc_impl_) {
         return conv_acc_impl_->DoForward(inputs, outputs);
@@ -48,6 +186,12 @@ Status X86ConvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     }
 }
 
+#if TNN_PROFILE
+std::string X86ConvLayerAcc::GetImplName() {
+    return conv_acc_impl_ ? conv_acc_impl_->GetImplName() : X86LayerAcc::GetImplName();
+}
+#endif
+
 REGISTER_X86_ACC(Conv, LAYER_CONVOLUTION);
 
 }   // namespace TNN_NS
\ No newline at end of file
@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_ACC_X86_CONV_LAYER_ACC_H
 #define TNN_SOURCE_TNN_DEVICE_X86_ACC_X86_CONV_LAYER_ACC_H
 
+#include <string>
 #include <vector>
 
 #include "tnn/core/blob.h"
@@ -30,10 +31,26 @@ public:
     Status Init(Context *context, LayerParam *param, LayerResource *resource,
                 const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
+    // @brief with kernel tuning enabled, the impl is tuned for the new shape
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
+#if TNN_PROFILE
+    virtual std::string GetImplName() override;
+#endif
+
 protected:
     std::shared_ptr<X86LayerAcc> conv_acc_impl_ = nullptr;
+    // fp32 copy of a half resource
+    std::shared_ptr<LayerResource> conv_acc_f32_resource_ = nullptr;
+
+private:
+    // @brief pick the fastest candidate impl, the results are cached in the context by GetTuneKey
+    Status TuneImpl(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    std::string GetTuneKey(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    std::string tuned_key_ = "";
 };
 
 }   // namespace TNN_NS
@@ -0,0 +1,292 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/utils/attention_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+/*
+ * softmax(scale * Q K + mask) V without the scores in memory. each task takes blocks of kQueryBlock query rows and
+ * walks the keys in blocks of kKeyBlock, the K and V blocks stay in cache for all rows of the query block.
+ * a row keeps the running max and sum of its online softmax, the output accumulated so far is rescaled when the
+ * max grows, so only one block of scores per row exists at any time and the memory traffic is linear in the
+ * sequence length.
+ */
+class X86FusedAttentionLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86FusedAttentionLayerAcc(){};
+
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+#if TNN_PROFILE
+    virtual double GetFlops() override;
+    virtual double GetBandwidth() override;
+#endif
+
+protected:
+    // q, k and v are batched matmul operands of any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) override;
+
+private:
+    AttentionShape shape_;
+    // elements of all inputs and the output
+    double data_count_ = 0;
+};
+
+static const int kQueryBlock = 16;
+static const int kKeyBlock   = 64;
+
+std::vector<DataFormat> X86FusedAttentionLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    return SupportAnyRankDataFormat(data_type, dims_size);
+}
+
+Status X86FusedAttentionLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (inputs.size() < 3) {
+        return Status(TNNERR_PARAM_ERR, "FusedAttention needs the query, key and value inputs");
+    }
+    DimsVector mask_dims = inputs.size() > 3 ? inputs[3]->GetBlobDesc().dims : DimsVector();
+    RETURN_ON_NEQ(GetAttentionShape(inputs[0]->GetBlobDesc().dims, inputs[1]->GetBlobDesc().dims,
+                                    inputs[2]->GetBlobDesc().dims, mask_dims, shape_),
+                  TNN_OK);
+    data_count_ = DimsVectorUtils::Count(shape_.output_dims);
+    for (auto blob : inputs) {
+        data_count_ += DimsVectorUtils::Count(blob->GetBlobDesc().dims);
+    }
+    return TNN_OK;
+}
+
+#if TNN_PROFILE
+double X86FusedAttentionLayerAcc::GetFlops() {
+    const double rows = 1.0 * shape_.q_index.size() * shape_.query_len * shape_.key_len;
+    return 2.0 * rows * (shape_.head_size + shape_.value_size) / 1e6;
+}
+
+double X86FusedAttentionLayerAcc::GetBandwidth() {
+    return data_count_ * sizeof(float) / 1e6;
+}
+#endif
+
+template <typename VEC, int pack>
+static float HorizontalSum(const VEC &v) {
+    float buffer[pack];
+    VEC::saveu(buffer, v);
+    float sum = 0.f;
+    for (int i = 0; i < pack; i++) {
+        sum += buffer[i];
+    }
+    return sum;
+}
+
+template <typename VEC, int pack>
+static float HorizontalMax(const VEC &v) {
+    float buffer[pack];
+    VEC::saveu(buffer, v);
+    float max = buffer[0];
+    for (int i = 1; i < pack; i++) {
+        max = std::max(max, buffer[i]);
+    }
+    return max;
+}
+
+// y[cols] += x[rows] m[rows, cols], four vectors of y stay in registers over all rows of m
+template <typename VEC, int pack>
+static void RowTimesMatrix(const float *x, int rows, const float *m, int ldm, int cols, float *y) {
+    int c = 0;
+    for (; c + 4 * pack - 1 < cols; c += 4 * pack) {
+        VEC y0 = VEC::loadu(y + c);
+        VEC y1 = VEC::loadu(y + c + pack);
+        VEC y2 = VEC::loadu(y + c + 2 * pack);
+        VEC y3 = VEC::loadu(y + c + 3 * pack);
+        for (int r = 0; r < rows; r++) {
+            const float *m_r = m + r * ldm + c;
+            VEC x_r(x[r]);
+            VEC::mla(y0, x_r, VEC::loadu(m_r));
+            VEC::mla(y1, x_r, VEC::loadu(m_r + pack));
+            VEC::mla(y2, x_r, VEC::loadu(m_r + 2 * pack));
+            VEC::mla(y3, x_r, VEC::loadu(m_r + 3 * pack));
+        }
+        VEC::saveu(y + c, y0);
+        VEC::saveu(y + c + pack, y1);
+        VEC::saveu(y + c + 2 * pack, y2);
+        VEC::saveu(y + c + 3 * pack, y3);
+    }
+    for (; c + pack - 1 < cols; c += pack) {
+        VEC y0 = VEC::loadu(y + c);
+        for (int r = 0; r < rows; r++) {
+            VEC::mla(y0, VEC(x[r]), VEC::loadu(m + r * ldm + c));
+        }
+        VEC::saveu(y + c, y0);
+    }
+    for (; c < cols; c++) {
+        float sum = y[c];
+        for (int r = 0; r < rows; r++) {
+            sum += x[r] * m[r * ldm + c];
+        }
+        y[c] = sum;
+    }
+}
+
+// y = a * x
+template <typename VEC, int pack>
+static void ScaleRow(const float *x, float a, int count, float *y) {
+    VEC a_v(a);
+    int i = 0;
+    for (; i + pack - 1 < count; i += pack) {
+        VEC::saveu(y + i, VEC::mul(VEC::loadu(x + i), a_v));
+    }
+    for (; i < count; i++) {
+        y[i] = x[i] * a;
+    }
+}
+
+/*
+ * s = exp(s - max) of one block of scores with the running max of the row updated, returns the sum of the block.
+ * alpha = exp(old max - new max) rescales what the row accumulated before.
+ */
+template <typename VEC, int pack>
+static float ExpBlock(float *s, int count, float &row_max, float &alpha) {
+    VEC max_v(-FLT_MAX);
+    int i = 0;
+    for (; i + pack - 1 < count; i += pack) {
+        max_v = VEC::max(max_v, VEC::loadu(s + i));
+    }
+    float block_max = HorizontalMax<VEC, pack>(max_v);
+    for (; i < count; i++) {
+        block_max = std::max(block_max, s[i]);
+    }
+    const float new_max = std::max(row_max, block_max);
+    alpha               = std::exp(row_max - new_max);
+    row_max             = new_max;
+
+    VEC new_max_v(new_max), sum_v(0.f);
+    for (i = 0; i + pack - 1 < count; i += pack) {
+        VEC e = VEC::exp(VEC::sub(VEC::loadu(s + i), new_max_v));
+        VEC::saveu(s + i, e);
+        sum_v = VEC::add(sum_v, e);
+    }
+    float sum = HorizontalSum<VEC, pack>(sum_v);
+    for (; i < count; i++) {
+        s[i] = std::exp(s[i] - new_max);
+        sum += s[i];
+    }
+    return sum;
+}
+
+// buffers of a task, q_buf [kQueryBlock, D], s [kKeyBlock], o [kQueryBlock, Dv], row_max and row_sum [kQueryBlock]
+static size_t TaskBufferSize(int D, int Dv) {
+    return ROUND_UP(kQueryBlock * D, 8) + kKeyBlock + ROUND_UP(kQueryBlock * Dv, 8) + 2 * kQueryBlock;
+}
+
+/*
+ * rows query rows from q of one output matrix, mask points to the mask of the first row or is nullptr
+ */
+template <typename VEC, int pack>
+static void AttentionQueryBlock(const float *q, const float *k, const float *v, const float *mask, int rows,
+                                const AttentionShape &shape, float scale, float *output, float *buffer) {
+    const int Sk = shape.key_len, D = shape.head_size, Dv = shape.value_size;
+    float *q_buf   = buffer;
+    float *s       = q_buf + ROUND_UP(kQueryBlock * D, 8);
+    float *o       = s + kKeyBlock;
+    float *row_max = o + ROUND_UP(kQueryBlock * Dv, 8);
+    float *row_sum = row_max + kQueryBlock;
+
+    // the scale goes to the queries, the scores start from the mask
+    ScaleRow<VEC, pack>(q, scale, rows * D, q_buf);
+    memset(o, 0, rows * Dv * sizeof(float));
+    for (int i = 0; i < rows; i++) {
+        row_max[i] = -FLT_MAX;
+        row_sum[i] = 0.f;
+    }
+
+    for (int k0 = 0; k0 < Sk; k0 += kKeyBlock) {
+        const int cur_k = std::min(kKeyBlock, Sk - k0);
+        for (int i = 0; i < rows; i++) {
+            float *o_i = o + i * Dv;
+            if (!mask) {
+                memset(s, 0, cur_k * sizeof(float));
+            } else if (shape.mask_col_stride) {
+                memcpy(s, mask + i * shape.mask_row_stride + k0, cur_k * sizeof(float));
+            } else {
+                std::fill(s, s + cur_k, mask[i * shape.mask_row_stride]);
+            }
+            RowTimesMatrix<VEC, pack>(q_buf + i * D, D, k + k0, Sk, cur_k, s);
+
+            float alpha     = 1.f;
+            float block_sum = ExpBlock<VEC, pack>(s, cur_k, row_max[i], alpha);
+            row_sum[i]      = row_sum[i] * alpha + block_sum;
+            if (alpha != 1.f) {
+                ScaleRow<VEC, pack>(o_i, alpha, Dv, o_i);
+            }
+            RowTimesMatrix<VEC, pack>(s, cur_k, v + k0 * Dv, Dv, Dv, o_i);
+        }
+    }
+
+    for (int i = 0; i < rows; i++) {
+        ScaleRow<VEC, pack>(o + i * Dv, 1.f / row_sum[i], Dv, output + i * Dv);
+    }
+}
+
+Status X86FusedAttentionLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<FusedAttentionLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    const auto &shape = shape_;
+    const int Sq = shape.query_len, Sk = shape.key_len, D = shape.head_size, Dv = shape.value_size;
+    const float *q    = static_cast<float *>(inputs[0]->GetHandle().base);
+    const float *k    = static_cast<float *>(inputs[1]->GetHandle().base);
+    const float *v    = static_cast<float *>(inputs[2]->GetHandle().base);
+    const float *mask = inputs.size() > 3 ? static_cast<float *>(inputs[3]->GetHandle().base) : nullptr;
+    float *output     = static_cast<float *>(outputs[0]->GetHandle().base);
+
+    // a work item is one query block of one output matrix, each task holds the buffers of its items
+    const int query_blocks = UP_DIV(Sq, kQueryBlock);
+    const long items       = static_cast<long>(shape.q_index.size()) * query_blocks;
+    const int tasks        = static_cast<int>(std::min(static_cast<long>(context_->GetNumThreads()), items));
+    if (tasks < 1) {
+        return TNN_OK;
+    }
+    const size_t task_buffer_size = TaskBufferSize(D, Dv);
+    float *workspace =
+        reinterpret_cast<float *>(context_->GetSharedWorkSpace(tasks * task_buffer_size * sizeof(float)));
+
+    auto block_kernel = arch_ == avx2 ? AttentionQueryBlock<Float8, 8> : AttentionQueryBlock<Float4, 4>;
+    X86ParallelFor(tasks, tasks, 1, [&](long begin, long end) {
+        for (long t = begin; t < end; t++) {
+            for (long item = items * t / tasks; item < items * (t + 1) / tasks; item++) {
+                const int n    = static_cast<int>(item / query_blocks);
+                const int q0   = static_cast<int>(item % query_blocks) * kQueryBlock;
+                const int rows = std::min(kQueryBlock, Sq - q0);
+                const float *mask_n = mask ? mask + shape.mask_offset[n] + q0 * shape.mask_row_stride : nullptr;
+                block_kernel(q + (shape.q_index[n] * Sq + q0) * D, k + shape.k_index[n] * D * Sk,
+                             v + shape.v_index[n] * Sk * Dv, mask_n, rows, shape, param->scale,
+                             output + (n * Sq + q0) * Dv, workspace + t * task_buffer_size);
+            }
+        }
+    });
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(FusedAttention, LAYER_FUSED_ATTENTION);
+
+}  // namespace TNN_NS
@@ -0,0 +1,89 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cstring>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/gather_utils.h"
+
+namespace TNN_NS {
+
+class X86GatherLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86GatherLayerAcc(){};
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override;
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+protected:
+    // the data and the indices are of any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) override;
+
+private:
+    std::shared_ptr<LayerResource> gather_f32_resource_;
+};
+
+std::vector<DataFormat> X86GatherLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    return SupportAnyRankDataFormat(data_type, dims_size);
+}
+
+Status X86GatherLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                               const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto gather_res = dynamic_cast<GatherLayerResource *>(resource);
+    if (gather_res && gather_res->data_handle.GetDataType() == DATA_TYPE_HALF) {
+        LayerResource *fp32_res = nullptr;
+        RETURN_ON_NEQ(ConvertHalfResource(LAYER_GATHER, gather_res, &fp32_res), TNN_OK);
+        gather_f32_resource_ = std::shared_ptr<LayerResource>(fp32_res);
+        resource             = gather_f32_resource_.get();
+    }
+    return X86LayerAcc::Init(context, param, resource, inputs, outputs);
+}
+
+Status X86GatherLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<GatherLayerParam *>(param_);
+    auto resource = dynamic_cast<GatherLayerResource *>(resource_);
+    CHECK_PARAM_NULL(param);
+
+    DimsVector data_dims, indices_dims;
+    int axis = 0;
+    RETURN_ON_NEQ(GetGatherShape(param, inputs, data_dims, indices_dims, axis), TNN_OK);
+    std::vector<int> indices;
+    RETURN_ON_NEQ(GetGatherIndices(param, resource, inputs, data_dims[axis], indices), TNN_OK);
+
+    const float *data = GetGatherData(param, resource, inputs);
+    float *output     = static_cast<float *>(outputs[0]->GetHandle().base);
+    if (!data) {
+        return Status(TNNERR_MODEL_ERR, "Error: Gather data is nil");
+    }
+
+    // each row of the output is a memcpy of inner floats, e.g. an embedding lookup copies one row per token
+    const int outer    = DimsVectorUtils::Count(data_dims, 0, axis);
+    const int inner    = DimsVectorUtils::Count(data_dims, axis + 1);
+    const int axis_dim = data_dims[axis];
+    const long count   = indices.size();
+    X86ParallelFor(context_->GetNumThreads(), outer * count, 1, [&](long begin, long end) {
+        for (long r = begin; r < end; r++) {
+            const long i = r / count, j = r % count;
+            memcpy(output + r * inner, data + (i * axis_dim + indices[j]) * inner, inner * sizeof(float));
+        }
+    });
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(Gather, LAYER_GATHER);
+
+}  // namespace TNN_NS
@@ -0,0 +1,62 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_unary2_layer_acc.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace TNN_NS {
+
+/*
+ * gelu of the erf form, 0.5 * x * (1 + erf(x / sqrt(2)))
+ * erf of the vectors is Abramowitz and Stegun 7.1.26, erfc(|x|) = t * poly(t) * exp(-x * x) with
+ * t = 1 / (1 + p * |x|), the absolute error is below 1.5e-7
+ */
+typedef struct x86_gelu_operator : x86_unary2_operator {
+    virtual float operator()(const float v) {
+        return 0.5f * v * (1.0f + erff(v * 0.70710678f));
+    }
+
+    virtual Float4 operator()(const Float4 &v) {
+        return Gelu<Float4>(v);
+    }
+
+    virtual Float8 operator()(const Float8 &v) {
+        return Gelu<Float8>(v);
+    }
+
+private:
+    template <typename VEC>
+    static VEC Gelu(const VEC &v) {
+        VEC x  = VEC::mul(v, VEC(0.70710678f));
+        VEC t  = VEC::div(VEC(1.0f), VEC::add(VEC(1.0f), VEC::mul(VEC::abs(x), VEC(0.3275911f))));
+        VEC q  = VEC(1.061405429f);
+        q      = VEC::add(VEC::mul(q, t), VEC(-1.453152027f));
+        q      = VEC::add(VEC::mul(q, t), VEC(1.421413741f));
+        q      = VEC::add(VEC::mul(q, t), VEC(-0.284496736f));
+        q      = VEC::add(VEC::mul(q, t), VEC(0.254829592f));
+        q      = VEC::mul(VEC::mul(q, t), VEC::exp(VEC::neg(VEC::mul(x, x))));
+        // 1 + erf(x) is 2 - erfc(|x|) for positive x and erfc(|x|) otherwise
+        VEC one_plus_erf = VEC::bsl_cge(v, VEC(0.0f), VEC::sub(VEC(2.0f), q), q);
+        return VEC::mul(VEC::mul(v, VEC(0.5f)), one_plus_erf);
+    }
+} X86_GELU_OP;
+
+X86_REGISTER_UNARY2_KERNEL(LAYER_GELU, avx2, unary2_kernel_avx<X86_GELU_OP>);
+X86_REGISTER_UNARY2_KERNEL(LAYER_GELU, sse42, unary2_kernel_sse<X86_GELU_OP>);
+DECLARE_X86_UNARY2_ACC(Gelu, LAYER_GELU);
+REGISTER_X86_ACC(Gelu, LAYER_GELU);
+
+}  // namespace TNN_NS
@@ -0,0 +1,107 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_rnn_layer_acc.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+
+namespace TNN_NS {
+
+class X86GruLayerAcc : public X86RNNLayerAcc {
+public:
+    virtual ~X86GruLayerAcc() {}
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override {
+        auto gru_param = dynamic_cast<GRULayerParam *>(param);
+        CHECK_PARAM_NULL(gru_param);
+        linear_before_reset_ = gru_param->linear_before_reset != 0;
+        return X86RNNLayerAcc::Init(context, param, resource, inputs, outputs);
+    }
+
+protected:
+    virtual int GetGateCount() override {
+        return 3;
+    }
+    virtual bool IsRecurrenceBiasSeparate(int gate) override {
+        return linear_before_reset_ && gate == 2;
+    }
+    // without linear_before_reset the h gate needs r of all the hidden units
+    virtual int GetStepPhases() override {
+        return linear_before_reset_ ? 1 : 2;
+    }
+    virtual void StepBlock(int phase, const X86RNNStepBlock &block) override;
+
+    bool linear_before_reset_ = false;
+};
+
+// gates in zrh order, h = (1 - z) * h~ + z * h_prev
+template <typename VEC, int pack>
+static void X86GruStepBlock(int phase, bool linear_before_reset, const X86RNNStepBlock &block, int hidden_size,
+                            int hidden_pad) {
+    VEC h_prev     = VEC::loadu(block.h_prev + block.block_offset);
+    const float *r = block.recurrence;
+    if (linear_before_reset) {
+        // h~ = tanh(x Wh + Wbh + r * (h_prev Rh + Rbh))
+        VEC z_gate = VEC::loadu(block.proj);
+        VEC r_gate = VEC::loadu(block.proj + hidden_pad);
+        VEC h_gate = VEC::loadu(block.recurrence_bias + 2 * hidden_pad);
+        for (int k = 0; k < hidden_size; k++) {
+            VEC h(block.h_prev[k]);
+            VEC::mla(z_gate, h, VEC::loadu(r));
+            VEC::mla(r_gate, h, VEC::loadu(r + pack));
+            VEC::mla(h_gate, h, VEC::loadu(r + 2 * pack));
+            r += 3 * pack;
+        }
+        z_gate = VEC::sigmoid(z_gate);
+        r_gate = VEC::sigmoid(r_gate);
+        h_gate = VEC::tanh(VEC::loadu(block.proj + 2 * hidden_pad) + r_gate * h_gate);
+        VEC::saveu(block.h_next, h_gate + z_gate * (h_prev - h_gate));
+    } else if (phase == 0) {
+        // z of the block and r * h_prev of the row the h gate reads in the next phase
+        VEC z_gate = VEC::loadu(block.proj);
+        VEC r_gate = VEC::loadu(block.proj + hidden_pad);
+        for (int k = 0; k < hidden_size; k++) {
+            VEC h(block.h_prev[k]);
+            VEC::mla(z_gate, h, VEC::loadu(r));
+            VEC::mla(r_gate, h, VEC::loadu(r + pack));
+            r += 3 * pack;
+        }
+        VEC::saveu(block.temp, VEC::sigmoid(z_gate));
+        VEC::saveu(block.temp_row + block.block_offset, VEC::sigmoid(r_gate) * h_prev);
+    } else {
+        // h~ = tanh(x Wh + (r * h_prev) Rh + Wbh + Rbh), both biases are in the projection
+        VEC h_gate = VEC::loadu(block.proj + 2 * hidden_pad);
+        r += 2 * pack;
+        for (int k = 0; k < hidden_size; k++) {
+            VEC::mla(h_gate, VEC(block.temp_row[k]), VEC::loadu(r));
+            r += 3 * pack;
+        }
+        h_gate     = VEC::tanh(h_gate);
+        VEC z_gate = VEC::loadu(block.temp);
+        VEC::saveu(block.h_next, h_gate + z_gate * (h_prev - h_gate));
+    }
+}
+
+void X86GruLayerAcc::StepBlock(int phase, const X86RNNStepBlock &block) {
+    if (arch_ == avx2) {
+        X86GruStepBlock<Float8, 8>(phase, linear_before_reset_, block, hidden_size_, hidden_pad_);
+    } else {
+        X86GruStepBlock<Float4, 4>(phase, linear_before_reset_, block, hidden_size_, hidden_pad_);
+    }
+}
+
+REGISTER_X86_ACC(Gru, LAYER_GRU);
+
+}  // namespace TNN_NS
@@ -12,27 +12,59 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include <cfloat>
+
+#include "tnn/core/blob_int8.h"
 #include "tnn/device/x86/x86_common.h"
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/device/x86/x86_util.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/string_utils_inner.h"
 #include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+#include "tnn/device/x86/acc/compute/jit/sgemv_driver.h"
 #include "tnn/device/x86/acc/x86_inner_product_layer_acc.h"
+#include "tnn/interpreter/layer_resource_generator.h"
 
 namespace TNN_NS {
 
 Status X86InnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                                      const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto fc_res = dynamic_cast<InnerProductLayerResource *>(resource);
+    CHECK_PARAM_NULL(fc_res);
+    if (fc_res->weight_handle.GetDataType() == DATA_TYPE_HALF) {
+        LayerResource *fp32_res = nullptr;
+        RETURN_ON_NEQ(ConvertHalfResource(LAYER_INNER_PRODUCT, fc_res, &fp32_res), TNN_OK);
+        fc_f32_resource_ = std::shared_ptr<LayerResource>(fp32_res);
+        resource         = fc_f32_resource_.get();
+    }
+    // the weights are packed by Reshape for the batch
+    use_avx512_ = sgemv_avx512_c16_available();
     auto status = X86LayerAcc::Init(context, param, resource, inputs, outputs);
     RETURN_ON_NEQ(status, TNN_OK);
-    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+    if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        RETURN_ON_NEQ(allocateBufferScale(inputs, outputs), TNN_OK);
+    }
 
     return TNN_OK;
 }
 
 X86InnerProductLayerAcc::~X86InnerProductLayerAcc() {}
 
+Status X86InnerProductLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    InnerProductLayerResource *res = dynamic_cast<InnerProductLayerResource *>(resource_);
+    CHECK_PARAM_NULL(res);
+
+    // the gemm runs for every batch > 1, each layout of the weights is packed the first time it is used
+    use_gemm_ = res->weight_handle.GetDataType() == DATA_TYPE_FLOAT && outputs[0]->GetBlobDesc().dims[0] > 1;
+    if (use_gemm_) {
+        return allocateBufferWeightGemm(inputs, outputs);
+    }
+    return allocateBufferWeight(inputs, outputs);
+}
+
 Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     InnerProductLayerParam *param = dynamic_cast<InnerProductLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
@@ -46,7 +78,9 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
 
     if (!buffer_weight_.GetBytesSize()) {
         int oc_rup = 8;
-        if (arch_ == sse42) {
+        if (use_avx512_) {
+            oc_rup = 16;
+        } else if (arch_ == sse42) {
             oc_rup = 4;
         }
         const float *src = res->weight_handle.force_to<float *>();
@@ -54,26 +88,107 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
         size_t weight_count = ROUND_UP(output_dims[1], oc_rup) * input_stride;
         int data_byte_size = DataTypeUtils::GetBytesSize(res->weight_handle.GetDataType());
 
-        if (res->weight_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer temp_buffer(weight_count * data_byte_size);
-            float *dst = temp_buffer.force_to<float *>();
+        auto pack = [&](RawBuffer &packed) -> Status {
+            DataType lowp_type = DATA_TYPE_FLOAT;
+            if (res->weight_handle.GetDataType() == DATA_TYPE_FLOAT) {
+                lowp_type = GetLowPrecisionWeightType(src, output_dims[1] * input_stride);
+            }
+
+            if (lowp_type != DATA_TYPE_FLOAT) {
+                // packed by 8 for X86SgemvLowp, half of the float weight bytes
+                RawBuffer pack_buffer(weight_count * sizeof(float));
+                PackC8(pack_buffer.force_to<float *>(), src, input_stride, input_stride, input_stride, output_dims[1]);
+
+                RawBuffer temp_buffer(weight_count * sizeof(uint16_t));
+                NarrowFromFloat(temp_buffer.force_to<uint16_t *>(), pack_buffer.force_to<float *>(), weight_count,
+                                lowp_type);
+                temp_buffer.SetDataType(lowp_type);
+                packed = temp_buffer;
+            } else if (res->weight_handle.GetDataType() == DATA_TYPE_FLOAT) {
+                RawBuffer temp_buffer(weight_count * data_byte_size);
+                float *dst = temp_buffer.force_to<float *>();
+
+                if (use_avx512_) {
+                    PackC16(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                } else if (arch_ == avx2) {
+                    PackC8(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                } else if (arch_ == sse42) {
+                    PackC4(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                }
+
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
+            } else if (res->weight_handle.GetDataType() == DATA_TYPE_INT8) {
+                // weights are the u8 side of the int8 gemm, the offset is compensated in forward
+                RawBuffer temp_buffer(X86Int8PackASize(output_dims[1], input_stride));
+                X86Int8PackA(temp_buffer.force_to<uint8_t *>(), res->weight_handle.force_to<int8_t *>(),
+                             output_dims[1], input_stride, input_stride);
 
-            if (arch_ == avx2) {
-                PackC8(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
-            } else if (arch_ == sse42) {
-                PackC4(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                temp_buffer.SetDataType(DATA_TYPE_INT8);
+                packed = temp_buffer;
+            } else {
+                LOGE("Error: DataType %d not support\n", res->weight_handle.GetDataType());
+                return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
             }
+            return TNN_OK;
+        };
 
-            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = temp_buffer;
-        } else {
-            LOGE("Error: DataType %d not support\n", res->weight_handle.GetDataType());
-            return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
+        std::string variant = "fc_" + ToString(res->weight_handle.GetDataType()) + "_sgemv_" + ToString(use_avx512_);
+        RETURN_ON_NEQ(GetSharedPackedWeight(buffer_weight_, variant, pack), TNN_OK);
+
+        // the lowp sgemv is packed by 8
+        auto weight_type = buffer_weight_.GetDataType();
+        if (weight_type == DATA_TYPE_HALF || weight_type == DATA_TYPE_BFP16) {
+            use_avx512_ = false;
         }
     }
     return TNN_OK;
 }
 
+Status X86InnerProductLayerAcc::allocateBufferWeightGemm(const std::vector<Blob *> &inputs,
+                                                         const std::vector<Blob *> &outputs) {
+    InnerProductLayerResource *res = dynamic_cast<InnerProductLayerResource *>(resource_);
+    CHECK_PARAM_NULL(res);
+
+    if (!buffer_weight_gemm_.GetBytesSize()) {
+        auto input_dims     = inputs[0]->GetBlobDesc().dims;
+        const int oc        = outputs[0]->GetBlobDesc().dims[1];
+        const float *src    = res->weight_handle.force_to<float *>();
+        size_t input_stride = input_dims[1] * input_dims[2] * input_dims[3];
+        gemm_oc_chunk_      = ROUND_UP(UP_DIV(oc, context_->GetNumThreads()), conv_gemm_conf_.n_block_);
+
+        auto pack = [&](RawBuffer &packed) -> Status {
+            size_t chunk_size = ROUND_UP(input_stride, conv_gemm_conf_.K_c_) * gemm_oc_chunk_;
+            size_t count      = UP_DIV(oc, gemm_oc_chunk_) * chunk_size;
+
+            RawBuffer temp_buffer(count * sizeof(float));
+            float *dst = temp_buffer.force_to<float *>();
+            for (int c = 0; c * gemm_oc_chunk_ < oc; c++) {
+                int cur_oc = MIN(gemm_oc_chunk_, oc - c * gemm_oc_chunk_);
+                conv_pack_weights(cur_oc, input_stride, src + c * gemm_oc_chunk_ * input_stride, input_stride,
+                                  dst + c * chunk_size, conv_gemm_conf_);
+            }
+            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+            packed = temp_buffer;
+
+            auto lowp_type = GetLowPrecisionWeightType(src, oc * input_stride);
+            if (lowp_type != DATA_TYPE_FLOAT) {
+                RawBuffer lowp_buffer(count * sizeof(uint16_t));
+                NarrowFromFloat(lowp_buffer.force_to<uint16_t *>(), dst, count, lowp_type);
+                lowp_buffer.SetDataType(lowp_type);
+                packed = lowp_buffer;
+            }
+            return TNN_OK;
+        };
+
+        std::string variant = "fc_" + ToString(res->weight_handle.GetDataType()) + "_gemm_" +
+                              ToString(gemm_oc_chunk_) + "_" + ToString(conv_gemm_conf_.K_c_) + "_" +
+                              ToString(conv_gemm_conf_.n_block_);
+        RETURN_ON_NEQ(GetSharedPackedWeight(buffer_weight_gemm_, variant, pack), TNN_OK);
+    }
+    return TNN_OK;
+}
+
 Status X86InnerProductLayerAcc::allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     InnerProductLayerParam *param = dynamic_cast<InnerProductLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
@@ -82,7 +197,7 @@ Status X86InnerProductLayerAcc::allocateBufferBias(const std::vector<Blob *> &in
 
     if (!buffer_bias_.GetBytesSize()) {
         auto dims_output = outputs[0]->GetBlobDesc().dims;
-        int total_byte_size = dims_output[1] * DataTypeUtils::GetBytesSize(res->bias_handle.GetDataType());
+        int total_byte_size = ROUND_UP(dims_output[1], 8) * DataTypeUtils::GetBytesSize(res->bias_handle.GetDataType());
         RawBuffer temp_buffer(total_byte_size);
         if (param->has_bias) {
             const int bias_handle_size    = res->bias_handle.GetBytesSize();
@@ -94,6 +209,123 @@ Status X86InnerProductLayerAcc::allocateBufferBias(const std::vector<Blob *> &in
     return TNN_OK;
 }
 
+Status X86InnerProductLayerAcc::allocateBufferScale(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    InnerProductLayerResource *res = dynamic_cast<InnerProductLayerResource *>(resource_);
+    CHECK_PARAM_NULL(res);
+
+    if (!buffer_scale_.GetBytesSize()) {
+        auto dims_output = outputs[0]->GetBlobDesc().dims;
+        const float *w_scale = res->scale_handle.force_to<float *>();
+        CHECK_PARAM_NULL(w_scale);
+
+        auto o_resource      = reinterpret_cast<BlobInt8 *>(outputs[0])->GetIntResource();
+        const float *o_scale = o_resource->scale_handle.force_to<float *>();
+        int scale_len_w      = res->scale_handle.GetDataCount();
+        int scale_len_o      = o_resource->scale_handle.GetDataCount();
+
+        RawBuffer temp_buffer(dims_output[1] * sizeof(float));
+        float *temp_ptr = temp_buffer.force_to<float *>();
+        for (int i = 0; i < dims_output[1]; i++) {
+            int w_scale_idx = scale_len_w == 1 ? 0 : i;
+            int o_scale_idx = scale_len_o == 1 ? 0 : i;
+            if (o_scale[o_scale_idx] >= FLT_MIN)
+                temp_ptr[i] = w_scale[w_scale_idx] / o_scale[o_scale_idx];
+            else
+                temp_ptr[i] = 0.0;
+        }
+        buffer_scale_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status X86InnerProductLayerAcc::ExecInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<InnerProductLayerParam *>(param_);
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+
+    int batch = dims_output[0];
+    int M     = dims_output[1];
+    int K     = dims_input[1] * dims_input[2] * dims_input[3];
+    int ldc   = ROUND_UP(M, 16);
+
+    // activations are the s8 side of the int8 gemm, batch is the n dim
+    size_t pack_b_size    = ROUND_UP(X86Int8PackBSize(batch, K), 32);
+    size_t sum_size       = ROUND_UP(ROUND_UP(batch, 6) * sizeof(int32_t), 32);
+    size_t dst_size       = ROUND_UP(batch, 6) * ldc * sizeof(int32_t);
+    int8_t *workspace     = reinterpret_cast<int8_t *>(context_->GetSharedWorkSpace(pack_b_size + sum_size + dst_size));
+    int8_t *pack_b        = workspace;
+    int32_t *sum_b        = reinterpret_cast<int32_t *>(workspace + pack_b_size);
+    int32_t *dst_int32    = reinterpret_cast<int32_t *>(workspace + pack_b_size + sum_size);
+
+    auto input_data  = static_cast<int8_t *>(inputs[0]->GetHandle().base);
+    auto output_data = static_cast<int8_t *>(outputs[0]->GetHandle().base);
+    auto bias_data   = param->has_bias ? buffer_bias_.force_to<int32_t *>() : nullptr;
+    auto scale_data  = buffer_scale_.force_to<float *>();
+
+    X86Int8PackB(pack_b, input_data, batch, K, K, sum_b);
+    X86Int8Gemm(M, batch, K, buffer_weight_.force_to<uint8_t *>(), pack_b, dst_int32, ldc);
+
+    // weights were fed as u8 (w + 128), acc -= 128 * sum(x)
+    for (int b = 0; b < batch; b++) {
+        X86Int8RequantPerChannel(output_data + b * M, dst_int32 + b * ldc, M, bias_data, -128 * sum_b[b], scale_data,
+                                 M);
+    }
+    return TNN_OK;
+}
+
+Status X86InnerProductLayerAcc::ExecGemm(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<InnerProductLayerParam *>(param_);
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+
+    const int batch   = dims_output[0];
+    const int oc      = dims_output[1];
+    const int K       = dims_input[1] * dims_input[2] * dims_input[3];
+    const int chunks  = UP_DIV(oc, gemm_oc_chunk_);
+    size_t chunk_size = ROUND_UP(K, conv_gemm_conf_.K_c_) * gemm_oc_chunk_;
+
+    auto weight_type = buffer_weight_gemm_.GetDataType();
+    bool lowp_weight = weight_type == DATA_TYPE_HALF || weight_type == DATA_TYPE_BFP16;
+
+    // transposed input and output, then the gemm buffers of each chunk
+    size_t input_t_size  = ROUND_UP(K * batch, 8);
+    size_t output_t_size = ROUND_UP(oc * batch, 8);
+    size_t src_buf_size  = ROUND_UP(conv_gemm_conf_.M_c_ * conv_gemm_conf_.K_c_, 8);
+    size_t b_buf_size    = lowp_weight ? conv_gemm_conf_.K_c_ * gemm_oc_chunk_ : 0;
+    size_t workspace_size = input_t_size + output_t_size + chunks * (src_buf_size + b_buf_size);
+    float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size * sizeof(float)));
+    float *input_t   = workspace;
+    float *output_t  = input_t + input_t_size;
+    float *chunk_buf = output_t + output_t_size;
+
+    auto input_data  = static_cast<float *>(inputs[0]->GetHandle().base);
+    auto output_data = static_cast<float *>(outputs[0]->GetHandle().base);
+    auto bias_data   = buffer_bias_.force_to<float *>();
+
+    // the gemm is column major, samples are contiguous in the transposed buffers
+    MatTranspose(input_t, input_data, batch, K);
+    X86ParallelFor(context_->GetNumThreads(), chunks, 1, [&](long begin, long end) {
+        for (long c = begin; c < end; c++) {
+            const int oc_begin = c * gemm_oc_chunk_;
+            const int cur_oc   = MIN(gemm_oc_chunk_, oc - oc_begin);
+            float *src_buf     = chunk_buf + c * (src_buf_size + b_buf_size);
+            if (lowp_weight) {
+                conv_sgemm_nn_col_major(batch, cur_oc, K, input_t, batch,
+                                        buffer_weight_gemm_.force_to<uint16_t *>() + c * chunk_size, weight_type, K,
+                                        output_t + oc_begin * batch, batch, bias_data + oc_begin,
+                                        param->activation_type, src_buf, src_buf + src_buf_size, conv_gemm_conf_);
+            } else {
+                conv_sgemm_nn_col_major(batch, cur_oc, K, input_t, batch,
+                                        buffer_weight_gemm_.force_to<float *>() + c * chunk_size, K,
+                                        output_t + oc_begin * batch, batch, bias_data + oc_begin,
+                                        param->activation_type, src_buf, conv_gemm_conf_);
+            }
+        }
+    });
+    MatTranspose(output_data, output_t, oc, batch);
+    return TNN_OK;
+}
+
 Status X86InnerProductLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param    = dynamic_cast<InnerProductLayerParam *>(param_);
     auto resource = dynamic_cast<InnerProductLayerResource *>(resource_);
@@ -124,14 +356,53 @@ Status X86InnerProductLayerAcc::DoForward(const std::vector<Blob *> &inputs, con
     if (arch_ == avx2) {
         X86SgemvFunc = X86Sgemv<Float8, 8>;
     }
-    if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
-        X86SgemvFunc(output_data, input_data, weight_data, bias_data, input_dims, output_dims);
-    } else {
+    if (output_blob->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        return ExecInt8(inputs, outputs);
+    } else if (output_blob->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
         return Status(TNNERR_MODEL_ERR, "blob type is unsupported");
     }
+    if (use_gemm_) {
+        return ExecGemm(inputs, outputs);
+    }
+
+    auto weight_type = buffer_weight_.GetDataType();
+    if (weight_type == DATA_TYPE_HALF || weight_type == DATA_TYPE_BFP16) {
+        X86SgemvLowp(output_data, input_data, buffer_weight_.force_to<uint16_t *>(), weight_type, bias_data,
+                     input_dims, output_dims, context_->GetNumThreads());
+    } else if (use_avx512_) {
+        size_t input_stride = dims_input[1] * dims_input[2] * dims_input[3];
+        sgemv_avx512_c16(dims_output[0], dims_output[1], input_stride, input_data, weight_data, bias_data, output_data,
+                         context_->GetNumThreads());
+    } else {
+        X86SgemvFunc(output_data, input_data, weight_data, bias_data, input_dims, output_dims, context_->GetNumThreads());
+    }
+    if (param->activation_type == ActivationType_ReLU || param->activation_type == ActivationType_ReLU6) {
+        // the output is clamped as one column of a tile
+        long count = DimsVectorUtils::Count(dims_output);
+        bool relu6 = param->activation_type == ActivationType_ReLU6;
+        auto X86ActivationFunc = relu6 ? X86_Post_Tile<ActivationType_ReLU6, Float4, 4>
+                                       : X86_Post_Tile<ActivationType_ReLU, Float4, 4>;
+        if (arch_ == avx2) {
+            X86ActivationFunc = relu6 ? X86_Post_Tile<ActivationType_ReLU6, Float8, 8>
+                                      : X86_Post_Tile<ActivationType_ReLU, Float8, 8>;
+        }
+        X86ActivationFunc(output_data, count, count, 1, nullptr);
+    }
     return TNN_OK;
 }
 
+#if TNN_PROFILE
+std::string X86InnerProductLayerAcc::GetImplName() {
+    std::string name = X86LayerAcc::GetImplName();
+    if (use_gemm_) {
+        name += "_Gemm";
+    } else if (use_avx512_) {
+        name += "_Avx512";
+    }
+    return name;
+}
+#endif
+
 REGISTER_X86_ACC(InnerProduct, LAYER_INNER_PRODUCT);
 
 }  // namespace TNN_NS
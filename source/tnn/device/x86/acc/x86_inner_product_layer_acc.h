@@ -16,6 +16,7 @@
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_INNER_PRODUCT_LAYER_ACC_H_
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
 
 namespace TNN_NS {
 
@@ -25,13 +26,36 @@ public:
 
     Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
                 const std::vector<Blob *> &outputs) override;
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status allocateBufferWeightGemm(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status allocateBufferScale(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+#if TNN_PROFILE
+    virtual std::string GetImplName() override;
+#endif
+
+private:
+    Status ExecInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    // samples are the m dim of a gemm, the weights are streamed once per forward instead of once per sample
+    Status ExecGemm(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
 protected:
     RawBuffer buffer_weight_;
     RawBuffer buffer_bias_;
+    RawBuffer buffer_scale_;
+    // weights packed in 16 channels for the avx512 sgemv kernel
+    bool use_avx512_ = false;
+    // fp32 copy of a half resource
+    std::shared_ptr<LayerResource> fc_f32_resource_;
+    // with batch > 1, set by Reshape. buffer_weight_gemm_ is packed by conv_pack_weights in chunks of
+    // gemm_oc_chunk_ output channels, the chunks run on different threads
+    bool use_gemm_      = false;
+    int gemm_oc_chunk_  = 0;
+    RawBuffer buffer_weight_gemm_;
+    conv_gemm_config<float, float, float> conv_gemm_conf_;
 };
 
 }  // namespace TNN_NS
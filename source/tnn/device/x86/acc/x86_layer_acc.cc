@@ -14,13 +14,18 @@
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 
+#include <cmath>
+
+#include "tnn/utils/packed_weight_cache.h"
+#include "tnn/utils/string_utils_inner.h"
+
 namespace TNN_NS {
 
 X86LayerAcc::~X86LayerAcc() {}
 
 Status X86LayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                          const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    AbstractLayerAcc::Init(context, param, resource, inputs, outputs);
+    RETURN_ON_NEQ(AbstractLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
     context_ = reinterpret_cast<X86Context *>(context);
 
     param_    = param;
@@ -45,6 +50,33 @@ std::vector<DataFormat> X86LayerAcc::SupportDataFormat(DataType data_type, int d
     return support_list;
 }
 
+std::vector<DataFormat> X86LayerAcc::SupportAnyRankDataFormat(DataType data_type, int dims_size) {
+    std::vector<DataFormat> support_list;
+    if (dims_size > 0) {
+        support_list.push_back(DATA_FORMAT_NCHW);
+    }
+    return support_list;
+}
+
+DataType X86LayerAcc::GetLowPrecisionWeightType(const float *weight, size_t count) {
+    if (context_->GetPrecision() != PRECISION_LOW || arch_ != avx2) {
+        return DATA_TYPE_FLOAT;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (std::fabs(weight[i]) > 65504.f) {
+            return DATA_TYPE_BFP16;
+        }
+    }
+    return DATA_TYPE_HALF;
+}
+
+Status X86LayerAcc::GetSharedPackedWeight(RawBuffer &buffer, const std::string &variant,
+                                          const std::function<Status(RawBuffer &)> &pack) {
+    auto key = PackedWeightCache::GetKey(context_->GetModelMd5(), param_->name, DEVICE_X86,
+                                         variant + "_" + ToString(arch_) + "_" + ToString(context_->GetPrecision()));
+    return PackedWeightCache::Get(key, buffer, pack);
+}
+
 Status X86LayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     Status status;
 #if TNN_PROFILE
@@ -15,6 +15,8 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
 
+#include <functional>
+#include <string>
 #include <vector>
 
 #include "tnn/core/abstract_layer_acc.h"
@@ -50,9 +52,20 @@ protected:
     X86Context *context_           = nullptr;
     x86_isa_t arch_;
 
-private:
     // @brief return device layer acc support data format
     virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
+
+    // @brief data formats of the accs indexing the dims by the rank, NCHW holds blobs of any rank
+    std::vector<DataFormat> SupportAnyRankDataFormat(DataType data_type, int dims_size);
+
+    // @brief type of the packed weights with PRECISION_LOW on avx2, DATA_TYPE_FLOAT otherwise.
+    // fp16 keeps more mantissa bits, bf16 is taken if some weight is out of the fp16 range.
+    DataType GetLowPrecisionWeightType(const float *weight, size_t count);
+
+    // @brief packed weight shared by the instances of the model, pack is only called if no instance holds it.
+    // variant names the packing layout, the isa and the precision are added here.
+    Status GetSharedPackedWeight(RawBuffer &buffer, const std::string &variant,
+                                 const std::function<Status(RawBuffer &)> &pack);
 };
 
 #define DECLARE_X86_ACC(type_string, layer_type)                                                                   \
@@ -0,0 +1,157 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cmath>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class X86LayerNormLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86LayerNormLayerAcc(){};
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override;
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+protected:
+    // rows of the dims from the normalized axis on, any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) override;
+
+private:
+    std::shared_ptr<LayerResource> layer_norm_f32_resource_;
+};
+
+std::vector<DataFormat> X86LayerNormLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    return SupportAnyRankDataFormat(data_type, dims_size);
+}
+
+Status X86LayerNormLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                  const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_norm_res = dynamic_cast<LayerNormLayerResource *>(resource);
+    CHECK_PARAM_NULL(layer_norm_res);
+    if (layer_norm_res->scale_handle.GetDataType() == DATA_TYPE_HALF) {
+        LayerResource *fp32_res = nullptr;
+        RETURN_ON_NEQ(ConvertHalfResource(LAYER_LAYER_NORM, layer_norm_res, &fp32_res), TNN_OK);
+        layer_norm_f32_resource_ = std::shared_ptr<LayerResource>(fp32_res);
+        resource                 = layer_norm_f32_resource_.get();
+    }
+    return X86LayerAcc::Init(context, param, resource, inputs, outputs);
+}
+
+Status X86LayerNormLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<LayerNormLayerParam *>(param_);
+    auto resource = dynamic_cast<LayerNormLayerResource *>(resource_);
+    CHECK_PARAM_NULL(param);
+    CHECK_PARAM_NULL(resource);
+
+    auto dims             = inputs[0]->GetBlobDesc().dims;
+    const int reduce_axis = static_cast<int>(dims.size()) - param->reduce_dims_size;
+    if (reduce_axis < 0 || param->reduce_dims_size < 1) {
+        return Status(TNNERR_PARAM_ERR, "Error: LayerNorm reduce_dims_size is out of the input rank");
+    }
+    const int cols = DimsVectorUtils::Count(dims, reduce_axis);
+    if (resource->scale_handle.GetDataCount() != cols || resource->bias_handle.GetDataCount() != cols) {
+        return Status(TNNERR_PARAM_ERR, "Error: LayerNorm scale and bias do not match the normalized dims");
+    }
+    return TNN_OK;
+}
+
+template <typename VEC, int pack>
+static float HorizontalSum(const VEC &v) {
+    float buffer[pack];
+    VEC::saveu(buffer, v);
+    float sum = 0.f;
+    for (int i = 0; i < pack; i++) {
+        sum += buffer[i];
+    }
+    return sum;
+}
+
+/*
+ * one row of cols values in three passes: the mean, the variance of the centered values, and the output
+ * with the normalization, scale and bias fused into one multiply add of each vector
+ */
+template <typename VEC, int pack>
+static void LayerNormRow(const float *x, float *y, const float *scale, const float *bias, int cols, float eps) {
+    VEC sum_v(0.f);
+    int i = 0;
+    for (; i + pack - 1 < cols; i += pack) {
+        sum_v = VEC::add(sum_v, VEC::loadu(x + i));
+    }
+    float sum = HorizontalSum<VEC, pack>(sum_v);
+    for (; i < cols; i++) {
+        sum += x[i];
+    }
+    const float mean = sum / cols;
+
+    VEC mean_v(mean), var_v(0.f);
+    for (i = 0; i + pack - 1 < cols; i += pack) {
+        VEC d = VEC::sub(VEC::loadu(x + i), mean_v);
+        VEC::mla(var_v, d, d);
+    }
+    float variance = HorizontalSum<VEC, pack>(var_v);
+    for (; i < cols; i++) {
+        variance += (x[i] - mean) * (x[i] - mean);
+    }
+    const float rstd = 1.0f / std::sqrt(variance / cols + eps);
+
+    VEC rstd_v(rstd);
+    for (i = 0; i + pack - 1 < cols; i += pack) {
+        VEC d = VEC::sub(VEC::loadu(x + i), mean_v);
+        VEC r = VEC::loadu(bias + i);
+        VEC::mla(r, d, VEC::mul(VEC::loadu(scale + i), rstd_v));
+        VEC::saveu(y + i, r);
+    }
+    for (; i < cols; i++) {
+        y[i] = (x[i] - mean) * rstd * scale[i] + bias[i];
+    }
+}
+
+Status X86LayerNormLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<LayerNormLayerParam *>(param_);
+    auto resource = dynamic_cast<LayerNormLayerResource *>(resource_);
+    CHECK_PARAM_NULL(param);
+    CHECK_PARAM_NULL(resource);
+
+    // the axis and the sizes of scale and bias are checked by Reshape
+    auto dims             = inputs[0]->GetBlobDesc().dims;
+    const int reduce_axis = static_cast<int>(dims.size()) - param->reduce_dims_size;
+    const int rows        = DimsVectorUtils::Count(dims, 0, reduce_axis);
+    const int cols        = DimsVectorUtils::Count(dims, reduce_axis);
+    const float eps       = param->eps;
+
+    const float *scale = resource->scale_handle.force_to<float *>();
+    const float *bias  = resource->bias_handle.force_to<float *>();
+    const float *input = static_cast<float *>(inputs[0]->GetHandle().base);
+    float *output      = static_cast<float *>(outputs[0]->GetHandle().base);
+
+    auto row_kernel = arch_ == avx2 ? LayerNormRow<Float8, 8> : LayerNormRow<Float4, 4>;
+    X86ParallelFor(context_->GetNumThreads(), rows, 1, [&](long begin, long end) {
+        for (long r = begin; r < end; r++) {
+            row_kernel(input + r * cols, output + r * cols, scale, bias, cols, eps);
+        }
+    });
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(LayerNorm, LAYER_LAYER_NORM);
+
+}  // namespace TNN_NS
@@ -0,0 +1,71 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_rnn_layer_acc.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+
+namespace TNN_NS {
+
+class X86LstmLayerAcc : public X86RNNLayerAcc {
+public:
+    virtual ~X86LstmLayerAcc() {}
+
+protected:
+    virtual int GetGateCount() override {
+        return 4;
+    }
+    virtual void StepBlock(int phase, const X86RNNStepBlock &block) override;
+};
+
+// gates in iofc order, c = f * c + i * tanh(c~) and h = o * tanh(c)
+template <typename VEC, int pack>
+static void X86LstmStepBlock(const X86RNNStepBlock &block, int hidden_size, int hidden_pad) {
+    VEC i_gate = VEC::loadu(block.proj);
+    VEC o_gate = VEC::loadu(block.proj + hidden_pad);
+    VEC f_gate = VEC::loadu(block.proj + 2 * hidden_pad);
+    VEC c_gate = VEC::loadu(block.proj + 3 * hidden_pad);
+
+    const float *r = block.recurrence;
+    for (int k = 0; k < hidden_size; k++) {
+        VEC h(block.h_prev[k]);
+        VEC::mla(i_gate, h, VEC::loadu(r));
+        VEC::mla(o_gate, h, VEC::loadu(r + pack));
+        VEC::mla(f_gate, h, VEC::loadu(r + 2 * pack));
+        VEC::mla(c_gate, h, VEC::loadu(r + 3 * pack));
+        r += 4 * pack;
+    }
+
+    i_gate = VEC::sigmoid(i_gate);
+    o_gate = VEC::sigmoid(o_gate);
+    f_gate = VEC::sigmoid(f_gate);
+    c_gate = VEC::tanh(c_gate);
+
+    VEC c = VEC::loadu(block.c);
+    c     = f_gate * c + i_gate * c_gate;
+    VEC::saveu(block.c, c);
+    VEC::saveu(block.h_next, o_gate * VEC::tanh(c));
+}
+
+void X86LstmLayerAcc::StepBlock(int phase, const X86RNNStepBlock &block) {
+    if (arch_ == avx2) {
+        X86LstmStepBlock<Float8, 8>(block, hidden_size_, hidden_pad_);
+    } else {
+        X86LstmStepBlock<Float4, 4>(block, hidden_size_, hidden_pad_);
+    }
+}
+
+REGISTER_X86_ACC(Lstm, LAYER_LSTM);
+
+}  // namespace TNN_NS
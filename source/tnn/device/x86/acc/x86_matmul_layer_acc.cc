@@ -0,0 +1,238 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
+#include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/matmul_utils.h"
+#include "tnn/utils/string_utils_inner.h"
+
+namespace TNN_NS {
+
+/*
+ * batched MatMul on the jit sgemm driver, the batches run one after another and the chunks of a batch on
+ * different threads.
+ * a constant B is transposed and packed by conv_pack_weights once, A and C go through transposed buffers as the
+ * gemm is column major.
+ * otherwise C^T = B^T A^T is the column major gemm of B and the packed rows of A, which writes the row major C
+ * without any transpose. a constant A is packed once, an input A by each chunk in forward.
+ */
+class X86MatMulLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86MatMulLayerAcc(){};
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override;
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+protected:
+    // [..., M, K] x [..., K, N] of any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) override;
+
+private:
+    Status allocateBufferWeight(MatMulLayerParam *param);
+    // c = a b with the packed constant b
+    void ExecConstB(const float *a, int M, int N, int K, int b_index, float *c, const float *bias,
+                    float *workspace);
+    // c = a b, packed_a is the packed constant a or nullptr to pack a in place
+    void ExecPackedA(const float *a, const float *packed_a, const float *b, int M, int N, int K, float *c,
+                     const float *bias, float *workspace);
+
+    // chunk_ columns of a constant B or rows of A for each thread, a multiple of n_block
+    int chunk_ = 0;
+    // packed constant, chunks of every matrix of the weight batches
+    RawBuffer buffer_weight_;
+    conv_gemm_config<float, float, float> conv_gemm_conf_;
+    std::shared_ptr<LayerResource> matmul_f32_resource_;
+};
+
+std::vector<DataFormat> X86MatMulLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    return SupportAnyRankDataFormat(data_type, dims_size);
+}
+
+Status X86MatMulLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                               const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto matmul_param = dynamic_cast<MatMulLayerParam *>(param);
+    CHECK_PARAM_NULL(matmul_param);
+    if (matmul_param->weight_position != -1) {
+        auto matmul_res = dynamic_cast<MatMulLayerResource *>(resource);
+        CHECK_PARAM_NULL(matmul_res);
+        if (matmul_res->weight_handle.GetDataType() == DATA_TYPE_HALF) {
+            LayerResource *fp32_res = nullptr;
+            RETURN_ON_NEQ(ConvertHalfResource(LAYER_MATMUL, matmul_res, &fp32_res), TNN_OK);
+            matmul_f32_resource_ = std::shared_ptr<LayerResource>(fp32_res);
+            resource             = matmul_f32_resource_.get();
+        }
+    }
+    RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+    if (matmul_param->weight_position != -1) {
+        RETURN_ON_NEQ(allocateBufferWeight(matmul_param), TNN_OK);
+    }
+    return TNN_OK;
+}
+
+Status X86MatMulLayerAcc::allocateBufferWeight(MatMulLayerParam *param) {
+    auto res = dynamic_cast<MatMulLayerResource *>(resource_);
+    CHECK_PARAM_NULL(res);
+
+    // dims of a 1-d weight as GetMatMulShape takes them
+    auto dims = param->weight_dims;
+    if (dims.size() == 1) {
+        dims = param->weight_position == 0 ? DimsVector({1, dims[0]}) : DimsVector({dims[0], 1});
+    }
+    const int rows    = dims[dims.size() - 2];
+    const int cols    = dims[dims.size() - 1];
+    const int batches = DimsVectorUtils::Count(dims, 0, static_cast<int>(dims.size()) - 2);
+    if (res->weight_handle.GetDataCount() < batches * rows * cols) {
+        return Status(TNNERR_MODEL_ERR, "MatMul weight is smaller than its dims");
+    }
+    const float *weight = res->weight_handle.force_to<float *>();
+
+    // B [K, N] is transposed to the [N, K] that conv_pack_weights reads, A [M, K] is read as it is
+    const bool const_b = param->weight_position == 1;
+    const int K        = const_b ? rows : cols;
+    const int channels = const_b ? cols : rows;
+    chunk_             = ROUND_UP(UP_DIV(channels, context_->GetNumThreads()), conv_gemm_conf_.n_block_);
+
+    auto pack = [&](RawBuffer &packed) -> Status {
+        const int chunks  = UP_DIV(channels, chunk_);
+        size_t chunk_size = ROUND_UP(K, conv_gemm_conf_.K_c_) * chunk_;
+        RawBuffer temp_buffer(batches * chunks * chunk_size * sizeof(float));
+        std::vector<float> transposed(const_b ? K * channels : 0);
+        float *dst = temp_buffer.force_to<float *>();
+        for (int b = 0; b < batches; b++) {
+            const float *src = weight + b * rows * cols;
+            if (const_b) {
+                MatTranspose(transposed.data(), src, K, channels);
+                src = transposed.data();
+            }
+            for (int c = 0; c < chunks; c++) {
+                int cur = MIN(chunk_, channels - c * chunk_);
+                conv_pack_weights(cur, K, src + c * chunk_ * K, K, dst + (b * chunks + c) * chunk_size,
+                                  conv_gemm_conf_);
+            }
+        }
+        temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+        packed = temp_buffer;
+        return TNN_OK;
+    };
+    std::string variant = "matmul_" + ToString(param->weight_position) + "_" + ToString(chunk_) + "_" +
+                          ToString(conv_gemm_conf_.K_c_) + "_" + ToString(conv_gemm_conf_.n_block_);
+    return GetSharedPackedWeight(buffer_weight_, variant, pack);
+}
+
+void X86MatMulLayerAcc::ExecConstB(const float *a, int M, int N, int K, int b_index, float *c, const float *bias,
+                                   float *workspace) {
+    const int chunks    = UP_DIV(N, chunk_);
+    size_t chunk_size   = ROUND_UP(K, conv_gemm_conf_.K_c_) * chunk_;
+    size_t src_buf_size = ROUND_UP(conv_gemm_conf_.M_c_ * conv_gemm_conf_.K_c_, 8);
+    float *a_t          = workspace;
+    float *c_t          = a_t + ROUND_UP(M * K, 8);
+    float *chunk_buf    = c_t + ROUND_UP(M * N, 8);
+    const float *packed = buffer_weight_.force_to<float *>() + b_index * chunks * chunk_size;
+
+    MatTranspose(a_t, a, M, K);
+    X86ParallelFor(context_->GetNumThreads(), chunks, 1, [&](long begin, long end) {
+        for (long i = begin; i < end; i++) {
+            const int n_begin = i * chunk_;
+            const int cur_n   = MIN(chunk_, N - n_begin);
+            conv_sgemm_nn_col_major(M, cur_n, K, a_t, M, packed + i * chunk_size, K, c_t + n_begin * M, M,
+                                    bias + n_begin, ActivationType_None, chunk_buf + i * src_buf_size,
+                                    conv_gemm_conf_);
+        }
+    });
+    MatTranspose(c, c_t, N, M);
+}
+
+void X86MatMulLayerAcc::ExecPackedA(const float *a, const float *packed_a, const float *b, int M, int N, int K,
+                                    float *c, const float *bias, float *workspace) {
+    const int chunks    = UP_DIV(M, chunk_);
+    size_t chunk_size   = ROUND_UP(K, conv_gemm_conf_.K_c_) * chunk_;
+    size_t src_buf_size = ROUND_UP(conv_gemm_conf_.M_c_ * conv_gemm_conf_.K_c_, 8);
+    size_t pack_size    = packed_a ? 0 : chunk_size;
+    float *chunk_buf    = workspace;
+
+    X86ParallelFor(context_->GetNumThreads(), chunks, 1, [&](long begin, long end) {
+        for (long i = begin; i < end; i++) {
+            const int m_begin = i * chunk_;
+            const int cur_m   = MIN(chunk_, M - m_begin);
+            float *src_buf    = chunk_buf + i * (src_buf_size + pack_size);
+            const float *pack = packed_a ? packed_a + i * chunk_size : src_buf + src_buf_size;
+            if (!packed_a) {
+                conv_pack_weights(cur_m, K, a + m_begin * K, K, src_buf + src_buf_size, conv_gemm_conf_);
+            }
+            conv_sgemm_nn_col_major(N, cur_m, K, b, N, pack, K, c + m_begin * N, N, bias + m_begin,
+                                    ActivationType_None, src_buf, conv_gemm_conf_);
+        }
+    });
+}
+
+Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<MatMulLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    DimsVector a_dims, b_dims;
+    MatMulShape shape;
+    RETURN_ON_NEQ(GetMatMulInputDims(param, inputs, a_dims, b_dims), TNN_OK);
+    RETURN_ON_NEQ(GetMatMulShape(a_dims, b_dims, shape), TNN_OK);
+    const int M = shape.M, N = shape.N, K = shape.K;
+
+    const float *weight = param->weight_position != -1 ? buffer_weight_.force_to<float *>() : nullptr;
+    const float *a      = static_cast<float *>(inputs[0]->GetHandle().base);
+    const float *b      = param->weight_position == -1 ? static_cast<float *>(inputs[1]->GetHandle().base) : a;
+    float *c            = static_cast<float *>(outputs[0]->GetHandle().base);
+    if (param->weight_position == -1) {
+        chunk_ = ROUND_UP(UP_DIV(M, context_->GetNumThreads()), conv_gemm_conf_.n_block_);
+    }
+
+    // zero bias of the gemm, then the operand buffers and a gemm buffer for each chunk, all 32 byte aligned for
+    // the aligned loads of the kernels
+    const int channels  = param->weight_position == 1 ? N : M;
+    const int chunks    = UP_DIV(channels, chunk_);
+    size_t chunk_size   = ROUND_UP(K, conv_gemm_conf_.K_c_) * chunk_;
+    size_t src_buf_size = ROUND_UP(conv_gemm_conf_.M_c_ * conv_gemm_conf_.K_c_, 8);
+    size_t bias_size    = ROUND_UP(ROUND_UP(std::max(M, N), conv_gemm_conf_.n_block_), 8);
+    size_t workspace_size = bias_size + chunks * src_buf_size;
+    if (param->weight_position == 1) {
+        workspace_size += ROUND_UP(M * K, 8) + ROUND_UP(M * N, 8);
+    } else if (param->weight_position == -1) {
+        workspace_size += chunks * chunk_size;
+    }
+    float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size * sizeof(float)));
+    memset(workspace, 0, bias_size * sizeof(float));
+    const float *bias = workspace;
+    workspace += bias_size;
+
+    for (int n = 0; n < shape.a_index.size(); n++) {
+        float *c_n = c + n * M * N;
+        if (param->weight_position == 1) {
+            ExecConstB(a + shape.a_index[n] * M * K, M, N, K, shape.b_index[n], c_n, bias, workspace);
+        } else if (param->weight_position == 0) {
+            ExecPackedA(nullptr, weight + shape.a_index[n] * chunks * chunk_size, b + shape.b_index[n] * K * N, M,
+                        N, K, c_n, bias, workspace);
+        } else {
+            ExecPackedA(a + shape.a_index[n] * M * K, nullptr, b + shape.b_index[n] * K * N, M, N, K, c_n, bias,
+                        workspace);
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(MatMul, LAYER_MATMUL);
+
+}  // namespace TNN_NS
@@ -15,10 +15,36 @@
 #include "tnn/device/x86/acc/x86_permute_layer_acc.h"
 
 #include "tnn/utils/dims_vector_utils.h"
-#include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
 
+// output rows along the last dim are split among threads, the input offset of a row comes from its output index
+template <typename T>
+static void X86Permute(const DimsVector &output_dims, const T *input_data, const std::vector<int> &orders,
+                       const std::vector<int> &input_step, const std::vector<int> &output_step, T *output_data,
+                       int num_threads) {
+    const int num_dims   = static_cast<int>(output_dims.size());
+    const long row_size  = output_dims[num_dims - 1];
+    const long row_count = DimsVectorUtils::Count(output_dims) / MAX(row_size, 1L);
+    const long row_step  = input_step[orders[num_dims - 1]];
+
+    X86ParallelFor(num_threads, row_count, UP_DIV(4096, MAX(row_size, 1L)), [&](long begin, long end) {
+        for (long row = begin; row < end; row++) {
+            long idx     = row * row_size;
+            long old_idx = 0;
+            for (int j = 0; j < num_dims - 1; ++j) {
+                old_idx += (idx / output_step[j]) * input_step[orders[j]];
+                idx %= output_step[j];
+            }
+            const T *src = input_data + old_idx;
+            T *dst       = output_data + row * row_size;
+            for (long w = 0; w < row_size; ++w) {
+                dst[w] = src[w * row_step];
+            }
+        }
+    });
+}
+
 X86PermuteLayerAcc::~X86PermuteLayerAcc(){};
 
 Status X86PermuteLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
@@ -31,11 +57,9 @@ Status X86PermuteLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
     DataType data_type     = output_blob->GetBlobDesc().data_type;
     DimsVector input_dims  = input_blob->GetBlobDesc().dims;
     DimsVector output_dims = output_blob->GetBlobDesc().dims;
-    const int output_count = DimsVectorUtils::Count(output_dims);
 
     std::vector<int> input_step;
     std::vector<int> output_step;
-    int num_dims = int(input_dims.size());
     ASSERT(input_dims.size() == output_dims.size());
     for (int i = 0; i < input_dims.size(); ++i) {
         input_step.push_back(X86PermuteLayerAcc::count(input_dims, i + 1));
@@ -45,12 +69,14 @@ Status X86PermuteLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
     if (data_type != DATA_TYPE_INT8) {
         float *input_data  = static_cast<float *>(input_blob->GetHandle().base);
         float *output_data = static_cast<float *>(output_blob->GetHandle().base);
-        NaivePermute<float>(output_count, output_dims, input_data, param->orders, input_step, output_step, num_dims, output_data);
+        X86Permute<float>(output_dims, input_data, param->orders, input_step, output_step, output_data,
+                          context_->GetNumThreads());
     } else {
         // DATA_TYPE_INT8
         int8_t *input_data  = static_cast<int8_t *>(input_blob->GetHandle().base);
         int8_t *output_data = static_cast<int8_t *>(output_blob->GetHandle().base);
-        NaivePermute<int8_t>(output_count, output_dims, input_data, param->orders, input_step, output_step, num_dims, output_data);
+        X86Permute<int8_t>(output_dims, input_data, param->orders, input_step, output_step, output_data,
+                           context_->GetNumThreads());
     }
     return TNN_OK;
 }
@@ -19,6 +19,7 @@
 #include "tnn/device/x86/x86_util.h"
 
 #include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
 #include "tnn/device/x86/acc/x86_pool_layer_acc.h"
 #include "tnn/device/x86/acc/Float8.h"
 #include "tnn/device/x86/acc/Float4.h"
@@ -111,6 +112,28 @@ Status X86PoolLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
                 UnpackAcc(output_b + c * dst_hw, dst_pack_ptr, dst_hw, dst_hw, dst_hw, left_c);
             }
         }
+    } else if (output->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        // 16 int8 channels per pack, the float workspace holds at least 16 bytes per pixel
+        auto src_pack_i8 = reinterpret_cast<int8_t *>(src_pack_ptr);
+        auto dst_pack_i8 = reinterpret_cast<int8_t *>(dst_pack_ptr);
+        for (int b = 0; b < batch; b++) {
+            auto input_b  = reinterpret_cast<int8_t *>(input_ptr) + b * dims_input[1] * src_hw;
+            auto output_b = reinterpret_cast<int8_t *>(output_ptr) + b * dims_output[1] * dst_hw;
+            for (int c = 0; c < dims_output[1]; c += 16) {
+                int left_c = MIN(dims_output[1] - c, 16);
+                X86Int8PackC16(src_pack_i8, input_b + c * src_hw, src_hw, src_hw, left_c);
+                if (param->pool_type == 0) {
+                    X86Int8MaxPoolingC16(src_pack_i8, dims_input[3], dims_input[2], dst_pack_i8, dims_output[3],
+                                         dims_output[2], param->kernels[0], param->kernels[1], param->strides[0],
+                                         param->strides[1], param->pads[0], param->pads[2]);
+                } else {
+                    X86Int8AvgPoolingC16(src_pack_i8, dims_input[3], dims_input[2], dst_pack_i8, dims_output[3],
+                                         dims_output[2], param->kernels[0], param->kernels[1], param->strides[0],
+                                         param->strides[1], param->pads[0], param->pads[2]);
+                }
+                X86Int8UnpackC16(output_b + c * dst_hw, dst_pack_i8, dst_hw, dst_hw, left_c);
+            }
+        }
     } else {
         return Status(TNNERR_DEVICE_ACC_DATA_FORMAT_NOT_SUPPORT, "Error: this data type not supported in pooling layer");
     }
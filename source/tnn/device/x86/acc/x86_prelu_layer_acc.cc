@@ -24,14 +24,17 @@ namespace TNN_NS {
 DECLARE_X86_ACC(PRelu, X86_PRELU_OP);
 
 template <typename VEC, int pack>
-static void prelu_func(float *input, float *output, const float *slope, DimsVector dims, bool is_channel_shared) {
+static void prelu_func(float *input, float *output, const float *slope, DimsVector dims, bool is_channel_shared,
+                       int num_threads) {
     auto plane = DimsVectorUtils::Count(dims, 2);
 
-    for (int b = 0; b < dims[0]; b++) {
-        for (int c = 0; c < dims[1]; c++) {
+    // planes of batch * channel are split among threads
+    X86ParallelFor(num_threads, dims[0] * dims[1], UP_DIV(4096, plane), [&](long begin, long end) {
+        for (long bc = begin; bc < end; bc++) {
+            int c         = bc % dims[1];
             float coef    = is_channel_shared ? slope[0] : slope[c];
-            auto input_c  = input + b * DimsVectorUtils::Count(dims, 1) + c * plane;
-            auto output_c = output + b * DimsVectorUtils::Count(dims, 1) + c * plane;
+            auto input_c  = input + bc * plane;
+            auto output_c = output + bc * plane;
             int i         = 0;
             VEC v_zero(0.f);
             VEC v_slope(coef);
@@ -57,7 +60,7 @@ static void prelu_func(float *input, float *output, const float *slope, DimsVect
                 }
             }
         }
-    }
+    });
 }
 
 Status X86PReluLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
@@ -96,7 +99,8 @@ Status X86PReluLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std:
 
         float *input_data  = static_cast<float *>(input_blob->GetHandle().base);
         float *output_data = static_cast<float *>(output_blob->GetHandle().base);
-        calc(input_data, output_data, slope_data, output_blob->GetBlobDesc().dims, layer_param->channel_shared);
+        calc(input_data, output_data, slope_data, output_blob->GetBlobDesc().dims, layer_param->channel_shared,
+             context_->GetNumThreads());
     } else {
         return Status(TNNERR_DEVICE_ACC_DATA_FORMAT_NOT_SUPPORT, "Error: this data type not supported in prelu layer");
     }
@@ -54,7 +54,7 @@ Status X86ReduceOpLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
 
     X86_REDUCE_CALCULATE(static_cast<float *>(input_blob->GetHandle().base),
                          static_cast<float *>(output_blob->GetHandle().base),
-                         workspace, reduce_dims, input_dim, output_dim, op_type_);
+                         workspace, reduce_dims, input_dim, output_dim, op_type_, context_->GetNumThreads());
 
     return TNN_OK;
 }
@@ -0,0 +1,73 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/blob_int8.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+
+namespace TNN_NS {
+
+// @brief quant and dequant between float and int8 blobs, both in NCHW
+class X86ReformatLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86ReformatLayerAcc(){};
+
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+};
+
+Status X86ReformatLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto reformat_param = dynamic_cast<ReformatLayerParam *>(param_);
+    CHECK_PARAM_NULL(reformat_param);
+
+    if (reformat_param->src_type == DATA_TYPE_INT8 && reformat_param->dst_type == DATA_TYPE_FLOAT) {
+        reformat_param->type = DEQUANT_ONLY;
+    } else if (reformat_param->src_type == DATA_TYPE_FLOAT && reformat_param->dst_type == DATA_TYPE_INT8) {
+        reformat_param->type = QUANT_ONLY;
+    } else {
+        return Status(TNNERR_LAYER_ERR, "Error: x86 layer acc got unsupported data type.");
+    }
+    return TNN_OK;
+}
+
+Status X86ReformatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ReformatLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    auto dims = outputs[0]->GetBlobDesc().dims;
+
+    IntScaleResource *re;
+    if (param->src_type == DATA_TYPE_INT8) {
+        re = reinterpret_cast<BlobInt8 *>(inputs[0])->GetIntResource();
+    } else if (param->dst_type == DATA_TYPE_INT8) {
+        re = reinterpret_cast<BlobInt8 *>(outputs[0])->GetIntResource();
+    } else {
+        return Status(TNNERR_LAYER_ERR, "Error: x86 layer acc got unsupported data type.");
+    }
+
+    if (param->type == DEQUANT_ONLY) {
+        X86Int8Dequant(reinterpret_cast<float *>(outputs[0]->GetHandle().base),
+                       reinterpret_cast<int8_t *>(inputs[0]->GetHandle().base), re->scale_handle.force_to<float *>(),
+                       re->scale_handle.GetDataCount(), dims);
+    } else if (param->type == QUANT_ONLY) {
+        X86Int8Quant(reinterpret_cast<int8_t *>(outputs[0]->GetHandle().base),
+                     reinterpret_cast<float *>(inputs[0]->GetHandle().base), re->scale_handle.force_to<float *>(),
+                     re->scale_handle.GetDataCount(), dims);
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(Reformat, LAYER_REFORMAT);
+
+}  // namespace TNN_NS
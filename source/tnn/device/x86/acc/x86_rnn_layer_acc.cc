@@ -0,0 +1,295 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_rnn_layer_acc.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/rnn_utils.h"
+#include "tnn/utils/string_utils_inner.h"
+
+namespace TNN_NS {
+
+X86RNNLayerAcc::~X86RNNLayerAcc() {}
+
+std::vector<DataFormat> X86RNNLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    return SupportAnyRankDataFormat(data_type, dims_size);
+}
+
+Status X86RNNLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                            const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto rnn_res = dynamic_cast<RNNLayerResource *>(resource);
+    CHECK_PARAM_NULL(rnn_res);
+    if (rnn_res->weight_handle.GetDataType() == DATA_TYPE_HALF) {
+        LayerType layer_type    = dynamic_cast<GRULayerParam *>(param) ? LAYER_GRU : LAYER_LSTM;
+        LayerResource *fp32_res = nullptr;
+        RETURN_ON_NEQ(ConvertHalfResource(layer_type, rnn_res, &fp32_res), TNN_OK);
+        rnn_f32_resource_ = std::shared_ptr<LayerResource>(fp32_res);
+        resource          = rnn_f32_resource_.get();
+    }
+    RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+    if (inputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_LAYER_ERR, "x86 rnn layer acc only supports float");
+    }
+
+    gates_ = GetGateCount();
+    pack_  = arch_ == avx2 ? 8 : 4;
+    return allocateBufferWeight(inputs, outputs);
+}
+
+bool X86RNNLayerAcc::IsRecurrenceBiasSeparate(int gate) {
+    return false;
+}
+
+int X86RNNLayerAcc::GetStepPhases() {
+    return 1;
+}
+
+Status X86RNNLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<RNNLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    auto res = dynamic_cast<RNNLayerResource *>(resource_);
+    CHECK_PARAM_NULL(res);
+
+    hidden_size_             = param->hidden_size;
+    hidden_pad_              = ROUND_UP(hidden_size_, pack_);
+    const int num_directions = param->direction == 2 ? 2 : 1;
+    const int input_size     = DimsVectorUtils::Count(inputs[0]->GetBlobDesc().dims, 2);
+    const int gate_size      = gates_ * hidden_size_;
+    const int channels       = num_directions * gates_ * hidden_pad_;
+    if (res->weight_handle.GetDataCount() != num_directions * gate_size * input_size ||
+        res->recurrence_handle.GetDataCount() != num_directions * gate_size * hidden_size_) {
+        return Status(TNNERR_MODEL_ERR, "RNNLayerResource does not match the input size or the hidden size");
+    }
+    const float *weight     = res->weight_handle.force_to<float *>();
+    const float *recurrence = res->recurrence_handle.force_to<float *>();
+    const float *bias       = res->bias_handle.GetDataCount() >= num_directions * 2 * gate_size
+                                  ? res->bias_handle.force_to<float *>()
+                                  : nullptr;
+
+    gemm_oc_chunk_ = ROUND_UP(UP_DIV(channels, context_->GetNumThreads()), conv_gemm_conf_.n_block_);
+    auto pack_weight = [&](RawBuffer &packed) -> Status {
+        RawBuffer padded(channels * input_size * sizeof(float));
+        float *padded_data = padded.force_to<float *>();
+        for (int g = 0; g < num_directions * gates_; g++) {
+            memcpy(padded_data + g * hidden_pad_ * input_size, weight + g * hidden_size_ * input_size,
+                   hidden_size_ * input_size * sizeof(float));
+        }
+
+        size_t chunk_size = ROUND_UP(input_size, conv_gemm_conf_.K_c_) * gemm_oc_chunk_;
+        RawBuffer temp_buffer(UP_DIV(channels, gemm_oc_chunk_) * chunk_size * sizeof(float));
+        float *dst = temp_buffer.force_to<float *>();
+        for (int c = 0; c * gemm_oc_chunk_ < channels; c++) {
+            int cur_oc = MIN(gemm_oc_chunk_, channels - c * gemm_oc_chunk_);
+            conv_pack_weights(cur_oc, input_size, padded_data + c * gemm_oc_chunk_ * input_size, input_size,
+                              dst + c * chunk_size, conv_gemm_conf_);
+        }
+        temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+        packed = temp_buffer;
+        return TNN_OK;
+    };
+    std::string variant = "rnn_w_" + ToString(gemm_oc_chunk_) + "_" + ToString(conv_gemm_conf_.K_c_) + "_" +
+                          ToString(conv_gemm_conf_.n_block_);
+    RETURN_ON_NEQ(GetSharedPackedWeight(buffer_weight_, variant, pack_weight), TNN_OK);
+
+    // each block of pack_ hidden units reads its rows of all the gates in one pass over h
+    auto pack_recurrence = [&](RawBuffer &packed) -> Status {
+        const int blocks = hidden_pad_ / pack_;
+        RawBuffer temp_buffer(num_directions * blocks * hidden_size_ * gates_ * pack_ * sizeof(float));
+        float *dst = temp_buffer.force_to<float *>();
+        for (int d = 0; d < num_directions; d++) {
+            for (int b = 0; b < blocks; b++) {
+                for (int k = 0; k < hidden_size_; k++) {
+                    for (int q = 0; q < gates_; q++) {
+                        for (int j = 0; j < pack_ && b * pack_ + j < hidden_size_; j++) {
+                            int h  = b * pack_ + j;
+                            dst[j] = recurrence[((d * gates_ + q) * hidden_size_ + h) * hidden_size_ + k];
+                        }
+                        dst += pack_;
+                    }
+                }
+            }
+        }
+        temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+        packed = temp_buffer;
+        return TNN_OK;
+    };
+    RETURN_ON_NEQ(GetSharedPackedWeight(buffer_recurrence_, "rnn_r_" + ToString(pack_), pack_recurrence), TNN_OK);
+
+    // Wb + Rb go with the projection unless the step needs Rb on its own
+    RawBuffer proj_bias(channels * sizeof(float));
+    RawBuffer recurrence_bias(channels * sizeof(float));
+    if (bias) {
+        float *proj_bias_data       = proj_bias.force_to<float *>();
+        float *recurrence_bias_data = recurrence_bias.force_to<float *>();
+        for (int d = 0; d < num_directions; d++) {
+            for (int q = 0; q < gates_; q++) {
+                const float *wb = bias + d * 2 * gate_size + q * hidden_size_;
+                const float *rb = wb + gate_size;
+                int offset      = (d * gates_ + q) * hidden_pad_;
+                for (int h = 0; h < hidden_size_; h++) {
+                    if (IsRecurrenceBiasSeparate(q)) {
+                        proj_bias_data[offset + h]       = wb[h];
+                        recurrence_bias_data[offset + h] = rb[h];
+                    } else {
+                        proj_bias_data[offset + h] = wb[h] + rb[h];
+                    }
+                }
+            }
+        }
+    }
+    buffer_bias_            = proj_bias;
+    buffer_recurrence_bias_ = recurrence_bias;
+    return TNN_OK;
+}
+
+void X86RNNLayerAcc::ProjectInput(const float *input, int tokens, int input_size, int channels, float *proj,
+                                  float *workspace) {
+    const int chunks    = UP_DIV(channels, gemm_oc_chunk_);
+    size_t chunk_size   = ROUND_UP(input_size, conv_gemm_conf_.K_c_) * gemm_oc_chunk_;
+    size_t input_t_size = ROUND_UP(tokens * input_size, 8);
+    size_t proj_t_size  = ROUND_UP(tokens * channels, 8);
+    size_t src_buf_size = ROUND_UP(conv_gemm_conf_.M_c_ * conv_gemm_conf_.K_c_, 8);
+    float *input_t      = workspace;
+    float *proj_t       = input_t + input_t_size;
+    float *chunk_buf    = proj_t + proj_t_size;
+    auto weight_data    = buffer_weight_.force_to<float *>();
+    auto bias_data      = buffer_bias_.force_to<float *>();
+
+    // the gemm is column major, tokens are contiguous in the transposed buffers
+    MatTranspose(input_t, input, tokens, input_size);
+    X86ParallelFor(context_->GetNumThreads(), chunks, 1, [&](long begin, long end) {
+        for (long c = begin; c < end; c++) {
+            const int oc_begin = c * gemm_oc_chunk_;
+            const int cur_oc   = MIN(gemm_oc_chunk_, channels - oc_begin);
+            conv_sgemm_nn_col_major(tokens, cur_oc, input_size, input_t, tokens, weight_data + c * chunk_size,
+                                    input_size, proj_t + oc_begin * tokens, tokens, bias_data + oc_begin,
+                                    ActivationType_None, chunk_buf + c * src_buf_size, conv_gemm_conf_);
+        }
+    });
+    MatTranspose(proj, proj_t, channels, tokens);
+}
+
+Status X86RNNLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<RNNLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    auto dims_input          = inputs[0]->GetBlobDesc().dims;
+    const int sequence       = dims_input[0];
+    const int batch          = dims_input[1];
+    const int input_size     = DimsVectorUtils::Count(dims_input, 2);
+    const int num_directions = param->direction == 2 ? 2 : 1;
+    const int tokens         = sequence * batch;
+    const int channels       = num_directions * gates_ * hidden_pad_;
+    const int blocks         = hidden_pad_ / pack_;
+
+    // projection, h of the previous and the next step, c, two scratch rows, then the gemm operands
+    size_t proj_size  = ROUND_UP(tokens * channels, 8);
+    size_t state_size = ROUND_UP(num_directions * batch * hidden_pad_, 8);
+    size_t gemm_size  = ROUND_UP(tokens * input_size, 8) + proj_size +
+                       UP_DIV(channels, gemm_oc_chunk_) * ROUND_UP(conv_gemm_conf_.M_c_ * conv_gemm_conf_.K_c_, 8);
+    float *workspace = reinterpret_cast<float *>(
+        context_->GetSharedWorkSpace((proj_size + 5 * state_size + gemm_size) * sizeof(float)));
+    float *proj     = workspace;
+    float *h_prev   = proj + proj_size;
+    float *h_next   = h_prev + state_size;
+    float *c        = h_next + state_size;
+    float *temp_row = c + state_size;
+    float *temp     = temp_row + state_size;
+
+    auto input_data = static_cast<float *>(inputs[0]->GetHandle().base);
+    ProjectInput(input_data, tokens, input_size, channels, proj, temp + state_size);
+
+    const float *initial_h = GetRNNInitialState(param, inputs, 0);
+    const float *initial_c = gates_ == 4 ? GetRNNInitialState(param, inputs, 1) : nullptr;
+    memset(h_prev, 0, 3 * state_size * sizeof(float));
+    for (int i = 0; i < num_directions * batch; i++) {
+        if (initial_h) {
+            memcpy(h_prev + i * hidden_pad_, initial_h + i * hidden_size_, hidden_size_ * sizeof(float));
+        }
+        if (initial_c) {
+            memcpy(c + i * hidden_pad_, initial_c + i * hidden_size_, hidden_size_ * sizeof(float));
+        }
+    }
+
+    auto sequence_lens = GetRNNSequenceLens(param, inputs);
+    auto output_data   = static_cast<float *>(outputs[0]->GetHandle().base);
+    if (*std::min_element(sequence_lens.begin(), sequence_lens.end()) < sequence) {
+        // steps past the sequence length of a batch are 0
+        memset(output_data, 0, DimsVectorUtils::Count(outputs[0]->GetBlobDesc().dims) * sizeof(float));
+    }
+
+    auto recurrence_data      = buffer_recurrence_.force_to<float *>();
+    auto recurrence_bias_data = buffer_recurrence_bias_.force_to<float *>();
+    const int phases          = GetStepPhases();
+    for (int s = 0; s < sequence; s++) {
+        for (int phase = 0; phase < phases; phase++) {
+            const bool last_phase = phase == phases - 1;
+            X86ParallelFor(context_->GetNumThreads(), num_directions * batch * blocks, 1, [&](long begin, long end) {
+                for (long i = begin; i < end; i++) {
+                    const int b      = i % blocks;
+                    const int n      = (i / blocks) % batch;
+                    const int d      = i / (blocks * batch);
+                    const int row    = (d * batch + n) * hidden_pad_;
+                    const int offset = b * pack_;
+                    const int len    = sequence_lens[n];
+                    if (s >= len) {
+                        // the state of a finished sequence is carried over
+                        if (last_phase) {
+                            memcpy(h_next + row + offset, h_prev + row + offset, pack_ * sizeof(float));
+                        }
+                        continue;
+                    }
+
+                    const bool reverse = param->direction == 1 || d == 1;
+                    const int t        = reverse ? len - 1 - s : s;
+                    X86RNNStepBlock block;
+                    block.proj            = proj + (t * batch + n) * channels + d * gates_ * hidden_pad_ + offset;
+                    block.recurrence      = recurrence_data + (d * blocks + b) * hidden_size_ * gates_ * pack_;
+                    block.recurrence_bias = recurrence_bias_data + d * gates_ * hidden_pad_ + offset;
+                    block.h_prev          = h_prev + row;
+                    block.h_next          = h_next + row + offset;
+                    block.c               = c + row + offset;
+                    block.temp_row        = temp_row + row;
+                    block.temp            = temp + row + offset;
+                    block.block_offset    = offset;
+                    StepBlock(phase, block);
+
+                    if (last_phase) {
+                        memcpy(output_data + ((t * num_directions + d) * batch + n) * hidden_size_ + offset,
+                               h_next + row + offset, MIN(pack_, hidden_size_ - offset) * sizeof(float));
+                    }
+                }
+            });
+        }
+        std::swap(h_prev, h_next);
+    }
+
+    for (int i = 0; i < num_directions * batch; i++) {
+        if (outputs.size() > 1) {
+            memcpy(static_cast<float *>(outputs[1]->GetHandle().base) + i * hidden_size_, h_prev + i * hidden_pad_,
+                   hidden_size_ * sizeof(float));
+        }
+        if (outputs.size() > 2) {
+            memcpy(static_cast<float *>(outputs[2]->GetHandle().base) + i * hidden_size_, c + i * hidden_pad_,
+                   hidden_size_ * sizeof(float));
+        }
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,83 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_RNN_LAYER_ACC_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_X86_RNN_LAYER_ACC_H_
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
+
+namespace TNN_NS {
+
+// @brief pointers of one block of pack hidden units of a batch and direction in a recurrent step.
+// gate q of proj and recurrence_bias is at q * hidden_pad, recurrence is [hidden_size][gates][pack].
+struct X86RNNStepBlock {
+    const float *proj;
+    const float *recurrence;
+    const float *recurrence_bias;
+    // the whole hidden state row of the previous step
+    const float *h_prev;
+    float *h_next;
+    float *c;
+    // scratch rows of hidden_pad floats for the gates computed in an earlier phase
+    float *temp_row;
+    float *temp;
+    int block_offset;
+};
+
+// @brief Lstm and Gru on x86. x W^T + b of all the steps and directions is one gemm ahead of the recurrence,
+// each step then runs the h R^T of a block of hidden units and its gate activations in registers.
+// blocks of all the batches and directions of a step run on different threads.
+class X86RNNLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86RNNLayerAcc();
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override;
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+protected:
+    // the input is [sequence, batch, input...], the states and sequence_lens have 1 to 3 dims
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) override;
+
+    virtual int GetGateCount() = 0;
+    // gru with linear_before_reset adds the Rb of a gate inside the step instead of the projection
+    virtual bool IsRecurrenceBiasSeparate(int gate);
+    // phases of a step, the blocks of a phase see all the results of the previous one
+    virtual int GetStepPhases();
+    virtual void StepBlock(int phase, const X86RNNStepBlock &block) = 0;
+
+    Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    // proj [tokens, channels] of the input [tokens, input_size], workspace holds the transposed gemm operands
+    void ProjectInput(const float *input, int tokens, int input_size, int channels, float *proj, float *workspace);
+
+    int gates_       = 0;
+    int pack_        = 8;
+    int hidden_size_ = 0;
+    // hidden units of each gate rounded up to pack_, the padded units have zero weights and stay 0
+    int hidden_pad_ = 0;
+    // projection weights packed by conv_pack_weights in chunks of gemm_oc_chunk_ channels
+    RawBuffer buffer_weight_;
+    RawBuffer buffer_bias_;
+    // [num_directions][hidden_pad / pack][hidden_size][gates][pack]
+    RawBuffer buffer_recurrence_;
+    RawBuffer buffer_recurrence_bias_;
+    int gemm_oc_chunk_ = 0;
+    conv_gemm_config<float, float, float> conv_gemm_conf_;
+    std::shared_ptr<LayerResource> rnn_f32_resource_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_X86_RNN_LAYER_ACC_H_
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
 #include "tnn/utils/data_type_utils.h"
@@ -42,52 +43,60 @@ Status X86SoftMaxLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
     int channel        = dims[axis];
     int count          = DimsVectorUtils::Count(dims, axis + 1);
 
-    float *const temp = new float[count];
-
-    for (int n = 0; n < batch; n++) {
-        float *const input_batch  = input_data + n * channel * count;
-        float *const output_batch = output_data + n * channel * count;
-        // max
-        memcpy(temp, input_batch, count * sizeof(float));
-        for (int c = 1; c < channel; c++) {
-            float *input_channel = input_batch + c * count;
-            for (int ele = 0; ele < count; ele++) {
-                temp[ele] = std::max(temp[ele], input_channel[ele]);
+    // every thread takes a range of (batch, inner) positions, softmax runs along the channel of each position
+    const long total = static_cast<long>(batch) * count;
+    X86ParallelFor(context_->GetNumThreads(), total, UP_DIV(4096, channel), [&](long begin, long end) {
+        std::vector<float> temp_buffer(MIN(end - begin, static_cast<long>(count)));
+        float *const temp = temp_buffer.data();
+        for (long pos = begin; pos < end;) {
+            const int n     = static_cast<int>(pos / count);
+            const int start = static_cast<int>(pos % count);
+            const int len   = static_cast<int>(MIN(end - pos, static_cast<long>(count - start)));
+            pos += len;
+
+            float *const input_batch  = input_data + n * channel * count + start;
+            float *const output_batch = output_data + n * channel * count + start;
+            // max
+            memcpy(temp, input_batch, len * sizeof(float));
+            for (int c = 1; c < channel; c++) {
+                float *input_channel = input_batch + c * count;
+                for (int ele = 0; ele < len; ele++) {
+                    temp[ele] = std::max(temp[ele], input_channel[ele]);
+                }
             }
-        }
 
-        // exp
-        for (int c = 0; c < channel; c++) {
-            float *input_channel  = input_batch + c * count;
-            float *output_channel = output_batch + c * count;
+            // exp
+            for (int c = 0; c < channel; c++) {
+                float *input_channel  = input_batch + c * count;
+                float *output_channel = output_batch + c * count;
 
-            for (int ele = 0; ele < count; ele++) {
-                output_channel[ele] = expf(input_channel[ele] - temp[ele]);
+                for (int ele = 0; ele < len; ele++) {
+                    output_channel[ele] = expf(input_channel[ele] - temp[ele]);
+                }
             }
-        }
 
-        // sum
-        memcpy(temp, output_batch, count * sizeof(float));
-        for (int c = 1; c < channel; c++) {
-            float *output_channel = output_batch + c * count;
-            for (int ele = 0; ele < count; ele++) {
-                temp[ele] += output_channel[ele];
+            // sum
+            memcpy(temp, output_batch, len * sizeof(float));
+            for (int c = 1; c < channel; c++) {
+                float *output_channel = output_batch + c * count;
+                for (int ele = 0; ele < len; ele++) {
+                    temp[ele] += output_channel[ele];
+                }
             }
-        }
 
-        // division
-        for (int ele = 0; ele < count; ele++) {
-            temp[ele] = 1.0f / temp[ele];
-        }
-        for (int c = 0; c < channel; c++) {
-            float *output_channel = output_batch + c * count;
-            for (int ele = 0; ele < count; ele++) {
-                output_channel[ele] *= temp[ele];
+            // division
+            for (int ele = 0; ele < len; ele++) {
+                temp[ele] = 1.0f / temp[ele];
+            }
+            for (int c = 0; c < channel; c++) {
+                float *output_channel = output_batch + c * count;
+                for (int ele = 0; ele < len; ele++) {
+                    output_channel[ele] *= temp[ele];
+                }
             }
         }
-    }
+    });
 
-    delete[] temp;
     return TNN_OK;
 }
 
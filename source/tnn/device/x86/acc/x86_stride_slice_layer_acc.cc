@@ -54,22 +54,25 @@ Status X86StrideSliceLayerAcc::DoForward(const std::vector<Blob *> &inputs, cons
             ends[i] = input_blob->GetBlobDesc().dims[i];
         }
     }
-    int nn = 0, nc = 0, nh = 0, nw = 0;
-
     if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         float *input_data  = reinterpret_cast<float *>(input_blob->GetHandle().base);
         float *output_data = reinterpret_cast<float *>(output_blob->GetHandle().base);
 
-        for (int n = begins[0]; n < ends[0]; n += strides[0], nn++) {
-            auto input_ptr  = input_data + n * input_channel * input_width * input_height;
-            auto output_ptr = output_data + nn * output_channel * output_width * output_height;
-            nc = 0;
-            for (int c = begins[1]; c < ends[1]; c += strides[1], nc++) {
-                nh = 0;
-                auto input_c  = input_ptr + c * input_width * input_height;
-                auto output_c = output_ptr + nc * output_width * output_height;
+        // output planes of batch * channel are split among threads
+        const long plane_count = static_cast<long>(dims_output[0]) * output_channel;
+        const long plane_size  = static_cast<long>(output_height) * output_width;
+        X86ParallelFor(context_->GetNumThreads(), plane_count, UP_DIV(4096, MAX(plane_size, 1L)),
+                       [&](long begin, long end) {
+            for (long plane = begin; plane < end; plane++) {
+                int nn        = static_cast<int>(plane / output_channel);
+                int nc        = static_cast<int>(plane % output_channel);
+                int n         = begins[0] + nn * strides[0];
+                int c         = begins[1] + nc * strides[1];
+                auto input_c  = input_data + (n * input_channel + c) * input_width * input_height;
+                auto output_c = output_data + plane * plane_size;
+                int nh        = 0;
                 for (int h = begins[2]; h < ends[2]; h += strides[2], nh++) {
-                    nw = 0;
+                    int nw        = 0;
                     auto input_h  = input_c + h * input_width;
                     auto output_h = output_c + nh * output_width;
                     for (int w = begins[3]; w < ends[3]; w += strides[3], nw++) {
@@ -77,7 +80,7 @@ Status X86StrideSliceLayerAcc::DoForward(const std::vector<Blob *> &inputs, cons
                     }
                 }
             }
-        }
+        });
     } else {
         return Status(TNNERR_LAYER_ERR, "NO IMPLEMENT FOR int8/bfp16 StrideSlice");
     }
@@ -57,6 +57,10 @@ Status X86_UNARY2_CALCULATE(DimsVector &dims, const float *src, float *dst, Laye
 
 X86Unary2LayerAcc::~X86Unary2LayerAcc() {}
 
+std::vector<DataFormat> X86Unary2LayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    return SupportAnyRankDataFormat(data_type, dims_size);
+}
+
 Status X86Unary2LayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto input  = inputs[0];
     auto output = outputs[0];
@@ -67,7 +71,17 @@ Status X86Unary2LayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     auto input_data  = static_cast<float *>(input->GetHandle().base);
     auto output_data = static_cast<float *>(output->GetHandle().base);
 
-    RETURN_ON_NEQ(X86_UNARY2_CALCULATE(dims, input_data, output_data, type_, arch_, param_), TNN_OK);
+    unary2_kernel_avx_func_t unary2_kernel_func = nullptr;
+    RETURN_ON_NEQ(GetUnary2Kernel(type_, arch_, unary2_kernel_func), TNN_OK);
+
+    // split by blocks of 16 floats, so that every range keeps the alignment of the blob
+    const long block_count = UP_DIV(count, 16);
+    X86ParallelFor(context_->GetNumThreads(), block_count, 256, [&](long begin, long end) {
+        long x_begin = begin * 16;
+        long x_end   = MIN(end * 16, static_cast<long>(count));
+        DimsVector range_dims = {static_cast<int>(x_end - x_begin)};
+        unary2_kernel_func(range_dims, input_data + x_begin, output_data + x_begin, param_);
+    });
 
     return TNN_OK;
 }
@@ -90,6 +90,9 @@ public:
     static Status GetUnary2Kernel(LayerType type, x86_isa_t arch, unary2_kernel_avx_func_t &kernel);
 
 protected:
+    // elementwise on blobs of any rank
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size) override;
+
     // std::shared_ptr<X86_UNARY2_OP> op_;
     LayerType type_;
 
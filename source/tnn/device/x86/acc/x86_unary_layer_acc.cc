@@ -36,9 +36,11 @@ Status X86UnaryLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std:
     auto input_data  = static_cast<float*>(input->GetHandle().base);
     auto output_data = static_cast<float*>(output->GetHandle().base);
 
-    for (int n = 0; n < count; n++) {
-        output_data[n] = (*op_)(input_data[n]);
-    }
+    X86ParallelFor(context_->GetNumThreads(), count, 4096, [&](long begin, long end) {
+        for (long n = begin; n < end; n++) {
+            output_data[n] = (*op_)(input_data[n]);
+        }
+    });
 
     return TNN_OK;
 }
@@ -12,19 +12,424 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include "tnn/device/x86/x86_blob_converter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "tnn/core/macro.h"
-#include "tnn/utils/blob_converter_default.h"
-#include "tnn/utils/blob_converter.h"
+#include "tnn/device/x86/x86_common.h"
+#include "tnn/device/x86/x86_mat_util.h"
+#include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_utils_inner.h"
 
 namespace TNN_NS {
 
-class X86BlobConverterAcc : public DefaultBlobConverterAcc {
-public:
-    X86BlobConverterAcc(Blob *blob) : DefaultBlobConverterAcc(blob) {}
-    ~X86BlobConverterAcc() {}
-};
+X86BlobConverterAcc::X86BlobConverterAcc(Blob *blob) : DefaultBlobConverterAcc(blob) {}
+X86BlobConverterAcc::~X86BlobConverterAcc() {}
+
+std::string X86BlobConverterAcc::GetUniqueBlobConvertKey(MatType mat_type, X86BlobConvertDirection cvt_dir) {
+    return ToString(mat_type) + "_" + ToString(cvt_dir);
+}
+
+std::map<std::string, X86BlobConvertFunc> &X86BlobConverterAcc::GetBlobConvertFuncMap() {
+    static std::map<std::string, X86BlobConvertFunc> cvt_map;
+    return cvt_map;
+}
+
+Status X86BlobConverterAcc::RegisterBlobConvertFunc(MatType mat_type, X86BlobConvertDirection cvt_dir,
+                                                    X86BlobConvertFunc cvt_func) {
+    auto &cvt_map       = GetBlobConvertFuncMap();
+    const auto &cvt_key = GetUniqueBlobConvertKey(mat_type, cvt_dir);
+    cvt_map[cvt_key]    = cvt_func;
+    return TNN_OK;
+}
+
+X86BlobConvertFunc X86BlobConverterAcc::GetBlobConvertFunc(Mat &image, X86BlobConvertDirection cvt_dir) {
+    const auto &desc = blob_->GetBlobDesc();
+    if (desc.data_type != DATA_TYPE_FLOAT || desc.data_format != DATA_FORMAT_NCHW || desc.dims.size() != 4) {
+        return nullptr;
+    }
+    const auto &cvt_map = GetBlobConvertFuncMap();
+    auto iter           = cvt_map.find(GetUniqueBlobConvertKey(image.GetMatType(), cvt_dir));
+    return iter != cvt_map.end() ? iter->second : nullptr;
+}
+
+Status X86BlobConverterAcc::ConvertToMatAsync(Mat &image, MatConvertParam param, void *command_queue) {
+    if (blob_ == nullptr) {
+        return Status(TNNERR_NULL_PARAM, "input/output blob is null");
+    }
+    auto cvt_func = GetBlobConvertFunc(image, X86_CVT_DIR_BLOB2MAT);
+    if (!cvt_func) {
+        return DefaultBlobConverterAcc::ConvertToMatAsync(image, param, command_queue);
+    }
+    auto dims      = blob_->GetBlobDesc().dims;
+    auto blob_data = reinterpret_cast<float *>(blob_->GetHandle().base);
+    return cvt_func(image, blob_data, param, dims, dims[2] * dims[3]);
+}
+
+Status X86BlobConverterAcc::ConvertFromMatAsync(Mat &image, MatConvertParam param, void *command_queue) {
+    if (blob_ == nullptr) {
+        return Status(TNNERR_NULL_PARAM, "input/output blob_ is null");
+    }
+    auto cvt_func = GetBlobConvertFunc(image, X86_CVT_DIR_MAT2BLOB);
+    if (!cvt_func) {
+        return DefaultBlobConverterAcc::ConvertFromMatAsync(image, param, command_queue);
+    }
+    auto dims      = blob_->GetBlobDesc().dims;
+    auto blob_data = reinterpret_cast<float *>(blob_->GetHandle().base);
+    return cvt_func(image, blob_data, param, dims, dims[2] * dims[3]);
+}
 
 DECLARE_BLOB_CONVERTER_CREATER(X86);
 REGISTER_BLOB_CONVERTER(X86, DEVICE_X86);
 
+static inline uint8_t SaturateCast(float data) {
+    data += 0.5f;
+    data = std::min(std::max(data, 0.0f), 255.0f);
+    return static_cast<uint8_t>(data);
+}
+
+#ifdef __AVX2__
+// 8 uint8 values in the low 64 bits of v, scaled to float
+static inline __m256 U8ToFloat8(__m128i v, __m256 scale, __m256 bias) {
+    return _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)), scale, bias);
+}
+
+// scale 8 floats and round them to uint8 in int32 lanes, same as SaturateCast
+static inline __m256i Float8ToU8(__m256 v, __m256 scale, __m256 bias) {
+    v = _mm256_add_ps(_mm256_fmadd_ps(v, scale, bias), _mm256_set1_ps(0.5f));
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(255.0f));
+    return _mm256_cvttps_epi32(v);
+}
+#endif
+
+/*
+ * Convert one row of uint8 bgr / bgra pixels to nchw float planes, element of channel c is read at
+ * src[c_offset[c]], which reverses rgb for free
+ */
+template <int mat_channel>
+static void PixelsToPlanes(const uint8_t *src, float *dst, int plane_size, const int *c_offset, int channel,
+                           const float *scale, const float *bias, int width) {
+    float *dst_c[4] = {dst, dst + plane_size, dst + plane_size * 2, dst + plane_size * 3};
+    int x           = 0;
+#ifdef __AVX2__
+    __m256 v_scale[4], v_bias[4];
+    for (int c = 0; c < channel; ++c) {
+        v_scale[c] = _mm256_set1_ps(scale[c]);
+        v_bias[c]  = _mm256_set1_ps(bias[c]);
+    }
+    if (mat_channel == 4) {
+        const __m256i mask = _mm256_set1_epi32(0xff);
+        for (; x + 8 <= width; x += 8) {
+            __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + x * 4));
+            for (int c = 0; c < channel; ++c) {
+                __m256i v = _mm256_and_si256(_mm256_srli_epi32(pixels, c_offset[c] * 8), mask);
+                _mm256_storeu_ps(dst_c[c] + x, _mm256_fmadd_ps(_mm256_cvtepi32_ps(v), v_scale[c], v_bias[c]));
+            }
+        }
+    } else {
+        // gather the channels of 8 bgr pixels, the low 16 bytes and the high 8 bytes separately
+        static const int8_t lo_index[3][16] = {
+            {0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+        };
+        static const int8_t hi_index[3][16] = {
+            {-1, -1, -1, -1, -1, -1, 2, 5, -1, -1, -1, -1, -1, -1, -1, -1},
+            {-1, -1, -1, -1, -1, 0, 3, 6, -1, -1, -1, -1, -1, -1, -1, -1},
+            {-1, -1, -1, -1, -1, 1, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1},
+        };
+        __m128i lo_mask[3], hi_mask[3];
+        for (int c = 0; c < channel; ++c) {
+            lo_mask[c] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lo_index[c_offset[c]]));
+            hi_mask[c] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hi_index[c_offset[c]]));
+        }
+        for (; x + 8 <= width; x += 8) {
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x * 3));
+            __m128i hi = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + x * 3 + 16));
+            for (int c = 0; c < channel; ++c) {
+                __m128i v = _mm_or_si128(_mm_shuffle_epi8(lo, lo_mask[c]), _mm_shuffle_epi8(hi, hi_mask[c]));
+                _mm256_storeu_ps(dst_c[c] + x, U8ToFloat8(v, v_scale[c], v_bias[c]));
+            }
+        }
+    }
+#endif
+    for (; x < width; ++x) {
+        for (int c = 0; c < channel; ++c) {
+            dst_c[c][x] = scale[c] * src[x * mat_channel + c_offset[c]] + bias[c];
+        }
+    }
+}
+
+/*
+ * Convert one row of nchw float planes to uint8 bgr / bgra pixels, channel c is written to dst[c_offset[c]],
+ * alpha is kept if the blob has 3 channels
+ */
+template <int mat_channel>
+static void PlanesToPixels(const float *src, uint8_t *dst, int plane_size, const int *c_offset, int channel,
+                           const float *scale, const float *bias, int width) {
+    const float *src_c[4] = {src, src + plane_size, src + plane_size * 2, src + plane_size * 3};
+    int x                 = 0;
+#ifdef __AVX2__
+    __m256 v_scale[4], v_bias[4];
+    for (int c = 0; c < channel; ++c) {
+        v_scale[c] = _mm256_set1_ps(scale[c]);
+        v_bias[c]  = _mm256_set1_ps(bias[c]);
+    }
+    if (mat_channel == 4) {
+        const __m256i alpha_mask = _mm256_set1_epi32(channel == 4 ? 0 : 0xff000000);
+        for (; x + 8 <= width; x += 8) {
+            __m256i pixels = _mm256_and_si256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + x * 4)), alpha_mask);
+            for (int c = 0; c < channel; ++c) {
+                __m256i v = Float8ToU8(_mm256_loadu_ps(src_c[c] + x), v_scale[c], v_bias[c]);
+                pixels    = _mm256_or_si256(pixels, _mm256_slli_epi32(v, c_offset[c] * 8));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x * 4), pixels);
+        }
+    } else {
+        // pack 4 pixels of 32 bits to 12 bytes in each 128-bit lane
+        const __m256i pack_mask = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                                   0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        for (; x + 8 <= width; x += 8) {
+            __m256i pixels = _mm256_setzero_si256();
+            for (int c = 0; c < channel; ++c) {
+                __m256i v = Float8ToU8(_mm256_loadu_ps(src_c[c] + x), v_scale[c], v_bias[c]);
+                pixels    = _mm256_or_si256(pixels, _mm256_slli_epi32(v, c_offset[c] * 8));
+            }
+            pixels     = _mm256_shuffle_epi8(pixels, pack_mask);
+            __m128i lo = _mm256_castsi256_si128(pixels);
+            __m128i hi = _mm256_extracti128_si256(pixels, 1);
+            uint8_t *d = dst + x * 3;
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(d), lo);
+            *reinterpret_cast<int *>(d + 8) = _mm_extract_epi32(lo, 2);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(d + 12), hi);
+            *reinterpret_cast<int *>(d + 20) = _mm_extract_epi32(hi, 2);
+        }
+    }
+#endif
+    for (; x < width; ++x) {
+        for (int c = 0; c < channel; ++c) {
+            dst[x * mat_channel + c_offset[c]] = SaturateCast(scale[c] * src_c[c][x] + bias[c]);
+        }
+    }
+}
+
+static void ScaleBiasFloat(const float *src, float *dst, float scale, float bias, int count) {
+    int i = 0;
+#ifdef __AVX2__
+    __m256 v_scale = _mm256_set1_ps(scale);
+    __m256 v_bias  = _mm256_set1_ps(bias);
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i), v_scale, v_bias));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = scale * src[i] + bias;
+    }
+}
+
+static void GrayToFloat(const uint8_t *src, float *dst, float scale, float bias, int count) {
+    int i = 0;
+#ifdef __AVX2__
+    __m256 v_scale = _mm256_set1_ps(scale);
+    __m256 v_bias  = _mm256_set1_ps(bias);
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i));
+        _mm256_storeu_ps(dst + i, U8ToFloat8(v, v_scale, v_bias));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = scale * src[i] + bias;
+    }
+}
+
+static void FloatToGray(const float *src, uint8_t *dst, float scale, float bias, int count) {
+    int i = 0;
+#ifdef __AVX2__
+    __m256 v_scale = _mm256_set1_ps(scale);
+    __m256 v_bias  = _mm256_set1_ps(bias);
+    for (; i + 8 <= count; i += 8) {
+        __m256i v   = Float8ToU8(_mm256_loadu_ps(src + i), v_scale, v_bias);
+        __m128i u16 = _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(u16, u16));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = SaturateCast(scale * src[i] + bias);
+    }
+}
+
+// element offset of each channel in a pixel, rgb is swapped if reverse_channel is set
+static void GetChannelOffset(const MatConvertParam &param, int *c_offset) {
+    for (int c = 0; c < 4; ++c) {
+        c_offset[c] = c;
+    }
+    if (param.reverse_channel) {
+        std::swap(c_offset[0], c_offset[2]);
+    }
+}
+
+/*
+ * mat to blob, rows of all batches are converted in parallel
+ */
+template <int mat_channel>
+static Status PixelsToBlob(const uint8_t *src, float *blob_data, const MatConvertParam &param,
+                           const DimsVector &dims, const int hw) {
+    const int channel = std::min(dims[1], mat_channel);
+    const int height  = dims[2];
+    const int width   = dims[3];
+    int c_offset[4];
+    GetChannelOffset(param, c_offset);
+
+    OMP_PARALLEL_FOR_
+    for (int r = 0; r < dims[0] * height; ++r) {
+        const int n = r / height;
+        const int y = r % height;
+        PixelsToPlanes<mat_channel>(src + (n * hw + y * width) * mat_channel, blob_data + n * dims[1] * hw + y * width,
+                                    hw, c_offset, channel, param.scale.data(), param.bias.data(), width);
+    }
+    return TNN_OK;
+}
+
+static Status N8UC4ToBlob(Mat &image, float *blob_data, const MatConvertParam &param, const DimsVector &dims,
+                          const int hw) {
+    return PixelsToBlob<4>(reinterpret_cast<uint8_t *>(image.GetData()), blob_data, param, dims, hw);
+}
+
+static Status N8UC3ToBlob(Mat &image, float *blob_data, const MatConvertParam &param, const DimsVector &dims,
+                          const int hw) {
+    return PixelsToBlob<3>(reinterpret_cast<uint8_t *>(image.GetData()), blob_data, param, dims, hw);
+}
+
+/*
+ * two rows of an nv12/nv21 mat share one row of the chroma plane, each pair goes to bgr in a buffer of
+ * its thread and on to the blob, the bgr image is never written in full
+ */
+template <bool is_nv12>
+static Status YUVToBlob(Mat &image, float *blob_data, const MatConvertParam &param, const DimsVector &dims,
+                        const int hw) {
+    const int channel = std::min(dims[1], 3);
+    const int height  = dims[2];
+    const int width   = dims[3];
+    if (height % 2 != 0) {
+        return Status(TNNERR_PARAM_ERR, "nv12 and nv21 mat need an even height");
+    }
+    int c_offset[4];
+    GetChannelOffset(param, c_offset);
+
+    const int pair_bytes = 2 * width * 3;
+    std::vector<uint8_t> bgr_buffer(OMP_MAX_THREADS_NUM_ * pair_bytes);
+    auto src = reinterpret_cast<uint8_t *>(image.GetData());
+
+    OMP_PARALLEL_FOR_
+    for (int r = 0; r < dims[0] * height / 2; ++r) {
+        const int n  = r / (height / 2);
+        const int y  = r % (height / 2) * 2;
+        auto y_plane = src + n * 3 * hw / 2;
+        auto bgr     = bgr_buffer.data() + OMP_TID_ * pair_bytes;
+        if (is_nv12) {
+            NV12ToBGR(y_plane + y * width, y_plane + hw + y / 2 * width, bgr, 2, width);
+        } else {
+            NV21ToBGR(y_plane + y * width, y_plane + hw + y / 2 * width, bgr, 2, width);
+        }
+        for (int i = 0; i < 2; ++i) {
+            PixelsToPlanes<3>(bgr + i * width * 3, blob_data + n * dims[1] * hw + (y + i) * width, hw, c_offset,
+                              channel, param.scale.data(), param.bias.data(), width);
+        }
+    }
+    return TNN_OK;
+}
+
+static Status NGRAYToBlob(Mat &image, float *blob_data, const MatConvertParam &param, const DimsVector &dims,
+                          const int hw) {
+    if (param.reverse_channel) {
+        return Status(TNNERR_PARAM_ERR, "reverse type not support yet, mat type: " + std::to_string(NGRAY));
+    }
+    auto src = reinterpret_cast<uint8_t *>(image.GetData());
+    OMP_PARALLEL_FOR_
+    for (int r = 0; r < dims[0] * dims[2]; ++r) {
+        const int offset = r / dims[2] * hw + r % dims[2] * dims[3];
+        GrayToFloat(src + offset, blob_data + offset, param.scale[0], param.bias[0], dims[3]);
+    }
+    return TNN_OK;
+}
+
+// nchw float to nchw float, the same in both directions
+static Status NCHWFloatConvert(const float *src, float *dst, const MatConvertParam &param, const DimsVector &dims,
+                               const int hw) {
+    if (param.reverse_channel) {
+        return Status(TNNERR_PARAM_ERR, "reverse type not support yet, mat type: " + std::to_string(NCHW_FLOAT));
+    }
+    const int height = dims[2];
+    OMP_PARALLEL_FOR_
+    for (int r = 0; r < dims[0] * dims[1] * height; ++r) {
+        const int c      = r / height % dims[1];
+        const int offset = r / height * hw + r % height * dims[3];
+        ScaleBiasFloat(src + offset, dst + offset, param.scale[c], param.bias[c], dims[3]);
+    }
+    return TNN_OK;
+}
+
+static Status NCHWFloatToBlob(Mat &image, float *blob_data, const MatConvertParam &param, const DimsVector &dims,
+                              const int hw) {
+    return NCHWFloatConvert(reinterpret_cast<float *>(image.GetData()), blob_data, param, dims, hw);
+}
+
+REGISTER_X86_BLOB_CONVERT_FUNC(N8UC4, X86_CVT_DIR_MAT2BLOB, N8UC4ToBlob)
+REGISTER_X86_BLOB_CONVERT_FUNC(N8UC3, X86_CVT_DIR_MAT2BLOB, N8UC3ToBlob)
+REGISTER_X86_BLOB_CONVERT_FUNC(NNV12, X86_CVT_DIR_MAT2BLOB, YUVToBlob<true>)
+REGISTER_X86_BLOB_CONVERT_FUNC(NNV21, X86_CVT_DIR_MAT2BLOB, YUVToBlob<false>)
+REGISTER_X86_BLOB_CONVERT_FUNC(NGRAY, X86_CVT_DIR_MAT2BLOB, NGRAYToBlob)
+REGISTER_X86_BLOB_CONVERT_FUNC(NCHW_FLOAT, X86_CVT_DIR_MAT2BLOB, NCHWFloatToBlob)
+
+/*
+ * blob to mat, rows of all batches are converted in parallel
+ */
+template <int mat_channel>
+static Status BlobToPixels(Mat &image, float *blob_data, const MatConvertParam &param, const DimsVector &dims,
+                           const int hw) {
+    const int channel = std::min(dims[1], mat_channel);
+    const int height  = dims[2];
+    const int width   = dims[3];
+    auto dst          = reinterpret_cast<uint8_t *>(image.GetData());
+    int c_offset[4];
+    GetChannelOffset(param, c_offset);
+
+    OMP_PARALLEL_FOR_
+    for (int r = 0; r < dims[0] * height; ++r) {
+        const int n = r / height;
+        const int y = r % height;
+        PlanesToPixels<mat_channel>(blob_data + n * dims[1] * hw + y * width, dst + (n * hw + y * width) * mat_channel,
+                                    hw, c_offset, channel, param.scale.data(), param.bias.data(), width);
+    }
+    return TNN_OK;
+}
+
+static Status BlobToNGRAY(Mat &image, float *blob_data, const MatConvertParam &param, const DimsVector &dims,
+                          const int hw) {
+    if (param.reverse_channel) {
+        return Status(TNNERR_PARAM_ERR, "reverse type not support yet, mat type: " + std::to_string(NGRAY));
+    }
+    auto dst = reinterpret_cast<uint8_t *>(image.GetData());
+    OMP_PARALLEL_FOR_
+    for (int r = 0; r < dims[0] * dims[2]; ++r) {
+        const int offset = r / dims[2] * hw + r % dims[2] * dims[3];
+        FloatToGray(blob_data + offset, dst + offset, param.scale[0], param.bias[0], dims[3]);
+    }
+    return TNN_OK;
+}
+
+static Status BlobToNCHWFloat(Mat &image, float *blob_data, const MatConvertParam &param, const DimsVector &dims,
+                              const int hw) {
+    return NCHWFloatConvert(blob_data, reinterpret_cast<float *>(image.GetData()), param, dims, hw);
+}
+
+REGISTER_X86_BLOB_CONVERT_FUNC(N8UC4, X86_CVT_DIR_BLOB2MAT, BlobToPixels<4>)
+REGISTER_X86_BLOB_CONVERT_FUNC(N8UC3, X86_CVT_DIR_BLOB2MAT, BlobToPixels<3>)
+REGISTER_X86_BLOB_CONVERT_FUNC(NGRAY, X86_CVT_DIR_BLOB2MAT, BlobToNGRAY)
+REGISTER_X86_BLOB_CONVERT_FUNC(NCHW_FLOAT, X86_CVT_DIR_BLOB2MAT, BlobToNCHWFloat)
+
 }  // namespace TNN_NS
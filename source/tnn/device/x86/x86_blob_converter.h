@@ -0,0 +1,69 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_BLOB_CONVERTER_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_X86_BLOB_CONVERTER_H_
+
+#include <map>
+#include <string>
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/blob_converter_default.h"
+#include "tnn/utils/blob_converter_internal.h"
+
+namespace TNN_NS {
+
+// convert between a mat and a nchw float blob, reverse_channel of param is fused into the function
+typedef Status (*X86BlobConvertFunc)(Mat& image, float* blob_data, const MatConvertParam& param,
+                                     const DimsVector& dims, const int hw);
+
+typedef enum {
+    X86_CVT_DIR_MAT2BLOB = 0,
+    X86_CVT_DIR_BLOB2MAT = 1
+} X86BlobConvertDirection;
+
+// simd converter for float blobs, the other data types and mat types go to DefaultBlobConverterAcc
+class X86BlobConverterAcc : public DefaultBlobConverterAcc {
+public:
+    X86BlobConverterAcc(Blob* blob);
+    virtual ~X86BlobConverterAcc();
+
+    virtual Status ConvertToMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL);
+    virtual Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL);
+
+    static Status RegisterBlobConvertFunc(MatType mat_type, X86BlobConvertDirection cvt_dir,
+                                          X86BlobConvertFunc cvt_func);
+
+private:
+    X86BlobConvertFunc GetBlobConvertFunc(Mat& image, X86BlobConvertDirection cvt_dir);
+
+    static std::string GetUniqueBlobConvertKey(MatType mat_type, X86BlobConvertDirection cvt_dir);
+    static std::map<std::string, X86BlobConvertFunc>& GetBlobConvertFuncMap();
+};
+
+class X86BlobConvertFuncRegister {
+public:
+    explicit X86BlobConvertFuncRegister(MatType mat_type, X86BlobConvertDirection cvt_dir,
+                                        X86BlobConvertFunc cvt_func) {
+        X86BlobConverterAcc::RegisterBlobConvertFunc(mat_type, cvt_dir, cvt_func);
+    }
+};
+
+#define REGISTER_X86_BLOB_CONVERT_FUNC(mat_type, cvt_dir, cvt_func)                                               \
+    X86BlobConvertFuncRegister g_x86_##mat_type##_##cvt_dir##_register(mat_type, cvt_dir, cvt_func);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_X86_BLOB_CONVERTER_H_
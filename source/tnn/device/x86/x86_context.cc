@@ -14,8 +14,14 @@
 
 #include "tnn/device/x86/x86_context.h"
 
+#include <fstream>
+
+#include "tnn/utils/omp_utils.h"
+
 namespace TNN_NS {
 
+std::mutex X86Context::s_mutex_;
+
 Status X86Context::LoadLibrary(std::vector<std::string> path) {
     return TNN_OK;
 }
@@ -25,6 +31,8 @@ Status X86Context::GetCommandQueue(void** command_queue) {
 }
 
 Status X86Context::OnInstanceForwardBegin() {
+    Context::OnInstanceForwardBegin();
+    OMP_SET_THREADS_(GetNumThreads());
     return TNN_OK;
 }
 
@@ -32,22 +40,96 @@ Status X86Context::OnInstanceForwardEnd() {
     return TNN_OK;
 }
 
+// the cache file has the count of configs in the first line, then one config per line:
+// key, length of the config, config values
+Status X86Context::OnInstanceReshapeBegin() {
+    if (enable_tune_kernel_ && !cache_file_path_.empty() && kernel_tune_map_.empty()) {
+        std::lock_guard<std::mutex> lock(s_mutex_);
+        std::ifstream cache_stream(cache_file_path_);
+        if (cache_stream.is_open() && cache_stream.good()) {
+            size_t cache_map_size = 0;
+            cache_stream >> cache_map_size;
+            for (size_t i = 0; i < cache_map_size && cache_stream.good(); ++i) {
+                std::string key;
+                size_t config_length = 0;
+                cache_stream >> key >> config_length;
+                std::vector<int> config(config_length);
+                for (size_t j = 0; j < config_length; ++j) {
+                    cache_stream >> config[j];
+                }
+                if (!cache_stream.good()) {
+                    LOGE("X86Context got a broken tune cache file %s\n", cache_file_path_.c_str());
+                    kernel_tune_map_.clear();
+                    break;
+                }
+                kernel_tune_map_[key] = config;
+            }
+        }
+    }
+    tune_map_size_ = kernel_tune_map_.size();
+    return TNN_OK;
+}
+
+Status X86Context::OnInstanceReshapeEnd() {
+    if (enable_tune_kernel_ && !cache_file_path_.empty() && kernel_tune_map_.size() > tune_map_size_) {
+        std::lock_guard<std::mutex> lock(s_mutex_);
+        tune_map_size_ = kernel_tune_map_.size();
+        std::ofstream cache_stream(cache_file_path_);
+        if (cache_stream.is_open()) {
+            cache_stream << kernel_tune_map_.size() << std::endl;
+            for (const auto &element : kernel_tune_map_) {
+                cache_stream << element.first << " " << element.second.size();
+                for (auto value : element.second) {
+                    cache_stream << " " << value;
+                }
+                cache_stream << std::endl;
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+std::map<std::string, std::vector<int>>& X86Context::GetKernelTuneMap() {
+    return kernel_tune_map_;
+}
+
 Status X86Context::Synchronize() {
     return TNN_OK;
 }
 
+Status X86Context::SetNumThreads(int num_threads) {
+    num_threads_ = MIN(MAX(num_threads, 1), OMP_CORES_);
+    return TNN_OK;
+}
+
+int X86Context::GetNumThreads() {
+    int branch_threads = GetBranchNumThreads();
+    if (branch_threads > 0) {
+        return MIN(branch_threads, num_threads_);
+    }
+    return num_threads_;
+}
+
 void* X86Context::GetSharedWorkSpace(size_t size) {
     return GetSharedWorkSpace(size, 0);
 }
 
 void* X86Context::GetSharedWorkSpace(size_t size, int index) {
-    while(work_space_.size() < index + 1) {
-        work_space_.push_back(RawBuffer(size, 32));
+    std::lock_guard<std::mutex> guard(work_space_mutex_);
+    auto &work_space = work_space_[GetBranchIndex()];
+    while(work_space.size() < index + 1) {
+        work_space.push_back(RawBuffer(size, 32));
+#if TNN_PROFILE
+        AddMemoryEvent("work_space", size);
+#endif
     }
-    if (work_space_[index].GetBytesSize() < size) {
-        work_space_[index] = RawBuffer(size, 32);
+    if (work_space[index].GetBytesSize() < size) {
+#if TNN_PROFILE
+        AddMemoryEvent("work_space", (double)size - work_space[index].GetBytesSize());
+#endif
+        work_space[index] = RawBuffer(size, 32);
     }
-    return work_space_[index].force_to<void*>();
+    return work_space[index].force_to<void*>();
 }
 
 }  // namespace TNN_NS
@@ -15,6 +15,8 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -38,15 +40,38 @@ public:
     // @brief after instace forword
     virtual Status OnInstanceForwardEnd() override;
 
+    // @brief load the tuned kernel configs from the cache file before reshape
+    virtual Status OnInstanceReshapeBegin() override;
+
+    // @brief save the kernel configs tuned in reshape to the cache file
+    virtual Status OnInstanceReshapeEnd() override;
+
     // @brief wait for jobs in the current context to complete
     virtual Status Synchronize() override;
 
+    // @brief set the threads used by the layer accs, bounded by the cpu cores
+    virtual Status SetNumThreads(int num_threads) override;
+
+    // @brief threads for the calling layer, the share of its branch if parallel branches run
+    virtual int GetNumThreads() override;
+
+    // @brief work space of the branch run by the calling thread
     void* GetSharedWorkSpace(size_t size);
     void* GetSharedWorkSpace(size_t size, int index);
 
+    // @brief tuned kernel configs by the key of the layer shape, see X86ConvLayerAcc
+    std::map<std::string, std::vector<int>>& GetKernelTuneMap();
+
 private:
     int num_threads_ = 1;
-    std::vector<RawBuffer> work_space_;
+    // work spaces by branch index
+    std::map<int, std::vector<RawBuffer>> work_space_;
+    std::mutex work_space_mutex_;
+
+    std::map<std::string, std::vector<int>> kernel_tune_map_;
+    size_t tune_map_size_ = 0;
+    // cache files are shared by the instances of a model
+    static std::mutex s_mutex_;
 };
 
 }  // namespace TNN_NS
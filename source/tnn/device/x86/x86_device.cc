@@ -88,6 +88,11 @@ AbstractLayerAcc* X86Device::CreateLayerAcc(LayerType type) {
     return NULL;
 }
 
+AbstractDevice* X86Device::GetFallbackDevice() {
+    // the naive accs run on the host memory of the x86 blobs in NCHW
+    return GetDevice(DEVICE_NAIVE);
+}
+
 Context* X86Device::CreateContext(int device_id) {
     return new X86Context();
 }
@@ -52,6 +52,8 @@ public:
 
     virtual Context *CreateContext(int device_id);
 
+    virtual AbstractDevice* GetFallbackDevice();
+
     static Status RegisterLayerAccCreator(LayerType type, LayerAccCreator* creator);
 
 private:
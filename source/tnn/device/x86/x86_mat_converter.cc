@@ -283,6 +283,16 @@ Status X86MatConverterAcc::CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderPara
     return ret;
 }
 
+Status X86MatConverterAcc::Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue) {
+    Status ret = TNN_OK;
+
+    ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    return FusedPreprocess(src, dst, param, PreprocessResizeRow);
+}
+
 DECLARE_MAT_CONVERTER_CREATER(X86);
 REGISTER_MAT_CONVERTER(X86, DEVICE_X86);
 
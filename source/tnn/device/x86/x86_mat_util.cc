@@ -112,10 +112,8 @@ color convert
 //     g = (74 * y - 1135 - 52 * vv - 25 * uu ) >> 6
 //     b = (74 * y - 1135 + 129 * uu ) >> 6
 template <bool is_nv12, bool has_alpha>
-void YUVToBGR(const unsigned char* yuv, unsigned char* bgr, int h, int w) {
-    const unsigned char* yptr  = yuv;
-    const unsigned char* vuptr = yuv + w * h;
-    const int channel          = has_alpha ? 4 : 3;
+void YUVToBGR(const unsigned char* yptr, const unsigned char* vuptr, unsigned char* bgr, int h, int w) {
+    const int channel = has_alpha ? 4 : 3;
 
 #ifdef __SSE4_2__
     __m128i _v1135 = _mm_set1_epi16(-1135);
@@ -281,16 +279,22 @@ void YUVToBGR(const unsigned char* yuv, unsigned char* bgr, int h, int w) {
 }
 
 void NV12ToBGR(const unsigned char* nv12, unsigned char* bgr, int h, int w) {
-    return YUVToBGR<true, false>(nv12, bgr, h, w);
+    return YUVToBGR<true, false>(nv12, nv12 + w * h, bgr, h, w);
 }
 void NV21ToBGR(const unsigned char* nv21, unsigned char* bgr, int h, int w) {
-    return YUVToBGR<false, false>(nv21, bgr, h, w);
+    return YUVToBGR<false, false>(nv21, nv21 + w * h, bgr, h, w);
 }
 void NV12ToBGRA(const unsigned char* nv12, unsigned char* bgra, int h, int w) {
-    return YUVToBGR<true, true>(nv12, bgra, h, w);
+    return YUVToBGR<true, true>(nv12, nv12 + w * h, bgra, h, w);
 }
 void NV21ToBGRA(const unsigned char* nv21, unsigned char* bgra, int h, int w) {
-    return YUVToBGR<false, true>(nv21, bgra, h, w);
+    return YUVToBGR<false, true>(nv21, nv21 + w * h, bgra, h, w);
+}
+void NV12ToBGR(const unsigned char* y, const unsigned char* uv, unsigned char* bgr, int h, int w) {
+    return YUVToBGR<true, false>(y, uv, bgr, h, w);
+}
+void NV21ToBGR(const unsigned char* y, const unsigned char* vu, unsigned char* bgr, int h, int w) {
+    return YUVToBGR<false, false>(y, vu, bgr, h, w);
 }
 
 template <int channel, bool bgr_order>
@@ -1869,4 +1873,113 @@ void WarpAffineNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src
     }
 }
 
+// fused preprocess
+// 8 columns of the row are gathered at once, each gather reads the 4 bytes from the pixel start
+#ifdef __AVX2__
+// same formula as NaiveYUVToBGROrBGRA on 8 pixels, y holds one byte and vu the two chroma bytes of each lane
+static inline void YUVToBGRAVX2(__m256i y, __m256i vu, bool is_nv12, __m256* bgr) {
+    const __m256i v_mask = _mm256_set1_epi32(0xff);
+    const __m256i v_240  = _mm256_set1_epi32(240);
+    const __m256i v_128  = _mm256_set1_epi32(128);
+    const __m256i v_zero = _mm256_setzero_si256();
+    const __m256i v_255  = _mm256_set1_epi32(255);
+    __m256i first  = _mm256_and_si256(vu, v_mask);
+    __m256i second = _mm256_and_si256(_mm256_srli_epi32(vu, 8), v_mask);
+    __m256i u = _mm256_sub_epi32(_mm256_min_epi32(is_nv12 ? first : second, v_240), v_128);
+    __m256i v = _mm256_sub_epi32(_mm256_min_epi32(is_nv12 ? second : first, v_240), v_128);
+    y = _mm256_sub_epi32(_mm256_mullo_epi32(y, _mm256_set1_epi32(74)), _mm256_set1_epi32(1135));
+    __m256i b = _mm256_add_epi32(y, _mm256_mullo_epi32(u, _mm256_set1_epi32(129)));
+    __m256i g = _mm256_sub_epi32(y, _mm256_add_epi32(_mm256_mullo_epi32(v, _mm256_set1_epi32(52)),
+                                                     _mm256_mullo_epi32(u, _mm256_set1_epi32(25))));
+    __m256i r = _mm256_add_epi32(y, _mm256_mullo_epi32(v, _mm256_set1_epi32(102)));
+    bgr[0] = _mm256_cvtepi32_ps(_mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(b, 6), v_zero), v_255));
+    bgr[1] = _mm256_cvtepi32_ps(_mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(g, 6), v_zero), v_255));
+    bgr[2] = _mm256_cvtepi32_ps(_mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(r, 6), v_zero), v_255));
+}
+#endif
+
+void PreprocessResizeRow(const PreprocessResizeRowParam& param) {
+    int i = 0;
+#ifdef __AVX2__
+    const int kind = param.kind;
+    // the gather of a column reads 4 bytes from its first byte, which may run past the end of the src row.
+    // the columns from last are left to the naive code, the yuv planes hold one byte per pixel.
+    int simd_count = param.count;
+    if (kind < 4) {
+        const int bytes = kind > 0 ? kind : 1;
+        const int last  = param.src_width - (4 + bytes - 1) / bytes + 1;
+        while (simd_count > 0 && param.pos1[simd_count - 1] >= last) {
+            simd_count--;
+        }
+    }
+
+    const __m256i v_kind = _mm256_set1_epi32(kind);
+    const __m256i v_mask = _mm256_set1_epi32(0xff);
+    const __m256 v_ay    = _mm256_set1_ps(param.ay);
+    const int* row0      = reinterpret_cast<const int*>(param.row0);
+    const int* row1      = reinterpret_cast<const int*>(param.row1);
+    if (kind == 0) {
+        const int* vu0         = reinterpret_cast<const int*>(param.vu0);
+        const int* vu1         = reinterpret_cast<const int*>(param.vu1);
+        const __m256i v_even   = _mm256_set1_epi32(~1);
+        for (; i + 8 <= simd_count; i += 8) {
+            __m256i x0 = _mm256_loadu_si256((const __m256i*)(param.pos0 + i));
+            __m256i x1 = _mm256_loadu_si256((const __m256i*)(param.pos1 + i));
+            __m256i c0 = _mm256_and_si256(x0, v_even);
+            __m256i c1 = _mm256_and_si256(x1, v_even);
+            __m256 p00[3], p01[3], p10[3], p11[3];
+            YUVToBGRAVX2(_mm256_and_si256(_mm256_i32gather_epi32(row0, x0, 1), v_mask),
+                         _mm256_i32gather_epi32(vu0, c0, 1), param.is_nv12, p00);
+            YUVToBGRAVX2(_mm256_and_si256(_mm256_i32gather_epi32(row0, x1, 1), v_mask),
+                         _mm256_i32gather_epi32(vu0, c1, 1), param.is_nv12, p01);
+            YUVToBGRAVX2(_mm256_and_si256(_mm256_i32gather_epi32(row1, x0, 1), v_mask),
+                         _mm256_i32gather_epi32(vu1, c0, 1), param.is_nv12, p10);
+            YUVToBGRAVX2(_mm256_and_si256(_mm256_i32gather_epi32(row1, x1, 1), v_mask),
+                         _mm256_i32gather_epi32(vu1, c1, 1), param.is_nv12, p11);
+            __m256 ax = _mm256_loadu_ps(param.alpha + i);
+            for (int c = 0; c < param.channel; ++c) {
+                const int k = param.c_offset[c];
+                __m256 top = _mm256_fmadd_ps(ax, _mm256_sub_ps(p01[k], p00[k]), p00[k]);
+                __m256 bot = _mm256_fmadd_ps(ax, _mm256_sub_ps(p11[k], p10[k]), p10[k]);
+                __m256 val = _mm256_fmadd_ps(v_ay, _mm256_sub_ps(bot, top), top);
+                val = _mm256_fmadd_ps(val, _mm256_set1_ps(param.scale[c]), _mm256_set1_ps(param.bias[c]));
+                _mm256_storeu_ps(param.dst[c] + i, val);
+            }
+        }
+    }
+    for (; kind > 0 && i + 8 <= simd_count; i += 8) {
+        __m256i x0  = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)(param.pos0 + i)), v_kind);
+        __m256i x1  = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)(param.pos1 + i)), v_kind);
+        __m256i p00 = _mm256_i32gather_epi32(row0, x0, 1);
+        __m256i p01 = _mm256_i32gather_epi32(row0, x1, 1);
+        __m256i p10 = _mm256_i32gather_epi32(row1, x0, 1);
+        __m256i p11 = _mm256_i32gather_epi32(row1, x1, 1);
+        __m256 ax   = _mm256_loadu_ps(param.alpha + i);
+        for (int c = 0; c < param.channel; ++c) {
+            const int shift = param.c_offset[c] * 8;
+            __m256 f00 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(p00, shift), v_mask));
+            __m256 f01 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(p01, shift), v_mask));
+            __m256 f10 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(p10, shift), v_mask));
+            __m256 f11 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(p11, shift), v_mask));
+            __m256 top = _mm256_fmadd_ps(ax, _mm256_sub_ps(f01, f00), f00);
+            __m256 bot = _mm256_fmadd_ps(ax, _mm256_sub_ps(f11, f10), f10);
+            __m256 val = _mm256_fmadd_ps(v_ay, _mm256_sub_ps(bot, top), top);
+            val = _mm256_fmadd_ps(val, _mm256_set1_ps(param.scale[c]), _mm256_set1_ps(param.bias[c]));
+            _mm256_storeu_ps(param.dst[c] + i, val);
+        }
+    }
+#endif
+    if (i < param.count) {
+        PreprocessResizeRowParam remain = param;
+        remain.pos0  = param.pos0 + i;
+        remain.pos1  = param.pos1 + i;
+        remain.alpha = param.alpha + i;
+        remain.count = param.count - i;
+        for (int c = 0; c < param.channel; ++c) {
+            remain.dst[c] = param.dst[c] + i;
+        }
+        PreprocessResizeRowNaive(remain);
+    }
+}
+
 }  // namespace TNN_NS
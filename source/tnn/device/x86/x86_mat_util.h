@@ -21,6 +21,7 @@
 #include "tnn/core/blob.h"
 #include "tnn/core/macro.h"
 #include "tnn/utils/bfp16.h"
+#include "tnn/utils/mat_converter_utils.h"
 
 namespace TNN_NS {
 
@@ -35,6 +36,9 @@ void NV12ToBGR(const unsigned char* nv12, unsigned char* bgr, int height, int wi
 void NV21ToBGR(const unsigned char* nv21, unsigned char* bgr, int height, int width);
 void NV12ToBGRA(const unsigned char* nv12, unsigned char* bgra, int height, int width);
 void NV21ToBGRA(const unsigned char* nv21, unsigned char* bgra, int height, int width);
+// rows of the y plane and the matching rows of the interleaved chroma plane, height is even
+void NV12ToBGR(const unsigned char* y, const unsigned char* uv, unsigned char* bgr, int height, int width);
+void NV21ToBGR(const unsigned char* y, const unsigned char* vu, unsigned char* bgr, int height, int width);
 
 void BGRToGray(const unsigned char* bgr, unsigned char* gray, int height, int width);
 void BGRAToGray(const unsigned char* bgra, unsigned char* gray, int height, int width);
@@ -77,6 +81,9 @@ void WarpAffineNearestC4(const uint8_t* src, int batch, int src_w, int src_h, ui
 void WarpAffineNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h,
                                const float (*transform)[3], const float border_val = 0.0);
 
+// fused preprocess
+void PreprocessResizeRow(const PreprocessResizeRowParam& param);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_DEVICE_X86_X86_MAT_UTIL_H_
@@ -18,6 +18,8 @@
 #include <type_traits>
 
 #include "tnn/core/macro.h"
+#include "tnn/utils/bfp16_utils.h"
+#include "tnn/utils/half_utils.h"
 #include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
@@ -298,6 +300,25 @@ int PackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t
     return 0;
 }
 
+int PackC16(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel) {
+    for (int c = 0; c < channel; c += 16) {
+        auto src_c   = src + c * src_hw_stride;
+        auto dst_c   = dst + c * dst_hw_stride;
+        int left_c   = MIN(channel - c, 16);
+        for (int cur_hw = 0; cur_hw < hw; cur_hw++) {
+            auto dst_hw = dst_c + cur_hw * 16;
+            int ci = 0;
+            for (; ci < left_c; ci++) {
+                dst_hw[ci] = src_c[ci * src_hw_stride + cur_hw];
+            }
+            for (; ci < 16; ci++) {
+                dst_hw[ci] = 0.f;
+            }
+        }
+    }
+    return 0;
+}
+
 template <int left_c>
 inline void UnpackC4_Left(float *dst, const float *src, size_t hw, size_t dst_hw_stride) {
     auto dst0 = dst;
@@ -374,14 +395,14 @@ inline void UnpackC8_Left(float *dst, const float *src, size_t hw, size_t dst_hw
 #ifdef __AVX2__
     for (; cur_hw + 7 < hw; cur_hw += 8) {
         auto src_hw = src + cur_hw * 8;
-        __m256 v0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw)),      _mm_load_ps(src_hw + 32), 1);
-        __m256 v1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 8)),  _mm_load_ps(src_hw + 40), 1);
-        __m256 v2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 16)), _mm_load_ps(src_hw + 48), 1);
-        __m256 v3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 24)), _mm_load_ps(src_hw + 56), 1);
-        __m256 v4 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 4)),  _mm_load_ps(src_hw + 36), 1);
-        __m256 v5 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 12)), _mm_load_ps(src_hw + 44), 1);
-        __m256 v6 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 20)), _mm_load_ps(src_hw + 52), 1);
-        __m256 v7 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 28)), _mm_load_ps(src_hw + 60), 1);
+        __m256 v0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw)),      _mm_loadu_ps(src_hw + 32), 1);
+        __m256 v1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 8)),  _mm_loadu_ps(src_hw + 40), 1);
+        __m256 v2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 16)), _mm_loadu_ps(src_hw + 48), 1);
+        __m256 v3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 24)), _mm_loadu_ps(src_hw + 56), 1);
+        __m256 v4 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 4)),  _mm_loadu_ps(src_hw + 36), 1);
+        __m256 v5 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 12)), _mm_loadu_ps(src_hw + 44), 1);
+        __m256 v6 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 20)), _mm_loadu_ps(src_hw + 52), 1);
+        __m256 v7 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 28)), _mm_loadu_ps(src_hw + 60), 1);
         _MM256_TRANSPOSE8(v0, v1, v2, v3, v4, v5, v6, v7);
         _mm256_storeu_ps(dst0 + cur_hw, v0);
         if(left_c > 1) _mm256_storeu_ps(dst1 + cur_hw, v1);
@@ -419,14 +440,14 @@ int UnpackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size
 #ifdef __AVX2__
         for (; cur_hw + 7 < hw; cur_hw += 8) {
             auto src_hw = src_c + cur_hw * 8;
-            __m256 v0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw)),      _mm_load_ps(src_hw + 32), 1);
-            __m256 v1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 8)),  _mm_load_ps(src_hw + 40), 1);
-            __m256 v2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 16)), _mm_load_ps(src_hw + 48), 1);
-            __m256 v3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 24)), _mm_load_ps(src_hw + 56), 1);
-            __m256 v4 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 4)),  _mm_load_ps(src_hw + 36), 1);
-            __m256 v5 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 12)), _mm_load_ps(src_hw + 44), 1);
-            __m256 v6 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 20)), _mm_load_ps(src_hw + 52), 1);
-            __m256 v7 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src_hw + 28)), _mm_load_ps(src_hw + 60), 1);
+            __m256 v0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw)),      _mm_loadu_ps(src_hw + 32), 1);
+            __m256 v1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 8)),  _mm_loadu_ps(src_hw + 40), 1);
+            __m256 v2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 16)), _mm_loadu_ps(src_hw + 48), 1);
+            __m256 v3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 24)), _mm_loadu_ps(src_hw + 56), 1);
+            __m256 v4 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 4)),  _mm_loadu_ps(src_hw + 36), 1);
+            __m256 v5 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 12)), _mm_loadu_ps(src_hw + 44), 1);
+            __m256 v6 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 20)), _mm_loadu_ps(src_hw + 52), 1);
+            __m256 v7 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_hw + 28)), _mm_loadu_ps(src_hw + 60), 1);
             _MM256_TRANSPOSE8(v0, v1, v2, v3, v4, v5, v6, v7);
             _mm256_storeu_ps(dst0 + cur_hw, v0);
             _mm256_storeu_ps(dst1 + cur_hw, v1);
@@ -480,4 +501,35 @@ int MatTranspose(T *dst, const T *src, size_t M, size_t N) {
 }
 template int MatTranspose(float *dst, const float *src, size_t M, size_t N);
 
+void NarrowFromFloat(uint16_t *dst, const float *src, size_t count, DataType data_type) {
+    if (data_type == DATA_TYPE_HALF) {
+        ConvertFromFloatToHalf(const_cast<float *>(src), dst, count);
+    } else {
+        ConvertFromFloatToBFP16(const_cast<float *>(src), dst, count);
+    }
+}
+
+void WidenToFloat(float *dst, const uint16_t *src, size_t count, DataType data_type) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if (data_type == DATA_TYPE_HALF) {
+        for (; i + 7 < count; i += 8) {
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(src + i))));
+        }
+    } else {
+        for (; i + 7 < count; i += 8) {
+            __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+            _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(v, 16)));
+        }
+    }
+#endif
+    if (i < count) {
+        if (data_type == DATA_TYPE_HALF) {
+            ConvertFromHalfToFloat(const_cast<uint16_t *>(src + i), dst + i, count - i);
+        } else {
+            ConvertFromBFP16ToFloat(const_cast<uint16_t *>(src + i), dst + i, count - i);
+        }
+    }
+}
+
 }
@@ -23,6 +23,7 @@
 
 #include "tnn/core/blob.h"
 #include "tnn/core/macro.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 #if TNN_PROFILE
@@ -51,6 +52,8 @@ int PackC4(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t
 
 int PackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel);
 
+int PackC16(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel);
+
 int UnpackC4(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel);
 
 int UnpackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel);
@@ -58,6 +61,30 @@ int UnpackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size
 template<typename T>
 int MatTranspose(T *dst, const T *src, size_t M, size_t N);
 
+// @brief narrow count floats to fp16 (DATA_TYPE_HALF) or bf16 (DATA_TYPE_BFP16)
+void NarrowFromFloat(uint16_t *dst, const float *src, size_t count, DataType data_type);
+
+// @brief widen count fp16 (DATA_TYPE_HALF) or bf16 (DATA_TYPE_BFP16) values to float
+void WidenToFloat(float *dst, const uint16_t *src, size_t count, DataType data_type);
+
+// @brief split [0, count) into at most num_threads ranges of at least grain items and run func(begin, end)
+// on each range, num_threads usually comes from X86Context::GetNumThreads. Small work runs inline.
+template <typename F>
+void X86ParallelFor(int num_threads, long count, long grain, const F &func) {
+    long max_tasks = count / MAX(grain, 1L);
+    int tasks      = static_cast<int>(MIN(static_cast<long>(num_threads), max_tasks));
+    if (tasks <= 1) {
+        func(0L, count);
+        return;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(tasks) schedule(static, 1)
+#endif
+    for (int t = 0; t < tasks; t++) {
+        func(count * t / tasks, count * (t + 1) / tasks);
+    }
+}
+
 }  // namespace TNN_NS
 
 #endif
@@ -14,6 +14,10 @@
 
 #include "tnn/interpreter/default_model_interpreter.h"
 
+#include <algorithm>
+
+#include "tnn/utils/md5.h"
+
 namespace TNN_NS {
 
 DefaultModelInterpreter::DefaultModelInterpreter() {
@@ -34,4 +38,27 @@ NetResource *DefaultModelInterpreter::GetNetResource() {
     return net_resource_;
 }
 
+std::string DefaultModelInterpreter::GetModelMd5() {
+    return model_md5_;
+}
+
+void DefaultModelInterpreter::ComputeModelMd5(const std::string &proto_content, const char *model_data,
+                                              size_t model_size) {
+    // without model bytes the weights are generated randomly, e.g. in the layer tests
+    if (model_data == nullptr || model_size == 0) {
+        model_md5_ = "";
+        return;
+    }
+
+    MD5 model_md5;
+    model_md5.update(proto_content.c_str(), static_cast<MD5::size_type>(proto_content.size()));
+    // MD5::update takes 32 bits lengths
+    const size_t block_size = 1 << 30;
+    for (size_t offset = 0; offset < model_size; offset += block_size) {
+        auto length = static_cast<MD5::size_type>(std::min(block_size, model_size - offset));
+        model_md5.update(model_data + offset, length);
+    }
+    model_md5_ = model_md5.finalize().hexdigest();
+}
+
 }  // namespace TNN_NS
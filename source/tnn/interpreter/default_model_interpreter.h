@@ -41,9 +41,17 @@ public:
     //@brief GetNetResource return network weights data
     virtual NetResource *GetNetResource();
 
+    //@brief md5 of the proto and the model bytes, empty if the weights are not read from a model
+    std::string GetModelMd5();
+
+protected:
+    //@brief computed once by Interpret from the model bytes it loaded or mapped
+    void ComputeModelMd5(const std::string &proto_content, const char *model_data, size_t model_size);
+
 private:
     NetStructure *net_structure_;
     NetResource *net_resource_;
+    std::string model_md5_ = "";
 };
 
 }  // namespace TNN_NS
@@ -42,6 +42,8 @@ enum ActivationType {
     ActivationType_ReLU  = 0x0001,
     ActivationType_ReLU6 = 0x0002,
     ActivationType_SIGMOID_MUL = 0x0100,
+    // x * clip(x / 6 + 0.5, 0, 1)
+    ActivationType_HARDSWISH   = 0x0200,
 };
 
 enum FusionType {
@@ -190,6 +192,8 @@ struct InnerProductLayerParam : public LayerParam {
     int has_bias   = 0;
     int transpose  = 0;
     int axis       = 0;
+    // relu or relu6 fused by the optimizer
+    int activation_type = ActivationType_None;
 };
 
 struct ConcatLayerParam : public LayerParam {
@@ -382,6 +386,57 @@ struct PixelShuffleLayerParam : public LayerParam {
     int upscale_factor;
 };
 
+// @brief params shared by Lstm and Gru, the layouts follow onnx with a trailing 1 to keep the blobs 4 dims:
+// inputs X [T, N, I, 1], then sequence_lens [N, 1, 1, 1] if has_sequence_lens, initial_h and initial_c
+// [num_directions, N, H, 1]; outputs Y [T, num_directions, N, H], Y_h and Y_c [num_directions, N, H, 1].
+struct RNNLayerParam : public LayerParam {
+    int hidden_size = 0;
+    // 0: forward, 1: reverse, 2: bidirectional
+    int direction         = 0;
+    int has_sequence_lens = 0;
+};
+
+// gates in iofc order
+struct LSTMLayerParam : public RNNLayerParam {};
+
+// gates in zrh order
+struct GRULayerParam : public RNNLayerParam {
+    // apply the reset gate after the recurrent linear transform, as pytorch does
+    int linear_before_reset = 0;
+};
+
+// @brief batched matmul of A [..., M, K] and B [..., K, N], the batch dims broadcast as numpy does.
+// both are inputs if weight_position is -1, else A (0) or B (1) is the constant in MatMulLayerResource.
+struct MatMulLayerParam : public LayerParam {
+    int weight_position = -1;
+    // dims of the constant
+    std::vector<int> weight_dims;
+};
+
+// @brief onnx Gather along axis, negative indices count from the end. the data or the indices may be the
+// constant in GatherLayerResource with data_dims or indices_dims, the other one is the input.
+struct GatherLayerParam : public LayerParam {
+    int axis                = 0;
+    int data_in_resource    = 0;
+    int indices_in_resource = 0;
+    std::vector<int> data_dims;
+    std::vector<int> indices_dims;
+};
+
+// @brief normalizes over the last reduce_dims_size dims, then applies the scale and bias of LayerNormLayerResource
+struct LayerNormLayerParam : public LayerParam {
+    int reduce_dims_size = 1;
+    float eps            = 1e-5f;
+};
+
+// @brief softmax(scale * Q K + mask) V of the inputs Q [..., Sq, D], K [..., D, Sk], V [..., Sk, Dv] and the
+// optional additive mask that broadcasts to [..., Sq, Sk], the batch dims broadcast as in MatMul.
+// softmax_axis is the axis of the fused Softmax, it must be the last one of the scores.
+struct FusedAttentionLayerParam : public LayerParam {
+    float scale      = 1.0f;
+    int softmax_axis = -1;
+};
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_INTERPRETER_LAYER_PARAM_H
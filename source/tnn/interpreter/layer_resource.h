@@ -110,6 +110,32 @@ struct DetectionPostProcessLayerResource : public LayerResource {
     RawBuffer anchors_handle;
 };
 
+// @brief Lstm and Gru weights as onnx stores them, gates is 4 for lstm and 3 for gru
+struct RNNLayerResource : public LayerResource {
+    // W [num_directions, gates * hidden_size, input_size]
+    RawBuffer weight_handle;
+
+    // R [num_directions, gates * hidden_size, hidden_size]
+    RawBuffer recurrence_handle;
+
+    // B [num_directions, 2 * gates * hidden_size], Wb then Rb
+    RawBuffer bias_handle;
+};
+
+struct MatMulLayerResource : public LayerResource {
+    // the constant A or B, its dims are MatMulLayerParam::weight_dims
+    RawBuffer weight_handle;
+};
+
+struct GatherLayerResource : public LayerResource {
+    RawBuffer data_handle;
+    // int32
+    RawBuffer indices_handle;
+};
+
+// scale and bias of the normalized dims
+struct LayerNormLayerResource : public BatchNormLayerResource {};
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_INTERPRETER_LAYER_RESOURCE_H_
@@ -16,6 +16,7 @@
 
 #include <mutex>
 
+#include "tnn/utils/dims_vector_utils.h"
 #include "tnn/utils/random_data_utils.h"
 
 namespace TNN_NS {
@@ -157,6 +158,56 @@ class InnerProductLayerResourceGenerator : public LayerResourceGenerator {
     }
 };
 
+/*
+ * Generate weights for Lstm and Gru layers
+ */
+class RNNLayerResourceGenerator : public LayerResourceGenerator {
+    virtual Status GenLayerResource(LayerParam* param, LayerResource** resource, std::vector<Blob*>& inputs) {
+        LOGD("RNNLayerResourceGenerator\n");
+        auto layer_param = dynamic_cast<RNNLayerParam*>(param);
+        CHECK_PARAM_NULL(layer_param);
+        auto layer_res = new RNNLayerResource();
+
+        auto dims                = inputs[0]->GetBlobDesc().dims;
+        const int gates          = dynamic_cast<GRULayerParam*>(param) ? 3 : 4;
+        const int num_directions = layer_param->direction == 2 ? 2 : 1;
+        const int hidden_size    = layer_param->hidden_size;
+        const int input_size     = DimsVectorUtils::Count(dims, 2);
+
+        int weight_count     = num_directions * gates * hidden_size * input_size;
+        int recurrence_count = num_directions * gates * hidden_size * hidden_size;
+        int bias_count       = num_directions * 2 * gates * hidden_size;
+
+        layer_res->weight_handle     = RawBuffer(weight_count * sizeof(float));
+        layer_res->recurrence_handle = RawBuffer(recurrence_count * sizeof(float));
+        layer_res->bias_handle       = RawBuffer(bias_count * sizeof(float));
+        InitRandom(layer_res->weight_handle.force_to<float*>(), weight_count, 1.0f);
+        InitRandom(layer_res->recurrence_handle.force_to<float*>(), recurrence_count, 1.0f);
+        InitRandom(layer_res->bias_handle.force_to<float*>(), bias_count, 1.0f);
+
+        *resource = layer_res;
+        return TNN_OK;
+    }
+
+    virtual Status ConvertHalfLayerResource(LayerResource* fp16_res, LayerResource** fp32_res) {
+        LOGD("RNNLayerResource convert from fp16 to fp32\n");
+        auto src_res = dynamic_cast<RNNLayerResource*>(fp16_res);
+        CHECK_PARAM_NULL(src_res);
+
+        auto dst_res = new RNNLayerResource();
+
+        dst_res->weight_handle     = ConvertHalfHandle(src_res->weight_handle);
+        dst_res->recurrence_handle = ConvertHalfHandle(src_res->recurrence_handle);
+        dst_res->bias_handle       = ConvertHalfHandle(src_res->bias_handle);
+
+        *fp32_res = dst_res;
+        return TNN_OK;
+    }
+};
+
+class LstmLayerResourceGenerator : public RNNLayerResourceGenerator {};
+class GruLayerResourceGenerator : public RNNLayerResourceGenerator {};
+
 /*
  * Generate weights for Batchnorm layer
  */
@@ -394,6 +445,128 @@ class HdrGuideLayerResourceGenerator : public LayerResourceGenerator {
     }
 };
 
+/*
+ * Generate the constant of MatMul
+ */
+class MatMulLayerResourceGenerator : public LayerResourceGenerator {
+    virtual Status GenLayerResource(LayerParam* param, LayerResource** resource, std::vector<Blob*>& inputs) {
+        LOGD("MatMulLayerResourceGenerator\n");
+        auto layer_param = dynamic_cast<MatMulLayerParam*>(param);
+        CHECK_PARAM_NULL(layer_param);
+        if (layer_param->weight_position == -1) {
+            return TNN_OK;
+        }
+
+        auto layer_res   = new MatMulLayerResource();
+        int weight_count = DimsVectorUtils::Count(layer_param->weight_dims);
+
+        layer_res->weight_handle = RawBuffer(weight_count * sizeof(float));
+        InitRandom(layer_res->weight_handle.force_to<float*>(), weight_count, 1.0f);
+
+        *resource = layer_res;
+        return TNN_OK;
+    }
+
+    virtual Status ConvertHalfLayerResource(LayerResource* fp16_res, LayerResource** fp32_res) {
+        LOGD("MatMulLayerResource convert from fp16 to fp32\n");
+        auto src_res = dynamic_cast<MatMulLayerResource*>(fp16_res);
+        CHECK_PARAM_NULL(src_res);
+
+        auto dst_res = new MatMulLayerResource();
+
+        dst_res->weight_handle = ConvertHalfHandle(src_res->weight_handle);
+
+        *fp32_res = dst_res;
+        return TNN_OK;
+    }
+};
+
+/*
+ * Generate the constant data or indices of Gather
+ */
+class GatherLayerResourceGenerator : public LayerResourceGenerator {
+    virtual Status GenLayerResource(LayerParam* param, LayerResource** resource, std::vector<Blob*>& inputs) {
+        LOGD("GatherLayerResourceGenerator\n");
+        auto layer_param = dynamic_cast<GatherLayerParam*>(param);
+        CHECK_PARAM_NULL(layer_param);
+        if (!layer_param->data_in_resource && !layer_param->indices_in_resource) {
+            return TNN_OK;
+        }
+
+        auto layer_res = new GatherLayerResource();
+        auto data_dims = layer_param->data_in_resource ? layer_param->data_dims : inputs[0]->GetBlobDesc().dims;
+        if (layer_param->data_in_resource) {
+            int data_count         = DimsVectorUtils::Count(data_dims);
+            layer_res->data_handle = RawBuffer(data_count * sizeof(float));
+            InitRandom(layer_res->data_handle.force_to<float*>(), data_count, 1.0f);
+        }
+        if (layer_param->indices_in_resource) {
+            // indices in [-axis_dim, axis_dim), negative ones count from the end
+            int axis      = layer_param->axis < 0 ? layer_param->axis + (int)data_dims.size() : layer_param->axis;
+            int axis_dim  = data_dims[axis];
+            int count     = DimsVectorUtils::Count(layer_param->indices_dims);
+            auto &indices = layer_res->indices_handle;
+            indices       = RawBuffer(count * sizeof(int32_t));
+            indices.SetDataType(DATA_TYPE_INT32);
+            InitRandom(indices.force_to<int32_t*>(), count, -axis_dim, axis_dim);
+        }
+
+        *resource = layer_res;
+        return TNN_OK;
+    }
+
+    virtual Status ConvertHalfLayerResource(LayerResource* fp16_res, LayerResource** fp32_res) {
+        LOGD("GatherLayerResource convert from fp16 to fp32\n");
+        auto src_res = dynamic_cast<GatherLayerResource*>(fp16_res);
+        CHECK_PARAM_NULL(src_res);
+
+        auto dst_res = new GatherLayerResource();
+
+        dst_res->data_handle    = ConvertHalfHandle(src_res->data_handle);
+        dst_res->indices_handle = src_res->indices_handle;
+
+        *fp32_res = dst_res;
+        return TNN_OK;
+    }
+};
+
+/*
+ * Generate weights for LayerNorm
+ */
+class LayerNormLayerResourceGenerator : public LayerResourceGenerator {
+    virtual Status GenLayerResource(LayerParam* param, LayerResource** resource, std::vector<Blob*>& inputs) {
+        LOGD("LayerNormLayerResourceGenerator\n");
+        auto layer_param = dynamic_cast<LayerNormLayerParam*>(param);
+        CHECK_PARAM_NULL(layer_param);
+        auto layer_res = new LayerNormLayerResource();
+
+        auto dims = inputs[0]->GetBlobDesc().dims;
+        int count = DimsVectorUtils::Count(dims, (int)dims.size() - layer_param->reduce_dims_size);
+
+        layer_res->scale_handle = RawBuffer(count * sizeof(float));
+        InitRandom(layer_res->scale_handle.force_to<float*>(), count, 1.0f);
+        layer_res->bias_handle = RawBuffer(count * sizeof(float));
+        InitRandom(layer_res->bias_handle.force_to<float*>(), count, 1.0f);
+
+        *resource = layer_res;
+        return TNN_OK;
+    }
+
+    virtual Status ConvertHalfLayerResource(LayerResource* fp16_res, LayerResource** fp32_res) {
+        LOGD("LayerNormLayerResource convert from fp16 to fp32\n");
+        auto src_res = dynamic_cast<LayerNormLayerResource*>(fp16_res);
+        CHECK_PARAM_NULL(src_res);
+
+        auto dst_res = new LayerNormLayerResource();
+
+        dst_res->scale_handle = ConvertHalfHandle(src_res->scale_handle);
+        dst_res->bias_handle  = ConvertHalfHandle(src_res->bias_handle);
+
+        *fp32_res = dst_res;
+        return TNN_OK;
+    }
+};
+
 REGISTER_LAYER_RESOURCE(Convolution, LAYER_CONVOLUTION)
 REGISTER_LAYER_RESOURCE(Deconvolution, LAYER_DECONVOLUTION)
 REGISTER_LAYER_RESOURCE(InnerProduct, LAYER_INNER_PRODUCT)
@@ -410,4 +583,9 @@ REGISTER_LAYER_RESOURCE(Div, LAYER_DIV);
 REGISTER_LAYER_RESOURCE(Mul, LAYER_MUL);
 REGISTER_LAYER_RESOURCE(SquaredDifference, LAYER_SQUARED_DIFFERENCE);
 REGISTER_LAYER_RESOURCE(HdrGuide, LAYER_HDRGUIDE);
+REGISTER_LAYER_RESOURCE(Lstm, LAYER_LSTM);
+REGISTER_LAYER_RESOURCE(Gru, LAYER_GRU);
+REGISTER_LAYER_RESOURCE(MatMul, LAYER_MATMUL);
+REGISTER_LAYER_RESOURCE(Gather, LAYER_GATHER);
+REGISTER_LAYER_RESOURCE(LayerNorm, LAYER_LAYER_NORM);
 }  // namespace TNN_NS
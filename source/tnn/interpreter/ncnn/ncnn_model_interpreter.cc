@@ -40,6 +40,7 @@ namespace ncnn {
         RETURN_ON_ERROR(InterpretProto(proto_content));
         std::string &model_content = params.size() > 1 ? params[1] : empty_content;
         RETURN_ON_ERROR(InterpretModel(model_content));
+        ComputeModelMd5(proto_content, model_content.data(), model_content.size());
         RETURN_ON_ERROR(NCNNOptimizerManager::Optimize(GetNetStructure(), GetNetResource()));
         RETURN_ON_ERROR(FindOutputs());
 
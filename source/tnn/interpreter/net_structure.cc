@@ -38,4 +38,53 @@ bool GetQuantizedInfoFromNetStructure(NetStructure* net_struct) {
     return quantize_layer != layers.end();
 }
 
+std::vector<std::vector<int>> GetLayerStepsFromNetStructure(NetStructure* net_struct, const NetworkConfig& config) {
+    const int layer_count = static_cast<int>(net_struct->layers.size());
+    std::vector<std::vector<int>> steps;
+    auto sequential = [&]() {
+        steps.clear();
+        for (int i = 0; i < layer_count; i++) {
+            steps.push_back({i});
+        }
+        return steps;
+    };
+
+#ifdef _OPENMP
+    const bool parallel = config.enable_parallel_branches && config.device_type == DEVICE_X86;
+#else
+    const bool parallel = false;
+#endif
+    if (!parallel) {
+        return sequential();
+    }
+
+    // the step of a layer is one after the latest step of the layers writing its inputs
+    std::map<std::string, int> blob_step;
+    std::vector<int> layer_step(layer_count, 0);
+    for (int i = 0; i < layer_count; i++) {
+        auto layer_info = net_struct->layers[i];
+        int step        = 0;
+        for (auto& name : layer_info->inputs) {
+            if (blob_step.count(name) > 0) {
+                step = std::max(step, blob_step[name] + 1);
+            }
+        }
+        for (auto& name : layer_info->outputs) {
+            if (blob_step.count(name) > 0) {
+                return sequential();
+            }
+            blob_step[name] = step;
+        }
+        layer_step[i] = step;
+    }
+
+    for (int i = 0; i < layer_count; i++) {
+        if (layer_step[i] >= static_cast<int>(steps.size())) {
+            steps.resize(layer_step[i] + 1);
+        }
+        steps[layer_step[i]].push_back(i);
+    }
+    return steps;
+}
+
 }  // namespace TNN_NS
@@ -54,6 +54,11 @@ std::shared_ptr<LayerInfo> GetLayerInfoFromName(NetStructure* net_struct, std::s
 
 bool GetQuantizedInfoFromNetStructure(NetStructure* net_struct);
 
+// @brief group the layer indexes into steps run in order. a layer only reads blobs written in the
+// earlier steps, so the layers of one step may run at the same time. every layer is a step of its own
+// unless the config enables parallel branches on a device supporting them, or if a blob has two writers.
+std::vector<std::vector<int>> GetLayerStepsFromNetStructure(NetStructure* net_struct, const NetworkConfig& config);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_INTERPRETER_NET_STRUCTURE_H_
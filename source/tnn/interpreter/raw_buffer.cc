@@ -70,6 +70,11 @@ RawBuffer::RawBuffer(int bytes_size, int alignment) {
     bytes_size_ = bytes_size;
 }
 
+RawBuffer::RawBuffer(int bytes_size, shared_ptr<char> buffer) {
+    buff_       = buffer;
+    bytes_size_ = bytes_size;
+}
+
 template <typename T>
 void permute(void *in, void *out, size_t outter, size_t inner) {
     T *in_ptr  = static_cast<T *>(in);
@@ -34,6 +34,9 @@ public:
     RawBuffer(int bytes_size, char *buffer);
     RawBuffer(const RawBuffer &buf);
     RawBuffer(int bytes_size, int alignment);
+    // @brief reference external memory without copy, the shared_ptr keeps the
+    // owner (e.g. a memory mapped model file) alive
+    RawBuffer(int bytes_size, shared_ptr<char> buffer);
     RawBuffer &operator=(RawBuffer buf);
     ~RawBuffer();
 
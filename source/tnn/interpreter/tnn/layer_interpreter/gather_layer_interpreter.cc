@@ -0,0 +1,70 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
+
+namespace TNN_NS {
+
+DECLARE_LAYER_INTERPRETER(Gather, LAYER_GATHER);
+
+Status GatherLayerInterpreter::InterpretProto(str_arr layer_cfg_arr, int index, LayerParam** param) {
+    auto p = CreateLayerParam<GatherLayerParam>(param);
+    GET_INT_1_OR_DEFAULT(p->axis, 0);
+
+    int dims_size = 0;
+    GET_INT_1_OR_DEFAULT(p->data_in_resource, 0);
+    GET_INT_1_OR_DEFAULT(dims_size, 0);
+    p->data_dims.clear();
+    GET_INT_N_INTO_VEC(p->data_dims, dims_size);
+
+    GET_INT_1_OR_DEFAULT(p->indices_in_resource, 0);
+    GET_INT_1_OR_DEFAULT(dims_size, 0);
+    p->indices_dims.clear();
+    GET_INT_N_INTO_VEC(p->indices_dims, dims_size);
+    return TNN_OK;
+}
+
+Status GatherLayerInterpreter::InterpretResource(Deserializer& deserializer, LayerResource** resource) {
+    auto layer_res = CreateLayerRes<GatherLayerResource>(resource);
+    GET_BUFFER_FOR_ATTR(layer_res, data_handle, deserializer);
+    GET_BUFFER_FOR_ATTR(layer_res, indices_handle, deserializer);
+    return TNN_OK;
+}
+
+Status GatherLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+    CAST_OR_RET_ERROR(layer_param, GatherLayerParam, "invalid layer param to save", param);
+    output_stream << layer_param->axis << " ";
+    output_stream << layer_param->data_in_resource << " ";
+    output_stream << layer_param->data_dims.size() << " ";
+    for (auto item : layer_param->data_dims) {
+        output_stream << item << " ";
+    }
+    output_stream << layer_param->indices_in_resource << " ";
+    output_stream << layer_param->indices_dims.size() << " ";
+    for (auto item : layer_param->indices_dims) {
+        output_stream << item << " ";
+    }
+    return TNN_OK;
+}
+
+Status GatherLayerInterpreter::SaveResource(Serializer& serializer, LayerParam* param, LayerResource* resource) {
+    CAST_OR_RET_ERROR(layer_res, GatherLayerResource, "invalid layer res to save", resource);
+    serializer.PutRaw(layer_res->data_handle);
+    serializer.PutRaw(layer_res->indices_handle);
+    return TNN_OK;
+}
+
+REGISTER_LAYER_INTERPRETER(Gather, LAYER_GATHER);
+
+}  // namespace TNN_NS
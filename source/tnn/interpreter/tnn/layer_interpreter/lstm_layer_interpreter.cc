@@ -0,0 +1,84 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
+
+#include <stdlib.h>
+
+namespace TNN_NS {
+
+DECLARE_LAYER_INTERPRETER(Lstm, LAYER_LSTM);
+
+Status LstmLayerInterpreter::InterpretProto(str_arr layer_cfg_arr, int start_index, LayerParam** param) {
+    LSTMLayerParam* layer_param = new LSTMLayerParam();
+    *param                      = layer_param;
+    int index                   = start_index;
+
+    layer_param->hidden_size       = atoi(layer_cfg_arr[index++].c_str());
+    layer_param->direction         = atoi(layer_cfg_arr[index++].c_str());
+    layer_param->has_sequence_lens = atoi(layer_cfg_arr[index++].c_str());
+
+    return TNN_OK;
+}
+
+Status LstmLayerInterpreter::InterpretResource(Deserializer& deserializer, LayerResource** resource) {
+    RNNLayerResource* layer_res = new RNNLayerResource();
+    *resource                   = layer_res;
+
+    std::string layer_name = deserializer.GetString();
+
+    deserializer.GetRaw(layer_res->weight_handle);
+    deserializer.GetRaw(layer_res->recurrence_handle);
+    deserializer.GetRaw(layer_res->bias_handle);
+
+    return TNN_OK;
+}
+
+Status LstmLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+    LSTMLayerParam* layer_param = dynamic_cast<LSTMLayerParam*>(param);
+    if (nullptr == layer_param) {
+        LOGE("invalid layer param to save\n");
+        return Status(TNNERR_NULL_PARAM, "invalid layer param to save");
+    }
+
+    output_stream << layer_param->hidden_size << " ";
+    output_stream << layer_param->direction << " ";
+    output_stream << layer_param->has_sequence_lens << " ";
+
+    return TNN_OK;
+}
+
+Status LstmLayerInterpreter::SaveResource(Serializer& serializer, LayerParam* param, LayerResource* resource) {
+    LSTMLayerParam* layer_param = dynamic_cast<LSTMLayerParam*>(param);
+    if (nullptr == layer_param) {
+        LOGE("invalid layer param to save\n");
+        return Status(TNNERR_NULL_PARAM, "invalid layer param to save");
+    }
+    RNNLayerResource* layer_res = dynamic_cast<RNNLayerResource*>(resource);
+    if (nullptr == layer_res) {
+        LOGE("invalid layer res to save\n");
+        return Status(TNNERR_NULL_PARAM, "invalid layer res to save");
+    }
+
+    serializer.PutString(layer_param->name);
+    serializer.PutRaw(layer_res->weight_handle);
+    serializer.PutRaw(layer_res->recurrence_handle);
+    serializer.PutRaw(layer_res->bias_handle);
+
+    return TNN_OK;
+}
+
+REGISTER_LAYER_INTERPRETER(Lstm, LAYER_LSTM);
+
+}  // namespace TNN_NS
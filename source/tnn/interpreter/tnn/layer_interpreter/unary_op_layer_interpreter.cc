@@ -38,4 +38,6 @@ REGISTER_UNARY_OP_LAYER_INTERPRETER(Sigmoid, LAYER_SIGMOID);
 
 REGISTER_UNARY_OP_LAYER_INTERPRETER(Rsqrt, LAYER_RSQRT);
 
-REGISTER_UNARY_OP_LAYER_INTERPRETER(Softplus, LAYER_SOFTPLUS);
\ No newline at end of file
+REGISTER_UNARY_OP_LAYER_INTERPRETER(Softplus, LAYER_SOFTPLUS);
+
+REGISTER_UNARY_OP_LAYER_INTERPRETER(Gelu, LAYER_GELU);
\ No newline at end of file
@@ -0,0 +1,173 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/interpreter/tnn/mmap_model_interpreter.h"
+
+#include <fstream>
+#include <istream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "tnn/core/macro.h"
+
+namespace TNN_NS {
+
+TypeModelInterpreterRegister<TypeModelInterpreterCreator<MmapModelInterpreter>> g_tnn_mmap_model_interpreter_register(
+    MODEL_TYPE_TNN_MMAP);
+
+MemoryStreamBuf::MemoryStreamBuf(char *data, size_t size) {
+    setg(data, data, data + size);
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                   std::ios_base::openmode which) {
+    char *target = nullptr;
+    if (dir == std::ios_base::beg) {
+        target = eback() + off;
+    } else if (dir == std::ios_base::cur) {
+        target = gptr() + off;
+    } else {
+        target = egptr() + off;
+    }
+    if (target < eback() || target > egptr()) {
+        return pos_type(off_type(-1));
+    }
+    setg(eback(), target, egptr());
+    return pos_type(target - eback());
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which) {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+MmapDeserializer::MmapDeserializer(std::istream &is, std::shared_ptr<char> mapping)
+    : Deserializer(is), mapping_(mapping) {}
+
+void MmapDeserializer::GetRaw(TNN_NS::RawBuffer &value) {
+    auto magic_number = GetInt();
+    auto data_type    = (TNN_NS::DataType)GetInt();
+    int length        = GetInt();
+    if (length <= 0 || _istream.eof()) {
+        return;
+    }
+
+    if (magic_number != g_version_magic_number_v2) {
+        // v1 layout has no alignment guarantee, copy it as Deserializer does
+        value = TNN_NS::RawBuffer(length);
+        value.SetDataType(data_type);
+        _istream.read(value.force_to<char *>(), static_cast<std::streamsize>(length));
+        return;
+    }
+
+    SkipPadding();
+    const std::streamoff offset = _istream.tellg();
+    if (offset < 0 || !_istream.seekg(length, std::ios_base::cur)) {
+        LOGE("MmapDeserializer: raw buffer exceeds the model file\n");
+        return;
+    }
+
+    // alias the mapping so that it lives as long as any raw buffer referencing it
+    value = TNN_NS::RawBuffer(length, std::shared_ptr<char>(mapping_, mapping_.get() + offset));
+    value.SetDataType(data_type);
+}
+
+std::shared_ptr<Deserializer> MmapModelInterpreter::GetDeserializer(std::istream &is) {
+    return std::make_shared<MmapDeserializer>(is, mapping_);
+}
+
+Status MmapModelInterpreter::MapModelFile(const std::string &model_path) {
+#if !defined(_WIN32)
+    int fd = open(model_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOGE("MmapModelInterpreter: open model file failed (%s)\n", model_path.c_str());
+        return Status(TNNERR_LOAD_MODEL, "open model file failed");
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+        close(fd);
+        return Status(TNNERR_LOAD_MODEL, "model file is empty");
+    }
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    // private writable mapping: pages stay shared in the page cache until some
+    // layer modifies its weights in place, which then gets a private copy
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return Status(TNNERR_LOAD_MODEL, "mmap model file failed");
+    }
+    mapping_      = std::shared_ptr<char>(static_cast<char *>(addr), [size](char *p) { munmap(p, size); });
+    mapping_size_ = size;
+    return TNN_OK;
+#else
+    // no mmap, read the whole file once into an aligned buffer and reference it
+    std::ifstream file(model_path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        LOGE("MmapModelInterpreter: open model file failed (%s)\n", model_path.c_str());
+        return Status(TNNERR_LOAD_MODEL, "open model file failed");
+    }
+    std::streamoff size = file.tellg();
+    if (size <= 0) {
+        return Status(TNNERR_LOAD_MODEL, "model file is empty");
+    }
+    RawBuffer buffer(static_cast<int>(size), g_model_data_alignment);
+    file.seekg(0, std::ios::beg);
+    file.read(buffer.force_to<char *>(), size);
+    mapping_      = std::shared_ptr<char>(buffer.force_to<char *>(), [buffer](char *) {});
+    mapping_size_ = static_cast<size_t>(size);
+    return TNN_OK;
+#endif
+}
+
+Status MmapModelInterpreter::Interpret(std::vector<std::string> &params) {
+    std::string empty_content = "";
+
+    auto &proto_content = params.size() > 0 ? params[0] : empty_content;
+    Status status       = InterpretProto(proto_content);
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    auto &model_path = params.size() > 1 ? params[1] : empty_content;
+    if (model_path.empty()) {
+#ifdef GENERATE_RESOURCE
+        LOGD("model path is empty, will generate random data\n");
+        return TNN_OK;
+#else
+        return Status(TNNERR_LOAD_MODEL, "model path is invalid");
+#endif
+    }
+
+    status = MapModelFile(model_path);
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    MemoryStreamBuf stream_buf(mapping_.get(), mapping_size_);
+    std::istream content_stream(&stream_buf);
+    status = InterpretModel(content_stream);
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    // the md5 is taken from the mapped bytes, a model replaced at the same path gets another one
+    ComputeModelMd5(proto_content, mapping_.get(), mapping_size_);
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
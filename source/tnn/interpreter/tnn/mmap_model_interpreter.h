@@ -0,0 +1,67 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_INTERPRETER_TNN_MMAP_MODEL_INTERPRETER_H_
+#define TNN_SOURCE_TNN_INTERPRETER_TNN_MMAP_MODEL_INTERPRETER_H_
+
+#include <memory>
+#include <streambuf>
+
+#include "tnn/interpreter/tnn/model_interpreter.h"
+
+namespace TNN_NS {
+
+// @brief read only stream buffer over a memory region, supports tellg/seekg
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(char *data, size_t size);
+
+protected:
+    virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                             std::ios_base::openmode which = std::ios_base::in);
+    virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in);
+};
+
+// @brief MmapDeserializer makes raw buffers of v2 model reference the mapped
+// file instead of copying them. Buffers of v1 model are still copied.
+class MmapDeserializer : public Deserializer {
+public:
+    MmapDeserializer(std::istream &is, std::shared_ptr<char> mapping);
+
+    virtual void GetRaw(TNN_NS::RawBuffer &value);
+
+private:
+    std::shared_ptr<char> mapping_;
+};
+
+// @brief MmapModelInterpreter load params is proto content, model file path.
+// The model file is memory mapped, weights of model packed with version 2 are
+// shared with the page cache.
+class MmapModelInterpreter : public ModelInterpreter {
+public:
+    virtual Status Interpret(std::vector<std::string> &params);
+
+protected:
+    virtual std::shared_ptr<Deserializer> GetDeserializer(std::istream &is);
+
+private:
+    Status MapModelFile(const std::string &model_path);
+
+    std::shared_ptr<char> mapping_ = nullptr;
+    size_t mapping_size_           = 0;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_INTERPRETER_TNN_MMAP_MODEL_INTERPRETER_H_
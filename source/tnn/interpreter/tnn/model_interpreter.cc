@@ -31,7 +31,7 @@ std::string ModelInterpreter::Transfer(std::string content) {
 
 // Check if the magic number is valid.
 bool ModelInterpreter::IsValidVersionNumber(uint32_t number) {
-    return number == g_version_magic_number;
+    return number == g_version_magic_number || number == g_version_magic_number_v2;
 }
 
 std::shared_ptr<Deserializer> ModelInterpreter::GetDeserializer(std::istream &is) {
@@ -50,7 +50,12 @@ Status ModelInterpreter::Interpret(std::vector<std::string> &params) {
 
     auto &model_content = params.size() > 1 ? params[1] : empty_content;
     status              = InterpretModel(model_content);
-    return status;
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    ComputeModelMd5(proto_content, model_content.data(), model_content.size());
+    return TNN_OK;
 }
 
 Status ModelInterpreter::InterpretProto(std::string &content) {
@@ -250,8 +255,6 @@ Status ModelInterpreter::InterpretLayer(const std::string &layer_str) {
 }
 
 Status ModelInterpreter::InterpretModel(std::string &model_content) {
-    NetResource *net_resource = GetNetResource();
-
     const auto model_length = model_content.length();
     if (model_length <= 0) {
 #ifdef GENERATE_RESOURCE
@@ -264,6 +267,11 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
 
     std::istringstream content_stream;
     content_stream.str(model_content);
+    return InterpretModel(content_stream);
+}
+
+Status ModelInterpreter::InterpretModel(std::istream &content_stream) {
+    NetResource *net_resource = GetNetResource();
 
     uint32_t magic_version_number = 0;
     content_stream.read(reinterpret_cast<char *>(&magic_version_number), sizeof(g_version_magic_number));
@@ -97,6 +97,8 @@ public:
 protected:
     virtual Status InterpretProto(std::string &content);
     virtual Status InterpretModel(std::string &model_content);
+    // @brief interpret model from stream, which must start at the beginning of model file
+    virtual Status InterpretModel(std::istream &content_stream);
     virtual Status InterpretInput(const std::string& inputs_content);
     virtual Status InterpretOutput(const std::string& outputs_content);
     virtual Status InterpretLayer(const std::string& layer_str);
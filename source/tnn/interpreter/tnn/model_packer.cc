@@ -25,10 +25,14 @@ std::string ModelPacker::Transfer(std::string content) {
 }
 
 uint32_t ModelPacker::GetMagicNumber() {
-    return g_version_magic_number;
+    return model_version_ >= 2 ? g_version_magic_number_v2 : g_version_magic_number;
 }
 
 std::shared_ptr<Serializer> ModelPacker::GetSerializer(std::ostream &os) {
+    // v2 model aligns weights to g_model_data_alignment so that they can be memory mapped
+    if (model_version_ >= 2) {
+        return std::make_shared<AlignedSerializer>(os);
+    }
     return std::make_shared<Serializer>(os);
 }
 
@@ -29,7 +29,8 @@ public:
     // @brief save the rpn model into files
     virtual Status Pack(std::string proto_path, std::string model_path);
 
-    // @brief set the model version to pack
+    // @brief set the model version to pack, version 2 writes weights 64-byte
+    // aligned for MODEL_TYPE_TNN_MMAP
     void SetVersion(int version);
 
 private:
@@ -27,6 +27,10 @@
 
 namespace TNN_NS {
     static const uint32_t g_version_magic_number = 0x0FABC0002;
+    // v2 model: raw buffer data is padded to g_model_data_alignment bytes from
+    // the beginning of the model file, so that it can be memory mapped in place
+    static const uint32_t g_version_magic_number_v2 = 0x0FABC0003;
+    static const int g_model_data_alignment         = 64;
 
     class Serializer {
     public:
@@ -76,6 +80,35 @@ namespace TNN_NS {
         Serializer &operator=(const Serializer &);
     };
 
+    // @brief AlignedSerializer writes raw buffer in v2 layout, the stream must
+    // start at the beginning of the model file.
+    class AlignedSerializer : public Serializer {
+    public:
+        explicit AlignedSerializer(std::ostream &os) : Serializer(os) {}
+
+        virtual void PutRaw(TNN_NS::RawBuffer &value) {
+            int length = value.GetBytesSize();
+            auto data_type = (TNN_NS::DataType)value.GetDataType();
+            char *buffer = value.force_to<char *>();
+
+            PutInt(g_version_magic_number_v2);
+            PutInt(data_type);
+            PutInt(static_cast<int>(length));
+            if (length <= 0) {
+                return;
+            }
+
+            const std::streamoff pos = _ostream.tellp();
+            int padding = static_cast<int>((g_model_data_alignment - pos % g_model_data_alignment) %
+                                           g_model_data_alignment);
+            for (int i = 0; i < padding; ++i) {
+                _ostream.put(0);
+            }
+            _ostream.write(reinterpret_cast<char *>(buffer),
+                           static_cast<std::streamsize>(length));
+        }
+    };
+
     template <typename T>
     void Serializer::put_basic_t(T value) {
         _ostream.write(reinterpret_cast<char *>(&value), sizeof(T));
@@ -120,7 +153,11 @@ namespace TNN_NS {
             if (length <= 0) {
                 return;
             }
-            
+
+            if (magic_number == g_version_magic_number_v2) {
+                SkipPadding();
+            }
+
             value = TNN_NS::RawBuffer(length);
             value.SetDataType(data_type);
 
@@ -134,6 +171,16 @@ namespace TNN_NS {
 
     protected:
         std::istream &_istream;
+
+        // skip the zero padding in front of v2 raw buffer data
+        void SkipPadding() {
+            const std::streamoff pos = _istream.tellg();
+            if (pos < 0)
+                return;
+            int padding = static_cast<int>((g_model_data_alignment - pos % g_model_data_alignment) %
+                                           g_model_data_alignment);
+            _istream.ignore(padding);
+        }
         
         template <typename T>
         T get_basic_t();
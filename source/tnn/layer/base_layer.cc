@@ -64,6 +64,13 @@ Status BaseLayer::Init(Context* context, LayerParam* param, LayerResource* resou
     }
 
     layer_acc_ = device->CreateLayerAcc(type_);
+    auto fallback_device = device->GetFallbackDevice();
+    if (layer_acc_ == NULL && fallback_device != NULL) {
+        layer_acc_ = fallback_device->CreateLayerAcc(type_);
+        if (layer_acc_ != NULL) {
+            LOGD("layer %s of type(%d) runs on the fallback device\n", layer_name_.c_str(), type_);
+        }
+    }
     if (layer_acc_ != NULL) {
         return layer_acc_->Init(context, param, resource, input_blobs_, output_blobs_);
     } else {
@@ -92,6 +99,10 @@ Status BaseLayer::Reshape() {
         }
     }
 
+    return ReshapeAcc();
+}
+
+Status BaseLayer::ReshapeAcc() {
     if (layer_acc_ != NULL) {
         return layer_acc_->Reshape(input_blobs_, output_blobs_);
     } else {
@@ -100,6 +111,32 @@ Status BaseLayer::Reshape() {
     }
 }
 
+std::vector<int> BaseLayer::GetInferredParams() {
+    std::vector<int> params;
+    if (auto conv_param = dynamic_cast<ConvLayerParam*>(param_)) {
+        params = conv_param->pads;
+    } else if (auto pool_param = dynamic_cast<PoolingLayerParam*>(param_)) {
+        params = pool_param->kernels;
+        params.insert(params.end(), pool_param->pads.begin(), pool_param->pads.end());
+    } else if (auto broadcast_param = dynamic_cast<MultidirBroadcastLayerParam*>(param_)) {
+        params = {broadcast_param->input0_broadcast_type, broadcast_param->input1_broadcast_type};
+    }
+    return params;
+}
+
+void BaseLayer::SetInferredParams(const std::vector<int>& params) {
+    if (auto conv_param = dynamic_cast<ConvLayerParam*>(param_)) {
+        conv_param->pads = params;
+    } else if (auto pool_param = dynamic_cast<PoolingLayerParam*>(param_)) {
+        const size_t kernel_count = pool_param->kernels.size();
+        pool_param->kernels.assign(params.begin(), params.begin() + kernel_count);
+        pool_param->pads.assign(params.begin() + kernel_count, params.end());
+    } else if (auto broadcast_param = dynamic_cast<MultidirBroadcastLayerParam*>(param_)) {
+        broadcast_param->input0_broadcast_type = params[0];
+        broadcast_param->input1_broadcast_type = params[1];
+    }
+}
+
 Status BaseLayer::Forward() {
     if (layer_acc_ != NULL) {
         return layer_acc_->Forward(input_blobs_, output_blobs_);
@@ -46,6 +46,14 @@ public:
     //@brief Reshape recalculate the output tensor dims
     virtual Status Reshape();
 
+    //@brief reshape the layer acc with the current blob dims, the output dims are not inferred
+    Status ReshapeAcc();
+
+    //@brief params InferOutputShape derives from the input dims: pads of SAME padding, kernels of
+    // global pooling and broadcast types. Reshape plans save them to skip the shape inference.
+    virtual std::vector<int> GetInferredParams();
+    virtual void SetInferredParams(const std::vector<int>& params);
+
     //@brief layer infer
     virtual Status Forward();
 
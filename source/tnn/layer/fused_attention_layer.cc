@@ -0,0 +1,49 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/layer/base_layer.h"
+#include "tnn/utils/attention_utils.h"
+
+namespace TNN_NS {
+DECLARE_LAYER(FusedAttention, LAYER_FUSED_ATTENTION);
+
+Status FusedAttentionLayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+Status FusedAttentionLayer::InferOutputShape() {
+    auto layer_param = dynamic_cast<FusedAttentionLayerParam*>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    if (input_blobs_.size() < 3) {
+        return Status(TNNERR_PARAM_ERR, "FusedAttention needs the query, key and value inputs");
+    }
+
+    DimsVector mask_dims = input_blobs_.size() > 3 ? input_blobs_[3]->GetBlobDesc().dims : DimsVector();
+    AttentionShape shape;
+    RETURN_ON_NEQ(GetAttentionShape(input_blobs_[0]->GetBlobDesc().dims, input_blobs_[1]->GetBlobDesc().dims,
+                                    input_blobs_[2]->GetBlobDesc().dims, mask_dims, shape),
+                  TNN_OK);
+    const int scores_rank = static_cast<int>(shape.scores_dims.size());
+    const int axis        = (layer_param->softmax_axis + scores_rank) % scores_rank;
+    if (axis != scores_rank - 1) {
+        return Status(TNNERR_PARAM_ERR, "FusedAttention softmax is not over the last axis of the scores");
+    }
+
+    output_blobs_[0]->GetBlobDesc().dims = shape.output_dims;
+    return TNN_OK;
+}
+
+REGISTER_LAYER(FusedAttention, LAYER_FUSED_ATTENTION);
+
+}  // namespace TNN_NS
@@ -0,0 +1,43 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/layer/base_layer.h"
+#include "tnn/utils/gather_utils.h"
+
+namespace TNN_NS {
+DECLARE_LAYER(Gather, LAYER_GATHER);
+
+Status GatherLayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+// output dims are data_dims[:axis] + indices_dims + data_dims[axis + 1:]
+Status GatherLayer::InferOutputShape() {
+    auto layer_param = dynamic_cast<GatherLayerParam*>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    DimsVector data_dims, indices_dims;
+    int axis = 0;
+    RETURN_ON_NEQ(GetGatherShape(layer_param, input_blobs_, data_dims, indices_dims, axis), TNN_OK);
+
+    DimsVector output_dims(data_dims.begin(), data_dims.begin() + axis);
+    output_dims.insert(output_dims.end(), indices_dims.begin(), indices_dims.end());
+    output_dims.insert(output_dims.end(), data_dims.begin() + axis + 1, data_dims.end());
+    output_blobs_[0]->GetBlobDesc().dims = output_dims;
+    return TNN_OK;
+}
+
+REGISTER_LAYER(Gather, LAYER_GATHER);
+
+}  // namespace TNN_NS
@@ -0,0 +1,51 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/layer/base_layer.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+DECLARE_LAYER(Gru, LAYER_GRU);
+
+Status GruLayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+Status GruLayer::InferOutputShape() {
+    auto layer_param = dynamic_cast<GRULayerParam*>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    auto input_dims = input_blobs_[0]->GetBlobDesc().dims;
+    if (input_dims.size() < 3 || layer_param->hidden_size <= 0) {
+        return Status(TNNERR_PARAM_ERR, "GruLayer has invalid input dims or hidden size");
+    }
+    if (output_blobs_.size() > 2) {
+        return Status(TNNERR_PARAM_ERR, "GruLayer has at most 2 outputs: Y and Y_h");
+    }
+
+    const int num_directions = layer_param->direction == 2 ? 2 : 1;
+    const int sequence       = input_dims[0];
+    const int batch          = input_dims[1];
+    const int hidden_size    = layer_param->hidden_size;
+
+    output_blobs_[0]->GetBlobDesc().dims = {sequence, num_directions, batch, hidden_size};
+    for (size_t i = 1; i < output_blobs_.size(); i++) {
+        output_blobs_[i]->GetBlobDesc().dims = {num_directions, batch, hidden_size, 1};
+    }
+    return TNN_OK;
+}
+
+REGISTER_LAYER(Gru, LAYER_GRU);
+
+}  // namespace TNN_NS
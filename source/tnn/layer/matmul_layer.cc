@@ -0,0 +1,40 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/layer/base_layer.h"
+#include "tnn/utils/matmul_utils.h"
+
+namespace TNN_NS {
+DECLARE_LAYER(MatMul, LAYER_MATMUL);
+
+Status MatMulLayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+Status MatMulLayer::InferOutputShape() {
+    auto layer_param = dynamic_cast<MatMulLayerParam*>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    DimsVector a_dims, b_dims;
+    RETURN_ON_NEQ(GetMatMulInputDims(layer_param, input_blobs_, a_dims, b_dims), TNN_OK);
+    MatMulShape shape;
+    RETURN_ON_NEQ(GetMatMulShape(a_dims, b_dims, shape), TNN_OK);
+
+    output_blobs_[0]->GetBlobDesc().dims = shape.output_dims;
+    return TNN_OK;
+}
+
+REGISTER_LAYER(MatMul, LAYER_MATMUL);
+
+}  // namespace TNN_NS
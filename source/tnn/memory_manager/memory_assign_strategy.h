@@ -20,7 +20,7 @@
 
 namespace TNN_NS {
 
-enum MemoryAssignStragegyType { UNIFY = 0, SEPERATE = 1 };
+enum MemoryAssignStragegyType { UNIFY = 0, SEPERATE = 1, LIFETIME = 2 };
 
 class MemoryAssignStrategy {
 public:
@@ -0,0 +1,109 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/memory_manager/memory_lifetime_assign_strategy.h"
+
+#include <algorithm>
+#include <climits>
+#include <list>
+
+#include "tnn/core/macro.h"
+#include "tnn/memory_manager/blob_memory_size_info.h"
+
+namespace TNN_NS {
+
+// every offset is aligned to the cache line, which also keeps simd loads aligned
+static const int kBlobMemoryAlignment = 64;
+
+MemoryLifetimeAssignStrategy::MemoryLifetimeAssignStrategy(const std::vector<BlobMemoryLifetime>& lifetimes) {
+    Plan(lifetimes);
+}
+
+void MemoryLifetimeAssignStrategy::SetMemory(void* data) {
+    all_blob_memory_data_ = data;
+}
+
+int MemoryLifetimeAssignStrategy::GetPlannedMemorySize() const {
+    return planned_memory_size_;
+}
+
+void MemoryLifetimeAssignStrategy::Plan(const std::vector<BlobMemoryLifetime>& lifetimes) {
+    struct PlanRecord {
+        BlobMemoryLifetime lifetime;
+        int size   = 0;
+        int offset = 0;
+    };
+
+    std::vector<PlanRecord> records;
+    for (const auto& lifetime : lifetimes) {
+        PlanRecord record;
+        record.lifetime              = lifetime;
+        BlobMemorySizeInfo size_info = lifetime.blob_memory->GetBlobMemorySizeInfo();
+        record.size = ROUND_UP(GetBlobMemoryBytesSize(size_info), kBlobMemoryAlignment);
+        records.push_back(record);
+    }
+    // larger blob memories first, the earlier one first for the same size
+    std::stable_sort(records.begin(), records.end(), [](const PlanRecord& a, const PlanRecord& b) {
+        if (a.size != b.size) {
+            return a.size > b.size;
+        }
+        return a.lifetime.first_use < b.lifetime.first_use;
+    });
+
+    offsets_.clear();
+    planned_memory_size_ = 0;
+    // placed records ordered by offset
+    std::list<const PlanRecord*> placed;
+    for (auto& record : records) {
+        int prev_end     = 0;
+        int best_offset  = -1;
+        int smallest_gap = INT_MAX;
+        for (auto other : placed) {
+            if (other->lifetime.last_use < record.lifetime.first_use ||
+                other->lifetime.first_use > record.lifetime.last_use) {
+                continue;
+            }
+            int gap = other->offset - prev_end;
+            if (gap >= record.size && gap < smallest_gap) {
+                smallest_gap = gap;
+                best_offset  = prev_end;
+            }
+            prev_end = std::max(prev_end, other->offset + other->size);
+        }
+        record.offset = best_offset >= 0 ? best_offset : prev_end;
+
+        auto pos = std::find_if(placed.begin(), placed.end(),
+                                [&](const PlanRecord* other) { return other->offset > record.offset; });
+        placed.insert(pos, &record);
+
+        offsets_[record.lifetime.blob_memory] = record.offset;
+        planned_memory_size_                  = std::max(planned_memory_size_, record.offset + record.size);
+    }
+}
+
+Status MemoryLifetimeAssignStrategy::AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library) {
+    for (auto& iter : blob_memory_library) {
+        if (offsets_.find(iter) == offsets_.end()) {
+            LOGE("blob memory is not planned by the lifetime strategy\n");
+            return Status(TNNERR_COMMON_ERROR, "blob memory is not planned by the lifetime strategy");
+        }
+        BlobHandle handle;
+        handle.base         = all_blob_memory_data_;
+        handle.bytes_offset = offsets_[iter];
+        iter->SetHandleFromExternal(handle);
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
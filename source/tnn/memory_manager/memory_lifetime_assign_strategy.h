@@ -0,0 +1,58 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_LIFETIME_ASSIGN_STRATEGY_H_
+#define TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_LIFETIME_ASSIGN_STRATEGY_H_
+
+#include <map>
+#include <vector>
+
+#include "tnn/memory_manager/memory_assign_strategy.h"
+
+namespace TNN_NS {
+
+struct BlobMemoryLifetime {
+    BlobMemory* blob_memory = nullptr;
+    // index of the first and the last layer in which the blob memory is alive, both included
+    int first_use = 0;
+    int last_use  = 0;
+};
+
+// @brief place all blob memories in one arena, blob memories whose lifetimes do not
+// overlap may share the same bytes. Offsets are planned greedy by size: the largest
+// blob memory is placed first, into the smallest gap left by the placed blob memories
+// alive at the same time.
+class MemoryLifetimeAssignStrategy : public MemoryAssignStrategy {
+public:
+    explicit MemoryLifetimeAssignStrategy(const std::vector<BlobMemoryLifetime>& lifetimes);
+
+    // @brief set the arena the planned offsets point into
+    void SetMemory(void* data);
+
+    // @brief bytes of the arena, the peak of the planned offsets
+    int GetPlannedMemorySize() const;
+
+    virtual Status AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library);
+
+private:
+    void Plan(const std::vector<BlobMemoryLifetime>& lifetimes);
+
+    std::map<BlobMemory*, int> offsets_;
+    int planned_memory_size_    = 0;
+    void* all_blob_memory_data_ = nullptr;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_LIFETIME_ASSIGN_STRATEGY_H_
@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_OPTIMIZER_NET_OPTIMIZER_H_
 #define TNN_SOURCE_TNN_OPTIMIZER_NET_OPTIMIZER_H_
 
+#include <memory>
 #include <string>
 
 #include "tnn/core/common.h"
@@ -33,8 +34,23 @@ namespace optimizer {
         virtual std::string Strategy()                                          = 0;
         virtual bool IsSupported(const NetworkConfig &net_config)               = 0;
         virtual Status Optimize(NetStructure *structure, NetResource *resource) = 0;
+        // an optimizer whose result depends on the device runs on the copy of the structure owned by
+        // each network, the others change the structure shared by all the networks of the model
+        virtual bool IsPerNetwork() {
+            return false;
+        }
     };
 
+    // the layers may be shared with other networks, an optimizer changes a copy of the layer and of its param
+    template <typename T>
+    std::shared_ptr<LayerInfo> CopyLayerInfo(const std::shared_ptr<LayerInfo> &layer_info, T **param) {
+        auto param_copy   = std::make_shared<T>(*dynamic_cast<T *>(layer_info->param.get()));
+        auto layer_copy   = std::make_shared<LayerInfo>(*layer_info);
+        layer_copy->param = param_copy;
+        *param            = param_copy.get();
+        return layer_copy;
+    }
+
 }  // namespace optimizer
 
 }  // namespace TNN_NS
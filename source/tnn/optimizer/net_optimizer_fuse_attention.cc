@@ -0,0 +1,260 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_fuse_attention.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // P2 priority: should be fuse after the layers of ncnn models are removed
+    NetOptimizerRegister<NetOptimizerFuseAttention> g_net_optimizer_fuse_attention(OptPriority::P2);
+
+    std::string NetOptimizerFuseAttention::Strategy() {
+        return kNetOptimizerFuseAttention;
+    }
+
+    bool NetOptimizerFuseAttention::IsSupported(const NetworkConfig &net_config) {
+#ifdef TNN_CONVERTER_RUNTIME
+        return false;
+#else
+        return net_config.device_type == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO;
+#endif
+    }
+
+    bool NetOptimizerFuseAttention::IsPerNetwork() {
+        return true;
+    }
+
+    /*
+     * the unfused subgraph is
+     *     scores = MatMul(Q, K) -> [Mul or Div by a constant scalar] -> [Add(scores, mask)] -> Softmax(last axis)
+     *     output = MatMul(scores, V)
+     * every blob between the two MatMuls must be read by the next layer only.
+     */
+    struct AttentionPattern {
+        std::vector<int> layers;
+        std::vector<std::string> inputs;
+        float scale      = 1.0f;
+        int softmax_axis = -1;
+    };
+
+    class AttentionMatcher {
+    public:
+        explicit AttentionMatcher(NetStructure *structure, NetResource *resource)
+            : structure_(structure), resource_(resource) {
+            for (int index = 0; index < structure->layers.size(); index++) {
+                auto layer = structure->layers[index];
+                for (auto output : layer->outputs) {
+                    producer_[output] = index;
+                }
+                for (auto input : layer->inputs) {
+                    use_count_[input]++;
+                }
+            }
+        }
+
+        bool Match(int index, AttentionPattern &pattern) {
+            auto output_matmul = structure_->layers[index];
+            int softmax_index  = -1;
+            if (!IsMatMulOfInputs(output_matmul) || !GetInternalProducer(output_matmul->inputs[0], softmax_index)) {
+                return false;
+            }
+            auto softmax       = structure_->layers[softmax_index];
+            auto softmax_param = dynamic_cast<SoftmaxLayerParam *>(softmax->param.get());
+            // the rank of the scores is not known here, only -1 is surely the last axis.
+            // other axes are left to Softmax
+            if (softmax->type != LAYER_SOFTMAX || !softmax_param || softmax->inputs.size() != 1 ||
+                softmax_param->axis != -1) {
+                return false;
+            }
+
+            int layer_index = -1;
+            if (!GetInternalProducer(softmax->inputs[0], layer_index)) {
+                return false;
+            }
+            std::string mask;
+            auto layer = structure_->layers[layer_index];
+            if (layer->type == LAYER_ADD && layer->inputs.size() == 2 && layer->param && !layer->param->quantized) {
+                // the scores are either input of the add
+                for (int i = 0; i < 2; i++) {
+                    int scores_index = -1;
+                    if (GetInternalProducer(layer->inputs[i], scores_index) &&
+                        MatchScores(scores_index, pattern)) {
+                        mask = layer->inputs[1 - i];
+                        break;
+                    }
+                }
+                if (mask.empty()) {
+                    return false;
+                }
+                pattern.layers.push_back(layer_index);
+            } else if (!MatchScores(layer_index, pattern)) {
+                return false;
+            }
+
+            pattern.layers.push_back(softmax_index);
+            pattern.softmax_axis = softmax_param->axis;
+            pattern.inputs.push_back(output_matmul->inputs[1]);
+            if (!mask.empty()) {
+                pattern.inputs.push_back(mask);
+            }
+            return true;
+        }
+
+    private:
+        static bool IsMatMulOfInputs(std::shared_ptr<LayerInfo> layer) {
+            auto param = dynamic_cast<MatMulLayerParam *>(layer->param.get());
+            return layer->type == LAYER_MATMUL && param && param->weight_position == -1 && !param->quantized &&
+                   layer->inputs.size() == 2 && layer->outputs.size() == 1;
+        }
+
+        // the layer writing blob, which must be read by one layer only and not be an output of the net
+        bool GetInternalProducer(const std::string &blob, int &index) {
+            if (producer_.find(blob) == producer_.end() || use_count_[blob] != 1 ||
+                structure_->outputs.find(blob) != structure_->outputs.end()) {
+                return false;
+            }
+            index = producer_[blob];
+            return structure_->layers[index]->outputs.size() == 1;
+        }
+
+        // the constant scalar of a Mul or Div
+        bool GetScale(std::shared_ptr<LayerInfo> layer, float &scale) {
+            auto param = dynamic_cast<MultidirBroadcastLayerParam *>(layer->param.get());
+            if ((layer->type != LAYER_MUL && layer->type != LAYER_DIV) || !param || param->quantized ||
+                layer->inputs.size() != 1 || param->weight_input_index != 1) {
+                return false;
+            }
+            if (!resource_) {
+                return false;
+            }
+            auto iter = resource_->resource_map.find(layer->name);
+            if (iter == resource_->resource_map.end()) {
+                return false;
+            }
+            auto eltwise_res = dynamic_cast<EltwiseLayerResource *>(iter->second.get());
+            if (!eltwise_res || eltwise_res->element_handle.GetDataCount() != 1) {
+                return false;
+            }
+            float value = GetFloatFromRawBuffer(eltwise_res->element_handle).get()[0];
+            if (layer->type == LAYER_DIV) {
+                if (value == 0.f) {
+                    return false;
+                }
+                value = 1.0f / value;
+            }
+            scale = value;
+            return true;
+        }
+
+        // MatMul(Q, K) with the optional scale behind it
+        bool MatchScores(int index, AttentionPattern &pattern) {
+            std::vector<int> layers;
+            float scale = 1.0f;
+            if (GetScale(structure_->layers[index], scale)) {
+                layers.push_back(index);
+                if (!GetInternalProducer(structure_->layers[index]->inputs[0], index)) {
+                    return false;
+                }
+            }
+            auto matmul = structure_->layers[index];
+            if (!IsMatMulOfInputs(matmul)) {
+                return false;
+            }
+            layers.insert(layers.begin(), index);
+            pattern.layers = layers;
+            pattern.inputs = matmul->inputs;
+            pattern.scale  = scale;
+            return true;
+        }
+
+        NetStructure *structure_;
+        NetResource *resource_;
+        std::map<std::string, int> producer_;
+        std::map<std::string, int> use_count_;
+    };
+
+    Status NetOptimizerFuseAttention::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_orig = structure->layers;
+        const int count                                     = (const int)layers_orig.size();
+        // the shortest pattern is MatMul, Softmax and MatMul
+        if (count < 3) {
+            return TNN_OK;
+        }
+
+        AttentionMatcher matcher(structure, resource);
+        // the fused layer takes the place of the second MatMul, all its inputs are written before
+        std::map<int, std::shared_ptr<LayerInfo>> fused_layers;
+        std::set<int> removed_layers;
+        for (int index = 0; index < count; index++) {
+            AttentionPattern pattern;
+            if (!matcher.Match(index, pattern)) {
+                continue;
+            }
+            auto output_matmul = layers_orig[index];
+            auto param         = std::make_shared<FusedAttentionLayerParam>();
+            param->type         = "FusedAttention";
+            param->name         = output_matmul->name;
+            param->scale        = pattern.scale;
+            param->softmax_axis = pattern.softmax_axis;
+
+            auto layer_info_fused      = std::make_shared<LayerInfo>();
+            layer_info_fused->type     = LAYER_FUSED_ATTENTION;
+            layer_info_fused->type_str = "FusedAttention";
+            layer_info_fused->name     = output_matmul->name;
+            layer_info_fused->inputs   = pattern.inputs;
+            layer_info_fused->outputs  = output_matmul->outputs;
+            layer_info_fused->param    = param;
+            fused_layers[index]        = layer_info_fused;
+            for (auto layer_index : pattern.layers) {
+                removed_layers.insert(layer_index);
+            }
+        }
+        if (fused_layers.empty()) {
+            return TNN_OK;
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_fused;
+        for (int index = 0; index < count; index++) {
+            if (fused_layers.find(index) != fused_layers.end()) {
+                layers_fused.push_back(fused_layers[index]);
+            } else if (removed_layers.find(index) == removed_layers.end()) {
+                layers_fused.push_back(layers_orig[index]);
+            }
+        }
+        structure->layers = layers_fused;
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
@@ -14,6 +14,7 @@
 
 #include "tnn/optimizer/net_optimizer_fuse_conv_add.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -30,6 +31,7 @@ namespace optimizer {
 
     // P1 priority: should be fuse after bn scale fuse
     NetOptimizerRegister<NetOptimizerFuseConvAdd> g_net_optimizer_fuse_conv_add(OptPriority::P1);
+    NetOptimizerRegister<NetOptimizerFuseConvAddX86> g_net_optimizer_fuse_conv_add_x86(OptPriority::P1);
 
     std::string NetOptimizerFuseConvAdd::Strategy() {
         return kNetOptimizerFuseConvAdd;
@@ -40,7 +42,7 @@ namespace optimizer {
         return false;
 #else
         auto device = net_config.device_type;
-        if (device == DEVICE_ARM || device == DEVICE_NAIVE) {
+        if (device == DEVICE_ARM || device == DEVICE_NAIVE || device == DEVICE_X86) {
             auto conv_post_optimizer = NetOptimizerManager::GetNetOptimizerByName(kNetOptimizerFuseConvPost);
             if (conv_post_optimizer && conv_post_optimizer->IsSupported(net_config)) {
                 conv_post_opt_ = conv_post_optimizer;
@@ -53,7 +55,34 @@ namespace optimizer {
 #endif
     }
 
-    static bool IsPreviousLayerSupportFusion(std::shared_ptr<LayerInfo> layer_info) {
+    std::string NetOptimizerFuseConvAddX86::Strategy() {
+        return kNetOptimizerFuseConvAddX86;
+    }
+
+    bool NetOptimizerFuseConvAddX86::IsSupported(const NetworkConfig &net_config) {
+#ifdef TNN_CONVERTER_RUNTIME
+        return false;
+#else
+        // x86 fuses the add of float convs into the sgemm epilogue
+        if (net_config.device_type != DEVICE_X86 || net_config.network_type == NETWORK_TYPE_OPENVINO) {
+            return false;
+        }
+        fuse_float_              = true;
+        auto conv_post_optimizer = NetOptimizerManager::GetNetOptimizerByName(kNetOptimizerFuseConvPostX86);
+        if (conv_post_optimizer && conv_post_optimizer->IsSupported(net_config)) {
+            conv_post_opt_ = conv_post_optimizer;
+        } else {
+            conv_post_opt_ = nullptr;
+        }
+        return true;
+#endif
+    }
+
+    bool NetOptimizerFuseConvAddX86::IsPerNetwork() {
+        return true;
+    }
+
+    static bool IsPreviousLayerSupportFusion(std::shared_ptr<LayerInfo> layer_info, bool fuse_float) {
         auto param = dynamic_cast<ConvLayerParam *>(layer_info->param.get());
         if (param) {
             // only fuse conv 1x1 now
@@ -62,18 +91,22 @@ namespace optimizer {
                 param->pads[3] != 0) {
                 return false;
             } else {
-                return param->quantized;
+                return fuse_float ? (!param->quantized && layer_info->type == LAYER_CONVOLUTION) : param->quantized;
             }
         }
         return false;
     }
 
-    static bool IsCurrentLayerSupportFusion(std::shared_ptr<LayerInfo> layer_info) {
-        return (layer_info->type == LAYER_ADD && layer_info->param->quantized);
+    static bool IsCurrentLayerSupportFusion(std::shared_ptr<LayerInfo> layer_info, bool fuse_float) {
+        // float add with a constant operand has a single input and nothing to fuse
+        return (layer_info->type == LAYER_ADD &&
+                (fuse_float ? (!layer_info->param->quantized && layer_info->inputs.size() == 2)
+                            : layer_info->param->quantized));
     }
 
-    static bool NeedConvAddFusion(std::shared_ptr<LayerInfo> prev, std::shared_ptr<LayerInfo> current) {
-        return (IsPreviousLayerSupportFusion(prev) && IsCurrentLayerSupportFusion(current));
+    static bool NeedConvAddFusion(std::shared_ptr<LayerInfo> prev, std::shared_ptr<LayerInfo> current,
+                                  bool fuse_float) {
+        return (IsPreviousLayerSupportFusion(prev, fuse_float) && IsCurrentLayerSupportFusion(current, fuse_float));
     }
 
     Status NetOptimizerFuseConvAdd::Optimize(NetStructure *structure, NetResource *resource) {
@@ -83,9 +116,9 @@ namespace optimizer {
             return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
         }
 
-        // Only fuse quantized network now
+        // Only fuse quantized network now, except float convs on x86
         auto is_quantized_net = GetQuantizedInfoFromNetStructure(structure);
-        if (!is_quantized_net) {
+        if (!is_quantized_net && !fuse_float_) {
             return TNN_OK;
         }
         if (structure->layers.size() <= 1) {
@@ -113,7 +146,7 @@ namespace optimizer {
             auto layer_info_current = layers_orig[index];
             auto layer_info_prev    = layers_orig[index - 1];
             auto conv_param = dynamic_cast<ConvLayerParam *>(layer_info_prev->param.get());
-            if (NeedConvAddFusion(layer_info_prev, layer_info_current)) {
+            if (NeedConvAddFusion(layer_info_prev, layer_info_current, fuse_float_)) {
                 auto conv_output_name   = layer_info_prev->outputs[0];
                 auto conv_inputs        = layer_info_prev->inputs;
                 // inputs of add should contain conv_outputs, and others are pushed back to conv_inputs
@@ -140,14 +173,18 @@ namespace optimizer {
                     }
                 }
 
-                if (is_add_after_conv && !is_input_of_others) {
-                    layer_info_prev->outputs = layer_info_current->outputs;
-                    layer_info_prev->inputs  = conv_inputs;
+                // add of the conv output to itself leaves no residual to fuse
+                bool has_residual = conv_inputs.size() == layer_info_prev->inputs.size() + 1;
+                if (is_add_after_conv && has_residual && !is_input_of_others) {
+                    auto layer_info_conv     = CopyLayerInfo(layer_info_prev, &conv_param);
+                    layer_info_conv->outputs = layer_info_current->outputs;
+                    layer_info_conv->inputs  = conv_inputs;
                     if (conv_param->activation_type == ActivationType_None) {
                         conv_param->fusion_type  = FusionType_Conv_Add_Activation;
                     } else {
                         conv_param->fusion_type  = FusionType_Conv_Activation_Add;
                     }
+                    std::replace(layers_fused.begin(), layers_fused.end(), layer_info_prev, layer_info_conv);
                 } else {
                     layers_fused.push_back(layer_info_current);
                 }
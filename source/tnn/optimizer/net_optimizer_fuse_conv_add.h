@@ -33,8 +33,18 @@ namespace optimizer {
         virtual std::string Strategy();
         virtual bool IsSupported(const NetworkConfig &net_config);
         virtual Status Optimize(NetStructure *structure, NetResource *resource);
-    private:
+    protected:
         std::shared_ptr<NetOptimizer> conv_post_opt_ = nullptr;
+        // fuse the float convs instead of the quantized ones
+        bool fuse_float_ = false;
+    };
+
+    //@brief net optimize: fuse float conv and add on the copy of the structure of the x86 network
+    class NetOptimizerFuseConvAddX86 : public NetOptimizerFuseConvAdd {
+    public:
+        virtual std::string Strategy();
+        virtual bool IsSupported(const NetworkConfig &net_config);
+        virtual bool IsPerNetwork();
     };
 
 }  // namespace optimizer
@@ -14,8 +14,11 @@
 
 #include "tnn/optimizer/net_optimizer_fuse_conv_post.h"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "tnn/core/layer_type.h"
@@ -29,6 +32,7 @@ namespace optimizer {
 
     // P1 priority: should be fuse after bn scale fuse
     NetOptimizerRegister<NetOptimizerFuseConvPost> g_net_optimizer_fuse_conv_post(OptPriority::P1);
+    NetOptimizerRegister<NetOptimizerFuseConvPostX86> g_net_optimizer_fuse_conv_post_x86(OptPriority::P1);
 
     std::string NetOptimizerFuseConvPost::Strategy() {
         return kNetOptimizerFuseConvPost;
@@ -36,6 +40,9 @@ namespace optimizer {
 
     bool NetOptimizerFuseConvPost::IsSupported(const NetworkConfig &net_config) {
         auto device = net_config.device_type;
+        // the optimizer is shared by all networks, drop the activations of the previous device
+        kLayerActivationMap.clear();
+        fuse_inner_product_ = false;
         if (device == DEVICE_METAL || device == DEVICE_OPENCL || device == DEVICE_ARM || device == DEVICE_NAIVE) {
             kLayerActivationMap[LAYER_RELU]    = ActivationType_ReLU;
             kLayerActivationMap[LAYER_RELU6]   = ActivationType_ReLU6;
@@ -47,12 +54,49 @@ namespace optimizer {
             return true;
         }
         if (device == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO) {
+            // the other activations and the inner product run on the copy of the structure,
+            // see NetOptimizerFuseConvPostX86
             kLayerActivationMap[LAYER_RELU] = ActivationType_ReLU;
             return true;
         }
         return false;
     }
 
+    std::string NetOptimizerFuseConvPostX86::Strategy() {
+        return kNetOptimizerFuseConvPostX86;
+    }
+
+    bool NetOptimizerFuseConvPostX86::IsSupported(const NetworkConfig &net_config) {
+        kLayerActivationMap.clear();
+        fuse_inner_product_ = false;
+        if (net_config.device_type != DEVICE_X86 || net_config.network_type == NETWORK_TYPE_OPENVINO) {
+            return false;
+        }
+        kLayerActivationMap[LAYER_RELU]      = ActivationType_ReLU;
+        kLayerActivationMap[LAYER_RELU6]     = ActivationType_ReLU6;
+        kLayerActivationMap[LAYER_SIGMOID]   = ActivationType_SIGMOID_MUL;
+        kLayerActivationMap[LAYER_HARDSWISH] = ActivationType_HARDSWISH;
+        fuse_inner_product_                  = true;
+        return true;
+    }
+
+    bool NetOptimizerFuseConvPostX86::IsPerNetwork() {
+        return true;
+    }
+
+    // whether the layers from begin read the blob
+    static bool IsInputOfLayers(const std::vector<std::shared_ptr<LayerInfo>> &layers, int begin,
+                                const std::string &name) {
+        for (int next = begin; next < (int)layers.size(); next++) {
+            for (auto input_next : layers[next]->inputs) {
+                if (name == input_next) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     Status NetOptimizerFuseConvPost::Optimize(NetStructure *structure, NetResource *resource) {
         if (!structure) {
             LOGE("Error: empty NetStructure\n");
@@ -73,6 +117,20 @@ namespace optimizer {
             auto layer_info_prev    = layers_orig[index - 1];
             auto layer_current_type = layer_info_current->type;
 
+            auto fc_param = dynamic_cast<InnerProductLayerParam *>(layer_info_prev->param.get());
+            if (fuse_inner_product_ && fc_param && !fc_param->quantized &&
+                fc_param->activation_type == ActivationType_None &&
+                (layer_current_type == LAYER_RELU || layer_current_type == LAYER_RELU6) &&
+                layer_info_current->inputs.size() == 1 && layer_info_prev->outputs.size() == 1 &&
+                layer_info_current->inputs[0] == layer_info_prev->outputs[0] &&
+                !IsInputOfLayers(layers_orig, index + 1, layer_info_prev->outputs[0])) {
+                auto layer_info_fc        = CopyLayerInfo(layer_info_prev, &fc_param);
+                fc_param->activation_type = kLayerActivationMap[layer_current_type];
+                layer_info_fc->outputs    = layer_info_current->outputs;
+                std::replace(layers_fused.begin(), layers_fused.end(), layer_info_prev, layer_info_fc);
+                continue;
+            }
+
             auto conv_param = dynamic_cast<ConvLayerParam *>(layer_info_prev->param.get());
             auto activation = kLayerActivationMap.find(layer_current_type);
             if (conv_param && activation != kLayerActivationMap.end()) {
@@ -92,25 +150,22 @@ namespace optimizer {
                             conv_output_name_check = true;
                         }
                     }
+                } else if (activation_type == ActivationType_HARDSWISH) {
+                    // only x * hardsigmoid(x) with the default alpha and beta of onnx
+                    auto hardswish_param = dynamic_cast<HardSwishLayerParam *>(layer_info_current->param.get());
+                    conv_output_name_check = hardswish_param &&
+                                             std::fabs(hardswish_param->alpha - 1.0f / 6.0f) < 1e-6f &&
+                                             std::fabs(hardswish_param->beta - 0.5f) < 1e-6f;
+                    for (auto input_current : layer_info_current->inputs) {
+                        conv_output_name_check &= (input_current == conv_output_name);
+                    }
                 } else {
                     conv_output_name_check = true;
                 }
 
                 if (conv_output_name_check) {
                     // outputs of conv cannot be inputs of other layeres from index + 1
-                    bool is_input_of_others = false;
-                    for (int next = index + 1; next < count; next++) {
-                        auto layer_info_next = layers_orig[next];
-                        for (auto input_next : layer_info_next->inputs) {
-                            if (conv_output_name == input_next) {
-                                is_input_of_others = true;
-                                break;
-                            }
-                        }
-                        if (is_input_of_others) {
-                            break;
-                        }
-                    }
+                    bool is_input_of_others = IsInputOfLayers(layers_orig, index + 1, conv_output_name);
 
                     // prevent fusing multiple activation layers into one conv layer
                     if (!is_input_of_others && conv_param->activation_type == ActivationType_None) {
@@ -118,8 +173,10 @@ namespace optimizer {
                         if (conv_param->quantized && activation_type != ActivationType_ReLU) {
                             layers_fused.push_back(layer_info_current);
                         } else {
+                            auto layer_info_conv        = CopyLayerInfo(layer_info_prev, &conv_param);
                             conv_param->activation_type = activation_type;
-                            layer_info_prev->outputs    = layer_info_current->outputs;
+                            layer_info_conv->outputs    = layer_info_current->outputs;
+                            std::replace(layers_fused.begin(), layers_fused.end(), layer_info_prev, layer_info_conv);
                         }
                     } else {
                         layers_fused.push_back(layer_info_current);
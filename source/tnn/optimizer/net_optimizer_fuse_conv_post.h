@@ -33,8 +33,19 @@ namespace optimizer {
         virtual std::string Strategy();
         virtual bool IsSupported(const NetworkConfig &net_config);
         virtual Status Optimize(NetStructure *structure, NetResource *resource);
-    private:
+    protected:
         std::map<LayerType, ActivationType> kLayerActivationMap;
+        // relu and relu6 are fused into inner product as well
+        bool fuse_inner_product_ = false;
+    };
+
+    //@brief net optimize: fuse the conv post only x86 applies (relu6, sigmoid mul, hardswish) on the copy of
+    // the structure of the network, the networks of other devices keep these layers
+    class NetOptimizerFuseConvPostX86 : public NetOptimizerFuseConvPost {
+    public:
+        virtual std::string Strategy();
+        virtual bool IsSupported(const NetworkConfig &net_config);
+        virtual bool IsPerNetwork();
     };
 
 }  // namespace optimizer
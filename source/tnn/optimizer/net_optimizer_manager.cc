@@ -31,12 +31,22 @@ namespace optimizer {
     }
 
     Status NetOptimizerManager::Optimize(NetStructure *structure, NetResource *resource, const NetworkConfig &net_config) {
+        return RunOptimizers(structure, resource, net_config, false);
+    }
+
+    Status NetOptimizerManager::OptimizeNetwork(NetStructure *structure, NetResource *resource,
+                                                const NetworkConfig &net_config) {
+        return RunOptimizers(structure, resource, net_config, true);
+    }
+
+    Status NetOptimizerManager::RunOptimizers(NetStructure *structure, NetResource *resource,
+                                              const NetworkConfig &net_config, bool per_network) {
         auto &optimizer_map = NetOptimizerManager::GetNetOptimizerMap();
         std::sort(NetOptimizerManager::GetNetOptimizerSeq().begin(), NetOptimizerManager::GetNetOptimizerSeq().end());
 
         for (auto iter : NetOptimizerManager::GetNetOptimizerSeq()) {
             auto optimizer = optimizer_map[iter.second];
-            if (optimizer->IsSupported(net_config)) {
+            if (optimizer->IsPerNetwork() == per_network && optimizer->IsSupported(net_config)) {
                 auto status = optimizer->Optimize(structure, resource);
                 if (status != TNN_OK) {
                     return status;
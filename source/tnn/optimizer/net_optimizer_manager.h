@@ -47,11 +47,17 @@ namespace optimizer {
     public:
         static Status Optimize(NetStructure *structure, NetResource *resource, const NetworkConfig &net_config);
 
+        // runs the per network optimizers, the structure must be owned by the network
+        static Status OptimizeNetwork(NetStructure *structure, NetResource *resource, const NetworkConfig &net_config);
+
         static void RegisterNetOptimizer(NetOptimizer *ptimizer, OptPriority prior);
 
         static std::shared_ptr<NetOptimizer> GetNetOptimizerByName(const std::string &k_net_optimizer);
 
     private:
+        static Status RunOptimizers(NetStructure *structure, NetResource *resource, const NetworkConfig &net_config,
+                                    bool per_network);
+
         static std::map<std::string, std::shared_ptr<NetOptimizer>> &GetNetOptimizerMap();
 
         static std::vector<std::pair<OptPriority, std::string>> &GetNetOptimizerSeq();
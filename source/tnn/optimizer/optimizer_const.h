@@ -25,12 +25,21 @@ static const std::string kNetOptimizerFuseConvPost =
 static const std::string kNetOptimizerFuseConvAdd =
     "net_optimizer_fuse_conv_add";
 
+static const std::string kNetOptimizerFuseConvPostX86 =
+    "net_optimizer_fuse_conv_post_x86";
+
+static const std::string kNetOptimizerFuseConvAddX86 =
+    "net_optimizer_fuse_conv_add_x86";
+
 static const std::string kNetOptimizerCbamFusedReduce =
     "net_optimizer_cbam_fused_reduce";
 
 static const std::string kNetOptimizerCbamFusedPooling =
     "net_optimizer_cbam_fused_pooling";
 
+static const std::string kNetOptimizerFuseAttention =
+    "net_optimizer_fuse_attention";
+
 static const std::string kNetOptimizerInsertInt8Reformat =
     "net_optimizer_insert_int8_reformat";
 
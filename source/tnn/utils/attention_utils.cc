@@ -0,0 +1,98 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/attention_utils.h"
+
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/matmul_utils.h"
+
+namespace TNN_NS {
+
+// offset of the mask of each scores matrix
+static Status GetMaskOffsets(const DimsVector &scores_dims, const DimsVector &mask_dims, std::vector<int> &offsets) {
+    const int rank      = static_cast<int>(scores_dims.size());
+    const int mask_rank = static_cast<int>(mask_dims.size());
+    if (mask_rank > rank) {
+        return Status(TNNERR_PARAM_ERR, "FusedAttention mask has more dims than the scores");
+    }
+    // mask dims aligned to the right
+    DimsVector mask_strides(mask_rank, 1);
+    for (int i = mask_rank - 1; i >= 0; i--) {
+        if (mask_dims[i] != 1 && mask_dims[i] != scores_dims[rank - mask_rank + i]) {
+            return Status(TNNERR_PARAM_ERR, "FusedAttention mask can not broadcast to the scores");
+        }
+        if (i < mask_rank - 1) {
+            mask_strides[i] = mask_strides[i + 1] * mask_dims[i + 1];
+        }
+    }
+
+    const int batch_rank = rank - 2;
+    const int batch      = DimsVectorUtils::Count(scores_dims, 0, batch_rank);
+    offsets.resize(batch);
+    for (int n = 0; n < batch; n++) {
+        int offset = 0, rest = n;
+        for (int i = batch_rank - 1; i >= 0; i--) {
+            int index = rest % scores_dims[i];
+            rest /= scores_dims[i];
+            const int mask_axis = i - (rank - mask_rank);
+            if (mask_axis >= 0 && mask_dims[mask_axis] != 1) {
+                offset += index * mask_strides[mask_axis];
+            }
+        }
+        offsets[n] = offset;
+    }
+    return TNN_OK;
+}
+
+Status GetAttentionShape(const DimsVector &q_dims, const DimsVector &k_dims, const DimsVector &v_dims,
+                         const DimsVector &mask_dims, AttentionShape &shape) {
+    if (q_dims.size() < 2 || k_dims.size() < 2 || v_dims.size() < 2) {
+        return Status(TNNERR_PARAM_ERR, "FusedAttention needs inputs of at least two dims");
+    }
+    MatMulShape scores, output;
+    RETURN_ON_NEQ(GetMatMulShape(q_dims, k_dims, scores), TNN_OK);
+    RETURN_ON_NEQ(GetMatMulShape(scores.output_dims, v_dims, output), TNN_OK);
+    shape.query_len   = scores.M;
+    shape.key_len     = scores.N;
+    shape.head_size   = scores.K;
+    shape.value_size  = output.N;
+    shape.scores_dims = scores.output_dims;
+    shape.output_dims = output.output_dims;
+
+    std::vector<int> mask_offsets;
+    if (!mask_dims.empty()) {
+        RETURN_ON_NEQ(GetMaskOffsets(scores.output_dims, mask_dims, mask_offsets), TNN_OK);
+        const int mask_rank    = static_cast<int>(mask_dims.size());
+        shape.mask_col_stride  = mask_dims[mask_rank - 1] == 1 ? 0 : 1;
+        shape.mask_row_stride  = (mask_rank < 2 || mask_dims[mask_rank - 2] == 1) ? 0 : mask_dims[mask_rank - 1];
+    }
+
+    const int batch = static_cast<int>(output.a_index.size());
+    shape.q_index.resize(batch);
+    shape.k_index.resize(batch);
+    shape.v_index.resize(batch);
+    shape.mask_offset.resize(batch, 0);
+    for (int n = 0; n < batch; n++) {
+        const int s      = output.a_index[n];
+        shape.q_index[n] = scores.a_index[s];
+        shape.k_index[n] = scores.b_index[s];
+        shape.v_index[n] = output.b_index[n];
+        if (!mask_offsets.empty()) {
+            shape.mask_offset[n] = mask_offsets[s];
+        }
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,50 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_ATTENTION_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_ATTENTION_UTILS_H_
+
+#include <vector>
+
+#include "tnn/core/blob.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// @brief shape of the attention softmax(Q [..., Sq, D] K [..., D, Sk] + mask) V [..., Sk, Dv], the batch dims of
+// both products broadcast as in MatMul and the mask broadcasts to the scores [..., Sq, Sk].
+struct AttentionShape {
+    int query_len  = 0;
+    int key_len    = 0;
+    int head_size  = 0;
+    int value_size = 0;
+    DimsVector scores_dims;
+    DimsVector output_dims;
+    // the query, key and value matrix that each output matrix reads
+    std::vector<int> q_index;
+    std::vector<int> k_index;
+    std::vector<int> v_index;
+    // offset of the mask of each output matrix, the strides of its rows and columns are 0 for broadcast dims
+    std::vector<int> mask_offset;
+    int mask_row_stride = 0;
+    int mask_col_stride = 0;
+};
+
+// @brief mask_dims is empty without a mask, all other inputs need at least two dims
+Status GetAttentionShape(const DimsVector &q_dims, const DimsVector &k_dims, const DimsVector &v_dims,
+                         const DimsVector &mask_dims, AttentionShape &shape);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_ATTENTION_UTILS_H_
@@ -156,6 +156,21 @@ void RGBAChannelReverseNaive(uint8_t *src, uint8_t *dst, int channel, int hw) {
     }
 }
 
+/*
+ * view the dims of a blob as n, c, h, w
+ * lower ranks are padded with 1, higher ranks fold the trailing dims into w
+ */
+static DimsVector GetNCHWDims(const DimsVector &dims) {
+    DimsVector nchw_dims(dims.begin(), dims.begin() + std::min((int)dims.size(), 4));
+    while (nchw_dims.size() < 4) {
+        nchw_dims.push_back(1);
+    }
+    for (int i = 4; i < dims.size(); ++i) {
+        nchw_dims[3] *= dims[i];
+    }
+    return nchw_dims;
+}
+
 #define FREE_INT8_TEMP_DATA()                               \
     if (desc.data_type == DATA_TYPE_INT8 && blob_data) {    \
         delete[] blob_data;                                 \
@@ -168,7 +183,7 @@ Status DefaultBlobConverterAcc::ConvertToMatAsync(Mat &image, MatConvertParam pa
     }
     auto blob_data = reinterpret_cast<float *>(blob_->GetHandle().base);
     auto desc      = blob_->GetBlobDesc();
-    auto dims      = desc.dims;
+    auto dims      = GetNCHWDims(desc.dims);
     auto hw        = dims[2] * dims[3];
 
     if (desc.data_type == DATA_TYPE_INT8) {
@@ -301,7 +316,7 @@ Status DefaultBlobConverterAcc::ConvertFromMatAsync(Mat &image_src, MatConvertPa
         return Status(TNNERR_NULL_PARAM, "input/output blob_ is null");
     }
     auto desc      = blob_->GetBlobDesc();
-    auto dims      = desc.dims;
+    auto dims      = GetNCHWDims(desc.dims);
     auto hw        = dims[2] * dims[3];
     auto blob_data = reinterpret_cast<float *>(blob_->GetHandle().base);
     if (desc.data_type == DATA_TYPE_INT8) {
@@ -28,6 +28,10 @@ BlobMemorySizeInfo Calculate1DMemorySize(BlobDesc& desc) {
         count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * desc.dims[2] * desc.dims[3];
     } else if (desc.data_format == DATA_FORMAT_NHWC4) {
         count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * ROUND_UP(desc.dims[2] * desc.dims[3], 4);
+    } else if (desc.data_format == DATA_FORMAT_NC8HW8) {
+        count = desc.dims[0] * ROUND_UP(desc.dims[1], 8) * DimsVectorUtils::Count(desc.dims, 2);
+    } else if (desc.data_format == DATA_FORMAT_NC16HW16) {
+        count = desc.dims[0] * ROUND_UP(desc.dims[1], 16) * DimsVectorUtils::Count(desc.dims, 2);
     } else {
         count = DimsVectorUtils::Count(desc.dims);
     }
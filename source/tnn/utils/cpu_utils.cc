@@ -15,6 +15,9 @@
 #include "tnn/utils/cpu_utils.h"
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
+#include <map>
+#include <thread>
 #include <vector>
 #include "tnn/utils/cpu_info.h"
 
@@ -267,6 +270,44 @@ static int SetSchedAffinity(const std::vector<int>& cpuids) {
     return 0;
 }
 
+#if defined(__ANDROID__) || defined(__linux__)
+// cpus the calling thread may run on
+static std::vector<int> GetSchedAffinity() {
+    unsigned long bits[1024 / (8 * sizeof(unsigned long))];
+    memset(bits, 0, sizeof(bits));
+
+    std::vector<int> cpuids;
+    // the raw syscall returns the bytes of the kernel cpu mask
+    int mask_bytes = syscall(__NR_sched_getaffinity, 0, sizeof(bits), bits);
+    if (mask_bytes <= 0) {
+        return cpuids;
+    }
+    const int bits_per_long = 8 * sizeof(unsigned long);
+    for (int cpu = 0; cpu < mask_bytes * 8; cpu++) {
+        if ((bits[cpu / bits_per_long] >> (cpu % bits_per_long)) & 1) {
+            cpuids.push_back(cpu);
+        }
+    }
+    return cpuids;
+}
+
+// value in /sys/devices/system/cpu/cpuN/topology, -1 if it is not exported
+static int GetCpuTopology(int cpuid, const char* name) {
+    char path[256];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpuid, name);
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return -1;
+
+    int value = -1;
+    if (fscanf(fp, "%d", &value) != 1)
+        value = -1;
+
+    fclose(fp);
+    return value;
+}
+#endif
+
 Status CpuUtils::SetCpuPowersave(int powersave) {
 #ifdef __ANDROID__
     static std::vector<int> sorted_cpuids;
@@ -446,6 +487,62 @@ bool CpuUtils::CpuSupportFp16() {
 #endif  // TNN_ARM82
 }
 
+Status CpuUtils::PartitionCpus(int group_count, std::vector<std::vector<int>>& cpu_groups) {
+    cpu_groups.clear();
+
+    // cpuids of each core, ordered by package and core id
+    std::vector<std::vector<int>> cores;
+#if defined(__ANDROID__) || defined(__linux__)
+    std::map<std::pair<int, int>, std::vector<int>> core_map;
+    for (int cpuid : GetSchedAffinity()) {
+        int package = GetCpuTopology(cpuid, "physical_package_id");
+        int core_id = GetCpuTopology(cpuid, "core_id");
+        // without the topology every cpu is a core of its own
+        auto key = core_id < 0 ? std::make_pair(package, -1 - cpuid) : std::make_pair(package, core_id);
+        core_map[key].push_back(cpuid);
+    }
+    for (auto& iter : core_map) {
+        cores.push_back(iter.second);
+    }
+#endif
+    if (cores.empty()) {
+        int cpu_count = std::max(1, (int)std::thread::hardware_concurrency());
+        for (int i = 0; i < cpu_count; i++) {
+            cores.push_back({i});
+        }
+    }
+
+    int cpu_count = 0;
+    for (auto& core : cores) {
+        cpu_count += core.size();
+    }
+    if (group_count < 1 || group_count > cpu_count) {
+        LOGE("CpuUtils::PartitionCpus can not split %d cpus into %d groups\n", cpu_count, group_count);
+        return Status(TNNERR_PARAM_ERR, "cpu group count is out of range");
+    }
+
+    // more groups than cores, the hyper threads of a core go to different groups
+    if (group_count > (int)cores.size()) {
+        std::vector<std::vector<int>> cpus;
+        for (auto& core : cores) {
+            for (int cpuid : core) {
+                cpus.push_back({cpuid});
+            }
+        }
+        cores = cpus;
+    }
+
+    const int core_count = cores.size();
+    for (int g = 0; g < group_count; g++) {
+        std::vector<int> group;
+        for (int c = g * core_count / group_count; c < (g + 1) * core_count / group_count; c++) {
+            group.insert(group.end(), cores[c].begin(), cores[c].end());
+        }
+        cpu_groups.push_back(group);
+    }
+    return TNN_OK;
+}
+
 void CpuUtils::SetCpuDenormal(int denormal) {
 #if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
     if (denormal == 1) {
@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/gather_utils.h"
+
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+Status GetGatherShape(GatherLayerParam *param, const std::vector<Blob *> &inputs, DimsVector &data_dims,
+                      DimsVector &indices_dims, int &axis) {
+    if (param->data_in_resource && param->indices_in_resource) {
+        return Status(TNNERR_PARAM_ERR, "Gather needs the data or the indices as input");
+    }
+    const size_t input_count = (param->data_in_resource || param->indices_in_resource) ? 1 : 2;
+    if (inputs.size() < input_count) {
+        return Status(TNNERR_PARAM_ERR, "Gather has too few inputs");
+    }
+    data_dims    = param->data_in_resource ? param->data_dims : inputs[0]->GetBlobDesc().dims;
+    indices_dims = param->indices_in_resource ? param->indices_dims
+                                              : inputs[param->data_in_resource ? 0 : 1]->GetBlobDesc().dims;
+
+    const int rank = static_cast<int>(data_dims.size());
+    axis           = param->axis < 0 ? param->axis + rank : param->axis;
+    if (axis < 0 || axis >= rank) {
+        return Status(TNNERR_PARAM_ERR, "Gather axis is out of the rank of data");
+    }
+    return TNN_OK;
+}
+
+float *GetGatherData(GatherLayerParam *param, GatherLayerResource *resource, const std::vector<Blob *> &inputs) {
+    if (param->data_in_resource) {
+        return resource ? resource->data_handle.force_to<float *>() : nullptr;
+    }
+    return static_cast<float *>(inputs[0]->GetHandle().base);
+}
+
+Status GetGatherIndices(GatherLayerParam *param, GatherLayerResource *resource, const std::vector<Blob *> &inputs,
+                        int axis_dim, std::vector<int> &indices) {
+    int count = 0;
+    if (param->indices_in_resource) {
+        if (!resource || resource->indices_handle.GetDataType() != DATA_TYPE_INT32) {
+            return Status(TNNERR_MODEL_ERR, "Gather needs int32 indices in GatherLayerResource");
+        }
+        count           = resource->indices_handle.GetDataCount();
+        const int *data = resource->indices_handle.force_to<int *>();
+        indices.assign(data, data + count);
+    } else {
+        Blob *blob = inputs[param->data_in_resource ? 0 : 1];
+        count      = DimsVectorUtils::Count(blob->GetBlobDesc().dims);
+        indices.resize(count);
+        for (int i = 0; i < count; i++) {
+            indices[i] = blob->GetBlobDesc().data_type == DATA_TYPE_INT32
+                             ? static_cast<int32_t *>(blob->GetHandle().base)[i]
+                             : static_cast<int>(static_cast<float *>(blob->GetHandle().base)[i]);
+        }
+    }
+
+    for (auto &index : indices) {
+        index = index < 0 ? index + axis_dim : index;
+        if (index < 0 || index >= axis_dim) {
+            return Status(TNNERR_PARAM_ERR, "Gather index is out of range");
+        }
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,41 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_GATHER_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_GATHER_UTILS_H_
+
+#include <vector>
+
+#include "tnn/core/blob.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+
+namespace TNN_NS {
+
+// @brief dims of data and indices and the axis in [0, rank of data), a constant takes its dims from the param
+// and the input fills the other one
+Status GetGatherShape(GatherLayerParam *param, const std::vector<Blob *> &inputs, DimsVector &data_dims,
+                      DimsVector &indices_dims, int &axis);
+
+// @brief float data from the input or the resource
+float *GetGatherData(GatherLayerParam *param, GatherLayerResource *resource, const std::vector<Blob *> &inputs);
+
+// @brief indices from the input (int32 or float) or the resource, negative ones are moved into [0, axis_dim)
+Status GetGatherIndices(GatherLayerParam *param, GatherLayerResource *resource, const std::vector<Blob *> &inputs,
+                        int axis_dim, std::vector<int> &indices);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_GATHER_UTILS_H_
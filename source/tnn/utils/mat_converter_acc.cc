@@ -50,6 +50,10 @@ int MatConverterManager::RegisterMatConverterAccCreater(DeviceType type,
     return 0;
 }
 
+Status MatConverterAcc::Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue) {
+    return Status(TNNERR_PARAM_ERR, "MatConverterAcc::Preprocess, device type not support yet");
+}
+
 MatConverterManager::MatConverterManager() {}
 MatConverterManager::~MatConverterManager() {}
 
@@ -38,6 +38,8 @@ public:
     virtual Status WarpAffine(Mat& src, Mat& dst, WarpAffineParam param, void* command_queue = NULL)         = 0;
     virtual Status CvtColor(Mat& src, Mat& dst, ColorConversionType type, void* command_queue = NULL)        = 0;
     virtual Status CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, void* command_queue = NULL) = 0;
+    // fused preprocess, only host devices implement it
+    virtual Status Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue = NULL);
 };
 
 class MatConverterAccCreater {
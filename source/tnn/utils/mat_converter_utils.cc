@@ -16,6 +16,10 @@
 
 #include <climits>
 #include <algorithm>
+#include <string>
+#include <vector>
+
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
@@ -166,4 +170,387 @@ int GetMatElementSize(Mat* mat) {
     }
 }
 
+// the src of FusedPreprocess, kind is the channel of bgr(a) or gray pixels, 0 for yuv which is read as bgr
+struct PreprocessSrc {
+    const uint8_t* data;
+    int width;
+    int height;
+    int kind;
+    bool is_nv12;
+};
+
+// same formula as NaiveYUVToBGROrBGRA
+static inline void YUVToBGRFloat(int y, int u, int v, float* pixel) {
+    u = std::min(u, 240) - 128;
+    v = std::min(v, 240) - 128;
+    y = y * 74 - 1135;
+    pixel[0] = (float)std::min(std::max((y + 129 * u) >> 6, 0), 255);
+    pixel[1] = (float)std::min(std::max((y - 52 * v - 25 * u) >> 6, 0), 255);
+    pixel[2] = (float)std::min(std::max((y + 102 * v) >> 6, 0), 255);
+}
+
+static inline const uint8_t* GetVUPtr(const PreprocessSrc& src, int x, int y) {
+    return src.data + src.width * src.height + (y / 2) * src.width + (x & ~1);
+}
+
+template <int kind>
+static inline void LoadPixel(const PreprocessSrc& src, int x, int y, float* pixel) {
+    if (kind > 0) {
+        const uint8_t* ptr = src.data + (y * src.width + x) * kind;
+        for (int c = 0; c < kind; ++c) {
+            pixel[c] = ptr[c];
+        }
+    } else {
+        const uint8_t* vu = GetVUPtr(src, x, y);
+        YUVToBGRFloat(src.data[y * src.width + x], vu[src.is_nv12 ? 0 : 1], vu[src.is_nv12 ? 1 : 0], pixel);
+    }
+}
+
+// bilinear interpolation of the pixels at (x0, y0), (x1, y0), (x0, y1) and (x1, y1), all of them in src
+template <int kind>
+static inline void SampleLinear(const PreprocessSrc& src, int x0, int x1, int y0, int y1, float ax, float ay,
+                                float* pixel) {
+    const float w00 = (1 - ax) * (1 - ay), w01 = ax * (1 - ay);
+    const float w10 = (1 - ax) * ay, w11 = ax * ay;
+    if (kind > 0) {
+        const uint8_t* p00 = src.data + (y0 * src.width + x0) * kind;
+        const uint8_t* p01 = src.data + (y0 * src.width + x1) * kind;
+        const uint8_t* p10 = src.data + (y1 * src.width + x0) * kind;
+        const uint8_t* p11 = src.data + (y1 * src.width + x1) * kind;
+        for (int c = 0; c < kind; ++c) {
+            pixel[c] = w00 * p00[c] + w01 * p01[c] + w10 * p10[c] + w11 * p11[c];
+        }
+    } else {
+        // yuv is converted before interpolation, same as CvtColor followed by Resize
+        float p00[3], p01[3], p10[3], p11[3];
+        LoadPixel<kind>(src, x0, y0, p00);
+        LoadPixel<kind>(src, x1, y0, p01);
+        LoadPixel<kind>(src, x0, y1, p10);
+        LoadPixel<kind>(src, x1, y1, p11);
+        for (int c = 0; c < 3; ++c) {
+            pixel[c] = w00 * p00[c] + w01 * p01[c] + w10 * p10[c] + w11 * p11[c];
+        }
+    }
+}
+
+// bilinear interpolation at the edge of warp affine, neighbors out of src take border_val
+template <int kind>
+static inline void SampleLinearBorder(const PreprocessSrc& src, int x0, int y0, float ax, float ay, float border_val,
+                                      float* pixel) {
+    const float weight[4] = {(1 - ax) * (1 - ay), ax * (1 - ay), (1 - ax) * ay, ax * ay};
+    const int channel     = kind > 0 ? kind : 3;
+    for (int c = 0; c < channel; ++c) {
+        pixel[c] = 0;
+    }
+    for (int i = 0; i < 4; ++i) {
+        int x = x0 + (i & 1);
+        int y = y0 + (i >> 1);
+        float neighbor[4] = {border_val, border_val, border_val, border_val};
+        if (x >= 0 && x < src.width && y >= 0 && y < src.height) {
+            LoadPixel<kind>(src, x, y, neighbor);
+        }
+        for (int c = 0; c < channel; ++c) {
+            pixel[c] += weight[i] * neighbor[c];
+        }
+    }
+}
+
+struct PreprocessDst {
+    float* data[4];
+    int channel;
+    int c_offset[4];
+    const float* scale;
+    const float* bias;
+};
+
+static inline void StorePixel(const PreprocessDst& dst, int x, const float* pixel) {
+    for (int c = 0; c < dst.channel; ++c) {
+        dst.data[c][x] = dst.scale[c] * pixel[dst.c_offset[c]] + dst.bias[c];
+    }
+}
+
+static inline void StoreBorder(const PreprocessDst& dst, int begin, int end, float border_val) {
+    for (int c = 0; c < dst.channel; ++c) {
+        const float value = dst.scale[c] * border_val + dst.bias[c];
+        std::fill(dst.data[c] + begin, dst.data[c] + end, value);
+    }
+}
+
+// source position of dst pixels along one axis, pixel centers are aligned as in Resize and
+// positions are clamped to the crop region
+struct ResizeAxisTab {
+    std::vector<int> pos0;
+    std::vector<int> pos1;
+    std::vector<float> alpha;
+};
+
+static void GetResizeAxisTab(int dst_len, int crop_begin, int crop_len, bool is_linear, ResizeAxisTab& tab) {
+    tab.pos0.resize(dst_len);
+    tab.pos1.resize(dst_len);
+    tab.alpha.resize(dst_len);
+    const double scale = (double)crop_len / dst_len;
+    for (int i = 0; i < dst_len; ++i) {
+        tab.pos0[i] = 0;
+        float alpha = 0.f;
+        if (crop_len > 1) {
+            alpha = CalculatePosition(tab.pos0.data(), i, scale, crop_len, 1);
+        }
+        int pos1 = std::min(tab.pos0[i] + 1, crop_len - 1);
+        if (!is_linear) {
+            // nearest takes the left pixel up to a ratio of 0.5, as the mask of ResizeNearest
+            tab.pos0[i] = alpha <= 0.5f ? tab.pos0[i] : pos1;
+            pos1        = tab.pos0[i];
+            alpha       = 0.f;
+        }
+        tab.pos0[i] += crop_begin;
+        tab.pos1[i]  = crop_begin + pos1;
+        tab.alpha[i] = alpha;
+    }
+}
+
+template <int kind>
+static void PreprocessResizeRowNaiveImpl(const PreprocessResizeRowParam& param) {
+    float pixel[4];
+    for (int i = 0; i < param.count; ++i) {
+        const int x0 = param.pos0[i], x1 = param.pos1[i];
+        const float ax = param.alpha[i];
+        if (kind > 0) {
+            for (int c = 0; c < kind; ++c) {
+                float p00 = param.row0[x0 * kind + c], p01 = param.row0[x1 * kind + c];
+                float p10 = param.row1[x0 * kind + c], p11 = param.row1[x1 * kind + c];
+                float top = p00 + ax * (p01 - p00);
+                float bot = p10 + ax * (p11 - p10);
+                pixel[c]  = top + param.ay * (bot - top);
+            }
+        } else {
+            // yuv is converted before interpolation, same as CvtColor followed by Resize
+            const int u = param.is_nv12 ? 0 : 1, v = 1 - u;
+            float p00[3], p01[3], p10[3], p11[3];
+            YUVToBGRFloat(param.row0[x0], param.vu0[(x0 & ~1) + u], param.vu0[(x0 & ~1) + v], p00);
+            YUVToBGRFloat(param.row0[x1], param.vu0[(x1 & ~1) + u], param.vu0[(x1 & ~1) + v], p01);
+            YUVToBGRFloat(param.row1[x0], param.vu1[(x0 & ~1) + u], param.vu1[(x0 & ~1) + v], p10);
+            YUVToBGRFloat(param.row1[x1], param.vu1[(x1 & ~1) + u], param.vu1[(x1 & ~1) + v], p11);
+            for (int c = 0; c < 3; ++c) {
+                float top = p00[c] + ax * (p01[c] - p00[c]);
+                float bot = p10[c] + ax * (p11[c] - p10[c]);
+                pixel[c]  = top + param.ay * (bot - top);
+            }
+        }
+        for (int c = 0; c < param.channel; ++c) {
+            param.dst[c][i] = param.scale[c] * pixel[param.c_offset[c]] + param.bias[c];
+        }
+    }
+}
+
+void PreprocessResizeRowNaive(const PreprocessResizeRowParam& param) {
+    if (param.kind == 1) {
+        PreprocessResizeRowNaiveImpl<1>(param);
+    } else if (param.kind == 3) {
+        PreprocessResizeRowNaiveImpl<3>(param);
+    } else if (param.kind == 4) {
+        PreprocessResizeRowNaiveImpl<4>(param);
+    } else {
+        PreprocessResizeRowNaiveImpl<0>(param);
+    }
+}
+
+template <int kind>
+static void PreprocessResizeRow(const PreprocessSrc& src, const PreprocessDst& dst, const ResizeAxisTab& x_tab,
+                                const ResizeAxisTab& y_tab, int inner_x, int y, bool is_linear,
+                                PreprocessResizeRowFunc resize_row) {
+    float pixel[4];
+    const int y0 = y_tab.pos0[y], y1 = y_tab.pos1[y];
+    const int count = (int)x_tab.pos0.size();
+    if (is_linear) {
+        const int channel = kind > 0 ? kind : 1;
+        const uint8_t* vu = src.data + src.width * src.height;
+        PreprocessResizeRowParam param;
+        param.row0      = src.data + y0 * src.width * channel;
+        param.row1      = src.data + y1 * src.width * channel;
+        param.vu0       = vu + (y0 / 2) * src.width;
+        param.vu1       = vu + (y1 / 2) * src.width;
+        param.is_nv12   = src.is_nv12;
+        param.kind      = kind;
+        param.src_width = src.width;
+        param.pos0      = x_tab.pos0.data();
+        param.pos1      = x_tab.pos1.data();
+        param.alpha     = x_tab.alpha.data();
+        param.ay        = y_tab.alpha[y];
+        param.count     = count;
+        param.channel   = dst.channel;
+        param.c_offset  = dst.c_offset;
+        param.scale     = dst.scale;
+        param.bias      = dst.bias;
+        for (int c = 0; c < dst.channel; ++c) {
+            param.dst[c] = dst.data[c] + inner_x;
+        }
+        resize_row(param);
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        LoadPixel<kind>(src, x_tab.pos0[i], y0, pixel);
+        StorePixel(dst, inner_x + i, pixel);
+    }
+}
+
+static inline int RoundToInt(double x) {
+    return (int)(x + (x >= 0 ? 0.5 : -0.5));
+}
+
+// source positions are computed in the fixed point of WarpAffine, 10 bits of fraction rounded to 1/32 of
+// a pixel, so that the fused pass samples the same pixels
+template <int kind>
+static void PreprocessWarpAffineRow(const PreprocessSrc& src, const PreprocessDst& dst, const double* m, int width,
+                                    int y, bool is_linear, float border_val) {
+    float pixel[4];
+    const int channel = kind > 0 ? kind : 3;
+    const int sx_base = RoundToInt((y * m[1] + m[2]) * 1024) + 16;
+    const int sy_base = RoundToInt((y * m[4] + m[5]) * 1024) + 16;
+    for (int x = 0; x < width; ++x) {
+        const int sx = RoundToInt(m[0] * x * 1024) + sx_base;
+        const int sy = RoundToInt(m[3] * x * 1024) + sy_base;
+        const int x0 = sx >> 10;
+        const int y0 = sy >> 10;
+        const int tx = (sx >> 5) & 31;
+        const int ty = (sy >> 5) & 31;
+        for (int c = 0; c < channel; ++c) {
+            pixel[c] = border_val;
+        }
+        if (is_linear) {
+            const float ax = tx / 32.f;
+            const float ay = ty / 32.f;
+            if (x0 >= 0 && x0 + 1 < src.width && y0 >= 0 && y0 + 1 < src.height) {
+                SampleLinear<kind>(src, x0, x0 + 1, y0, y0 + 1, ax, ay, pixel);
+            } else if (x0 >= -1 && x0 < src.width && y0 >= -1 && y0 < src.height) {
+                SampleLinearBorder<kind>(src, x0, y0, ax, ay, border_val, pixel);
+            }
+        } else {
+            const int xi = x0 + (tx >= 16);
+            const int yi = y0 + (ty >= 16);
+            if (xi >= 0 && xi < src.width && yi >= 0 && yi < src.height) {
+                LoadPixel<kind>(src, xi, yi, pixel);
+            }
+        }
+        StorePixel(dst, x, pixel);
+    }
+}
+
+template <int kind>
+static void FusedPreprocessImpl(const PreprocessSrc& source, Mat& dst, const PreprocessParam& param,
+                                const PreprocessDst& planes, PreprocessResizeRowFunc resize_row) {
+    const int batch      = dst.GetBatch();
+    const int height     = dst.GetHeight();
+    const int width      = dst.GetWidth();
+    const int plane_size = height * width;
+    const int src_size   = kind > 0 ? source.width * source.height * kind : source.width * source.height * 3 / 2;
+
+    const bool use_warp_affine = param.use_warp_affine;
+    const bool is_linear       = (use_warp_affine ? param.warp_affine.interp_type : param.interp_type) ==
+                                 INTERP_TYPE_LINEAR;
+    const float border_val     = use_warp_affine ? param.warp_affine.border_val : param.border.border_val;
+
+    // inverse map from dst (x, y) to src: (x * m[0] + y * m[1] + m[2], x * m[3] + y * m[4] + m[5])
+    double m[6];
+    ResizeAxisTab x_tab, y_tab;
+    const int inner_x = use_warp_affine ? 0 : param.border.left;
+    const int inner_y = use_warp_affine ? 0 : param.border.top;
+    const int inner_w = use_warp_affine ? width : width - param.border.left - param.border.right;
+    const int inner_h = use_warp_affine ? height : height - param.border.top - param.border.bottom;
+    if (use_warp_affine) {
+        WarpAffineMatrixInverse(param.warp_affine.transform, m);
+    } else {
+        GetResizeAxisTab(inner_w, param.crop.top_left_x, param.crop.width, is_linear, x_tab);
+        GetResizeAxisTab(inner_h, param.crop.top_left_y, param.crop.height, is_linear, y_tab);
+    }
+
+    OMP_PARALLEL_FOR_
+    for (int r = 0; r < batch * height; ++r) {
+        const int n       = r / height;
+        const int y       = r % height;
+        PreprocessSrc src = source;
+        src.data          = source.data + (size_t)n * src_size;
+        PreprocessDst row = planes;
+        for (int c = 0; c < planes.channel; ++c) {
+            row.data[c] = planes.data[c] + (size_t)n * planes.channel * plane_size + y * width;
+        }
+
+        if (use_warp_affine) {
+            PreprocessWarpAffineRow<kind>(src, row, m, width, y, is_linear, border_val);
+        } else if (y < inner_y || y >= inner_y + inner_h) {
+            StoreBorder(row, 0, width, border_val);
+        } else {
+            StoreBorder(row, 0, inner_x, border_val);
+            PreprocessResizeRow<kind>(src, row, x_tab, y_tab, inner_x, y - inner_y, is_linear, resize_row);
+            StoreBorder(row, inner_x + inner_w, width, border_val);
+        }
+    }
+}
+
+Status FusedPreprocess(Mat& src, Mat& dst, const PreprocessParam& param, PreprocessResizeRowFunc resize_row) {
+    PreprocessSrc source;
+    source.data    = reinterpret_cast<const uint8_t*>(src.GetData());
+    source.width   = src.GetWidth();
+    source.height  = src.GetHeight();
+    source.is_nv12 = src.GetMatType() == NNV12;
+    int src_channel;
+    switch (src.GetMatType()) {
+        case NGRAY:
+            source.kind = src_channel = 1;
+            break;
+        case N8UC3:
+            source.kind = src_channel = 3;
+            break;
+        case N8UC4:
+            source.kind = src_channel = 4;
+            break;
+        case NNV12:
+        case NNV21:
+            source.kind = 0;
+            src_channel = 3;
+            if (source.width % 2 || source.height % 2) {
+                return Status(TNNERR_PARAM_ERR, "FusedPreprocess, yuv size can not be odd");
+            }
+            break;
+        default:
+            return Status(TNNERR_PARAM_ERR, "FusedPreprocess, src mat type not support yet");
+    }
+
+    const int channel = dst.GetChannel();
+    if (channel != src_channel && !(src_channel == 4 && channel == 3)) {
+        return Status(TNNERR_PARAM_ERR, "FusedPreprocess, dst channel not match src mat type");
+    }
+    if (channel == 1 && param.convert_param.reverse_channel) {
+        return Status(TNNERR_PARAM_ERR, "reverse type not support yet, mat type: " + std::to_string(NGRAY));
+    }
+
+    PreprocessDst planes;
+    planes.channel = channel;
+    planes.scale   = param.convert_param.scale.data();
+    planes.bias    = param.convert_param.bias.data();
+    for (int c = 0; c < 4; ++c) {
+        planes.data[c]     = reinterpret_cast<float*>(dst.GetData()) + c * dst.GetHeight() * dst.GetWidth();
+        planes.c_offset[c] = c;
+    }
+    // dst plane c takes channel c_offset[c] of the bgr(a) pixel
+    if (param.convert_param.reverse_channel) {
+        std::swap(planes.c_offset[0], planes.c_offset[2]);
+    }
+
+    switch (source.kind) {
+        case 1:
+            FusedPreprocessImpl<1>(source, dst, param, planes, resize_row);
+            break;
+        case 3:
+            FusedPreprocessImpl<3>(source, dst, param, planes, resize_row);
+            break;
+        case 4:
+            FusedPreprocessImpl<4>(source, dst, param, planes, resize_row);
+            break;
+        default:
+            FusedPreprocessImpl<0>(source, dst, param, planes, resize_row);
+            break;
+    }
+    return TNN_OK;
+}
+
 }  // namespace TNN_NS
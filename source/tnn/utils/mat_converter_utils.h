@@ -20,6 +20,7 @@
 #include "tnn/core/macro.h"
 #include "tnn/core/status.h"
 #include "tnn/core/mat.h"
+#include "tnn/utils/mat_utils.h"
 
 namespace TNN_NS {
 
@@ -56,6 +57,38 @@ void WarpAffineMatrixInverse(const float (*transform)[3], double* inverse);
 
 int GetMatElementSize(Mat* mat);
 
+// one dst row of the linear resize in FusedPreprocess: pixels of two src rows are interpolated at columns pos0
+// and pos1 with weights alpha and ay, then scaled and written to the dst planes in c_offset order.
+// kind is the channel of bgr(a) or gray pixels, 0 for yuv with y rows row0, row1 and vu rows vu0, vu1
+struct PreprocessResizeRowParam {
+    const uint8_t* row0;
+    const uint8_t* row1;
+    const uint8_t* vu0;
+    const uint8_t* vu1;
+    bool is_nv12;
+    int kind;
+    int src_width;
+    const int* pos0;
+    const int* pos1;
+    const float* alpha;
+    float ay;
+    int count;
+    float* dst[4];
+    int channel;
+    const int* c_offset;
+    const float* scale;
+    const float* bias;
+};
+
+typedef void (*PreprocessResizeRowFunc)(const PreprocessResizeRowParam& param);
+
+void PreprocessResizeRowNaive(const PreprocessResizeRowParam& param);
+
+// crop, resize or warp affine, border, yuv to bgr and normalize src into the NCHW_FLOAT dst in one pass over dst
+// rows, param must be checked by MatUtils::Preprocess. devices pass a simd resize_row for the common case
+Status FusedPreprocess(Mat& src, Mat& dst, const PreprocessParam& param,
+                       PreprocessResizeRowFunc resize_row = PreprocessResizeRowNaive);
+
 }  // namespace TNN_NS
 
 #endif
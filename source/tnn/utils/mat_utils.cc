@@ -213,6 +213,57 @@ Status MatUtils::CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, v
     return converter->CopyMakeBorder(src, dst, param, command_queue);
 }
 
+Status MatUtils::Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue) {
+    auto ret = CheckSrcAndDstMat(src, dst, true, false, true);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    if (dst.GetMatType() != NCHW_FLOAT) {
+        return Status(TNNERR_PARAM_ERR, "preprocess dst mat type must be NCHW_FLOAT");
+    }
+    if (dst.GetDims().size() != 4 || dst.GetWidth() <= 0 || dst.GetHeight() <= 0) {
+        return Status(TNNERR_PARAM_ERR, "preprocess dst size is zero or negnative");
+    }
+    if (dst.GetBatch() != src.GetBatch()) {
+        return Status(TNNERR_PARAM_ERR, "src and dst batch not equal");
+    }
+    if (param.convert_param.scale.size() < dst.GetChannel() || param.convert_param.bias.size() < dst.GetChannel()) {
+        return Status(TNNERR_PARAM_ERR, "preprocess scale bias not match dst channel");
+    }
+
+    if (param.use_warp_affine) {
+        if (param.warp_affine.border_type != BORDER_TYPE_CONSTANT) {
+            return Status(TNNERR_PARAM_ERR, "preprocess warpaffine border type not support yet");
+        }
+    } else {
+        auto& crop = param.crop;
+        if (crop.width <= 0 || crop.height <= 0) {
+            crop.top_left_x = 0;
+            crop.top_left_y = 0;
+            crop.width      = src.GetWidth();
+            crop.height     = src.GetHeight();
+        }
+        if (crop.top_left_x < 0 || crop.top_left_y < 0 || crop.top_left_x + crop.width > src.GetWidth() ||
+            crop.top_left_y + crop.height > src.GetHeight()) {
+            return Status(TNNERR_PARAM_ERR, "preprocess crop region out of src");
+        }
+        auto& border = param.border;
+        if (border.top < 0 || border.bottom < 0 || border.left < 0 || border.right < 0) {
+            return Status(TNNERR_PARAM_ERR, "border size is negnative");
+        }
+        if (border.border_type != BORDER_TYPE_CONSTANT) {
+            return Status(TNNERR_PARAM_ERR, "preprocess border type not support yet");
+        }
+        if (border.top + border.bottom >= dst.GetHeight() || border.left + border.right >= dst.GetWidth()) {
+            return Status(TNNERR_PARAM_ERR, "preprocess border leaves no room for the resized image");
+        }
+    }
+
+    MAT_CONVERTER_PREPARATION(src.GetDeviceType());
+    return converter->Preprocess(src, dst, param, command_queue);
+}
+
 #undef CHECK_DST_DATA_NULL
 #undef MAT_CONVERTER_PREPARATION
 
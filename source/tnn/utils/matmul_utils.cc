@@ -0,0 +1,95 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/matmul_utils.h"
+
+#include <algorithm>
+
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+Status GetMatMulShape(const DimsVector &a_dims, const DimsVector &b_dims, MatMulShape &shape) {
+    if (a_dims.empty() || b_dims.empty()) {
+        return Status(TNNERR_PARAM_ERR, "MatMul has empty input dims");
+    }
+    DimsVector a = a_dims.size() == 1 ? DimsVector({1, a_dims[0]}) : a_dims;
+    DimsVector b = b_dims.size() == 1 ? DimsVector({b_dims[0], 1}) : b_dims;
+    shape.M      = a[a.size() - 2];
+    shape.K      = a[a.size() - 1];
+    shape.N      = b[b.size() - 1];
+    if (b[b.size() - 2] != shape.K) {
+        return Status(TNNERR_PARAM_ERR, "MatMul has mismatched K of A and B");
+    }
+
+    // batch dims aligned to the right
+    const int batch_rank = static_cast<int>(std::max(a.size(), b.size())) - 2;
+    DimsVector a_batch(batch_rank, 1), b_batch(batch_rank, 1), batch_dims(batch_rank, 1);
+    std::copy(a.begin(), a.end() - 2, a_batch.end() - (a.size() - 2));
+    std::copy(b.begin(), b.end() - 2, b_batch.end() - (b.size() - 2));
+    for (int i = 0; i < batch_rank; i++) {
+        if (a_batch[i] != b_batch[i] && a_batch[i] != 1 && b_batch[i] != 1) {
+            return Status(TNNERR_PARAM_ERR, "MatMul batch dims can not broadcast");
+        }
+        batch_dims[i] = std::max(a_batch[i], b_batch[i]);
+    }
+
+    const int batch = DimsVectorUtils::Count(batch_dims);
+    shape.a_index.resize(batch);
+    shape.b_index.resize(batch);
+    for (int n = 0; n < batch; n++) {
+        int a_offset = 0, b_offset = 0, rest = n;
+        int a_stride = 1, b_stride = 1;
+        for (int i = batch_rank - 1; i >= 0; i--) {
+            int index = rest % batch_dims[i];
+            rest /= batch_dims[i];
+            a_offset += (a_batch[i] == 1 ? 0 : index) * a_stride;
+            b_offset += (b_batch[i] == 1 ? 0 : index) * b_stride;
+            a_stride *= a_batch[i];
+            b_stride *= b_batch[i];
+        }
+        shape.a_index[n] = a_offset;
+        shape.b_index[n] = b_offset;
+    }
+
+    shape.output_dims = batch_dims;
+    if (a_dims.size() > 1) {
+        shape.output_dims.push_back(shape.M);
+    }
+    if (b_dims.size() > 1) {
+        shape.output_dims.push_back(shape.N);
+    }
+    return TNN_OK;
+}
+
+Status GetMatMulInputDims(MatMulLayerParam *param, const std::vector<Blob *> &inputs, DimsVector &a_dims,
+                          DimsVector &b_dims) {
+    const size_t input_count = param->weight_position == -1 ? 2 : 1;
+    if (inputs.size() < input_count) {
+        return Status(TNNERR_PARAM_ERR, "MatMul has too few inputs");
+    }
+    if (param->weight_position == 0) {
+        a_dims = param->weight_dims;
+        b_dims = inputs[0]->GetBlobDesc().dims;
+    } else if (param->weight_position == 1) {
+        a_dims = inputs[0]->GetBlobDesc().dims;
+        b_dims = param->weight_dims;
+    } else {
+        a_dims = inputs[0]->GetBlobDesc().dims;
+        b_dims = inputs[1]->GetBlobDesc().dims;
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,46 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_MATMUL_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_MATMUL_UTILS_H_
+
+#include <vector>
+
+#include "tnn/core/blob.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/layer_param.h"
+
+namespace TNN_NS {
+
+// @brief shape of A [..., M, K] x B [..., K, N] with numpy broadcast of the batch dims. as onnx does, a 1-d A is
+// [1, K] and a 1-d B is [K, 1], and the dim is dropped from the output.
+struct MatMulShape {
+    int M = 0;
+    int N = 0;
+    int K = 0;
+    DimsVector output_dims;
+    // the matrix of A and of B that each output matrix reads
+    std::vector<int> a_index;
+    std::vector<int> b_index;
+};
+
+Status GetMatMulShape(const DimsVector &a_dims, const DimsVector &b_dims, MatMulShape &shape);
+
+// @brief dims of A and B, the constant of weight_position takes weight_dims and the inputs fill the others in order
+Status GetMatMulInputDims(MatMulLayerParam *param, const std::vector<Blob *> &inputs, DimsVector &a_dims,
+                          DimsVector &b_dims);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_MATMUL_UTILS_H_
@@ -184,6 +184,8 @@ void FloatActivate(Tacc &result, const int activation_type) {
         }
     } else if(activation_type == ActivationType_SIGMOID_MUL) {
         result = 1.0f / (1.0f + exp(-result)) * result;
+    } else if (activation_type == ActivationType_HARDSWISH) {
+        result = result * std::min(std::max(result / 6.0f + 0.5f, 0.0f), 1.0f);
     }
 }
 
@@ -257,7 +259,13 @@ void NaiveConv(void *input_ptr, void *output_ptr, void *weight_ptr, void *bias,
                             result += bias_data[output_c];
                         }
                         if (sizeof(Tin) > 1) {  // float
+                            if (fusion_type == FusionType_Conv_Add_Activation) {
+                                result += static_cast<Tout *>(add_input)[output_position];
+                            }
                             FloatActivate(result, activation_type);
+                            if (fusion_type == FusionType_Conv_Activation_Add) {
+                                result += static_cast<Tout *>(add_input)[output_position];
+                            }
                             output_data[output_position] = result;
                         } else {
                             int scaleidx = scale_len == 1 ? 0 : output_c;
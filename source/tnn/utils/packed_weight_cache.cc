@@ -0,0 +1,86 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/packed_weight_cache.h"
+
+#include "tnn/utils/string_utils_inner.h"
+
+namespace TNN_NS {
+
+std::mutex PackedWeightCache::mutex_;
+
+std::map<std::string, std::weak_ptr<RawBuffer>> &PackedWeightCache::GetPackedWeightMap() {
+    static std::map<std::string, std::weak_ptr<RawBuffer>> packed_weight_map;
+    return packed_weight_map;
+}
+
+std::string PackedWeightCache::GetKey(const std::string &model_md5, const std::string &layer_name, DeviceType device,
+                                      const std::string &variant) {
+    if (model_md5.empty() || layer_name.empty()) {
+        return "";
+    }
+    return model_md5 + "/" + layer_name + "/" + ToString(device) + "/" + variant;
+}
+
+// the buffer aliases the cached one, the entry expires with the last acc holding it
+static RawBuffer ShareRawBuffer(std::shared_ptr<RawBuffer> holder) {
+    RawBuffer buffer(holder->GetBytesSize(), std::shared_ptr<char>(holder, holder->force_to<char *>()));
+    buffer.SetDataType(holder->GetDataType());
+    return buffer;
+}
+
+Status PackedWeightCache::Get(const std::string &key, RawBuffer &buffer,
+                              const std::function<Status(RawBuffer &)> &pack) {
+    if (key.empty()) {
+        return pack(buffer);
+    }
+
+    auto &packed_weight_map = GetPackedWeightMap();
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto iter = packed_weight_map.find(key);
+        if (iter != packed_weight_map.end()) {
+            auto holder = iter->second.lock();
+            if (holder) {
+                buffer = ShareRawBuffer(holder);
+                return TNN_OK;
+            }
+        }
+    }
+
+    // pack without the lock, instances initialized at the same time may pack the same layer twice
+    RawBuffer packed;
+    RETURN_ON_NEQ(pack(packed), TNN_OK);
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto &entry = packed_weight_map[key];
+    auto holder = entry.lock();
+    if (!holder) {
+        holder = std::make_shared<RawBuffer>(packed);
+        entry  = holder;
+    }
+    buffer = ShareRawBuffer(holder);
+
+    // drop the entries of the released models
+    for (auto iter = packed_weight_map.begin(); iter != packed_weight_map.end();) {
+        if (iter->second.expired()) {
+            iter = packed_weight_map.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,53 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_PACKED_WEIGHT_CACHE_H_
+#define TNN_SOURCE_TNN_UTILS_PACKED_WEIGHT_CACHE_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/raw_buffer.h"
+
+namespace TNN_NS {
+
+// Process wide cache of the packed weights, shared read only by the instances of one model.
+// An entry lives as long as some layer acc holds its buffer.
+class PackedWeightCache {
+public:
+    // @brief key of the packed weight, empty if the model md5 or the layer name is unknown
+    // @param model_md5 md5 of the model, see Context::GetModelMd5
+    // @param layer_name name of the layer
+    // @param device device of the layer acc
+    // @param variant packing layout, everything the packed bytes depend on besides the model weights
+    static std::string GetKey(const std::string &model_md5, const std::string &layer_name, DeviceType device,
+                              const std::string &variant);
+
+    // @brief fill buffer with the packed weight of key, pack is only called if no acc holds it.
+    // the buffer must not be written after, an empty key packs without sharing.
+    static Status Get(const std::string &key, RawBuffer &buffer, const std::function<Status(RawBuffer &)> &pack);
+
+private:
+    static std::map<std::string, std::weak_ptr<RawBuffer>> &GetPackedWeightMap();
+    static std::mutex mutex_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_PACKED_WEIGHT_CACHE_H_
@@ -0,0 +1,47 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/rnn_utils.h"
+
+#include <algorithm>
+
+namespace TNN_NS {
+
+std::vector<int> GetRNNSequenceLens(RNNLayerParam *param, const std::vector<Blob *> &inputs) {
+    const int sequence = inputs[0]->GetBlobDesc().dims[0];
+    const int batch    = inputs[0]->GetBlobDesc().dims[1];
+    std::vector<int> sequence_lens(batch, sequence);
+    if (!param->has_sequence_lens || inputs.size() < 2) {
+        return sequence_lens;
+    }
+
+    auto &desc = inputs[1]->GetBlobDesc();
+    void *data = inputs[1]->GetHandle().base;
+    for (int n = 0; n < batch; n++) {
+        int len = desc.data_type == DATA_TYPE_INT32 ? static_cast<int32_t *>(data)[n]
+                                                    : static_cast<int>(static_cast<float *>(data)[n]);
+        sequence_lens[n] = std::min(std::max(len, 0), sequence);
+    }
+    return sequence_lens;
+}
+
+float *GetRNNInitialState(RNNLayerParam *param, const std::vector<Blob *> &inputs, int state_index) {
+    size_t index = 1 + (param->has_sequence_lens ? 1 : 0) + state_index;
+    if (index >= inputs.size()) {
+        return nullptr;
+    }
+    return static_cast<float *>(inputs[index]->GetHandle().base);
+}
+
+}  // namespace TNN_NS
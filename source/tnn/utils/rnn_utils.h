@@ -0,0 +1,34 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_RNN_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_RNN_UTILS_H_
+
+#include <vector>
+
+#include "tnn/core/blob.h"
+#include "tnn/interpreter/layer_param.h"
+
+namespace TNN_NS {
+
+// @brief valid steps of each batch for Lstm and Gru, the sequence length T without sequence_lens.
+// sequence_lens is read as int32 or float as its blob tells, and clamped to [0, T].
+std::vector<int> GetRNNSequenceLens(RNNLayerParam *param, const std::vector<Blob *> &inputs);
+
+// @brief data of initial_h (state_index 0) or initial_c (state_index 1), nullptr if the input is omitted
+float *GetRNNInitialState(RNNLayerParam *param, const std::vector<Blob *> &inputs, int state_index);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_RNN_UTILS_H_
@@ -34,6 +34,17 @@ std::string DoubleToStringFilter(double val) {
     }
 }
 
+std::string JsonString(const std::string &str) {
+    std::string escaped = "\"";
+    for (auto c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
 struct CmpByValue {
     bool operator()(const std::pair<std::string, std::vector<float>> &lhs,
                     const std::pair<std::string, std::vector<float>> &rhs) {
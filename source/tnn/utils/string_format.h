@@ -28,6 +28,9 @@ std::string DoubleToString(double val);
 
 std::string DoubleToStringFilter(double val);
 
+// @brief the string as a quoted json string, quotes and backslashes are escaped
+std::string JsonString(const std::string &str);
+
 template <typename Int>
 std::string IntToString(Int val) {
     static_assert(std::is_integral<Int>::value, "Integral type required!");
@@ -58,4 +58,10 @@ DEFINE_string(sc, "", scale_message);
 
 DEFINE_string(bi, "", bias_message);
 
+DEFINE_string(pp, "", profile_path_message);
+
+DEFINE_string(ubt, "", unit_test_benchmark_threads_message);
+
+DEFINE_string(ubo, "", unit_test_benchmark_output_message);
+
 }  // namespace TNN_NS
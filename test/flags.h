@@ -22,7 +22,7 @@ namespace TNN_NS {
 
 static const char help_message[] = "print a usage message.";
 
-static const char model_type_message[] = "specify model type: TNN, OPENVINO, COREML, SNPE, NCNN, RKCACHE.";
+static const char model_type_message[] = "specify model type: TNN, TNN_MMAP, OPENVINO, COREML, SNPE, NCNN, RKCACHE.";
 
 static const char model_path_message[] =
     "specify model path: tnn proto path, openvino xml path, coreml "
@@ -67,6 +67,14 @@ static const char scale_message[] = "input scale: s0,s1,s2,...)";
 
 static const char bias_message[] = "input bias: b0,b1,b2,...)";
 
+static const char unit_test_benchmark_threads_message[] = "thread counts swept by the unit benchmark(eg: 1,2,4)";
+
+static const char unit_test_benchmark_output_message[] =
+    "unit benchmark result path, one json line per layer test and thread count is appended";
+
+static const char profile_path_message[] =
+    "profile export path prefix, writes prefix.trace.json, prefix.csv and prefix.json (needs TNN_PROFILE)";
+
 DECLARE_bool(h);
 
 DECLARE_string(mt);
@@ -109,6 +117,12 @@ DECLARE_string(sc);
 
 DECLARE_string(bi);
 
+DECLARE_string(pp);
+
+DECLARE_string(ubt);
+
+DECLARE_string(ubo);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_TEST_FLAGS_H_
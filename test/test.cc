@@ -152,6 +152,12 @@ namespace test {
             }
 #if TNN_PROFILE
             instance->FinishProfile(true);
+            if (!FLAGS_pp.empty()) {
+                ret = instance->ExportProfile(FLAGS_pp);
+                if (!CheckResult("ExportProfile", ret)) {
+                    return ret;
+                }
+            }
 #endif
             if (!FLAGS_op.empty()) {
                 WriteOutput(output_mat_map);
@@ -210,6 +216,7 @@ namespace test {
         printf("    -et \"<enable tune>\t%s \n", enable_tune_message);
         printf("    -sc \"<input scale>\t%s \n", scale_message);
         printf("    -bi \"<input bias>\t%s \n", bias_message);
+        printf("    -pp \"<profile path>\t%s \n", profile_path_message);
     }
 
     void SetCpuAffinity() {
@@ -262,14 +269,14 @@ namespace test {
         ModelConfig config;
         config.model_type = ConvertModelType(FLAGS_mt);
         if (config.model_type == MODEL_TYPE_TNN || config.model_type == MODEL_TYPE_OPENVINO ||
-            config.model_type == MODEL_TYPE_NCNN) {
+            config.model_type == MODEL_TYPE_NCNN || config.model_type == MODEL_TYPE_TNN_MMAP) {
             std::string network_path = FLAGS_mp;
             int size                 = static_cast<int>(network_path.size());
             std::string model_path;
             
             // TNN file names: xxx.tnnproto  xxx.tnnmodel
             // NCNN file names: xxx.param xxx.bin
-            if (config.model_type == MODEL_TYPE_TNN) {
+            if (config.model_type == MODEL_TYPE_TNN || config.model_type == MODEL_TYPE_TNN_MMAP) {
                 model_path = network_path.substr(0, size - 5) + "model";
             } else if (config.model_type == MODEL_TYPE_NCNN) {
                 model_path = network_path.substr(0, size - 5) + "bin";
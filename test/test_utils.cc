@@ -54,6 +54,8 @@ ModelType ConvertModelType(std::string model_type) {
         return MODEL_TYPE_NCNN;
     } else if ("RKCACHE" == model_type) {
         return MODEL_TYPE_RKCACHE;
+    } else if ("TNN_MMAP" == model_type) {
+        return MODEL_TYPE_TNN_MMAP;
     } else {
         return MODEL_TYPE_TNN;
     }
@@ -14,6 +14,7 @@
 
 #include "test/timer.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace TNN_NS {
@@ -39,6 +40,7 @@ void Timer::Stop() {
     max_         = static_cast<float>(fmax(max_, delta));
     sum_ += delta;
     count_++;
+    samples_.push_back(delta);
 }
 
 void Timer::Reset() {
@@ -46,8 +48,19 @@ void Timer::Reset() {
     max_ = FLT_MIN;
     sum_ = 0.0f;
     count_ = 0;
+    samples_.clear();
     stop_ = start_ = system_clock::now();
 }
+
+float Timer::Percentile(float p) {
+    if (samples_.empty()) {
+        return 0.0f;
+    }
+    std::vector<float> sorted = samples_;
+    std::sort(sorted.begin(), sorted.end());
+    int rank = static_cast<int>(ceil(p / 100.0f * sorted.size()));
+    return sorted[std::min(std::max(rank, 1), (int)sorted.size()) - 1];
+}
    
 void Timer::Print() {
     char min_str[16];
@@ -56,8 +69,13 @@ void Timer::Print() {
     snprintf(max_str, 16, "%6.3f", max_);
     char avg_str[16];
     snprintf(avg_str, 16, "%6.3f", sum_ / (float)count_);
-    LOGI("%-45s TNN Benchmark time cost: min = %-8s ms  |  max = %-8s ms  |  avg = %-8s ms \n", timer_info_.c_str(),
-         min_str, max_str, avg_str);
+    char p50_str[16];
+    snprintf(p50_str, 16, "%6.3f", Percentile(50));
+    char p99_str[16];
+    snprintf(p99_str, 16, "%6.3f", Percentile(99));
+    LOGI("%-45s TNN Benchmark time cost: min = %-8s ms  |  max = %-8s ms  |  avg = %-8s ms  |  p50 = %-8s ms  |  "
+         "p99 = %-8s ms \n",
+         timer_info_.c_str(), min_str, max_str, avg_str, p50_str, p99_str);
 }
 
 } // namespace test
@@ -17,6 +17,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include "tnn/core/macro.h"
 
@@ -36,6 +37,9 @@ public:
     void Print();
 
 private:
+    // time of the p-th percentile, nearest rank
+    float Percentile(float p);
+
     float min_;
     float max_;
     float sum_;
@@ -43,6 +47,7 @@ private:
     time_point<system_clock> start_;
     time_point<system_clock> stop_;
     int count_;
+    std::vector<float> samples_;
 };
 
 } // namespace test
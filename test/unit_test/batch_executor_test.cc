@@ -0,0 +1,146 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/batch_executor.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class BatchExecutorTest : public ::testing::Test {
+protected:
+    static const int kMaxBatch = 4;
+
+    // an abs net, so that every output sample can be checked against its request
+    std::shared_ptr<BatchExecutor> CreateExecutor(int max_delay_us) {
+        std::shared_ptr<LayerParam> param(new LayerParam());
+        param->name      = "layer_name";
+        auto interpreter = GenerateInterpreter("Abs", {{kMaxBatch, 3, 4, 5}}, param);
+        instance_        = CreateInstance(interpreter, ConvertDeviceType(FLAGS_dt));
+        if (!instance_) {
+            return nullptr;
+        }
+
+        BatchConfig config;
+        config.max_batch_size = kMaxBatch;
+        config.max_delay_us   = max_delay_us;
+        auto executor         = std::make_shared<BatchExecutor>(instance_, config);
+        if (executor->Init() != TNN_OK) {
+            return nullptr;
+        }
+        return executor;
+    }
+
+    MatMap CreateRequest(DimsVector dims) {
+        auto mat   = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, dims);
+        int count  = DimsVectorUtils::Count(dims);
+        float *ptr = static_cast<float *>(mat->GetData());
+        InitRandom(ptr, count, 1.0f);
+        MatMap inputs;
+        inputs["input0"] = mat;
+        return inputs;
+    }
+
+    void ExpectAbs(MatMap &inputs, BatchResult &result) {
+        ASSERT_TRUE(result.status == TNN_OK) << result.status.description();
+        ASSERT_EQ(1, result.outputs.size());
+        auto input  = inputs["input0"];
+        auto output = result.outputs.begin()->second;
+        ASSERT_EQ(input->GetDims(), output->GetDims());
+        const float *src = static_cast<float *>(input->GetData());
+        const float *dst = static_cast<float *>(output->GetData());
+        for (int i = 0; i < DimsVectorUtils::Count(input->GetDims()); ++i) {
+            ASSERT_FLOAT_EQ(std::fabs(src[i]), dst[i]) << "at " << i;
+        }
+    }
+
+    std::shared_ptr<Instance> instance_;
+};
+
+TEST_F(BatchExecutorTest, CoalesceRequests) {
+    // the delay is never reached, the worker runs as soon as the batch is full
+    auto executor = CreateExecutor(60 * 1000 * 1000);
+    ASSERT_TRUE(executor != nullptr);
+
+    std::vector<MatMap> requests = {CreateRequest({1, 3, 4, 5}), CreateRequest({2, 3, 4, 5}),
+                                    CreateRequest({1, 3, 4, 5})};
+    std::vector<std::future<BatchResult>> futures;
+    auto start = std::chrono::steady_clock::now();
+    for (auto &request : requests) {
+        futures.push_back(executor->Submit(request));
+    }
+    for (int i = 0; i < requests.size(); ++i) {
+        ASSERT_EQ(std::future_status::ready, futures[i].wait_for(std::chrono::seconds(10)));
+        auto result = futures[i].get();
+        ExpectAbs(requests[i], result);
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10));
+    executor->DeInit();
+}
+
+TEST_F(BatchExecutorTest, DelayDeadline) {
+    const int max_delay_us = 50 * 1000;
+    auto executor          = CreateExecutor(max_delay_us);
+    ASSERT_TRUE(executor != nullptr);
+
+    // a single request does not fill the batch, it runs when the oldest request is due
+    auto request = CreateRequest({1, 3, 4, 5});
+    auto start   = std::chrono::steady_clock::now();
+    auto future  = executor->Submit(request);
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(10)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::microseconds(max_delay_us));
+    auto result = future.get();
+    ExpectAbs(request, result);
+    executor->DeInit();
+}
+
+TEST_F(BatchExecutorTest, RejectInvalidRequests) {
+    auto executor = CreateExecutor(1000);
+    ASSERT_TRUE(executor != nullptr);
+
+    std::vector<DimsVector> invalid_dims = {
+        {kMaxBatch + 1, 3, 4, 5},  // batch larger than max_batch_size
+        {1, 2, 4, 5},              // less channels than the input
+        {1, 3, 3, 5},              // smaller height
+        {1, 3, 4, 6},              // larger width
+        {1, 3, 20},                // different rank
+    };
+    for (auto &dims : invalid_dims) {
+        auto future = executor->Submit(CreateRequest(dims));
+        ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+        EXPECT_FALSE(future.get().status == TNN_OK);
+    }
+
+    MatMap misnamed;
+    misnamed["other"] = CreateRequest({1, 3, 4, 5})["input0"];
+    EXPECT_FALSE(executor->Submit(misnamed).get().status == TNN_OK);
+
+    // the executor still serves valid requests
+    auto request = CreateRequest({kMaxBatch, 3, 4, 5});
+    auto result  = executor->Submit(request).get();
+    ExpectAbs(request, result);
+    executor->DeInit();
+
+    // no requests after DeInit
+    EXPECT_FALSE(executor->Submit(CreateRequest({1, 3, 4, 5})).get().status == TNN_OK);
+}
+
+}  // namespace TNN_NS
@@ -72,7 +72,8 @@ bool BlobConverterTest::TestFilterCheck(const DataType& blob_data_type, const De
         return true;
     } else if (mat_type == NGRAY && channel != 1) {
         return true;
-    } else if ((mat_type == NNV12 || mat_type == NNV21) && (channel != 3 || input_size % 2 != 0 || DEVICE_ARM != dev)) {
+    } else if ((mat_type == NNV12 || mat_type == NNV21) &&
+               (channel != 3 || input_size % 2 != 0 || (DEVICE_ARM != dev && DEVICE_X86 != dev))) {
         return true;
     } else if ((mat_type == NGRAY || mat_type == NNV12 || mat_type == NNV21 || mat_type == NCHW_FLOAT) &&
                reverse_channel) {
@@ -330,7 +331,8 @@ TEST_P(BlobConverterTest, BlobConverterTest) {
     Mat mat_out_ref(DEVICE_NAIVE, mat_type, dims, mat_out_ref_data);
     Mat mat_out_dev(DEVICE_NAIVE, mat_type, dims, mat_out_dev_data);
 
-    if (mat_type != NCHW_FLOAT &&
+    // nv12 and nv21 are converted to blobs only
+    if (mat_type != NCHW_FLOAT && mat_type != NNV12 && mat_type != NNV21 &&
         (dev != DEVICE_ARM || (dev == DEVICE_ARM && (mat_type == N8UC4 || mat_type == N8UC3)))) {
         to_mat_param.scale           = scale_data;
         to_mat_param.bias            = bias_data;
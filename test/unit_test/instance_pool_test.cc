@@ -0,0 +1,179 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance_pool.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+TEST(PartitionCpusTest, DisjointGroups) {
+    std::vector<std::vector<int>> all_cpus;
+    ASSERT_TRUE(CpuUtils::PartitionCpus(1, all_cpus) == TNN_OK);
+    ASSERT_EQ(1, all_cpus.size());
+    const std::set<int> cpus(all_cpus[0].begin(), all_cpus[0].end());
+    const int cpu_count = cpus.size();
+    ASSERT_GE(cpu_count, 1);
+    ASSERT_EQ(cpu_count, all_cpus[0].size());
+
+    for (int group_count = 1; group_count <= cpu_count; ++group_count) {
+        std::vector<std::vector<int>> groups;
+        ASSERT_TRUE(CpuUtils::PartitionCpus(group_count, groups) == TNN_OK) << group_count << " groups";
+        ASSERT_EQ(group_count, groups.size());
+        // every cpu is in exactly one group
+        std::set<int> covered;
+        int covered_count = 0;
+        for (auto &group : groups) {
+            EXPECT_FALSE(group.empty()) << group_count << " groups";
+            covered.insert(group.begin(), group.end());
+            covered_count += group.size();
+        }
+        EXPECT_EQ(cpus, covered) << group_count << " groups";
+        EXPECT_EQ(cpu_count, covered_count) << group_count << " groups";
+    }
+
+    std::vector<std::vector<int>> groups;
+    EXPECT_FALSE(CpuUtils::PartitionCpus(0, groups) == TNN_OK);
+    EXPECT_FALSE(CpuUtils::PartitionCpus(cpu_count + 1, groups) == TNN_OK);
+    EXPECT_TRUE(groups.empty());
+}
+
+class InstancePoolTest : public ::testing::TestWithParam<bool> {
+protected:
+    // a prelu of slope -1 is an abs with weights, so that every output can be checked against its request
+    Status InitTNN(TNN &tnn) {
+        const int channel = input_dims_[1];
+        std::shared_ptr<PReluLayerParam> param(new PReluLayerParam());
+        param->name           = "prelu";
+        param->channel_shared = 0;
+        param->has_filler     = 0;
+        std::shared_ptr<PReluLayerResource> resource(new PReluLayerResource());
+        resource->slope_handle = RawBuffer(channel * sizeof(float));
+        std::fill(resource->slope_handle.force_to<float *>(), resource->slope_handle.force_to<float *>() + channel,
+                  -1.0f);
+        auto interpreter = GenerateInterpreter("PReLU", {input_dims_}, param, resource);
+        auto src         = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter);
+        if (!src) {
+            return Status(TNNERR_PARAM_ERR, "failed to generate the model");
+        }
+
+        const std::string proto_path = testing::TempDir() + "instance_pool_test.tnnproto";
+        const std::string model_path = testing::TempDir() + "instance_pool_test.tnnmodel";
+        ModelPacker packer(src->GetNetStructure(), src->GetNetResource());
+        RETURN_ON_NEQ(packer.Pack(proto_path, model_path), TNN_OK);
+
+        ModelConfig model_config;
+        model_config.model_type = MODEL_TYPE_TNN;
+        model_config.params     = {ReadFile(proto_path), ReadFile(model_path)};
+        std::remove(proto_path.c_str());
+        std::remove(model_path.c_str());
+        return tnn.Init(model_config);
+    }
+
+    std::string ReadFile(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    MatMap CreateRequest() {
+        auto mat   = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, input_dims_);
+        float *ptr = static_cast<float *>(mat->GetData());
+        InitRandom(ptr, DimsVectorUtils::Count(input_dims_), 1.0f);
+        MatMap inputs;
+        inputs["input0"] = mat;
+        return inputs;
+    }
+
+    void ExpectAbs(MatMap &inputs, InstancePoolResult &result) {
+        ASSERT_TRUE(result.status == TNN_OK) << result.status.description();
+        ASSERT_EQ(1, result.outputs.size());
+        auto input  = inputs["input0"];
+        auto output = result.outputs.begin()->second;
+        ASSERT_EQ(input->GetDims(), output->GetDims());
+        const float *src = static_cast<float *>(input->GetData());
+        const float *dst = static_cast<float *>(output->GetData());
+        for (int i = 0; i < DimsVectorUtils::Count(input->GetDims()); ++i) {
+            ASSERT_FLOAT_EQ(std::fabs(src[i]), dst[i]) << "at " << i;
+        }
+    }
+
+    DimsVector input_dims_ = {1, 3, 4, 5};
+};
+
+INSTANTIATE_TEST_SUITE_P(InstancePoolTest, InstancePoolTest, testing::Values(true, false));
+
+TEST_P(InstancePoolTest, SubmitAndDeInit) {
+    TNN tnn;
+    ASSERT_TRUE(InitTNN(tnn) == TNN_OK);
+
+    std::vector<std::vector<int>> all_cpus;
+    ASSERT_TRUE(CpuUtils::PartitionCpus(1, all_cpus) == TNN_OK);
+    InstancePoolConfig pool_config;
+    pool_config.instance_count = std::min<int>(2, all_cpus[0].size());
+    pool_config.bind_cpu       = GetParam();
+    InstancePool pool(pool_config);
+
+    NetworkConfig config;
+    config.device_type = ConvertDeviceType(FLAGS_dt);
+    ASSERT_TRUE(pool.Init(tnn, config) == TNN_OK);
+    std::vector<std::vector<int>> groups;
+    ASSERT_TRUE(CpuUtils::PartitionCpus(pool_config.instance_count, groups) == TNN_OK);
+    for (int i = 0; i < pool_config.instance_count; ++i) {
+        EXPECT_EQ(groups[i], pool.GetCpuGroup(i));
+    }
+    EXPECT_TRUE(pool.GetCpuGroup(pool_config.instance_count).empty());
+
+    // more requests than instances, each instance takes the next request once its last one returned
+    std::vector<MatMap> requests;
+    std::vector<std::future<InstancePoolResult>> futures;
+    for (int i = 0; i < 8; ++i) {
+        requests.push_back(CreateRequest());
+        futures.push_back(pool.Submit(requests.back()));
+    }
+    for (int i = 0; i < requests.size(); ++i) {
+        ASSERT_EQ(std::future_status::ready, futures[i].wait_for(std::chrono::seconds(10)));
+        auto result = futures[i].get();
+        ExpectAbs(requests[i], result);
+    }
+
+    // the pool still serves requests after the queue ran empty
+    auto request = CreateRequest();
+    auto result  = pool.Submit(request).get();
+    ExpectAbs(request, result);
+
+    // invalid requests are rejected
+    EXPECT_FALSE(pool.Submit(MatMap()).get().status == TNN_OK);
+
+    ASSERT_TRUE(pool.DeInit() == TNN_OK);
+    // no requests after DeInit
+    EXPECT_FALSE(pool.Submit(CreateRequest()).get().status == TNN_OK);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,133 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/abstract_layer_acc.h"
+
+namespace TNN_NS {
+
+class KernelTuneCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        device_type_ = ConvertDeviceType(FLAGS_dt);
+        cache_path_  = testing::TempDir() + "kernel_tune_cache_test.cache";
+        std::remove(cache_path_.c_str());
+
+        // a 1x1 conv, the tuner times the sgemm blocking grid for it
+        param_.input_channel  = 16;
+        param_.output_channel = 24;
+        param_.group          = 1;
+        param_.kernels        = {1, 1};
+        param_.dialations     = {1, 1};
+        param_.strides        = {1, 1};
+        param_.pads           = {0, 0, 0, 0};
+        param_.bias           = 1;
+        const int filter_count   = param_.input_channel * param_.output_channel;
+        resource_.filter_handle  = RawBuffer(filter_count * sizeof(float));
+        resource_.bias_handle    = RawBuffer(param_.output_channel * sizeof(float));
+        InitRandom(resource_.filter_handle.force_to<float *>(), filter_count, 1.0f);
+        InitRandom(resource_.bias_handle.force_to<float *>(), param_.output_channel, 1.0f);
+    }
+
+    void TearDown() override {
+        std::remove(cache_path_.c_str());
+    }
+
+    std::shared_ptr<Blob> CreateBlob(DimsVector dims) {
+        BlobDesc desc;
+        desc.device_type = device_type_;
+        desc.data_type   = DATA_TYPE_FLOAT;
+        desc.data_format = DATA_FORMAT_NCHW;
+        desc.dims        = dims;
+        return std::make_shared<Blob>(desc, true);
+    }
+
+    // reshape the conv in a new context as an instance does, after_load runs once the cache is loaded
+    Status ReshapeConv(std::function<void()> after_load) {
+        auto device = GetDevice(device_type_);
+        std::shared_ptr<Context> context(device->CreateContext(0));
+        std::shared_ptr<AbstractLayerAcc> acc(device->CreateLayerAcc(LAYER_CONVOLUTION));
+        if (!context || !acc) {
+            return Status(TNNERR_DEVICE_NOT_SUPPORT, "no context or conv acc");
+        }
+        context->SetEnableTuneKernel(true);
+        context->SetCacheFilePath(cache_path_);
+        context->SetNumThreads(1);
+
+        auto input  = CreateBlob({1, param_.input_channel, 12, 10});
+        auto output = CreateBlob({1, param_.output_channel, 12, 10});
+        std::vector<Blob *> inputs  = {input.get()};
+        std::vector<Blob *> outputs = {output.get()};
+
+        RETURN_ON_NEQ(context->OnInstanceReshapeBegin(), TNN_OK);
+        after_load();
+        RETURN_ON_NEQ(acc->Init(context.get(), &param_, &resource_, inputs, outputs), TNN_OK);
+        RETURN_ON_NEQ(acc->Reshape(inputs, outputs), TNN_OK);
+        return context->OnInstanceReshapeEnd();
+    }
+
+    std::vector<std::string> ReadCacheLines() {
+        std::vector<std::string> lines;
+        std::ifstream cache_stream(cache_path_);
+        std::string line;
+        while (std::getline(cache_stream, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    DeviceType device_type_;
+    std::string cache_path_;
+    ConvLayerParam param_;
+    ConvLayerResource resource_;
+};
+
+TEST_F(KernelTuneCacheTest, SurviveReload) {
+    // only the x86 context keeps tuned kernels in the cache file
+    if (device_type_ != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    // configs of other layers in the file are kept when the conv is added
+    {
+        std::ofstream cache_stream(cache_path_);
+        cache_stream << 1 << std::endl << "other_layer 2 3 4" << std::endl;
+    }
+    ASSERT_TRUE(ReshapeConv([] {}) == TNN_OK);
+    auto lines = ReadCacheLines();
+    ASSERT_EQ(3, lines.size());
+    EXPECT_EQ("2", lines[0]);
+    EXPECT_EQ("conv_", lines[1].substr(0, 5));
+    EXPECT_EQ("other_layer 2 3 4", lines[2]);
+
+    // a new context finds the conv in the cache, it tunes nothing and does not write the file again
+    ASSERT_TRUE(ReshapeConv([this] { std::remove(cache_path_.c_str()); }) == TNN_OK);
+    EXPECT_FALSE(std::ifstream(cache_path_).good());
+
+    // without the cache the conv is tuned again
+    ASSERT_TRUE(ReshapeConv([] {}) == TNN_OK);
+    EXPECT_EQ(2, ReadCacheLines().size());
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,89 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/abstract_device.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+/*
+ * ShuffleChannel and LRN have no x86 acc, they run between x86 convs on the fallback device
+ */
+static std::shared_ptr<AbstractModelInterpreter> GenerateFallbackInterpreter(std::vector<int> input_dims) {
+    auto conv_param            = std::make_shared<ConvLayerParam>();
+    conv_param->input_channel  = input_dims[1];
+    conv_param->output_channel = 8;
+    conv_param->group          = 1;
+    conv_param->kernels        = {3, 3};
+    conv_param->dialations     = {1, 1};
+    conv_param->strides        = {1, 1};
+    conv_param->pads           = {1, 1, 1, 1};
+    conv_param->bias           = 1;
+
+    auto shuffle_param   = std::make_shared<ShuffleLayerParam>();
+    shuffle_param->group = 2;
+
+    auto lrn_param   = std::make_shared<LRNLayerParam>();
+    lrn_param->alpha = 1e-4f;
+    lrn_param->beta  = 0.75f;
+    lrn_param->bias  = 1.0f;
+    lrn_param->size  = 5;
+
+    std::vector<std::shared_ptr<LayerInfo>> layers = {
+        CreateLayerInfo("Convolution", "conv", {"input0"}, {"conv"}, conv_param),
+        CreateLayerInfo("ShuffleChannel", "shuffle", {"conv"}, {"shuffle"}, shuffle_param),
+        CreateLayerInfo("LRN", "lrn", {"shuffle"}, {"lrn"}, lrn_param),
+        CreateLayerInfo("ReLU", "relu", {"lrn"}, {"output0"}, std::make_shared<LayerParam>()),
+    };
+    return GenerateNetInterpreter({input_dims}, layers);
+}
+
+TEST(LayerFallbackTest, SameAsNaive) {
+    const DeviceType device_type = ConvertDeviceType(FLAGS_dt);
+    auto device                  = GetDevice(device_type);
+    ASSERT_TRUE(device != nullptr);
+    if (device->GetFallbackDevice() == nullptr) {
+        GTEST_SKIP() << "the device has no fallback device";
+    }
+
+    const DimsVector input_dims = {1, 3, 10, 9};
+    auto interpreter            = GenerateFallbackInterpreter(input_dims);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    std::map<std::string, std::vector<float>> inputs;
+    inputs["input0"] = std::vector<float>(DimsVectorUtils::Count(input_dims));
+    InitRandom(inputs["input0"].data(), inputs["input0"].size(), 1.0f);
+
+    auto naive = CreateInstance(interpreter, DEVICE_NAIVE);
+    ASSERT_TRUE(naive != nullptr);
+    std::map<std::string, std::vector<float>> expects;
+    ASSERT_TRUE(ForwardInstance(naive, inputs, expects) == TNN_OK);
+
+    NetworkConfig config;
+    config.device_type = device_type;
+    config.precision   = PRECISION_HIGH;
+    auto instance      = CreateInstance(interpreter, config);
+    ASSERT_TRUE(instance != nullptr);
+    std::map<std::string, std::vector<float>> outputs;
+    ASSERT_TRUE(ForwardInstance(instance, inputs, outputs) == TNN_OK);
+
+    ASSERT_TRUE(OutputsNear(expects, outputs));
+}
+
+}  // namespace TNN_NS
@@ -14,18 +14,25 @@
 
 #include "test/unit_test/layer_test/layer_test.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <sstream>
 #include <sys/time.h>
 
 #include "test/unit_test/unit_test_common.h"
 #include "test/unit_test/utils/network_helpers.h"
 #include "tnn/core/blob_int8.h"
+#include "tnn/core/profile.h"
 #include "tnn/utils/bfp16.h"
 #include "tnn/utils/blob_converter.h"
 #include "tnn/utils/blob_memory_size_utils.h"
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/string_format.h"
 
 namespace TNN_NS {
 
@@ -62,6 +69,15 @@ void LayerTest::Run(std::shared_ptr<AbstractModelInterpreter> interp, Precision
         return;
     }
 
+    if (FLAGS_ub && !FLAGS_ubo.empty()) {
+        ret = Benchmark();
+        if (ret != TNN_OK) {
+            EXPECT_EQ((int)ret, TNN_OK);
+            DeInit();
+            return;
+        }
+    }
+
 #ifndef TNN_UNIT_TEST_BENCHMARK
     // Compare the result for both cpu and device layer
     ret = Compare();
@@ -197,6 +213,94 @@ Status LayerTest::Forward() {
     return ret;
 }
 
+/*
+ * One json line per thread count: the gtest case and its param, the wall time of the forwards and,
+ * with TNN_PROFILE, the layers with the impl the factories picked, MFLOP, MB, GFLOP/s and GB/s.
+ * The records keep the gtest param string, grids are swept by the INSTANTIATE_TEST_SUITE_P params.
+ */
+Status LayerTest::Benchmark() {
+    std::vector<int> thread_counts;
+    std::stringstream thread_stream(FLAGS_ubt);
+    std::string thread_item;
+    while (std::getline(thread_stream, thread_item, ',')) {
+        if (atoi(thread_item.c_str()) > 0) {
+            thread_counts.push_back(atoi(thread_item.c_str()));
+        }
+    }
+    if (thread_counts.empty()) {
+        thread_counts.push_back(std::max(FLAGS_th, 1));
+    }
+
+    std::ofstream output(FLAGS_ubo, std::ios::app);
+    if (!output) {
+        LOGE("open unit benchmark output %s failed\n", FLAGS_ubo.c_str());
+        return Status(TNNERR_COMMON_ERROR, "open unit benchmark output failed");
+    }
+
+    auto test_info         = ::testing::UnitTest::GetInstance()->current_test_info();
+    std::string test_name  = std::string(test_info->test_suite_name()) + "." + test_info->name();
+    std::string test_param = test_info->value_param() ? test_info->value_param() : "";
+    const int iterations   = std::max(FLAGS_ic, 1);
+
+    for (auto threads : thread_counts) {
+        Status ret = instance_device_->SetCpuNumThreads(threads);
+        EXPECT_EQ_OR_RETURN(ret, TNN_OK);
+        // warm up with the new thread count
+        ret = instance_device_->Forward();
+        EXPECT_EQ_OR_RETURN(ret, TNN_OK);
+
+        // the wall times are taken without the profiler, which syncs and records every layer
+        double min = DBL_MAX, max = 0, sum = 0;
+        for (int i = 0; i < iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            ret        = instance_device_->Forward();
+            EXPECT_EQ_OR_RETURN(ret, TNN_OK);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            min = std::min(min, elapsed.count());
+            max = std::max(max, elapsed.count());
+            sum += elapsed.count();
+        }
+
+        std::ostringstream record;
+        record << "{\"test\": " << JsonString(test_name) << ", \"param\": " << JsonString(test_param)
+               << ", \"device\": " << JsonString(FLAGS_dt) << ", \"threads\": " << threads
+               << ", \"iterations\": " << iterations << ", \"min_ms\": " << min << ", \"max_ms\": " << max
+               << ", \"avg_ms\": " << sum / iterations;
+#if TNN_PROFILE
+        // a second run of the forwards for the layer times
+        instance_device_->StartProfile();
+        for (int i = 0; i < iterations; ++i) {
+            ret = instance_device_->Forward();
+            EXPECT_EQ_OR_RETURN(ret, TNN_OK);
+        }
+        instance_device_->FinishProfile(false);
+        auto profile_result = instance_device_->GetProfileResult();
+        double kernel_ms = 0, mflops = 0, mbytes = 0;
+        record << ", \"layers\": [";
+        std::vector<std::shared_ptr<ProfilingData>> profiling_data;
+        if (profile_result) {
+            profiling_data = profile_result->GetData();
+        }
+        for (size_t i = 0; i < profiling_data.size(); i++) {
+            auto p              = profiling_data[i];
+            double layer_kernel = p->kernel_time / std::max(p->count, 1);
+            kernel_ms += layer_kernel;
+            mflops += p->flops;
+            mbytes += p->bandwidth;
+            record << (i > 0 ? ", " : "") << "{\"name\": " << JsonString(p->layer_name)
+                   << ", \"op_type\": " << JsonString(p->op_name) << ", \"impl\": " << JsonString(p->impl_name)
+                   << ", \"kernel_ms\": " << layer_kernel << "}";
+        }
+        record << "], \"kernel_ms\": " << kernel_ms << ", \"mflops\": " << mflops << ", \"mbytes\": " << mbytes
+               << ", \"gflops\": " << (kernel_ms > 0 ? mflops / kernel_ms : 0)
+               << ", \"gbps\": " << (kernel_ms > 0 ? mbytes / kernel_ms : 0);
+#endif
+        record << "}";
+        output << record.str() << std::endl;
+    }
+    return TNN_OK;
+}
+
 Status LayerTest::Compare() {
     BlobMap output_blobs_cpu;
     BlobMap output_blobs_device;
@@ -261,7 +365,14 @@ Status LayerTest::GenerateRandomBlob(Blob* cpu_blob, Blob* device_blob, void* co
     }
     TNN_NS::Mat source(DEVICE_NAIVE, mat_type, blob_desc.dims);
     void* input_data = source.GetData();
-    if (mat_type == NCHW_FLOAT) {
+    auto fixed_data = fixed_input_data_.find(blob_desc.name);
+    if (fixed_data != fixed_input_data_.end()) {
+        if (mat_type != NCHW_FLOAT || (int)fixed_data->second.size() != blob_count) {
+            LOGE("fixed data of input %s does not match the blob\n", blob_desc.name.c_str());
+            return Status(TNNERR_PARAM_ERR, "fixed input data does not match the blob");
+        }
+        memcpy(input_data, fixed_data->second.data(), blob_count * sizeof(float));
+    } else if (mat_type == NCHW_FLOAT) {
         if (ensure_input_positive_) {
             // some layers only supports positive data as input
             InitRandom(static_cast<float*>(input_data), blob_count, 0.0001f, 1.0f + (float)magic_num);
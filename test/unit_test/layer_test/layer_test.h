@@ -47,11 +47,15 @@ protected:
 private:
     Status Init(std::shared_ptr<AbstractModelInterpreter> interp, Precision precision);
     Status Forward();
+    // times the device instance for each thread count of -ubt and appends the records to -ubo
+    Status Benchmark();
     Status Compare();
     Status DeInit();
 
 protected:
     int ensure_input_positive_ = 0;
+    // float data of the inputs that must not be random, keyed by input name
+    std::map<std::string, std::vector<float>> fixed_input_data_;
 
     static std::shared_ptr<Instance> instance_cpu_;
     static std::shared_ptr<Instance> instance_device_;
@@ -25,8 +25,8 @@ INSTANTIATE_TEST_SUITE_P(LayerTest, AddLayerTest,
                          ::testing::Combine(BASIC_BATCH_CHANNEL_SIZE,
                                             // input cnt
                                             testing::Values(1, 2),
-                                            // param size type (1, channel, chw, hw)
-                                            testing::Values(0, 1, 2, 3),
+                                            // param size type (1, channel, chw, hw, w per batch)
+                                            testing::Values(0, 1, 2, 3, 4),
                                             // weight index
                                             testing::Values(-1, 0, 1),
                                             // data_type
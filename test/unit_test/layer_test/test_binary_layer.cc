@@ -22,7 +22,7 @@ BinaryLayerTest::BinaryLayerTest(LayerType type) {
 }
 
 bool BinaryLayerTest::InputParamCheck(const DataType& data_type, const DeviceType& dev, const int batch) {
-    if (data_type == DATA_TYPE_INT8 && DEVICE_ARM != dev) {
+    if (data_type == DATA_TYPE_INT8 && DEVICE_ARM != dev && DEVICE_X86 != dev) {
         return true;
     }
 
@@ -62,6 +62,10 @@ void BinaryLayerTest::RunBinaryTest(std::string layer_type_str, bool resource_po
     if (batch > 1 && param_size_type == 3 && DEVICE_HUAWEI_NPU == dev) {
         GTEST_SKIP();
     }
+    // a width vector per batch, as the masks of attention
+    if (param_size_type == 4 && ((DEVICE_X86 != dev && DEVICE_NAIVE != dev) || DATA_TYPE_FLOAT != data_type)) {
+        GTEST_SKIP();
+    }
 
     std::vector<int> param_dims;
     int param_count = 1;
@@ -77,6 +81,9 @@ void BinaryLayerTest::RunBinaryTest(std::string layer_type_str, bool resource_po
     } else if (3 == param_size_type) {
         param_count = input_size * input_size;
         param_dims  = {1, 1, input_size, input_size};
+    } else if (4 == param_size_type) {
+        param_count = batch * input_size;
+        param_dims  = {batch, 1, 1, input_size};
     }
 
     std::shared_ptr<EltwiseLayerResource> resource = nullptr;
@@ -132,6 +139,8 @@ void BinaryLayerTest::RunBinaryTest(std::string layer_type_str, bool resource_po
                 weight_dims = {1, channel, input_size, input_size};
             } else if (3 == param_size_type) {
                 weight_dims = {1, 1, input_size, input_size};
+            } else if (4 == param_size_type) {
+                weight_dims = {batch, 1, 1, input_size};
             }
 
             if (0 == weight_idx) {
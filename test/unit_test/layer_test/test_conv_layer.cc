@@ -15,6 +15,8 @@
 #include "test/unit_test/layer_test/layer_test.h"
 #include "test/unit_test/unit_test_common.h"
 #include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
 #include "tnn/utils/cpu_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
 
@@ -47,7 +49,7 @@ INSTANTIATE_TEST_SUITE_P(LayerTest, ConvLayerTest,
                              testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_HALF),
                              // activation_type
                              testing::Values(ActivationType_None, ActivationType_ReLU, ActivationType_ReLU6,
-                                             ActivationType_SIGMOID_MUL)));
+                                             ActivationType_SIGMOID_MUL, ActivationType_HARDSWISH)));
 
 TEST_P(ConvLayerTest, ConvLayer) {
     // get param
@@ -90,10 +92,7 @@ TEST_P(ConvLayerTest, ConvLayer) {
         GTEST_SKIP();
     }
 
-    if (activation_type == ActivationType_ReLU6 && DEVICE_X86 == dev) {
-        GTEST_SKIP();
-    }
-    if (activation_type == ActivationType_SIGMOID_MUL && DEVICE_X86 == dev) {
+    if (activation_type == ActivationType_HARDSWISH && DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
         GTEST_SKIP();
     }
 
@@ -118,4 +117,109 @@ TEST_P(ConvLayerTest, ConvLayer) {
     Run(interpreter, precision);
 }
 
+static std::shared_ptr<ConvLayerParam> CreateConv1x1Param(int channel) {
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->input_channel  = channel;
+    param->output_channel = channel;
+    param->kernels        = {1, 1};
+    param->dialations     = {1, 1};
+    param->strides        = {1, 1};
+    param->pads           = {0, 0, 0, 0};
+    param->bias           = 1;
+    return param;
+}
+
+TEST(ConvFusionTest, SharedInterpreter) {
+    if (GetDevice(DEVICE_X86) == nullptr) {
+        GTEST_SKIP();
+    }
+    const DimsVector input_dims = {1, 8, 6, 6};
+    auto hardswish_param        = std::make_shared<HardSwishLayerParam>();
+    hardswish_param->alpha      = 1.0f / 6.0f;
+    hardswish_param->beta       = 0.5f;
+    std::vector<std::shared_ptr<LayerInfo>> layers = {
+        CreateLayerInfo("Convolution", "conv_a", {"input0"}, {"conv_a"}, CreateConv1x1Param(input_dims[1])),
+        CreateLayerInfo("HardSwish", "hardswish", {"conv_a"}, {"hardswish"}, hardswish_param),
+        CreateLayerInfo("Convolution", "conv_b", {"hardswish"}, {"conv_b"}, CreateConv1x1Param(input_dims[1])),
+        CreateLayerInfo("Add", "add", {"conv_b", "input0"}, {"add"}, std::make_shared<MultidirBroadcastLayerParam>()),
+        CreateLayerInfo("ReLU6", "relu6", {"add"}, {"output0"}, std::make_shared<LayerParam>()),
+    };
+    auto interpreter   = GenerateNetInterpreter({input_dims}, layers);
+    auto net_structure = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter)->GetNetStructure();
+    auto net_resource  = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter)->GetNetResource();
+
+    NetworkConfig config;
+    config.device_type = DEVICE_X86;
+    config.precision   = PRECISION_HIGH;
+    // the x86 network fuses hardswish into conv_a, the add and relu6 into conv_b, on its own copy
+    NetStructure network_structure = *net_structure;
+    ASSERT_TRUE(optimizer::NetOptimizerManager::OptimizeNetwork(&network_structure, net_resource, config) == TNN_OK);
+    ASSERT_EQ(2, network_structure.layers.size());
+    auto conv_b = dynamic_cast<ConvLayerParam *>(network_structure.layers[1]->param.get());
+    EXPECT_EQ(ActivationType_ReLU6, conv_b->activation_type);
+    EXPECT_EQ(FusionType_Conv_Add_Activation, conv_b->fusion_type);
+    EXPECT_EQ(layers, net_structure->layers);
+    for (auto layer : layers) {
+        auto conv_param = dynamic_cast<ConvLayerParam *>(layer->param.get());
+        if (conv_param) {
+            EXPECT_EQ(ActivationType_None, conv_param->activation_type) << layer->name;
+            EXPECT_EQ(FusionType_None, conv_param->fusion_type) << layer->name;
+            EXPECT_EQ(1, layer->inputs.size()) << layer->name;
+        }
+    }
+
+    std::map<std::string, std::vector<float>> inputs;
+    inputs["input0"] = std::vector<float>(DimsVectorUtils::Count(input_dims));
+    InitRandom(inputs["input0"].data(), inputs["input0"].size(), 1.0f);
+    auto fused = CreateInstance(interpreter, config);
+    ASSERT_TRUE(fused != nullptr);
+    // the naive network created later runs the unfused layers
+    config.device_type = DEVICE_NAIVE;
+    auto unfused       = CreateInstance(interpreter, config);
+    ASSERT_TRUE(unfused != nullptr);
+
+    std::map<std::string, std::vector<float>> expects, outputs;
+    ASSERT_TRUE(ForwardInstance(unfused, inputs, expects) == TNN_OK);
+    ASSERT_TRUE(ForwardInstance(fused, inputs, outputs) == TNN_OK);
+    ASSERT_TRUE(OutputsNear(expects, outputs));
+}
+
+TEST(ConvFusionTest, BroadcastResidual) {
+    if (GetDevice(DEVICE_X86) == nullptr) {
+        GTEST_SKIP();
+    }
+    const DimsVector input_dims = {2, 8, 6, 6};
+    // filled per channel plane, copied per batch, copied per channel, one scalar and one value per channel
+    const std::vector<DimsVector> residual_dims = {{2, 8, 1, 1}, {1, 8, 6, 6}, {2, 1, 6, 6}, {1, 1, 1, 1}, {1, 8, 1, 1}};
+    for (int d = 0; d < residual_dims.size(); ++d) {
+        const auto &dims                               = residual_dims[d];
+        std::vector<std::shared_ptr<LayerInfo>> layers = {
+            CreateLayerInfo("Convolution", "conv", {"input0"}, {"conv"}, CreateConv1x1Param(input_dims[1])),
+            CreateLayerInfo("Add", "add", {"conv", "input1"}, {"output0"},
+                            std::make_shared<MultidirBroadcastLayerParam>()),
+        };
+        auto interpreter = GenerateNetInterpreter({input_dims, dims}, layers);
+
+        std::map<std::string, std::vector<float>> inputs;
+        inputs["input0"] = std::vector<float>(DimsVectorUtils::Count(input_dims));
+        inputs["input1"] = std::vector<float>(DimsVectorUtils::Count(dims));
+        InitRandom(inputs["input0"].data(), inputs["input0"].size(), 1.0f);
+        InitRandom(inputs["input1"].data(), inputs["input1"].size(), 1.0f);
+
+        NetworkConfig config;
+        config.device_type = DEVICE_X86;
+        config.precision   = PRECISION_HIGH;
+        auto fused         = CreateInstance(interpreter, config);
+        ASSERT_TRUE(fused != nullptr);
+        config.device_type = DEVICE_NAIVE;
+        auto unfused       = CreateInstance(interpreter, config);
+        ASSERT_TRUE(unfused != nullptr);
+
+        std::map<std::string, std::vector<float>> expects, outputs;
+        ASSERT_TRUE(ForwardInstance(unfused, inputs, expects) == TNN_OK);
+        ASSERT_TRUE(ForwardInstance(fused, inputs, outputs) == TNN_OK);
+        ASSERT_TRUE(OutputsNear(expects, outputs)) << "residual " << d;
+    }
+}
+
 }  // namespace TNN_NS
@@ -0,0 +1,221 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cmath>
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class FusedAttentionLayerTest : public LayerTest,
+                                public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, FusedAttentionLayerTest,
+                         ::testing::Combine(
+                             // batch, heads
+                             testing::Values(1, 2), testing::Values(1, 3),
+                             // query length, key length
+                             testing::Values(1, 7, 33), testing::Values(5, 64, 130),
+                             // head size
+                             testing::Values(8, 13, 64),
+                             // mask: none, [batch, 1, 1, key], [batch, 1, query, key], [1, 1, 1, 1]
+                             testing::Values(0, 1, 2, 3)));
+
+TEST_P(FusedAttentionLayerTest, FusedAttentionLayer) {
+    // get param
+    int batch      = std::get<0>(GetParam());
+    int heads      = std::get<1>(GetParam());
+    int query_len  = std::get<2>(GetParam());
+    int key_len    = std::get<3>(GetParam());
+    int head_size  = std::get<4>(GetParam());
+    int mask_type  = std::get<5>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<FusedAttentionLayerParam> param(new FusedAttentionLayerParam());
+    param->name  = "FusedAttention";
+    param->scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+
+    // generate interpreter, the key is transposed to [batch, heads, head_size, key_len]
+    std::vector<std::vector<int>> input_dims = {{batch, heads, query_len, head_size},
+                                                {batch, heads, head_size, key_len},
+                                                {batch, heads, key_len, head_size}};
+    if (mask_type == 1) {
+        input_dims.push_back({batch, 1, 1, key_len});
+    } else if (mask_type == 2) {
+        input_dims.push_back({batch, 1, query_len, key_len});
+    } else if (mask_type == 3) {
+        input_dims.push_back({1, 1, 1, 1});
+    }
+    auto interpreter = GenerateInterpreter("FusedAttention", input_dims, param);
+    Run(interpreter);
+}
+
+/*
+ * MatMul, scale, mask Add, Softmax and MatMul as the converters write attention, the device network runs the
+ * FusedAttention of the optimizer and is compared with the layers of the naive network.
+ */
+static std::shared_ptr<AbstractModelInterpreter> GenerateAttentionInterpreter(std::vector<std::vector<int>> input_vec,
+                                                                              int scale_type, int mask_type,
+                                                                              int softmax_axis, float scale) {
+    auto interpreter = dynamic_cast<DefaultModelInterpreter*>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    if (!interpreter) {
+        return nullptr;
+    }
+    NetStructure* net_structure     = interpreter->GetNetStructure();
+    NetResource* net_resource       = interpreter->GetNetResource();
+    net_structure->inputs_shape_map = GenerateInputShapeMap(input_vec);
+    for (auto item : net_structure->inputs_shape_map) {
+        net_structure->blobs.insert(item.first);
+    }
+    auto& layers = net_structure->layers;
+
+    layers.push_back(CreateLayerInfo("MatMul", "scores", {"input0", "input1"}, {"scores"},
+                                     std::make_shared<MatMulLayerParam>()));
+    std::string scores = "scores";
+    if (scale_type != 0) {
+        // mul by the scale or div by its reciprocal
+        std::shared_ptr<EltwiseLayerResource> resource(new EltwiseLayerResource());
+        RawBuffer buffer(sizeof(float));
+        buffer.force_to<float*>()[0] = scale_type == 1 ? scale : 1.0f / scale;
+        resource->element_handle     = buffer;
+        resource->element_shape      = {1, 1, 1, 1};
+        net_resource->resource_map["scaled"] = resource;
+        layers.push_back(CreateLayerInfo(scale_type == 1 ? "Mul" : "Div", "scaled", {scores}, {"scaled"},
+                                         std::make_shared<MultidirBroadcastLayerParam>()));
+        scores = "scaled";
+    }
+    if (mask_type != 0) {
+        // the mask is either input of the add
+        auto inputs = mask_type == 1 ? std::vector<std::string>({scores, "input3"})
+                                     : std::vector<std::string>({"input3", scores});
+        layers.push_back(
+            CreateLayerInfo("Add", "masked", inputs, {"masked"}, std::make_shared<MultidirBroadcastLayerParam>()));
+        scores = "masked";
+    }
+    auto softmax_param  = std::make_shared<SoftmaxLayerParam>();
+    softmax_param->axis = softmax_axis;
+    layers.push_back(CreateLayerInfo("Softmax", "probs", {scores}, {"probs"}, softmax_param));
+    layers.push_back(CreateLayerInfo("MatMul", "output", {"probs", "input2"}, {"output0"},
+                                     std::make_shared<MatMulLayerParam>()));
+
+    for (auto layer : layers) {
+        net_structure->blobs.insert(layer->outputs[0]);
+    }
+    net_structure->outputs.insert("output0");
+    return std::shared_ptr<AbstractModelInterpreter>(interpreter);
+}
+
+class FusedAttentionSubgraphTest : public LayerTest,
+                                   public ::testing::WithParamInterface<std::tuple<int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, FusedAttentionSubgraphTest,
+                         ::testing::Combine(
+                             // sequence length, head size
+                             testing::Values(9, 70), testing::Values(16, 64),
+                             // scale: none, mul, div
+                             testing::Values(0, 1, 2),
+                             // mask: none, add of scores and mask, add of mask and scores
+                             testing::Values(0, 1, 2),
+                             // softmax axis, the layers of axis 3 are not fused
+                             testing::Values(-1, 3)));
+
+TEST_P(FusedAttentionSubgraphTest, FusedAttentionSubgraph) {
+    // get param
+    int seq_len      = std::get<0>(GetParam());
+    int head_size    = std::get<1>(GetParam());
+    int scale_type   = std::get<2>(GetParam());
+    int mask_type    = std::get<3>(GetParam());
+    int softmax_axis = std::get<4>(GetParam());
+    DeviceType dev   = ConvertDeviceType(FLAGS_dt);
+    if (DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+
+    std::vector<std::vector<int>> input_dims = {
+        {2, 4, seq_len, head_size}, {2, 4, head_size, seq_len}, {2, 4, seq_len, head_size}};
+    if (mask_type != 0) {
+        input_dims.push_back({2, 1, 1, seq_len});
+    }
+    float scale      = 1.0f / std::sqrt(static_cast<float>(head_size));
+    auto interpreter = GenerateAttentionInterpreter(input_dims, scale_type, mask_type, softmax_axis, scale);
+    Run(interpreter);
+}
+
+TEST(FusedAttentionSubgraphTest, SharedInterpreter) {
+    if (GetDevice(DEVICE_X86) == nullptr) {
+        GTEST_SKIP();
+    }
+    const int seq_len = 9, head_size = 16;
+    std::vector<std::vector<int>> input_dims = {
+        {1, 2, seq_len, head_size}, {1, 2, head_size, seq_len}, {1, 2, seq_len, head_size}};
+    auto interpreter = GenerateAttentionInterpreter(input_dims, 1, 0, -1, 0.25f);
+    ASSERT_TRUE(interpreter != nullptr);
+    auto net_structure = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter)->GetNetStructure();
+    const auto layers  = net_structure->layers;
+
+    std::map<std::string, std::vector<float>> inputs;
+    for (int i = 0; i < input_dims.size(); ++i) {
+        auto& data = inputs["input" + std::to_string(i)];
+        data.resize(DimsVectorUtils::Count(input_dims[i]));
+        InitRandom(data.data(), data.size(), 1.0f);
+    }
+
+    // the x86 instance fuses the attention on its own copy of the structure
+    NetworkConfig config;
+    config.device_type = DEVICE_X86;
+    config.precision   = PRECISION_HIGH;
+    auto fused         = CreateInstance(interpreter, config);
+    ASSERT_TRUE(fused != nullptr);
+    EXPECT_EQ(layers, net_structure->layers);
+
+    // so the instances of other devices created later still get the unfused layers
+    config.device_type = DEVICE_NAIVE;
+    auto unfused       = CreateInstance(interpreter, config);
+    ASSERT_TRUE(unfused != nullptr);
+
+    std::map<std::string, std::vector<float>> expects, outputs;
+    ASSERT_TRUE(ForwardInstance(unfused, inputs, expects) == TNN_OK);
+    ASSERT_TRUE(ForwardInstance(fused, inputs, outputs) == TNN_OK);
+    ASSERT_TRUE(OutputsNear(expects, outputs));
+}
+
+TEST(FusedAttentionSubgraphTest, NotLastAxis) {
+    // axis 3 of rank 5 scores is not the last one, the softmax over it stays a layer
+    const int seq_len = 5, head_size = 8;
+    std::vector<std::vector<int>> input_dims = {
+        {1, 2, 3, seq_len, head_size}, {1, 2, 3, head_size, seq_len}, {1, 2, 3, seq_len, head_size}};
+    auto interpreter = GenerateAttentionInterpreter(input_dims, 0, 0, 3, 1.0f);
+    ASSERT_TRUE(interpreter != nullptr);
+    auto net_structure = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter)->GetNetStructure();
+    auto net_resource  = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter)->GetNetResource();
+
+    NetworkConfig config;
+    config.device_type             = DEVICE_X86;
+    NetStructure network_structure = *net_structure;
+    ASSERT_TRUE(optimizer::NetOptimizerManager::OptimizeNetwork(&network_structure, net_resource, config) == TNN_OK);
+    ASSERT_EQ(3, network_structure.layers.size());
+    EXPECT_EQ(LAYER_SOFTMAX, network_structure.layers[1]->type);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,71 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class GatherLayerTest : public LayerTest, public ::testing::WithParamInterface<std::tuple<int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, GatherLayerTest,
+                         ::testing::Combine(
+                             // data, axis and indices: [10, 16] axis 0 [2, 3], [2, 6, 5] axis 1 [4, 2],
+                             // [2, 3, 8] axis -1 [3, 2], [3, 4, 5, 6] axis 2 [1, 3], [8, 4] axis 0 [5]
+                             testing::Values(0, 1, 2, 3, 4),
+                             // constant: none, data, indices
+                             testing::Values(0, 1, 2)));
+
+TEST_P(GatherLayerTest, GatherLayer) {
+    // get param
+    int shape      = std::get<0>(GetParam());
+    int constant   = std::get<1>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+
+    std::vector<std::vector<int>> data_dims    = {{10, 16}, {2, 6, 5}, {2, 3, 8}, {3, 4, 5, 6}, {8, 4}};
+    std::vector<std::vector<int>> indices_dims = {{2, 3}, {4, 2}, {3, 2}, {1, 3}, {5}};
+    std::vector<int> axes                      = {0, 1, -1, 2, 0};
+    // input blobs of the tests have at least 2 dims
+    if (indices_dims[shape].size() < 2 && constant != 2) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<GatherLayerParam> param(new GatherLayerParam());
+    param->name                = "Gather";
+    param->axis                = axes[shape];
+    param->data_in_resource    = constant == 1;
+    param->indices_in_resource = constant == 2;
+
+    // generate interpreter
+    std::vector<std::vector<int>> input_dims;
+    if (constant == 1) {
+        param->data_dims = data_dims[shape];
+        input_dims       = {indices_dims[shape]};
+    } else if (constant == 2) {
+        param->indices_dims = indices_dims[shape];
+        input_dims          = {data_dims[shape]};
+    } else {
+        input_dims = {data_dims[shape], indices_dims[shape]};
+    }
+    auto interpreter = GenerateInterpreter("Gather", input_dims, param);
+    Run(interpreter);
+}
+
+}  // namespace TNN_NS
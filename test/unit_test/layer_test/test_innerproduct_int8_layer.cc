@@ -34,7 +34,7 @@ TEST_P(InnerProductInt8LayerTest, InnerProductLayer) {
     int input_size     = std::get<2>(GetParam());
     int output_channel = std::get<3>(GetParam());
     DeviceType dev     = ConvertDeviceType(FLAGS_dt);
-    if (DEVICE_ARM != dev) {
+    if (DEVICE_ARM != dev && DEVICE_X86 != dev) {
         GTEST_SKIP();
     }
 
@@ -15,12 +15,14 @@
 #include "test/unit_test/layer_test/layer_test.h"
 #include "test/unit_test/unit_test_common.h"
 #include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
 #include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
 class InnerProductLayerTest : public LayerTest,
-                              public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, DataType>> {};
+                              public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, DataType, int>> {};
 
 INSTANTIATE_TEST_SUITE_P(LayerTest, InnerProductLayerTest,
                          ::testing::Combine(testing::Values(1, 2), testing::Values(1, 3, 10, 32),
@@ -28,7 +30,10 @@ INSTANTIATE_TEST_SUITE_P(LayerTest, InnerProductLayerTest,
                                             // output channel
                                             testing::Values(21, 50),
                                             // has bias Values(0, 1)));
-                                            testing::Values(0, 1), testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_BFP16)));
+                                            testing::Values(0, 1), testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_BFP16),
+                                            // fused activation
+                                            testing::Values(ActivationType_None, ActivationType_ReLU,
+                                                            ActivationType_ReLU6)));
 
 TEST_P(InnerProductLayerTest, InnerProductLayer) {
     // get param
@@ -37,18 +42,24 @@ TEST_P(InnerProductLayerTest, InnerProductLayer) {
     int input_size     = std::get<2>(GetParam());
     int output_channel = std::get<3>(GetParam());
     int has_bias       = std::get<4>(GetParam());
-    DataType dtype     = std::get<5>(GetParam());
-    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+    DataType dtype      = std::get<5>(GetParam());
+    int activation_type = std::get<6>(GetParam());
+    DeviceType dev      = ConvertDeviceType(FLAGS_dt);
     if (dtype != DATA_TYPE_FLOAT && (DEVICE_METAL == dev || DEVICE_OPENCL == dev || DEVICE_HUAWEI_NPU == dev)) {
         GTEST_SKIP();
     }
+    // the activation is fused into the inner product by the x86 network only
+    if (activation_type != ActivationType_None && DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
 
     // param
     std::shared_ptr<InnerProductLayerParam> param(new InnerProductLayerParam());
-    param->name       = "InnerProduct";
-    param->num_output = output_channel;
-    param->has_bias   = has_bias;
-    param->axis       = 1;
+    param->name            = "InnerProduct";
+    param->num_output      = output_channel;
+    param->has_bias        = has_bias;
+    param->axis            = 1;
+    param->activation_type = activation_type;
 
     // generate interpreter
     std::vector<int> input_dims = {batch, input_channel, input_size, input_size};
@@ -61,4 +72,88 @@ TEST_P(InnerProductLayerTest, InnerProductLayer) {
     Run(interpreter);
 }
 
+TEST(InnerProductFusionTest, SharedInterpreter) {
+    if (GetDevice(DEVICE_X86) == nullptr) {
+        GTEST_SKIP();
+    }
+    const DimsVector input_dims = {2, 16, 3, 3};
+    auto fc_param               = std::make_shared<InnerProductLayerParam>();
+    fc_param->num_output        = 20;
+    fc_param->has_bias          = 1;
+    fc_param->axis              = 1;
+    std::vector<std::shared_ptr<LayerInfo>> layers = {
+        CreateLayerInfo("InnerProduct", "fc", {"input0"}, {"fc"}, fc_param),
+        CreateLayerInfo("ReLU6", "relu6", {"fc"}, {"output0"}, std::make_shared<LayerParam>()),
+    };
+    auto interpreter   = GenerateNetInterpreter({input_dims}, layers);
+    auto net_structure = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter)->GetNetStructure();
+    auto net_resource  = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter)->GetNetResource();
+
+    NetworkConfig config;
+    config.device_type = DEVICE_X86;
+    config.precision   = PRECISION_HIGH;
+    // the x86 network fuses relu6 into the inner product on its own copy
+    NetStructure network_structure = *net_structure;
+    ASSERT_TRUE(optimizer::NetOptimizerManager::OptimizeNetwork(&network_structure, net_resource, config) == TNN_OK);
+    ASSERT_EQ(1, network_structure.layers.size());
+    auto fused_param = dynamic_cast<InnerProductLayerParam *>(network_structure.layers[0]->param.get());
+    EXPECT_EQ(ActivationType_ReLU6, fused_param->activation_type);
+    EXPECT_EQ(std::vector<std::string>{"output0"}, network_structure.layers[0]->outputs);
+    EXPECT_EQ(layers, net_structure->layers);
+    EXPECT_EQ(ActivationType_None, fc_param->activation_type);
+    EXPECT_EQ(std::vector<std::string>{"fc"}, layers[0]->outputs);
+
+    std::map<std::string, std::vector<float>> inputs;
+    inputs["input0"] = std::vector<float>(DimsVectorUtils::Count(input_dims));
+    InitRandom(inputs["input0"].data(), inputs["input0"].size(), 4.0f);
+    auto fused = CreateInstance(interpreter, config);
+    ASSERT_TRUE(fused != nullptr);
+    // the naive network created later runs the unfused layers
+    config.device_type = DEVICE_NAIVE;
+    auto unfused       = CreateInstance(interpreter, config);
+    ASSERT_TRUE(unfused != nullptr);
+
+    std::map<std::string, std::vector<float>> expects, outputs;
+    ASSERT_TRUE(ForwardInstance(unfused, inputs, expects) == TNN_OK);
+    ASSERT_TRUE(ForwardInstance(fused, inputs, outputs) == TNN_OK);
+    ASSERT_TRUE(OutputsNear(expects, outputs));
+}
+
+TEST(InnerProductReshapeTest, SwitchBatch) {
+    if (GetDevice(DEVICE_X86) == nullptr) {
+        GTEST_SKIP();
+    }
+    // batch 1 runs the sgemv, the others the gemm with the weights packed on the first reshape to them
+    std::vector<DimsVector> input_shapes = {{1, 16, 3, 3}, {3, 16, 3, 3}, {2, 16, 3, 3}};
+    auto fc_param                        = std::make_shared<InnerProductLayerParam>();
+    fc_param->num_output                 = 20;
+    fc_param->has_bias                   = 1;
+    fc_param->axis                       = 1;
+    fc_param->activation_type            = ActivationType_ReLU6;
+    std::vector<std::shared_ptr<LayerInfo>> layers = {
+        CreateLayerInfo("InnerProduct", "fc", {"input0"}, {"output0"}, fc_param),
+    };
+    auto interpreter = GenerateNetInterpreter({input_shapes[0]}, layers);
+
+    std::vector<std::map<std::string, std::vector<float>>> inputs(input_shapes.size());
+    std::vector<std::map<std::string, std::vector<float>>> expects(input_shapes.size());
+    for (int i = 0; i < input_shapes.size(); ++i) {
+        inputs[i]["input0"] = std::vector<float>(DimsVectorUtils::Count(input_shapes[i]));
+        InitRandom(inputs[i]["input0"].data(), inputs[i]["input0"].size(), 4.0f);
+        auto instance = CreateInstance(interpreter, DEVICE_NAIVE, {{"input0", input_shapes[i]}});
+        ASSERT_TRUE(instance != nullptr);
+        ASSERT_TRUE(ForwardInstance(instance, inputs[i], expects[i]) == TNN_OK);
+    }
+
+    auto instance = CreateInstance(interpreter, DEVICE_X86);
+    ASSERT_TRUE(instance != nullptr);
+    for (int step = 0; step < 6; ++step) {
+        const int index = (step + 1) % input_shapes.size();
+        ASSERT_TRUE(instance->Reshape({{"input0", input_shapes[index]}}) == TNN_OK);
+        std::map<std::string, std::vector<float>> outputs;
+        ASSERT_TRUE(ForwardInstance(instance, inputs[index], outputs) == TNN_OK);
+        ASSERT_TRUE(OutputsNear(expects[index], outputs)) << "step " << step;
+    }
+}
+
 }  // namespace TNN_NS
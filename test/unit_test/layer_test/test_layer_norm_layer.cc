@@ -0,0 +1,77 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class LayerNormLayerTest : public LayerTest, public ::testing::WithParamInterface<std::tuple<int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, LayerNormLayerTest,
+                         ::testing::Combine(
+                             // rank, reduce_dims_size
+                             testing::Values(3, 4), testing::Values(1, 2),
+                             // channel, the last dim
+                             testing::Values(7, 16, 768)));
+
+TEST_P(LayerNormLayerTest, LayerNormLayer) {
+    // get param
+    int rank             = std::get<0>(GetParam());
+    int reduce_dims_size = std::get<1>(GetParam());
+    int channel          = std::get<2>(GetParam());
+    DeviceType dev       = ConvertDeviceType(FLAGS_dt);
+    if (DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<LayerNormLayerParam> param(new LayerNormLayerParam());
+    param->name             = "LayerNorm";
+    param->reduce_dims_size = reduce_dims_size;
+
+    // generate interpreter
+    std::vector<int> input_dims = rank == 3 ? std::vector<int>({2, 5, channel}) : std::vector<int>({2, 3, 4, channel});
+    auto interpreter            = GenerateInterpreter("LayerNorm", {input_dims}, param);
+    Run(interpreter);
+}
+
+TEST(LayerNormResourceTest, ScaleSizeMismatch) {
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<LayerNormLayerParam> param(new LayerNormLayerParam());
+    param->name             = "LayerNorm";
+    param->reduce_dims_size = 1;
+    const std::vector<int> input_dims = {2, 5, 16};
+
+    // the scale and bias of the 16 normalized values, one of them too short
+    for (int short_index = 0; short_index < 2; ++short_index) {
+        std::shared_ptr<LayerNormLayerResource> resource(new LayerNormLayerResource());
+        RawBuffer scale((input_dims[2] - (short_index == 0)) * sizeof(float));
+        RawBuffer bias((input_dims[2] - (short_index == 1)) * sizeof(float));
+        scale.SetDataType(DATA_TYPE_FLOAT);
+        bias.SetDataType(DATA_TYPE_FLOAT);
+        resource->scale_handle = scale;
+        resource->bias_handle  = bias;
+
+        auto interpreter = GenerateInterpreter("LayerNorm", {input_dims}, param, resource);
+        EXPECT_TRUE(CreateInstance(interpreter, dev) == nullptr) << "short " << (short_index ? "bias" : "scale");
+    }
+}
+
+}  // namespace TNN_NS
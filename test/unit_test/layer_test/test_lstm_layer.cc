@@ -0,0 +1,81 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class LstmLayerTest : public LayerTest,
+                      public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, LstmLayerTest,
+                         ::testing::Combine(
+                             // sequence, batch, input size, hidden size
+                             testing::Values(1, 5), testing::Values(1, 2), testing::Values(3, 16),
+                             testing::Values(5, 16),
+                             // direction: forward, reverse, bidirectional
+                             testing::Values(0, 1, 2),
+                             // sequence_lens
+                             testing::Values(0, 1),
+                             // initial_h and initial_c
+                             testing::Values(0, 1)));
+
+TEST_P(LstmLayerTest, LstmLayer) {
+    // get param
+    int sequence          = std::get<0>(GetParam());
+    int batch             = std::get<1>(GetParam());
+    int input_size        = std::get<2>(GetParam());
+    int hidden_size       = std::get<3>(GetParam());
+    int direction         = std::get<4>(GetParam());
+    int has_sequence_lens = std::get<5>(GetParam());
+    int has_initial_state = std::get<6>(GetParam());
+    DeviceType dev        = ConvertDeviceType(FLAGS_dt);
+    if (DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<LSTMLayerParam> param(new LSTMLayerParam());
+    param->name              = "Lstm";
+    param->hidden_size       = hidden_size;
+    param->direction         = direction;
+    param->has_sequence_lens = has_sequence_lens;
+
+    // generate interpreter
+    int num_directions = direction == 2 ? 2 : 1;
+    std::vector<std::vector<int>> input_dims = {{sequence, batch, input_size, 1}};
+    if (has_sequence_lens) {
+        input_dims.push_back({batch, 1, 1, 1});
+        // lengths in [1, sequence], shorter than the sequence where it is long enough, so that the
+        // reverse direction starts inside the sequence
+        std::vector<float> sequence_lens(batch);
+        for (int b = 0; b < batch; b++) {
+            sequence_lens[b] = std::max(1, sequence - 1 - 2 * b);
+        }
+        fixed_input_data_["input1"] = sequence_lens;
+    }
+    if (has_initial_state) {
+        input_dims.push_back({num_directions, batch, hidden_size, 1});
+        input_dims.push_back({num_directions, batch, hidden_size, 1});
+    }
+    auto interpreter = GenerateInterpreter("Lstm", input_dims, param, nullptr, 3);
+    Run(interpreter);
+}
+
+}  // namespace TNN_NS
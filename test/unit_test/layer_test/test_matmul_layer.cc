@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class MatMulLayerTest : public LayerTest,
+                        public ::testing::WithParamInterface<std::tuple<int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, MatMulLayerTest,
+                         ::testing::Combine(
+                             // shape: [M, K] x [K, N], [2, 3, M, K] x [2, 3, K, N], [2, 1, M, K] x [3, K, N],
+                             // [2, M, K] x [K, N]
+                             testing::Values(0, 1, 2, 3),
+                             // weight_position: both inputs, constant A, constant B
+                             testing::Values(-1, 0, 1),
+                             // M, N, K
+                             testing::Values(1, 5, 17), testing::Values(1, 7, 32), testing::Values(3, 64)));
+
+TEST_P(MatMulLayerTest, MatMulLayer) {
+    // get param
+    int shape           = std::get<0>(GetParam());
+    int weight_position = std::get<1>(GetParam());
+    int M               = std::get<2>(GetParam());
+    int N               = std::get<3>(GetParam());
+    int K               = std::get<4>(GetParam());
+    DeviceType dev      = ConvertDeviceType(FLAGS_dt);
+    if (DEVICE_X86 != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+
+    std::vector<int> a_dims = {M, K};
+    std::vector<int> b_dims = {K, N};
+    if (shape == 1) {
+        a_dims = {2, 3, M, K};
+        b_dims = {2, 3, K, N};
+    } else if (shape == 2) {
+        a_dims = {2, 1, M, K};
+        b_dims = {3, K, N};
+    } else if (shape == 3) {
+        a_dims = {2, M, K};
+    }
+
+    // param
+    std::shared_ptr<MatMulLayerParam> param(new MatMulLayerParam());
+    param->name            = "MatMul";
+    param->weight_position = weight_position;
+
+    // generate interpreter
+    std::vector<std::vector<int>> input_dims;
+    if (weight_position == 0) {
+        param->weight_dims = a_dims;
+        input_dims         = {b_dims};
+    } else if (weight_position == 1) {
+        param->weight_dims = b_dims;
+        input_dims         = {a_dims};
+    } else {
+        input_dims = {a_dims, b_dims};
+    }
+    auto interpreter = GenerateInterpreter("MatMul", input_dims, param);
+    Run(interpreter);
+}
+
+}  // namespace TNN_NS
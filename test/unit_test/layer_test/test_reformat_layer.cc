@@ -36,7 +36,7 @@ TEST_P(ReformatLayerTest, ReformatLayer) {
     int input_size           = std::get<2>(GetParam());
     DataType input_data_type = std::get<3>(GetParam());
     DeviceType dev           = ConvertDeviceType(FLAGS_dt);
-    if (DEVICE_ARM != dev) {
+    if (DEVICE_ARM != dev && DEVICE_X86 != dev) {
         GTEST_SKIP();
     }
 
@@ -0,0 +1,189 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/mat_utils.h"
+
+namespace TNN_NS {
+
+enum PreprocessGeometry {
+    // resize the whole src
+    PREPROCESS_RESIZE = 0,
+    // crop, resize and letterbox border
+    PREPROCESS_CROP_BORDER = 1,
+    PREPROCESS_WARP_AFFINE = 2,
+};
+
+class MatPreprocessTest : public ::testing::TestWithParam<std::tuple<MatType, InterpType, PreprocessGeometry>> {
+protected:
+    void SetUp() override {
+        device_type_ = ConvertDeviceType(FLAGS_dt);
+        auto device  = GetDevice(device_type_);
+        if (device) {
+            context_.reset(device->CreateContext(0));
+        }
+    }
+
+    std::shared_ptr<Mat> CreateMat(MatType mat_type, DimsVector dims) {
+        return std::make_shared<Mat>(device_type_, mat_type, dims);
+    }
+
+    // the unfused path: each op writes a uint8 mat, the last one is converted to float as SetInputMat does
+    Status RunSeparateOps(std::shared_ptr<Mat> src, std::shared_ptr<Mat> dst, PreprocessParam& param,
+                          void* command_queue) {
+        const int batch = src->GetBatch();
+        auto mat        = src;
+        if (!param.use_warp_affine && param.crop.width > 0) {
+            auto cropped = CreateMat(mat->GetMatType(),
+                                     {batch, mat->GetChannel(), param.crop.height, param.crop.width});
+            RETURN_ON_NEQ(MatUtils::Crop(*mat, *cropped, param.crop, command_queue), TNN_OK);
+            mat = cropped;
+        }
+        if (mat->GetMatType() == NNV12 || mat->GetMatType() == NNV21) {
+            auto bgr      = CreateMat(N8UC3, {batch, 3, mat->GetHeight(), mat->GetWidth()});
+            auto cvt_type = mat->GetMatType() == NNV12 ? COLOR_CONVERT_NV12TOBGR : COLOR_CONVERT_NV21TOBGR;
+            RETURN_ON_NEQ(MatUtils::CvtColor(*mat, *bgr, cvt_type, command_queue), TNN_OK);
+            mat = bgr;
+        }
+
+        const int mat_channel = mat->GetChannel();
+        if (param.use_warp_affine) {
+            auto warped = CreateMat(mat->GetMatType(), {batch, mat_channel, dst->GetHeight(), dst->GetWidth()});
+            RETURN_ON_NEQ(MatUtils::WarpAffine(*mat, *warped, param.warp_affine, command_queue), TNN_OK);
+            mat = warped;
+        } else {
+            auto& border = param.border;
+            auto resized = CreateMat(mat->GetMatType(),
+                                     {batch, mat_channel, dst->GetHeight() - border.top - border.bottom,
+                                      dst->GetWidth() - border.left - border.right});
+            ResizeParam resize_param;
+            resize_param.type = param.interp_type;
+            RETURN_ON_NEQ(MatUtils::Resize(*mat, *resized, resize_param, command_queue), TNN_OK);
+            auto bordered = CreateMat(mat->GetMatType(), {batch, mat_channel, dst->GetHeight(), dst->GetWidth()});
+            RETURN_ON_NEQ(MatUtils::CopyMakeBorder(*resized, *bordered, border, command_queue), TNN_OK);
+            mat = bordered;
+        }
+
+        auto host = std::make_shared<Mat>(DEVICE_NAIVE, mat->GetMatType(), mat->GetDims());
+        RETURN_ON_NEQ(MatUtils::Copy(*mat, *host, command_queue), TNN_OK);
+        const uint8_t* src_data = static_cast<uint8_t*>(host->GetData());
+        float* dst_data         = static_cast<float*>(dst->GetData());
+        const int channel       = dst->GetChannel();
+        const int plane_size    = dst->GetHeight() * dst->GetWidth();
+        for (int n = 0; n < batch; ++n) {
+            for (int c = 0; c < channel; ++c) {
+                const int src_c = param.convert_param.reverse_channel && c < 3 ? 2 - c : c;
+                for (int i = 0; i < plane_size; ++i) {
+                    float value = src_data[(n * plane_size + i) * mat_channel + src_c];
+                    dst_data[(n * channel + c) * plane_size + i] =
+                        param.convert_param.scale[c] * value + param.convert_param.bias[c];
+                }
+            }
+        }
+        return TNN_OK;
+    }
+
+    DeviceType device_type_;
+    std::shared_ptr<Context> context_;
+};
+
+INSTANTIATE_TEST_SUITE_P(MatPreprocessTest, MatPreprocessTest,
+                         ::testing::Combine(testing::Values(N8UC3, N8UC4, NGRAY, NNV12, NNV21),
+                                            testing::Values(INTERP_TYPE_LINEAR, INTERP_TYPE_NEAREST),
+                                            testing::Values(PREPROCESS_RESIZE, PREPROCESS_CROP_BORDER,
+                                                            PREPROCESS_WARP_AFFINE)));
+
+TEST_P(MatPreprocessTest, SameAsSeparateOps) {
+    const MatType mat_type            = std::get<0>(GetParam());
+    const InterpType interp_type      = std::get<1>(GetParam());
+    const PreprocessGeometry geometry = std::get<2>(GetParam());
+    const bool is_yuv                 = mat_type == NNV12 || mat_type == NNV21;
+    // Preprocess runs on the host devices, the separate path of yuv needs CvtColor of arm or x86
+    if ((device_type_ != DEVICE_ARM && device_type_ != DEVICE_X86 && device_type_ != DEVICE_NAIVE) ||
+        (is_yuv && device_type_ == DEVICE_NAIVE)) {
+        GTEST_SKIP();
+    }
+    ASSERT_TRUE(context_ != nullptr);
+    void* command_queue = nullptr;
+    context_->GetCommandQueue(&command_queue);
+
+    // CvtColor reads a batch of yuv as one tall image, the other ops take the planes of each batch
+    const int batch       = is_yuv ? 1 : 2;
+    const int src_height  = 48;
+    const int src_width   = 64;
+    const int src_channel = mat_type == NGRAY ? 1 : (mat_type == N8UC4 ? 4 : 3);
+    // bgra is converted to a 3 channel input
+    const int channel = mat_type == NGRAY ? 1 : 3;
+
+    DimsVector src_dims = {batch, src_channel, src_height, src_width};
+    const int src_bytes = is_yuv ? batch * src_height * src_width * 3 / 2 : DimsVectorUtils::Count(src_dims);
+    std::vector<uint8_t> src_data(src_bytes);
+    InitRandom(src_data.data(), src_data.size(), static_cast<uint8_t>(0), static_cast<uint8_t>(255));
+    Mat host_src(DEVICE_NAIVE, mat_type, src_dims, src_data.data());
+    auto src = CreateMat(mat_type, src_dims);
+    ASSERT_TRUE(MatUtils::Copy(host_src, *src, command_queue) == TNN_OK);
+
+    PreprocessParam param;
+    param.interp_type                   = interp_type;
+    param.convert_param.scale           = {0.017f, 0.018f, 0.0175f, 0.5f};
+    param.convert_param.bias            = {-2.1f, -2.0f, -1.8f, 0.0f};
+    param.convert_param.reverse_channel = channel == 3 && geometry != PREPROCESS_RESIZE;
+    DimsVector dst_dims                 = {batch, channel, 30, 40};
+    if (geometry == PREPROCESS_CROP_BORDER) {
+        param.crop.top_left_x   = 6;
+        param.crop.top_left_y   = 4;
+        param.crop.width        = 44;
+        param.crop.height       = 32;
+        param.border.top        = 4;
+        param.border.bottom     = 6;
+        param.border.left       = 2;
+        param.border.right      = 6;
+        param.border.border_val = 114.0f;
+        dst_dims                = {batch, channel, 40, 48};
+    } else if (geometry == PREPROCESS_WARP_AFFINE) {
+        // scale down with a small rotation, the corners of dst fall out of src
+        param.use_warp_affine         = true;
+        param.warp_affine.interp_type = interp_type;
+        param.warp_affine.border_val  = 50.0f;
+        float transform[2][3]         = {{0.6f, 0.1f, -3.0f}, {-0.08f, 0.62f, 2.5f}};
+        memcpy(param.warp_affine.transform, transform, sizeof(transform));
+    }
+
+    auto expect = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, dst_dims);
+    auto output = CreateMat(NCHW_FLOAT, dst_dims);
+    auto actual = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, dst_dims);
+    ASSERT_TRUE(RunSeparateOps(src, expect, param, command_queue) == TNN_OK);
+    Status status = MatUtils::Preprocess(*src, *output, param, command_queue);
+    ASSERT_TRUE(status == TNN_OK) << status.description();
+    ASSERT_TRUE(MatUtils::Copy(*output, *actual, command_queue) == TNN_OK);
+
+    // the separate ops round every step to uint8, the fused pass keeps the interpolation in float
+    const float* expect_data = static_cast<float*>(expect->GetData());
+    const float* actual_data = static_cast<float*>(actual->GetData());
+    const int plane_size     = dst_dims[2] * dst_dims[3];
+    for (int i = 0; i < DimsVectorUtils::Count(dst_dims); ++i) {
+        const int c = (i / plane_size) % channel;
+        ASSERT_NEAR(expect_data[i], actual_data[i], 1.0f * param.convert_param.scale[c] + 1e-4f) << "at " << i;
+    }
+}
+
+}  // namespace TNN_NS
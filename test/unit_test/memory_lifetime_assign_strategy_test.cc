@@ -0,0 +1,130 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "tnn/core/macro.h"
+#include "tnn/memory_manager/blob_1d_memory.h"
+#include "tnn/memory_manager/memory_lifetime_assign_strategy.h"
+
+namespace TNN_NS {
+
+class MemoryLifetimeAssignStrategyTest : public ::testing::TestWithParam<int> {
+protected:
+    // plan the lifetimes and return the offset assigned to each blob memory
+    std::vector<int> Assign(std::vector<BlobMemoryLifetime>& lifetimes, int* planned_size) {
+        MemoryLifetimeAssignStrategy strategy(lifetimes);
+        strategy.SetMemory(nullptr);
+        std::set<BlobMemory*> library;
+        for (auto& lifetime : lifetimes) {
+            library.insert(lifetime.blob_memory);
+        }
+        EXPECT_TRUE(strategy.AssignAllBlobMemory(library) == TNN_OK);
+
+        std::vector<int> offsets;
+        for (auto& lifetime : lifetimes) {
+            offsets.push_back(lifetime.blob_memory->GetHandle().bytes_offset);
+        }
+        *planned_size = strategy.GetPlannedMemorySize();
+        return offsets;
+    }
+
+    BlobMemory* CreateBlobMemory(int count) {
+        BlobMemorySizeInfo size_info;
+        size_info.data_type = DATA_TYPE_FLOAT;
+        size_info.dims      = {count};
+        memories_.emplace_back(new Blob1DMemory(GetDevice(DEVICE_NAIVE), size_info));
+        return memories_.back().get();
+    }
+
+    int GetBytesSize(BlobMemory* blob_memory) {
+        BlobMemorySizeInfo size_info = blob_memory->GetBlobMemorySizeInfo();
+        return GetBlobMemoryBytesSize(size_info);
+    }
+
+    std::vector<std::shared_ptr<BlobMemory>> memories_;
+};
+
+INSTANTIATE_TEST_SUITE_P(MemoryLifetimeAssignStrategyTest, MemoryLifetimeAssignStrategyTest,
+                         testing::Values(1, 2, 3, 5, 8, 16, 64, 200));
+
+TEST_P(MemoryLifetimeAssignStrategyTest, NoOverlapOfLiveBlobs) {
+    const int blob_count  = GetParam();
+    const int layer_count = 32;
+    std::mt19937 rng(blob_count);
+    std::uniform_int_distribution<int> layer_dist(0, layer_count - 1);
+    std::uniform_int_distribution<int> count_dist(1, 4096);
+
+    std::vector<BlobMemoryLifetime> lifetimes;
+    for (int i = 0; i < blob_count; ++i) {
+        BlobMemoryLifetime lifetime;
+        lifetime.blob_memory = CreateBlobMemory(count_dist(rng));
+        int first            = layer_dist(rng);
+        int last             = layer_dist(rng);
+        lifetime.first_use   = std::min(first, last);
+        lifetime.last_use    = std::max(first, last);
+        lifetimes.push_back(lifetime);
+    }
+
+    int planned_size = 0;
+    auto offsets     = Assign(lifetimes, &planned_size);
+
+    int total_size = 0;
+    for (int i = 0; i < blob_count; ++i) {
+        int size_i = GetBytesSize(lifetimes[i].blob_memory);
+        total_size += ROUND_UP(size_i, 64);
+        EXPECT_EQ(0, offsets[i] % 64);
+        EXPECT_LE(offsets[i] + size_i, planned_size);
+        for (int j = 0; j < i; ++j) {
+            bool alive_together = lifetimes[i].first_use <= lifetimes[j].last_use &&
+                                  lifetimes[j].first_use <= lifetimes[i].last_use;
+            if (!alive_together) {
+                continue;
+            }
+            int size_j = GetBytesSize(lifetimes[j].blob_memory);
+            bool disjoint = offsets[i] + size_i <= offsets[j] || offsets[j] + size_j <= offsets[i];
+            EXPECT_TRUE(disjoint) << "blob " << i << " [" << lifetimes[i].first_use << ", "
+                                  << lifetimes[i].last_use << "] and blob " << j << " ["
+                                  << lifetimes[j].first_use << ", " << lifetimes[j].last_use << "] overlap";
+        }
+    }
+    EXPECT_LE(planned_size, total_size);
+}
+
+TEST_F(MemoryLifetimeAssignStrategyTest, ReuseInChain) {
+    // a chain of layers: each blob is alive from its producer to its consumer,
+    // two buffers are enough for the whole chain
+    std::vector<BlobMemoryLifetime> lifetimes;
+    for (int i = 0; i < 6; ++i) {
+        BlobMemoryLifetime lifetime;
+        lifetime.blob_memory = CreateBlobMemory(1024);
+        lifetime.first_use   = i;
+        lifetime.last_use    = i + 1;
+        lifetimes.push_back(lifetime);
+    }
+
+    int planned_size = 0;
+    auto offsets     = Assign(lifetimes, &planned_size);
+    EXPECT_EQ(2 * 1024 * sizeof(float), static_cast<size_t>(planned_size));
+    for (int i = 1; i < offsets.size(); ++i) {
+        EXPECT_NE(offsets[i - 1], offsets[i]);
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,111 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/interpreter/tnn/objseri.h"
+
+namespace TNN_NS {
+
+class ModelPackerTest : public ::testing::TestWithParam<std::tuple<int, ModelType>> {};
+
+INSTANTIATE_TEST_SUITE_P(ModelPackerTest, ModelPackerTest,
+                         ::testing::Combine(testing::Values(1, 2),
+                                            testing::Values(MODEL_TYPE_TNN, MODEL_TYPE_TNN_MMAP)));
+
+static std::string ReadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static void ExpectSameBuffer(RawBuffer& expect, RawBuffer& actual) {
+    ASSERT_EQ(expect.GetBytesSize(), actual.GetBytesSize());
+    EXPECT_EQ(expect.GetDataType(), actual.GetDataType());
+    EXPECT_EQ(0, memcmp(expect.force_to<char*>(), actual.force_to<char*>(), expect.GetBytesSize()));
+}
+
+TEST_P(ModelPackerTest, PackAndLoad) {
+    int version           = std::get<0>(GetParam());
+    ModelType model_type  = std::get<1>(GetParam());
+    const int channel     = 3;
+    const int out_channel = 7;
+
+    // a conv with odd sized weights, so that buffers after it are not aligned by chance
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->name           = "layer_name";
+    param->input_channel  = channel;
+    param->output_channel = out_channel;
+    param->group          = 1;
+    param->kernels        = {3, 3};
+    param->strides        = {1, 1};
+    param->pads           = {1, 1, 1, 1};
+    param->dialations     = {1, 1};
+    param->bias           = 1;
+
+    std::shared_ptr<ConvLayerResource> resource(new ConvLayerResource());
+    const int filter_count = out_channel * channel * 3 * 3;
+    resource->filter_handle = RawBuffer(filter_count * sizeof(float));
+    resource->bias_handle   = RawBuffer(out_channel * sizeof(float));
+    InitRandom(resource->filter_handle.force_to<float*>(), filter_count, 1.0f);
+    InitRandom(resource->bias_handle.force_to<float*>(), out_channel, 1.0f);
+
+    auto src_interpreter = GenerateInterpreter("Convolution", {{1, channel, 8, 8}}, param, resource);
+    auto src             = std::dynamic_pointer_cast<DefaultModelInterpreter>(src_interpreter);
+    ASSERT_TRUE(src != nullptr);
+
+    std::ostringstream prefix;
+    prefix << testing::TempDir() << "model_packer_test_v" << version << "_" << model_type;
+    const std::string proto_path = prefix.str() + ".tnnproto";
+    const std::string model_path = prefix.str() + ".tnnmodel";
+
+    ModelPacker packer(src->GetNetStructure(), src->GetNetResource());
+    packer.SetVersion(version);
+    ASSERT_TRUE(packer.Pack(proto_path, model_path) == TNN_OK);
+
+    std::vector<std::string> params = {ReadFile(proto_path)};
+    params.push_back(model_type == MODEL_TYPE_TNN_MMAP ? model_path : ReadFile(model_path));
+    std::shared_ptr<AbstractModelInterpreter> dst_interpreter(CreateModelInterpreter(model_type));
+    ASSERT_TRUE(dst_interpreter != nullptr);
+    ASSERT_TRUE(dst_interpreter->Interpret(params) == TNN_OK);
+
+    auto dst = std::dynamic_pointer_cast<DefaultModelInterpreter>(dst_interpreter);
+    ASSERT_TRUE(dst != nullptr);
+    auto& resource_map = dst->GetNetResource()->resource_map;
+    ASSERT_TRUE(resource_map.find("layer_name") != resource_map.end());
+    auto loaded = std::dynamic_pointer_cast<ConvLayerResource>(resource_map["layer_name"]);
+    ASSERT_TRUE(loaded != nullptr);
+
+    ExpectSameBuffer(resource->filter_handle, loaded->filter_handle);
+    ExpectSameBuffer(resource->bias_handle, loaded->bias_handle);
+    if (version >= 2 && model_type == MODEL_TYPE_TNN_MMAP) {
+        // v2 weights reference the mapped file in place
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(loaded->filter_handle.force_to<char*>()) % g_model_data_alignment);
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(loaded->bias_handle.force_to<char*>()) % g_model_data_alignment);
+    }
+
+    std::remove(proto_path.c_str());
+    std::remove(model_path.c_str());
+}
+
+}  // namespace TNN_NS
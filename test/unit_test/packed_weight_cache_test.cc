@@ -0,0 +1,142 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class PackedWeightCacheTest : public ::testing::TestWithParam<ModelType> {
+protected:
+    // a model file of a conv with random weights, all of them have the same proto
+    void PackModel(const std::string& proto_path, const std::string& model_path) {
+        std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+        param->name           = "conv";
+        param->input_channel  = kChannel;
+        param->output_channel = kChannel;
+        param->group          = 1;
+        param->kernels        = {3, 3};
+        param->strides        = {1, 1};
+        param->pads           = {1, 1, 1, 1};
+        param->dialations     = {1, 1};
+        param->bias           = 1;
+
+        std::shared_ptr<ConvLayerResource> resource(new ConvLayerResource());
+        const int filter_count  = kChannel * kChannel * 3 * 3;
+        resource->filter_handle = RawBuffer(filter_count * sizeof(float));
+        resource->bias_handle   = RawBuffer(kChannel * sizeof(float));
+        InitRandom(resource->filter_handle.force_to<float*>(), filter_count, 1.0f);
+        InitRandom(resource->bias_handle.force_to<float*>(), kChannel, 1.0f);
+
+        auto interpreter = GenerateInterpreter("Convolution", {input_dims_}, param, resource);
+        auto src         = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter);
+        ASSERT_TRUE(src != nullptr);
+        // a replaced model file is a new file, the mapping of the old one stays valid
+        std::remove(model_path.c_str());
+        ModelPacker packer(src->GetNetStructure(), src->GetNetResource());
+        packer.SetVersion(2);
+        ASSERT_TRUE(packer.Pack(proto_path, model_path) == TNN_OK);
+    }
+
+    std::string ReadFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // an instance created from the model as an app does, params hold the model content or its path
+    std::shared_ptr<Instance> CreateModelInstance(ModelType model_type, DeviceType device_type,
+                                                  const std::string& proto_path, const std::string& model_path,
+                                                  std::string* model_md5) {
+        ModelConfig model_config;
+        model_config.model_type = model_type;
+        model_config.params     = {ReadFile(proto_path)};
+        model_config.params.push_back(model_type == MODEL_TYPE_TNN_MMAP ? model_path : ReadFile(model_path));
+        std::shared_ptr<AbstractModelInterpreter> interpreter(CreateModelInterpreter(model_type));
+        if (!interpreter || interpreter->Interpret(model_config.params) != TNN_OK) {
+            return nullptr;
+        }
+        *model_md5 = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter)->GetModelMd5();
+
+        NetworkConfig config;
+        config.device_type = device_type;
+        config.precision   = PRECISION_HIGH;
+        auto instance      = std::make_shared<Instance>(config, model_config);
+        if (instance->Init(interpreter, {}) != TNN_OK) {
+            return nullptr;
+        }
+        return instance;
+    }
+
+    static const int kChannel = 16;
+    DimsVector input_dims_    = {1, kChannel, 12, 10};
+};
+
+INSTANTIATE_TEST_SUITE_P(PackedWeightCacheTest, PackedWeightCacheTest,
+                         testing::Values(MODEL_TYPE_TNN, MODEL_TYPE_TNN_MMAP));
+
+TEST_P(PackedWeightCacheTest, DifferentWeightsNotShared) {
+    const ModelType model_type   = GetParam();
+    const DeviceType device_type = ConvertDeviceType(FLAGS_dt);
+    std::ostringstream prefix;
+    prefix << testing::TempDir() << "packed_weight_cache_test_" << model_type;
+    const std::string proto_path = prefix.str() + ".tnnproto";
+    const std::string model_path = prefix.str() + ".tnnmodel";
+
+    std::map<std::string, std::vector<float>> inputs;
+    inputs["input0"] = std::vector<float>(DimsVectorUtils::Count(input_dims_));
+    InitRandom(inputs["input0"].data(), inputs["input0"].size(), 1.0f);
+
+    // the second model replaces the first one at the same path, while the instance of the first one is alive
+    std::vector<std::shared_ptr<Instance>> instances;
+    std::vector<std::string> model_md5s(2);
+    std::vector<std::map<std::string, std::vector<float>>> expects(2);
+    for (int i = 0; i < 2; ++i) {
+        PackModel(proto_path, model_path);
+        std::string naive_md5;
+        auto naive = CreateModelInstance(model_type, DEVICE_NAIVE, proto_path, model_path, &naive_md5);
+        ASSERT_TRUE(naive != nullptr);
+        ASSERT_TRUE(ForwardInstance(naive, inputs, expects[i]) == TNN_OK);
+
+        auto instance = CreateModelInstance(model_type, device_type, proto_path, model_path, &model_md5s[i]);
+        ASSERT_TRUE(instance != nullptr);
+        EXPECT_EQ(naive_md5, model_md5s[i]);
+        instances.push_back(instance);
+    }
+    EXPECT_FALSE(model_md5s[0].empty());
+    EXPECT_NE(model_md5s[0], model_md5s[1]);
+
+    for (int i = 0; i < 2; ++i) {
+        std::map<std::string, std::vector<float>> outputs;
+        ASSERT_TRUE(ForwardInstance(instances[i], inputs, outputs) == TNN_OK);
+        ASSERT_TRUE(OutputsNear(expects[i], outputs)) << "model " << i;
+    }
+
+    std::remove(proto_path.c_str());
+    std::remove(model_path.c_str());
+}
+
+}  // namespace TNN_NS
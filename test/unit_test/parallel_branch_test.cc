@@ -0,0 +1,121 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+static std::shared_ptr<ConvLayerParam> CreateConvParam(int channel, int kernel) {
+    auto param            = std::make_shared<ConvLayerParam>();
+    param->input_channel  = channel;
+    param->output_channel = channel;
+    param->group          = 1;
+    param->kernels        = {kernel, kernel};
+    param->dialations     = {1, 1};
+    param->strides        = {1, 1};
+    param->pads           = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+    param->bias           = 1;
+    return param;
+}
+
+/*
+ * an inception like block: three branches of different sizes read the input and are
+ * concatenated, followed by a conv that reads the concat
+ */
+static std::shared_ptr<AbstractModelInterpreter> GenerateBranchInterpreter(std::vector<int> input_dims) {
+    const int channel          = input_dims[1];
+    auto pool_param            = std::make_shared<PoolingLayerParam>();
+    pool_param->pool_type      = 0;
+    pool_param->pad_type       = -1;
+    pool_param->kernels_params = {3, 3};
+    pool_param->kernels        = {3, 3};
+    pool_param->strides        = {1, 1};
+    pool_param->pads           = {1, 1, 1, 1};
+    pool_param->kernel_indexs  = {-1, -1};
+    auto concat_param          = std::make_shared<ConcatLayerParam>();
+    concat_param->axis         = 1;
+    auto tail_param            = CreateConvParam(channel * 3, 1);
+    tail_param->output_channel = channel;
+
+    std::vector<std::shared_ptr<LayerInfo>> layers = {
+        CreateLayerInfo("Convolution", "conv_a", {"input0"}, {"conv_a"}, CreateConvParam(channel, 1)),
+        CreateLayerInfo("Convolution", "conv_b", {"input0"}, {"conv_b"}, CreateConvParam(channel, 3)),
+        CreateLayerInfo("Pooling", "pool_c", {"input0"}, {"pool_c"}, pool_param),
+        CreateLayerInfo("ReLU", "relu_a", {"conv_a"}, {"relu_a"}, std::make_shared<LayerParam>()),
+        CreateLayerInfo("Sigmoid", "sigmoid_b", {"conv_b"}, {"sigmoid_b"}, std::make_shared<LayerParam>()),
+        CreateLayerInfo("Concat", "concat", {"relu_a", "sigmoid_b", "pool_c"}, {"concat"}, concat_param),
+        CreateLayerInfo("Convolution", "tail", {"concat"}, {"output0"}, tail_param),
+    };
+    return GenerateNetInterpreter({input_dims}, layers);
+}
+
+TEST(ParallelBranchTest, LayerSteps) {
+    auto interpreter   = GenerateBranchInterpreter({1, 8, 16, 16});
+    auto net_structure = std::dynamic_pointer_cast<DefaultModelInterpreter>(interpreter)->GetNetStructure();
+
+    NetworkConfig config;
+    config.device_type              = DEVICE_X86;
+    config.enable_parallel_branches = true;
+    auto steps                      = GetLayerStepsFromNetStructure(net_structure, config);
+#ifdef _OPENMP
+    std::vector<std::vector<int>> expect_steps = {{0, 1, 2}, {3, 4}, {5}, {6}};
+#else
+    std::vector<std::vector<int>> expect_steps = {{0}, {1}, {2}, {3}, {4}, {5}, {6}};
+#endif
+    EXPECT_EQ(expect_steps, steps);
+
+    // sequential without the flag
+    config.enable_parallel_branches = false;
+    EXPECT_EQ(net_structure->layers.size(), GetLayerStepsFromNetStructure(net_structure, config).size());
+}
+
+TEST(ParallelBranchTest, SameAsSequential) {
+    // the branches only run together on x86 with more than one thread, the context caps them to the cpu cores
+    if (ConvertDeviceType(FLAGS_dt) != DEVICE_X86 || OMP_CORES_ < 2) {
+        GTEST_SKIP();
+    }
+    const DimsVector input_dims = {1, 8, 16, 16};
+    auto interpreter            = GenerateBranchInterpreter(input_dims);
+
+    std::map<std::string, std::vector<float>> inputs;
+    inputs["input0"] = std::vector<float>(DimsVectorUtils::Count(input_dims));
+    InitRandom(inputs["input0"].data(), inputs["input0"].size(), 1.0f);
+
+    NetworkConfig config;
+    config.device_type = ConvertDeviceType(FLAGS_dt);
+    config.precision   = PRECISION_HIGH;
+    auto sequential    = CreateInstance(interpreter, config);
+    ASSERT_TRUE(sequential != nullptr);
+    config.enable_parallel_branches = true;
+    auto parallel                   = CreateInstance(interpreter, config);
+    ASSERT_TRUE(parallel != nullptr);
+    parallel->SetCpuNumThreads(OMP_CORES_);
+
+    std::map<std::string, std::vector<float>> expects;
+    ASSERT_TRUE(ForwardInstance(sequential, inputs, expects) == TNN_OK);
+    for (int run = 0; run < 3; ++run) {
+        std::map<std::string, std::vector<float>> outputs;
+        ASSERT_TRUE(ForwardInstance(parallel, inputs, outputs) == TNN_OK);
+        ASSERT_TRUE(OutputsNear(expects, outputs)) << "run " << run;
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,97 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+/*
+ * conv with SAME padding and global pooling write params derived from the input shape,
+ * switching between cached reshape plans has to restore them.
+ */
+static std::shared_ptr<AbstractModelInterpreter> GenerateReshapeInterpreter(std::vector<int> input_dims) {
+    auto conv_param            = std::make_shared<ConvLayerParam>();
+    conv_param->input_channel  = input_dims[1];
+    conv_param->output_channel = 4;
+    conv_param->group          = 1;
+    conv_param->kernels        = {3, 3};
+    conv_param->dialations     = {1, 1};
+    conv_param->strides        = {2, 2};
+    conv_param->pads           = {0, 0, 0, 0};
+    conv_param->pad_type       = 0;
+    conv_param->bias           = 1;
+
+    auto pool_param            = std::make_shared<PoolingLayerParam>();
+    pool_param->pool_type      = 1;
+    pool_param->pad_type       = -1;
+    pool_param->kernels_params = {0, 0};
+    pool_param->kernels        = {0, 0};
+    pool_param->strides        = {1, 1};
+    pool_param->pads           = {0, 0, 0, 0};
+    pool_param->kernel_indexs  = {-1, -1};
+
+    std::vector<std::shared_ptr<LayerInfo>> layers = {
+        CreateLayerInfo("Convolution", "conv", {"input0"}, {"conv"}, conv_param),
+        CreateLayerInfo("ReLU", "relu", {"conv"}, {"relu"}, std::make_shared<LayerParam>()),
+        CreateLayerInfo("Pooling", "pool", {"relu"}, {"output0"}, pool_param),
+        CreateLayerInfo("Abs", "abs", {"relu"}, {"output1"}, std::make_shared<LayerParam>()),
+    };
+    return GenerateNetInterpreter({input_dims}, layers);
+}
+
+TEST(ReshapePlanTest, AlternateShapes) {
+    const DeviceType device_type         = ConvertDeviceType(FLAGS_dt);
+    std::vector<DimsVector> input_shapes = {{1, 3, 9, 9}, {1, 3, 16, 12}};
+    auto interpreter                     = GenerateReshapeInterpreter(input_shapes[0]);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    // outputs of instances inited with each shape
+    std::vector<std::map<std::string, std::vector<float>>> inputs(input_shapes.size());
+    std::vector<std::map<std::string, std::vector<float>>> expects(input_shapes.size());
+    for (int i = 0; i < input_shapes.size(); ++i) {
+        std::vector<float> data(DimsVectorUtils::Count(input_shapes[i]));
+        InitRandom(data.data(), data.size(), 1.0f);
+        inputs[i]["input0"] = data;
+
+        auto instance = CreateInstance(interpreter, device_type, {{"input0", input_shapes[i]}});
+        ASSERT_TRUE(instance != nullptr);
+        ASSERT_TRUE(ForwardInstance(instance, inputs[i], expects[i]) == TNN_OK);
+    }
+
+    auto instance = CreateInstance(interpreter, device_type);
+    ASSERT_TRUE(instance != nullptr);
+    int memory_size = 0;
+    for (int step = 0; step < 6; ++step) {
+        const int index = (step + 1) % input_shapes.size();
+        ASSERT_TRUE(instance->Reshape({{"input0", input_shapes[index]}}) == TNN_OK);
+        // the blob memory holds both plans after the first switch
+        int step_memory_size = 0;
+        instance->GetForwardMemorySize(step_memory_size);
+        if (step > 0) {
+            EXPECT_EQ(memory_size, step_memory_size);
+        }
+        memory_size = step_memory_size;
+
+        std::map<std::string, std::vector<float>> outputs;
+        ASSERT_TRUE(ForwardInstance(instance, inputs[index], outputs) == TNN_OK);
+        ASSERT_TRUE(OutputsNear(expects[index], outputs)) << "step " << step;
+    }
+}
+
+}  // namespace TNN_NS
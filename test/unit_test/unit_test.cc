@@ -28,6 +28,8 @@ void ShowUsage() {
     printf("    -ic \"<number>\"        %s \n", iterations_count_message);
     printf("    -ub \"<bool>\"          %s \n", unit_test_benchmark_message);
     printf("    -th \"<bumber>\"        %s \n", cpu_thread_num_message);
+    printf("    -ubt \"<1,2,4>\"      %s \n", unit_test_benchmark_threads_message);
+    printf("    -ubo \"<path>\"       %s \n", unit_test_benchmark_output_message);
     printf("    -et \"<enable tune>\t%s \n", enable_tune_message);
 }
 
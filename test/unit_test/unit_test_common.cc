@@ -14,7 +14,9 @@
 
 #include "test/unit_test/unit_test_common.h"
 
+#include <cmath>
 #include <iostream>
+#include <set>
 #include <sstream>
 
 #include "test/flags.h"
@@ -22,6 +24,7 @@
 #include "tnn/core/macro.h"
 #include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/utils/bfp16.h"
+#include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
@@ -124,6 +127,10 @@ std::shared_ptr<AbstractModelInterpreter> GenerateInterpreter(std::string layer_
         net_structure->outputs.insert(ostr.str());
         net_structure->blobs.insert(ostr.str());
     }
+    // the profiler reports the op type of the param
+    if (param && param->type.empty()) {
+        param->type = layer_type_str;
+    }
     layer_info->param = param;
     net_structure->layers.push_back(layer_info);
 
@@ -135,4 +142,123 @@ std::shared_ptr<AbstractModelInterpreter> GenerateInterpreter(std::string layer_
     return std::shared_ptr<AbstractModelInterpreter>(interpreter);
 }
 
+std::shared_ptr<LayerInfo> CreateLayerInfo(std::string type_str, std::string name, std::vector<std::string> inputs,
+                                           std::vector<std::string> outputs, std::shared_ptr<LayerParam> param) {
+    auto layer_info      = std::make_shared<LayerInfo>();
+    layer_info->type     = GlobalConvertLayerType(type_str);
+    layer_info->type_str = type_str;
+    layer_info->name     = name;
+    layer_info->inputs   = inputs;
+    layer_info->outputs  = outputs;
+    param->type          = type_str;
+    param->name          = name;
+    layer_info->param    = param;
+    return layer_info;
+}
+
+std::shared_ptr<AbstractModelInterpreter> GenerateNetInterpreter(std::vector<std::vector<int>> input_vec,
+                                                                 std::vector<std::shared_ptr<LayerInfo>> layers) {
+    auto interpreter = dynamic_cast<DefaultModelInterpreter*>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    if (!interpreter) {
+        return nullptr;
+    }
+    NetStructure* net_structure     = interpreter->GetNetStructure();
+    net_structure->inputs_shape_map = GenerateInputShapeMap(input_vec);
+    for (auto item : net_structure->inputs_shape_map) {
+        net_structure->blobs.insert(item.first);
+    }
+
+    std::set<std::string> read_blobs;
+    for (auto layer : layers) {
+        read_blobs.insert(layer->inputs.begin(), layer->inputs.end());
+        net_structure->blobs.insert(layer->outputs.begin(), layer->outputs.end());
+    }
+    for (auto layer : layers) {
+        for (auto name : layer->outputs) {
+            if (read_blobs.count(name) == 0) {
+                net_structure->outputs.insert(name);
+            }
+        }
+    }
+    net_structure->layers = layers;
+    return std::shared_ptr<AbstractModelInterpreter>(interpreter);
+}
+
+std::shared_ptr<Instance> CreateInstance(std::shared_ptr<AbstractModelInterpreter> interpreter,
+                                         DeviceType device_type, InputShapesMap input_shape) {
+    NetworkConfig config;
+    config.device_type = device_type;
+    config.precision   = PRECISION_HIGH;
+    if (FLAGS_lp.length() > 0) {
+        config.library_path = {FLAGS_lp};
+    }
+    return CreateInstance(interpreter, config, input_shape);
+}
+
+std::shared_ptr<Instance> CreateInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, NetworkConfig config,
+                                         InputShapesMap input_shape) {
+    ModelConfig model_config;
+    model_config.params.push_back("");
+    model_config.params.push_back("");
+
+    auto instance = std::make_shared<Instance>(config, model_config);
+    Status ret    = instance->Init(interpreter, input_shape);
+    if (ret != TNN_OK) {
+        LOGE("tnn init instance failed (%s)\n", ret.description().c_str());
+        return nullptr;
+    }
+    return instance;
+}
+
+Status ForwardInstance(std::shared_ptr<Instance> instance, std::map<std::string, std::vector<float>>& inputs,
+                       std::map<std::string, std::vector<float>>& outputs) {
+    BlobMap input_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    for (auto iter : input_blobs) {
+        auto dims = iter.second->GetBlobDesc().dims;
+        auto data = inputs.find(iter.first);
+        if (data == inputs.end() || data->second.size() != DimsVectorUtils::Count(dims)) {
+            return Status(TNNERR_PARAM_ERR, "input data does not match the input " + iter.first);
+        }
+        auto mat = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, dims, data->second.data());
+        RETURN_ON_NEQ(instance->SetInputMat(mat, MatConvertParam(), iter.first), TNN_OK);
+    }
+
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    BlobMap output_blobs;
+    RETURN_ON_NEQ(instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+    outputs.clear();
+    for (auto iter : output_blobs) {
+        std::shared_ptr<Mat> mat;
+        RETURN_ON_NEQ(instance->GetOutputMat(mat, MatConvertParam(), iter.first, DEVICE_NAIVE, NCHW_FLOAT), TNN_OK);
+        const float* data      = static_cast<float*>(mat->GetData());
+        outputs[iter.first]    = std::vector<float>(data, data + DimsVectorUtils::Count(mat->GetDims()));
+    }
+    return TNN_OK;
+}
+
+::testing::AssertionResult OutputsNear(const std::map<std::string, std::vector<float>>& expects,
+                                       const std::map<std::string, std::vector<float>>& outputs, float tolerance) {
+    for (const auto& iter : expects) {
+        auto output_iter = outputs.find(iter.first);
+        if (output_iter == outputs.end()) {
+            return ::testing::AssertionFailure() << "output " << iter.first << " is missing";
+        }
+        const auto& expect = iter.second;
+        const auto& output = output_iter->second;
+        if (expect.size() != output.size()) {
+            return ::testing::AssertionFailure() << "output " << iter.first << " has " << output.size()
+                                                 << " values, expect " << expect.size();
+        }
+        for (int i = 0; i < output.size(); ++i) {
+            if (!(std::fabs(expect[i] - output[i]) <= tolerance * (1.0f + std::fabs(expect[i])))) {
+                return ::testing::AssertionFailure() << "output " << iter.first << " at " << i << " is "
+                                                     << output[i] << ", expect " << expect[i];
+            }
+        }
+    }
+    return ::testing::AssertionSuccess();
+}
+
 }  // namespace TNN_NS
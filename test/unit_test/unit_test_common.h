@@ -20,12 +20,16 @@
 #include <string>
 #include <vector>
 
+#include <gtest/gtest.h>
+
 #include "tnn/core/abstract_device.h"
 #include "tnn/core/context.h"
+#include "tnn/core/instance.h"
 #include "tnn/core/macro.h"
 #include "tnn/interpreter/abstract_model_interpreter.h"
 #include "tnn/interpreter/layer_param.h"
 #include "tnn/interpreter/layer_resource.h"
+#include "tnn/interpreter/net_structure.h"
 #include "tnn/utils/random_data_utils.h"
 
 namespace TNN_NS {
@@ -33,12 +37,38 @@ namespace TNN_NS {
 IntScaleResource* CreateIntScale(int channel);
 void SetUpEnvironment(AbstractDevice** cpu, AbstractDevice** device, Context** cpu_context, Context** device_context);
 
+// @brief shapes of the inputs named input0, input1, ...
+InputShapesMap GenerateInputShapeMap(std::vector<std::vector<int>>& input_vec);
+
 std::shared_ptr<AbstractModelInterpreter> GenerateInterpreter(std::string layer_type_str,
                                                               std::vector<std::vector<int>> input_vec,
                                                               std::shared_ptr<LayerParam> param,
                                                               std::shared_ptr<LayerResource> resource = nullptr,
                                                               int output_count                        = 1);
 
+// @brief layer info of one layer, the type and name of the param are set to the layer's
+std::shared_ptr<LayerInfo> CreateLayerInfo(std::string type_str, std::string name, std::vector<std::string> inputs,
+                                           std::vector<std::string> outputs, std::shared_ptr<LayerParam> param);
+
+// @brief interpreter of a net of the layers, the blobs no layer reads are the net outputs
+std::shared_ptr<AbstractModelInterpreter> GenerateNetInterpreter(std::vector<std::vector<int>> input_vec,
+                                                                 std::vector<std::shared_ptr<LayerInfo>> layers);
+
+// @brief create and init an instance of the interpreter on the device
+std::shared_ptr<Instance> CreateInstance(std::shared_ptr<AbstractModelInterpreter> interpreter,
+                                         DeviceType device_type, InputShapesMap input_shape = InputShapesMap());
+std::shared_ptr<Instance> CreateInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, NetworkConfig config,
+                                         InputShapesMap input_shape = InputShapesMap());
+
+// @brief forward the instance with the NCHW float data of the inputs, get the NCHW float data of all outputs
+Status ForwardInstance(std::shared_ptr<Instance> instance, std::map<std::string, std::vector<float>>& inputs,
+                       std::map<std::string, std::vector<float>>& outputs);
+
+// @brief every expected output matches the output of the same name, the tolerance grows with the expected value
+::testing::AssertionResult OutputsNear(const std::map<std::string, std::vector<float>>& expects,
+                                       const std::map<std::string, std::vector<float>>& outputs,
+                                       float tolerance = 1e-4f);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_TEST_UNIT_TEST_COMMON_H_
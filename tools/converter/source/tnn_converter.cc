@@ -50,7 +50,7 @@ int Run(int argc, char* argv[]) {
     }
     // wright the model
     std::string file_name = GetFileName(model_config.model_path_);
-    status                = GenerateModel(net_structure, net_resource, model_config.output_dir_, file_name);
+    status                = GenerateModel(net_structure, net_resource, model_config.output_dir_, file_name, FLAGS_mv);
     if (status != TNN_NS::TNN_CONVERT_OK) {
         LOGE("Converter: generate tnn model failed!\n");
         return status;
@@ -26,6 +26,9 @@ static const char output_dir_message[] = "specify output path: <the>/<path>/<to>
 
 static const char model_type_message[] = "specify model type: Caffe, TF, TFLite.";
 
+static const char model_version_message[] =
+    "specify tnn model version: 1 (default), 2 (weights aligned for memory mapped loading).";
+
 DECLARE_bool(h);
 
 DECLARE_string(mp);
@@ -34,6 +37,8 @@ DECLARE_string(od);
 
 DECLARE_string(mt);
 
+DECLARE_int32(mv);
+
 }  // namespace TNN_CONVERTER
 
 #endif  // TNNCONVERTER_SRC_FLAGS_H_
@@ -26,7 +26,7 @@ const std::string MODEL_SUFFIX = ".tnnmodel";
 std::string GetFileName(std::string& file_path);
 
 TNN_NS::Status GenerateModel(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
-                             std::string& output_dir, std::string& file_name);
+                             std::string& output_dir, std::string& file_name, int model_version = 1);
 
 }  // namespace TNN_CONVERTER
 